@@ -19,11 +19,15 @@ ofxAssimpAnimation::ofxAssimpAnimation(shared_ptr<const aiScene> scene, aiAnimat
     durationInSeconds = 0;
     durationInMilliSeconds = 0;
     speed = 1;
+    weight = 1;
+    bApplyToScene = true;
     
     if(animation != NULL) {
         durationInSeconds = animation->mDuration;
         durationInMilliSeconds = durationInSeconds * 1000;
     }
+    
+    clip = make_shared<ofxAssimpAnimationClip>(scene.get(), animation);
 }
 
 ofxAssimpAnimation::~ofxAssimpAnimation() {
@@ -64,81 +68,20 @@ void ofxAssimpAnimation::update() {
 }
 
 void ofxAssimpAnimation::updateAnimationNodes() {
-	for(unsigned int i=0; i<animation->mNumChannels; i++) {
-        const aiNodeAnim * channel = animation->mChannels[i];
-        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
-        
-        aiVector3D presentPosition(0, 0, 0);
-        if(channel->mNumPositionKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumPositionKeys - 1) {
-                if(progressInSeconds < channel->mPositionKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
-            const aiVectorKey & key = channel->mPositionKeys[frame];
-            const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
-            } else {
-                presentPosition = key.mValue;
-            }
-        }
-        
-        aiQuaternion presentRotation(1, 0, 0, 0);
-        if(channel->mNumRotationKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumRotationKeys - 1) {
-                if(progressInSeconds < channel->mRotationKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
-            const aiQuatKey& key = channel->mRotationKeys[frame];
-            const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
-            } else {
-                presentRotation = key.mValue;
-            }
-        }
-        
-        aiVector3D presentScaling(1, 1, 1);
-        if(channel->mNumScalingKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumScalingKeys - 1){
-                if(progressInSeconds < channel->mScalingKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            presentScaling = channel->mScalingKeys[frame].mValue;
-        }
-        
-        aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
-        mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
-        mat.a2 *= presentScaling.y; mat.b2 *= presentScaling.y; mat.c2 *= presentScaling.y;
-        mat.a3 *= presentScaling.z; mat.b3 *= presentScaling.z; mat.c3 *= presentScaling.z;
-        mat.a4 = presentPosition.x; mat.b4 = presentPosition.y; mat.c4 = presentPosition.z;
-        
-        targetNode->mTransformation = mat;
+    if(!bApplyToScene) {
+        return;
     }
+    pose.clear();
+    sample(pose);
+    pose.apply(clip->getNodes());
+}
+
+void ofxAssimpAnimation::sample(ofxAssimpAnimationPose & pose, float weight) {
+    clip->sample(progressInSeconds, cursor, pose, weight);
+}
+
+const ofxAssimpAnimationClip & ofxAssimpAnimation::getClip() {
+    return *clip;
 }
 
 void ofxAssimpAnimation::play() {
@@ -230,3 +173,19 @@ void ofxAssimpAnimation::setLoopState(ofLoopType state) {
 void ofxAssimpAnimation::setSpeed(float speed) {
     speed = 1; // TODO.
 }
+
+void ofxAssimpAnimation::setWeight(float weight) {
+    this->weight = weight;
+}
+
+float ofxAssimpAnimation::getWeight() {
+    return weight;
+}
+
+void ofxAssimpAnimation::setApplyToScene(bool apply) {
+    bApplyToScene = apply;
+}
+
+bool ofxAssimpAnimation::isApplyingToScene() {
+    return bApplyToScene;
+}
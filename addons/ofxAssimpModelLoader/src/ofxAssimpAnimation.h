@@ -11,6 +11,8 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include "ofxAssimpAnimationClip.h"
+
 class ofxAssimpAnimation {
 
 public:
@@ -43,12 +45,31 @@ public:
     void setLoopState(ofLoopType state);
     void setSpeed(float speed);
     
+    // weight used when several animations are blended, see
+    // ofxAssimpAnimationMixer and ofxAssimpModelLoader::setAnimationBlending
+    void setWeight(float weight);
+    float getWeight();
+    
+    // when false update() and setPosition() only advance the time and the
+    // nodes are left for a mixer to write.
+    void setApplyToScene(bool apply);
+    bool isApplyingToScene();
+    
+    // accumulates the pose at the current position into pose
+    void sample(ofxAssimpAnimationPose & pose, float weight = 1);
+    const ofxAssimpAnimationClip & getClip();
+    
 protected:
     
     void updateAnimationNodes();
     
     shared_ptr<const aiScene> scene;
     aiAnimation * animation;
+    shared_ptr<ofxAssimpAnimationClip> clip;
+    ofxAssimpAnimationCursor cursor;
+    ofxAssimpAnimationPose pose;
+    float weight;
+    bool bApplyToScene;
     float animationCurrTime;
     float animationPrevTime;
     bool bPlay;
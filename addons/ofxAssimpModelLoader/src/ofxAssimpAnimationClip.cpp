@@ -0,0 +1,385 @@
+//
+//  ofxAssimpAnimationClip.cpp
+//
+
+#include "ofxAssimpAnimationClip.h"
+#include "ofxAssimpAnimation.h"
+
+//-------------------------------------------------------------- pose.
+void ofxAssimpAnimationPose::allocate(size_t numNodes) {
+    px.resize(numNodes); py.resize(numNodes); pz.resize(numNodes);
+    rw.resize(numNodes); rx.resize(numNodes); ry.resize(numNodes); rz.resize(numNodes);
+    sx.resize(numNodes); sy.resize(numNodes); sz.resize(numNodes);
+    weights.resize(numNodes);
+    clear();
+}
+
+void ofxAssimpAnimationPose::clear() {
+    std::fill(px.begin(), px.end(), 0.f);
+    std::fill(py.begin(), py.end(), 0.f);
+    std::fill(pz.begin(), pz.end(), 0.f);
+    std::fill(rw.begin(), rw.end(), 0.f);
+    std::fill(rx.begin(), rx.end(), 0.f);
+    std::fill(ry.begin(), ry.end(), 0.f);
+    std::fill(rz.begin(), rz.end(), 0.f);
+    std::fill(sx.begin(), sx.end(), 0.f);
+    std::fill(sy.begin(), sy.end(), 0.f);
+    std::fill(sz.begin(), sz.end(), 0.f);
+    std::fill(weights.begin(), weights.end(), 0.f);
+}
+
+size_t ofxAssimpAnimationPose::size() const {
+    return weights.size();
+}
+
+float ofxAssimpAnimationPose::getWeight(size_t node) const {
+    return weights[node];
+}
+
+void ofxAssimpAnimationPose::accumulate(size_t node, const aiVector3D & position, const aiQuaternion & rotation, const aiVector3D & scaling, float weight) {
+    // q and -q are the same rotation, keep every contribution in the
+    // same hemisphere as what's already accumulated so they don't cancel.
+    float rotationWeight = weight;
+    if(weights[node] > 0) {
+        float dot = rw[node] * rotation.w + rx[node] * rotation.x + ry[node] * rotation.y + rz[node] * rotation.z;
+        if(dot < 0) {
+            rotationWeight = -weight;
+        }
+    }
+    px[node] += position.x * weight;
+    py[node] += position.y * weight;
+    pz[node] += position.z * weight;
+    rw[node] += rotation.w * rotationWeight;
+    rx[node] += rotation.x * rotationWeight;
+    ry[node] += rotation.y * rotationWeight;
+    rz[node] += rotation.z * rotationWeight;
+    sx[node] += scaling.x * weight;
+    sy[node] += scaling.y * weight;
+    sz[node] += scaling.z * weight;
+    weights[node] += weight;
+}
+
+aiMatrix4x4 ofxAssimpAnimationPose::getTransform(size_t node) const {
+    float weight = weights[node];
+    if(weight <= 0) {
+        return aiMatrix4x4();
+    }
+    float invWeight = 1.f / weight;
+    aiQuaternion rotation(rw[node], rx[node], ry[node], rz[node]);
+    rotation.Normalize();
+
+    aiMatrix4x4 mat = aiMatrix4x4(rotation.GetMatrix());
+    float scaleX = sx[node] * invWeight;
+    float scaleY = sy[node] * invWeight;
+    float scaleZ = sz[node] * invWeight;
+    mat.a1 *= scaleX; mat.b1 *= scaleX; mat.c1 *= scaleX;
+    mat.a2 *= scaleY; mat.b2 *= scaleY; mat.c2 *= scaleY;
+    mat.a3 *= scaleZ; mat.b3 *= scaleZ; mat.c3 *= scaleZ;
+    mat.a4 = px[node] * invWeight;
+    mat.b4 = py[node] * invWeight;
+    mat.c4 = pz[node] * invWeight;
+    return mat;
+}
+
+void ofxAssimpAnimationPose::apply(const vector<aiNode*> & nodes) const {
+    size_t numNodes = std::min(nodes.size(), size());
+    for(size_t i=0; i<numNodes; i++) {
+        if(weights[i] > 0) {
+            nodes[i]->mTransformation = getTransform(i);
+        }
+    }
+}
+
+void ofxAssimpAnimationPose::blend(const ofxAssimpAnimationPose & from, const ofxAssimpAnimationPose & to, float pct) {
+    size_t numNodes = std::min(from.size(), to.size());
+    allocate(numNodes);
+    const ofxAssimpAnimationPose * poses[2] = { &from, &to };
+    for(size_t i=0; i<numNodes; i++) {
+        bool animated[2] = { from.weights[i] > 0, to.weights[i] > 0 };
+        float pcts[2] = { 1 - pct, pct };
+        for(int j=0; j<2; j++) {
+            if(!animated[j]) {
+                continue;
+            }
+            // if only one of the poses animates the node it takes all the weight
+            float weight = animated[1 - j] ? pcts[j] : 1;
+            if(weight <= 0) {
+                continue;
+            }
+            const ofxAssimpAnimationPose & src = *poses[j];
+            float invWeight = 1.f / src.weights[i];
+            aiQuaternion rotation(src.rw[i], src.rx[i], src.ry[i], src.rz[i]);
+            rotation.Normalize();
+            accumulate(i,
+                       aiVector3D(src.px[i], src.py[i], src.pz[i]) * invWeight,
+                       rotation,
+                       aiVector3D(src.sx[i], src.sy[i], src.sz[i]) * invWeight,
+                       weight);
+        }
+    }
+}
+
+//-------------------------------------------------------------- cursor.
+void ofxAssimpAnimationCursor::reset() {
+    std::fill(position.begin(), position.end(), 0);
+    std::fill(rotation.begin(), rotation.end(), 0);
+    std::fill(scaling.begin(), scaling.end(), 0);
+}
+
+//-------------------------------------------------------------- tracks.
+void ofxAssimpAnimationClip::Tracks::clear() {
+    offset.clear();
+    count.clear();
+    times.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+    w.clear();
+}
+
+void ofxAssimpAnimationClip::Tracks::resizeChannels(size_t numChannels) {
+    offset.resize(numChannels);
+    count.resize(numChannels);
+}
+
+unsigned int ofxAssimpAnimationClip::Tracks::find(double time, size_t channel, unsigned int cursor) const {
+    unsigned int numKeys = count[channel];
+    const double * keyTimes = &times[offset[channel]];
+
+    // when going backwards or on a new cursor do a binary search to find the
+    // last key <= time, otherwise walk forward from the previous key.
+    if(cursor >= numKeys || (cursor > 0 && time < keyTimes[cursor])) {
+        unsigned int upper = std::upper_bound(keyTimes, keyTimes + numKeys, time) - keyTimes;
+        cursor = upper > 0 ? upper - 1 : 0;
+    }
+    while(cursor < numKeys - 1 && time >= keyTimes[cursor + 1]) {
+        cursor++;
+    }
+    return cursor;
+}
+
+//-------------------------------------------------------------- clip.
+ofxAssimpAnimationClip::ofxAssimpAnimationClip() {
+    duration = 0;
+}
+
+ofxAssimpAnimationClip::ofxAssimpAnimationClip(const aiScene * scene, const aiAnimation * animation) {
+    duration = 0;
+    setup(scene, animation);
+}
+
+void ofxAssimpAnimationClip::collectNodes(aiNode * node, vector<aiNode*> & nodes) {
+    if(node == NULL) {
+        return;
+    }
+    nodes.push_back(node);
+    for(unsigned int i=0; i<node->mNumChildren; i++) {
+        collectNodes(node->mChildren[i], nodes);
+    }
+}
+
+void ofxAssimpAnimationClip::setup(const aiScene * scene, const aiAnimation * animation) {
+    nodes.clear();
+    channelNodes.clear();
+    positions.clear();
+    rotations.clear();
+    scalings.clear();
+    duration = 0;
+
+    if(scene == NULL || animation == NULL) {
+        return;
+    }
+
+    collectNodes(scene->mRootNode, nodes);
+    duration = animation->mDuration;
+
+    unsigned int numChannels = animation->mNumChannels;
+    channelNodes.resize(numChannels, -1);
+    positions.resizeChannels(numChannels);
+    rotations.resizeChannels(numChannels);
+    scalings.resizeChannels(numChannels);
+
+    for(unsigned int i=0; i<numChannels; i++) {
+        const aiNodeAnim * channel = animation->mChannels[i];
+        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
+        auto it = std::find(nodes.begin(), nodes.end(), targetNode);
+        if(it != nodes.end()) {
+            channelNodes[i] = it - nodes.begin();
+        } else {
+            ofLogWarning("ofxAssimpAnimationClip") << "setup(): couldn't find node " << channel->mNodeName.C_Str();
+        }
+
+        positions.offset[i] = positions.times.size();
+        positions.count[i] = channel->mNumPositionKeys;
+        for(unsigned int j=0; j<channel->mNumPositionKeys; j++) {
+            const aiVectorKey & key = channel->mPositionKeys[j];
+            positions.times.push_back(key.mTime);
+            positions.x.push_back(key.mValue.x);
+            positions.y.push_back(key.mValue.y);
+            positions.z.push_back(key.mValue.z);
+        }
+
+        rotations.offset[i] = rotations.times.size();
+        rotations.count[i] = channel->mNumRotationKeys;
+        for(unsigned int j=0; j<channel->mNumRotationKeys; j++) {
+            const aiQuatKey & key = channel->mRotationKeys[j];
+            rotations.times.push_back(key.mTime);
+            rotations.x.push_back(key.mValue.x);
+            rotations.y.push_back(key.mValue.y);
+            rotations.z.push_back(key.mValue.z);
+            rotations.w.push_back(key.mValue.w);
+        }
+
+        scalings.offset[i] = scalings.times.size();
+        scalings.count[i] = channel->mNumScalingKeys;
+        for(unsigned int j=0; j<channel->mNumScalingKeys; j++) {
+            const aiVectorKey & key = channel->mScalingKeys[j];
+            scalings.times.push_back(key.mTime);
+            scalings.x.push_back(key.mValue.x);
+            scalings.y.push_back(key.mValue.y);
+            scalings.z.push_back(key.mValue.z);
+        }
+    }
+}
+
+size_t ofxAssimpAnimationClip::getNumChannels() const {
+    return channelNodes.size();
+}
+
+size_t ofxAssimpAnimationClip::getNumNodes() const {
+    return nodes.size();
+}
+
+const vector<aiNode*> & ofxAssimpAnimationClip::getNodes() const {
+    return nodes;
+}
+
+int ofxAssimpAnimationClip::getChannelNode(size_t channel) const {
+    return channelNodes[channel];
+}
+
+double ofxAssimpAnimationClip::getDuration() const {
+    return duration;
+}
+
+void ofxAssimpAnimationClip::samplePosition(double time, size_t channel, unsigned int & cursor, aiVector3D & position) const {
+    unsigned int numKeys = positions.count[channel];
+    if(numKeys == 0) {
+        position.Set(0, 0, 0);
+        return;
+    }
+    cursor = positions.find(time, channel, cursor);
+    unsigned int key = positions.offset[channel] + cursor;
+    unsigned int nextKey = positions.offset[channel] + (cursor + 1) % numKeys;
+    double diffTime = positions.times[nextKey] - positions.times[key];
+    if(diffTime < 0.0) {
+        diffTime += duration;
+    }
+    if(diffTime > 0) {
+        float factor = float((time - positions.times[key]) / diffTime);
+        position.x = positions.x[key] + (positions.x[nextKey] - positions.x[key]) * factor;
+        position.y = positions.y[key] + (positions.y[nextKey] - positions.y[key]) * factor;
+        position.z = positions.z[key] + (positions.z[nextKey] - positions.z[key]) * factor;
+    } else {
+        position.Set(positions.x[key], positions.y[key], positions.z[key]);
+    }
+}
+
+void ofxAssimpAnimationClip::sampleRotation(double time, size_t channel, unsigned int & cursor, aiQuaternion & rotation) const {
+    unsigned int numKeys = rotations.count[channel];
+    if(numKeys == 0) {
+        rotation = aiQuaternion(1, 0, 0, 0);
+        return;
+    }
+    cursor = rotations.find(time, channel, cursor);
+    unsigned int key = rotations.offset[channel] + cursor;
+    unsigned int nextKey = rotations.offset[channel] + (cursor + 1) % numKeys;
+    aiQuaternion start(rotations.w[key], rotations.x[key], rotations.y[key], rotations.z[key]);
+    double diffTime = rotations.times[nextKey] - rotations.times[key];
+    if(diffTime < 0.0) {
+        diffTime += duration;
+    }
+    if(diffTime > 0) {
+        aiQuaternion end(rotations.w[nextKey], rotations.x[nextKey], rotations.y[nextKey], rotations.z[nextKey]);
+        float factor = float((time - rotations.times[key]) / diffTime);
+        aiQuaternion::Interpolate(rotation, start, end, factor);
+    } else {
+        rotation = start;
+    }
+}
+
+void ofxAssimpAnimationClip::sampleScaling(double time, size_t channel, unsigned int & cursor, aiVector3D & scaling) const {
+    if(scalings.count[channel] == 0) {
+        scaling.Set(1, 1, 1);
+        return;
+    }
+    cursor = scalings.find(time, channel, cursor);
+    unsigned int key = scalings.offset[channel] + cursor;
+    scaling.Set(scalings.x[key], scalings.y[key], scalings.z[key]);
+}
+
+void ofxAssimpAnimationClip::sample(double time, ofxAssimpAnimationCursor & cursor, ofxAssimpAnimationPose & pose, float weight) const {
+    size_t numChannels = getNumChannels();
+    if(cursor.position.size() != numChannels) {
+        cursor.position.assign(numChannels, 0);
+        cursor.rotation.assign(numChannels, 0);
+        cursor.scaling.assign(numChannels, 0);
+    }
+    if(pose.size() != nodes.size()) {
+        pose.allocate(nodes.size());
+    }
+
+    aiVector3D position;
+    aiQuaternion rotation;
+    aiVector3D scaling;
+    for(size_t i=0; i<numChannels; i++) {
+        int node = channelNodes[i];
+        if(node < 0) {
+            continue;
+        }
+        samplePosition(time, i, cursor.position[i], position);
+        sampleRotation(time, i, cursor.rotation[i], rotation);
+        sampleScaling(time, i, cursor.scaling[i], scaling);
+        pose.accumulate(node, position, rotation, scaling, weight);
+    }
+}
+
+void ofxAssimpAnimationClip::sample(const double * times, size_t numInstances, ofxAssimpAnimationCursor * cursors, ofxAssimpAnimationPose * poses, float weight) const {
+    for(size_t i=0; i<numInstances; i++) {
+        sample(times[i], cursors[i], poses[i], weight);
+    }
+}
+
+//-------------------------------------------------------------- mixer.
+void ofxAssimpAnimationMixer::setup(const aiScene * scene) {
+    nodes.clear();
+    if(scene != NULL) {
+        ofxAssimpAnimationClip::collectNodes(scene->mRootNode, nodes);
+    }
+    pose.allocate(nodes.size());
+}
+
+void ofxAssimpAnimationMixer::begin() {
+    pose.clear();
+}
+
+void ofxAssimpAnimationMixer::add(ofxAssimpAnimation & animation, float weight) {
+    if(weight <= 0) {
+        return;
+    }
+    animation.sample(pose, weight);
+}
+
+void ofxAssimpAnimationMixer::crossfade(ofxAssimpAnimation & from, ofxAssimpAnimation & to, float pct) {
+    pct = ofClamp(pct, 0, 1);
+    add(from, 1 - pct);
+    add(to, pct);
+}
+
+void ofxAssimpAnimationMixer::end() {
+    pose.apply(nodes);
+}
+
+const ofxAssimpAnimationPose & ofxAssimpAnimationMixer::getPose() const {
+    return pose;
+}
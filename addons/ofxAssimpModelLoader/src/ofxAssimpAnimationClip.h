@@ -0,0 +1,128 @@
+//
+//  ofxAssimpAnimationClip.h
+//
+//  Sampling engine for assimp animations. Key frames are copied once into
+//  flat float arrays (one array per component) and sampled with per channel
+//  cursors so forward playback doesn't need to search the keys every frame.
+//  Samples are accumulated into a pose which allows to blend several
+//  animations of the same scene before writing the result to the nodes.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+#include <assimp/scene.h>
+
+//--------------------------------------------------------------
+// local transform of every node in a scene, stored as one array per
+// component and indexed by the position of the node in
+// ofxAssimpAnimationClip::collectNodes. samples are accumulated weighted
+// so several clips can contribute to the same pose.
+class ofxAssimpAnimationPose {
+public:
+    void allocate(size_t numNodes);
+    void clear();
+    size_t size() const;
+
+    // returns the accumulated weight for a node, 0 if no clip animated it
+    float getWeight(size_t node) const;
+    // normalized transform for a node as an assimp matrix
+    aiMatrix4x4 getTransform(size_t node) const;
+
+    // writes the transform of every node with weight > 0 into the nodes
+    void apply(const vector<aiNode*> & nodes) const;
+
+    // blends two poses into this one, 0 -> from, 1 -> to
+    void blend(const ofxAssimpAnimationPose & from, const ofxAssimpAnimationPose & to, float pct);
+
+    void accumulate(size_t node, const aiVector3D & position, const aiQuaternion & rotation, const aiVector3D & scaling, float weight);
+
+    vector<float> px, py, pz;
+    vector<float> rw, rx, ry, rz;
+    vector<float> sx, sy, sz;
+    vector<float> weights;
+};
+
+//--------------------------------------------------------------
+// last key used for every track of a clip. keeping one per instance makes
+// sampling amortized O(1) when time moves forward, seeking backwards falls
+// back to a binary search.
+class ofxAssimpAnimationCursor {
+public:
+    void reset();
+
+    vector<unsigned int> position;
+    vector<unsigned int> rotation;
+    vector<unsigned int> scaling;
+};
+
+//--------------------------------------------------------------
+class ofxAssimpAnimationClip {
+public:
+    ofxAssimpAnimationClip();
+    ofxAssimpAnimationClip(const aiScene * scene, const aiAnimation * animation);
+
+    void setup(const aiScene * scene, const aiAnimation * animation);
+
+    // depth first list of every node in the scene, poses are indexed by it
+    static void collectNodes(aiNode * node, vector<aiNode*> & nodes);
+
+    size_t getNumChannels() const;
+    size_t getNumNodes() const;
+    const vector<aiNode*> & getNodes() const;
+    // index into getNodes() of the node animated by a channel, -1 if not found
+    int getChannelNode(size_t channel) const;
+    double getDuration() const;
+
+    // samples every channel at time (in ticks) and accumulates it into pose
+    void sample(double time, ofxAssimpAnimationCursor & cursor, ofxAssimpAnimationPose & pose, float weight = 1) const;
+
+    // samples many instances of the same clip, each one with its own time,
+    // cursor and pose
+    void sample(const double * times, size_t numInstances, ofxAssimpAnimationCursor * cursors, ofxAssimpAnimationPose * poses, float weight = 1) const;
+
+protected:
+    struct Tracks {
+        void clear();
+        void resizeChannels(size_t numChannels);
+        unsigned int find(double time, size_t channel, unsigned int cursor) const;
+
+        vector<unsigned int> offset;
+        vector<unsigned int> count;
+        vector<double> times;
+        vector<float> x, y, z, w;
+    };
+
+    void samplePosition(double time, size_t channel, unsigned int & cursor, aiVector3D & position) const;
+    void sampleRotation(double time, size_t channel, unsigned int & cursor, aiQuaternion & rotation) const;
+    void sampleScaling(double time, size_t channel, unsigned int & cursor, aiVector3D & scaling) const;
+
+    vector<aiNode*> nodes;
+    vector<int> channelNodes;
+    Tracks positions;
+    Tracks rotations;
+    Tracks scalings;
+    double duration;
+};
+
+//--------------------------------------------------------------
+// blends several ofxAssimpAnimation from the same scene into one pose and
+// writes it to the scene nodes.
+class ofxAssimpAnimation;
+
+class ofxAssimpAnimationMixer {
+public:
+    void setup(const aiScene * scene);
+
+    void begin();
+    void add(ofxAssimpAnimation & animation, float weight);
+    void crossfade(ofxAssimpAnimation & from, ofxAssimpAnimation & to, float pct);
+    void end();
+
+    const ofxAssimpAnimationPose & getPose() const;
+
+protected:
+    vector<aiNode*> nodes;
+    ofxAssimpAnimationPose pose;
+};
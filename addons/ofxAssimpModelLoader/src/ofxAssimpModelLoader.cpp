@@ -353,6 +353,7 @@ void ofxAssimpModelLoader::clear(){
     // clear out everything.
     modelMeshes.clear();
     animations.clear();
+    animationMixer.setup(NULL);
     pos.set(0,0,0);
     scale.set(1,1,1);
     rotAngle.clear();
@@ -367,6 +368,7 @@ void ofxAssimpModelLoader::clear(){
     bUsingColors = true;
 
     currentAnimation = -1;
+    bAnimationBlending = false;
 
     textures.clear();
 
@@ -386,9 +388,25 @@ void ofxAssimpModelLoader::update() {
 }
 
 void ofxAssimpModelLoader::updateAnimations() {
+    if(!bAnimationBlending) {
+        for(unsigned int i=0; i<animations.size(); i++) {
+            animations[i].update();
+        }
+        return;
+    }
+    
+    if(animationMixer.getPose().size() == 0) {
+        animationMixer.setup(scene.get());
+    }
+    animationMixer.begin();
     for(unsigned int i=0; i<animations.size(); i++) {
+        animations[i].setApplyToScene(false);
         animations[i].update();
+        if(animations[i].isPlaying()) {
+            animationMixer.add(animations[i], animations[i].getWeight());
+        }
     }
+    animationMixer.end();
 }
 
 void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix) {
@@ -554,6 +572,26 @@ void ofxAssimpModelLoader::setPositionForAllAnimations(float position) {
     }
 }
 
+void ofxAssimpModelLoader::setAnimationBlending(bool blend) {
+    bAnimationBlending = blend;
+    for(unsigned int i=0; i<animations.size(); i++) {
+        animations[i].setApplyToScene(!blend);
+    }
+}
+
+bool ofxAssimpModelLoader::isAnimationBlending() {
+    return bAnimationBlending;
+}
+
+void ofxAssimpModelLoader::crossfadeAnimations(int fromIndex, int toIndex, float pct) {
+    if(!hasAnimations()) {
+        return;
+    }
+    pct = ofClamp(pct, 0, 1);
+    getAnimation(fromIndex).setWeight(1 - pct);
+    getAnimation(toIndex).setWeight(pct);
+}
+
 // DEPRECATED.
 void ofxAssimpModelLoader::setAnimation(int animationIndex) {
     if(!hasAnimations()) {
@@ -12,7 +12,6 @@
 //      b) properly describe sub-folders
 //      c) reference absolute paths for images that dont exist.
 // 2) convert to ofMesh (?) in OF 007 ?
-// 3) Ability to ease *between* two animations. Maybe later folks.
 
 #include "ofMain.h"
 #include "ofxAssimpMeshHelper.h"
@@ -45,6 +44,11 @@ class ofxAssimpModelLoader{
         void setPausedForAllAnimations(bool pause);
         void setLoopStateForAllAnimations(ofLoopType state);
         void setPositionForAllAnimations(float position);
+        // blends every playing animation by its weight instead of each one
+        // overwriting the nodes animated by the previous ones.
+        void setAnimationBlending(bool blend);
+        bool isAnimationBlending();
+        void crossfadeAnimations(int fromIndex, int toIndex, float pct);
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setAnimation(int animationIndex));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setNormalizedTime(float time));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setTime(float time));
@@ -148,6 +152,8 @@ class ofxAssimpModelLoader{
         vector<ofxAssimpTexture> textures;
         vector<ofxAssimpMeshHelper> modelMeshes;
         vector<ofxAssimpAnimation> animations;
+        ofxAssimpAnimationMixer animationMixer;
+        bool bAnimationBlending;
         int currentAnimation; // DEPRECATED - to be removed with deprecated animation functions.
 
         bool bUsingTextures;
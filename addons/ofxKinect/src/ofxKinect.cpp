@@ -413,6 +413,26 @@ ofVec3f ofxKinect::getWorldCoordinateAt(float cx, float cy, float wz)  const{
 	return ofVec3f(wx, wy, wz);
 }
 
+//------------------------------------
+size_t ofxKinect::getWorldCoordinates(vector<ofVec3f> & points, int step, vector<unsigned char> * valid) const{
+	return depthProcessor.getWorldCoordinates(depthPixelsRaw, points, step, valid);
+}
+
+//------------------------------------
+void ofxKinect::getPointCloud(ofMesh & mesh, int step, bool bTexCoords) const{
+	depthProcessor.getPointCloud(depthPixelsRaw, mesh, step, bTexCoords);
+}
+
+//------------------------------------
+ofxKinectDepthProcessor & ofxKinect::getDepthProcessor(){
+	return depthProcessor;
+}
+
+//------------------------------------
+const ofxKinectDepthProcessor & ofxKinect::getDepthProcessor() const{
+	return depthProcessor;
+}
+
 //------------------------------------
 float ofxKinect::getSensorEmitterDistance()  const{
 	return kinectDevice->registration.zero_plane_info.dcmos_emitter_dist;
@@ -537,7 +557,6 @@ const ofTexture& ofxKinect::getDepthTextureReference() const{
 //---------------------------------------------------------------------------
 void ofxKinect::enableDepthNearValueWhite(bool bEnabled) {
 	bNearWhite = bEnabled;
-	updateDepthLookupTable();
 }
 
 //---------------------------------------------------------------------------
@@ -549,7 +568,6 @@ bool ofxKinect::isDepthNearValueWhite() const{
 void ofxKinect::setDepthClipping(float nearClip, float farClip) {
 	nearClipping = nearClip;
 	farClipping = farClip;
-	updateDepthLookupTable();
 }
 
 //---------------------------------------------------------------------------
@@ -745,26 +763,24 @@ string ofxKinect::nextAvailableSerial() {
 /* ***** PRIVATE ***** */
 
 //---------------------------------------------------------------------------
-void ofxKinect::updateDepthLookupTable() {
-	unsigned char nearColor = bNearWhite ? 255 : 0;
-	unsigned char farColor = bNearWhite ? 0 : 255;
-	unsigned int maxDepthLevels = 10001;
-	depthLookupTable.resize(maxDepthLevels);
-	depthLookupTable[0] = 0;
-	for(unsigned int i = 1; i < maxDepthLevels; i++) {
-		depthLookupTable[i] = ofMap(i, nearClipping, farClipping, nearColor, farColor, true);
+void ofxKinect::updateDepthProcessor() {
+	// the zero plane info is read from the device when the depth stream starts
+	if(kinectDevice == NULL) {
+		return;
+	}
+	const freenect_zero_plane_info & info = kinectDevice->registration.zero_plane_info;
+	if(info.reference_distance > 0 &&
+	   (info.reference_distance != depthProcessor.getReferenceDistance() ||
+	    info.reference_pixel_size != depthProcessor.getReferencePixelSize())) {
+		depthProcessor.setup(width, height, info.reference_pixel_size, info.reference_distance);
 	}
 }
 
 //----------------------------------------------------------
 void ofxKinect::updateDepthPixels() {
-	int n = width * height;
-	for(int i = 0; i < n; i++) {
-		distancePixels[i] = depthPixelsRaw[i];
-	}
-	for(int i = 0; i < n; i++) {
-		depthPixels[i] = depthLookupTable[depthPixelsRaw[i]];
-	}
+	updateDepthProcessor();
+	ofxKinectDepthProcessor::toDistance(depthPixelsRaw, distancePixels);
+	ofxKinectDepthProcessor::toGray(depthPixelsRaw, depthPixels, nearClipping, farClipping, bNearWhite);
 }
 
 //---------------------------------------------------------------------------
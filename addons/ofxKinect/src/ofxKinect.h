@@ -44,6 +44,7 @@
 
 
 #include "ofxBase3DVideo.h"
+#include "ofxKinectDepthProcessor.h"
 
 class ofxKinectContext;
 
@@ -129,6 +130,28 @@ public:
 	ofVec3f getWorldCoordinateAt(int cx, int cy) const;
 	ofVec3f getWorldCoordinateAt(float cx, float cy, float wz) const;
 
+/// \section Point Cloud
+
+	/// calculates the world coordinates of every step-th depth point at once,
+	/// much faster than calling getWorldCoordinateAt for every point
+	///
+	/// invalid points (no data or outside the depth processor range) are
+	/// (0,0,0), returns the number of valid points
+	size_t getWorldCoordinates(vector<ofVec3f> & points, int step=1, vector<unsigned char> * valid=NULL) const;
+
+	/// fill a mesh with the valid world coordinates of every step-th depth point
+	///
+	/// set bTexCoords to add the depth image coordinates of every point, ie
+	/// to texture the points with the video image when using registration
+	void getPointCloud(ofMesh & mesh, int step=1, bool bTexCoords=false) const;
+
+	/// the processor used for the depth conversions, ie to set the valid range
+	/// of distances for point clouds
+	///
+	/// it's set up with the device calibration once depth frames arrive
+	ofxKinectDepthProcessor & getDepthProcessor();
+	const ofxKinectDepthProcessor & getDepthProcessor() const;
+
 /// \section Intrinsic IR Sensor Parameters
 
 	/// these values are used when depth registration is enabled to align the
@@ -380,8 +403,8 @@ private:
 	ofShortPixels depthPixelsRawBack;	///< depth back
 	ofPixels videoPixelsBack;			///< rgb back
 
-	vector<unsigned char> depthLookupTable;
-	void updateDepthLookupTable();
+	ofxKinectDepthProcessor depthProcessor;
+	void updateDepthProcessor();
 	void updateDepthPixels();
 
 	bool bIsFrameNewVideo, bIsFrameNewDepth;
@@ -0,0 +1,296 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectDepthProcessor.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OFX_KINECT_SSE2
+	#include <emmintrin.h>
+#endif
+
+//--------------------------------------------------------------------
+ofxKinectDepthProcessor::ofxKinectDepthProcessor() {
+	minDistance = 0;
+	maxDistance = 0;
+	setup();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::setup(int width, int height, float refPixelSize, float refDistance) {
+	this->width = width;
+	this->height = height;
+	this->refPixelSize = refPixelSize;
+	this->refDistance = refDistance;
+
+	// the zero plane pixel size is for a 1280x1024 image, the depth image is
+	// that cropped to 1280x960 and scaled down, so the scale is the same in
+	// both dimensions. see freenect_camera_to_world
+	double factor = refPixelSize * (1280.0 / width) / refDistance;
+	rayX.resize(width);
+	rayY.resize(height);
+	for(int x = 0; x < width; x++) {
+		rayX[x] = (x - width / 2) * factor;
+	}
+	for(int y = 0; y < height; y++) {
+		rayY[y] = (y - height / 2) * factor;
+	}
+}
+
+//--------------------------------------------------------------------
+int ofxKinectDepthProcessor::getWidth() const {
+	return width;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectDepthProcessor::getHeight() const {
+	return height;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectDepthProcessor::getReferencePixelSize() const {
+	return refPixelSize;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectDepthProcessor::getReferenceDistance() const {
+	return refDistance;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::setDepthRange(float minDistance, float maxDistance) {
+	this->minDistance = minDistance;
+	this->maxDistance = maxDistance;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectDepthProcessor::getMinDistance() const {
+	return minDistance;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectDepthProcessor::getMaxDistance() const {
+	return maxDistance;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::toDistance(const unsigned short * raw, float * distance, size_t n) {
+	size_t i = 0;
+#ifdef OFX_KINECT_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for(; i + 8 <= n; i += 8) {
+		__m128i r = _mm_loadu_si128((const __m128i*)(raw + i));
+		_mm_storeu_ps(distance + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(r, zero)));
+		_mm_storeu_ps(distance + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(r, zero)));
+	}
+#endif
+	for(; i < n; i++) {
+		distance[i] = raw[i];
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::toDistance(const ofShortPixels & raw, ofFloatPixels & distance) {
+	if(distance.getWidth() != raw.getWidth() || distance.getHeight() != raw.getHeight() || distance.getNumChannels() != 1) {
+		distance.allocate(raw.getWidth(), raw.getHeight(), 1);
+	}
+	toDistance(raw.getData(), distance.getData(), raw.size());
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::toGray(const unsigned short * raw, unsigned char * gray, size_t n, float nearClip, float farClip, bool bNearWhite) {
+	float nearColor = bNearWhite ? 255 : 0;
+	float farColor = bNearWhite ? 0 : 255;
+
+	// ofMap returns the min output when the input range is empty
+	if(fabs(nearClip - farClip) < FLT_EPSILON) {
+		for(size_t i = 0; i < n; i++) {
+			gray[i] = raw[i] == 0 ? 0 : (unsigned char)nearColor;
+		}
+		return;
+	}
+
+	size_t i = 0;
+#ifdef OFX_KINECT_SSE2
+	// same operations in the same order as ofMap so the result is identical
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 inputMin = _mm_set1_ps(nearClip);
+	const __m128 inputRange = _mm_set1_ps(farClip - nearClip);
+	const __m128 outputRange = _mm_set1_ps(farColor - nearColor);
+	const __m128 outputMin = _mm_set1_ps(nearColor);
+	const __m128 low = _mm_set1_ps(0);
+	const __m128 high = _mm_set1_ps(255);
+	for(; i + 8 <= n; i += 8) {
+		__m128i r = _mm_loadu_si128((const __m128i*)(raw + i));
+		__m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(r, zero));
+		__m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(r, zero));
+		lo = _mm_add_ps(_mm_mul_ps(_mm_div_ps(_mm_sub_ps(lo, inputMin), inputRange), outputRange), outputMin);
+		hi = _mm_add_ps(_mm_mul_ps(_mm_div_ps(_mm_sub_ps(hi, inputMin), inputRange), outputRange), outputMin);
+		lo = _mm_min_ps(_mm_max_ps(lo, low), high);
+		hi = _mm_min_ps(_mm_max_ps(hi, low), high);
+		__m128i values = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+		// no data stays black
+		values = _mm_andnot_si128(_mm_cmpeq_epi16(r, zero), values);
+		_mm_storel_epi64((__m128i*)(gray + i), _mm_packus_epi16(values, values));
+	}
+#endif
+	for(; i < n; i++) {
+		gray[i] = raw[i] == 0 ? 0 : (unsigned char)ofMap(raw[i], nearClip, farClip, nearColor, farColor, true);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::toGray(const ofShortPixels & raw, ofPixels & gray, float nearClip, float farClip, bool bNearWhite) {
+	if(gray.getWidth() != raw.getWidth() || gray.getHeight() != raw.getHeight() || gray.getNumChannels() != 1) {
+		gray.allocate(raw.getWidth(), raw.getHeight(), 1);
+	}
+	toGray(raw.getData(), gray.getData(), raw.size(), nearClip, farClip, bNearWhite);
+}
+
+//--------------------------------------------------------------------
+ofVec3f ofxKinectDepthProcessor::getWorldCoordinateAt(int x, int y, float z) const {
+	return ofVec3f(rayX[x] * z, rayY[y] * z, z);
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectDepthProcessor::getNumPoints(int step) const {
+	step = MAX(step, 1);
+	return (size_t)((width + step - 1) / step) * ((height + step - 1) / step);
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectDepthProcessor::processRow(const unsigned short * raw, int y, int step, float * xyz, unsigned char * valid) const {
+	const float maxZ = maxDistance > 0 ? maxDistance : FLT_MAX;
+	const float ry = rayY[y];
+	size_t numValid = 0;
+	int x = 0;
+#ifdef OFX_KINECT_SSE2
+	if(step == 1) {
+		const __m128i zeroi = _mm_setzero_si128();
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 vmin = _mm_set1_ps(minDistance);
+		const __m128 vmax = _mm_set1_ps(maxZ);
+		const __m128 vry = _mm_set1_ps(ry);
+		for(; x + 4 <= width; x += 4) {
+			__m128 z = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(raw + x)), zeroi));
+			__m128 mask = _mm_and_ps(_mm_cmpgt_ps(z, zero), _mm_and_ps(_mm_cmpge_ps(z, vmin), _mm_cmple_ps(z, vmax)));
+			z = _mm_and_ps(z, mask);
+			__m128 wx = _mm_mul_ps(_mm_loadu_ps(&rayX[x]), z);
+			__m128 wy = _mm_mul_ps(vry, z);
+
+			// x0 y0 x1 y1 | x2 y2 x3 y3 -> x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+			__m128 a = _mm_unpacklo_ps(wx, wy);
+			__m128 b = _mm_unpackhi_ps(wx, wy);
+			__m128 t0 = _mm_shuffle_ps(z, a, _MM_SHUFFLE(2,2,0,0));
+			__m128 t1 = _mm_shuffle_ps(a, z, _MM_SHUFFLE(1,1,3,3));
+			__m128 t2 = _mm_shuffle_ps(z, b, _MM_SHUFFLE(2,2,2,2));
+			__m128 t3 = _mm_shuffle_ps(b, z, _MM_SHUFFLE(3,3,3,3));
+			float * out = xyz + x * 3;
+			_mm_storeu_ps(out, _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2,0,1,0)));
+			_mm_storeu_ps(out + 4, _mm_shuffle_ps(t1, b, _MM_SHUFFLE(1,0,2,0)));
+			_mm_storeu_ps(out + 8, _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(2,0,2,0)));
+
+			int bits = _mm_movemask_ps(mask);
+			numValid += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + ((bits >> 3) & 1);
+			if(valid != NULL) {
+				valid[x] = bits & 1;
+				valid[x + 1] = (bits >> 1) & 1;
+				valid[x + 2] = (bits >> 2) & 1;
+				valid[x + 3] = (bits >> 3) & 1;
+			}
+		}
+	}
+#endif
+	for(; x < width; x += step) {
+		float z = raw[x];
+		bool bValid = z > 0 && z >= minDistance && z <= maxZ;
+		if(!bValid) {
+			z = 0;
+		}
+		size_t i = x / step;
+		xyz[i * 3] = rayX[x] * z;
+		xyz[i * 3 + 1] = ry * z;
+		xyz[i * 3 + 2] = z;
+		if(valid != NULL) {
+			valid[i] = bValid;
+		}
+		numValid += bValid;
+	}
+	return numValid;
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectDepthProcessor::getWorldCoordinates(const unsigned short * raw, float * xyz, int step, unsigned char * valid) const {
+	step = MAX(step, 1);
+	size_t rowPoints = (width + step - 1) / step;
+	size_t numValid = 0;
+	size_t row = 0;
+	for(int y = 0; y < height; y += step, row++) {
+		numValid += processRow(raw + y * width, y, step, xyz + row * rowPoints * 3, valid == NULL ? NULL : valid + row * rowPoints);
+	}
+	return numValid;
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectDepthProcessor::getWorldCoordinates(const ofShortPixels & raw, vector<ofVec3f> & points, int step, vector<unsigned char> * valid) const {
+	if((int)raw.getWidth() != width || (int)raw.getHeight() != height) {
+		ofLogError("ofxKinectDepthProcessor") << "getWorldCoordinates(): depth pixels are " << raw.getWidth() << "x" << raw.getHeight()
+			<< ", expected " << width << "x" << height << ", call setup() first";
+		points.clear();
+		if(valid != NULL) {
+			valid->clear();
+		}
+		return 0;
+	}
+	points.resize(getNumPoints(step));
+	if(valid != NULL) {
+		valid->resize(points.size());
+	}
+	return getWorldCoordinates(raw.getData(), points[0].getPtr(), step, valid == NULL ? NULL : &(*valid)[0]);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectDepthProcessor::getPointCloud(const ofShortPixels & raw, ofMesh & mesh, int step, bool bTexCoords) const {
+	step = MAX(step, 1);
+	mesh.setMode(OF_PRIMITIVE_POINTS);
+	mesh.clearIndices();
+	mesh.clearColors();
+	mesh.clearNormals();
+	vector<ofVec3f> & vertices = mesh.getVertices();
+	vector<unsigned char> valid;
+	getWorldCoordinates(raw, vertices, step, &valid);
+
+	// keep the valid points only
+	vector<ofVec2f> & texCoords = mesh.getTexCoords();
+	texCoords.clear();
+	size_t rowPoints = (width + step - 1) / step;
+	size_t n = 0;
+	for(size_t i = 0; i < vertices.size(); i++) {
+		if(valid[i]) {
+			vertices[n++] = vertices[i];
+			if(bTexCoords) {
+				texCoords.push_back(ofVec2f((i % rowPoints) * step, (i / rowPoints) * step));
+			}
+		}
+	}
+	vertices.resize(n);
+}
@@ -0,0 +1,107 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+/// \class ofxKinectDepthProcessor
+///
+/// converts raw depth frames (millimeters, 0 = no data) into distance,
+/// grayscale and world coordinates for the whole frame at once
+///
+/// the perspective calculation is the same as freenect_camera_to_world but
+/// uses precomputed per column and per row ray tables, rows are converted
+/// with SSE2 when available
+///
+/// it doesn't need a device so it can process recorded frames
+///
+class ofxKinectDepthProcessor {
+
+public:
+
+	ofxKinectDepthProcessor();
+
+	/// build the ray tables for a depth image
+	///
+	/// the reference pixel size and distance (both in mm) are the zero plane
+	/// info of the device, the defaults are the usual values for a kinect 1414
+	void setup(int width=640, int height=480, float refPixelSize=0.1042, float refDistance=120);
+
+	int getWidth() const;
+	int getHeight() const;
+	float getReferencePixelSize() const;
+	float getReferenceDistance() const;
+
+/// \section Valid Range
+
+	/// set the range of distances in mm considered valid for world coordinates,
+	/// a max of 0 means no upper limit, 0 values are never valid
+	void setDepthRange(float minDistance=0, float maxDistance=0);
+	float getMinDistance() const;
+	float getMaxDistance() const;
+
+/// \section Pixels
+
+	/// copy the raw depth values into a float array
+	static void toDistance(const unsigned short * raw, float * distance, size_t n);
+	static void toDistance(const ofShortPixels & raw, ofFloatPixels & distance);
+
+	/// convert raw depth values to grayscale between nearClip and farClip,
+	/// 0 values stay black
+	///
+	/// the result is the same as ofMap(raw, nearClip, farClip, near, far, true)
+	/// with near = 255 and far = 0 if bNearWhite or the other way around
+	static void toGray(const unsigned short * raw, unsigned char * gray, size_t n, float nearClip, float farClip, bool bNearWhite=true);
+	static void toGray(const ofShortPixels & raw, ofPixels & gray, float nearClip, float farClip, bool bNearWhite=true);
+
+/// \section World Coordinates
+
+	/// world coordinate of a single pixel with distance z, center of image is (0,0)
+	ofVec3f getWorldCoordinateAt(int x, int y, float z) const;
+
+	/// world coordinates of every step-th pixel in x and y
+	///
+	/// writes getNumPoints(step) xyz triplets row by row, invalid pixels are
+	/// set to (0,0,0). if valid isn't NULL it gets 1 for every valid point
+	/// and 0 for the rest. returns the number of valid points
+	size_t getWorldCoordinates(const unsigned short * raw, float * xyz, int step=1, unsigned char * valid=NULL) const;
+	size_t getWorldCoordinates(const ofShortPixels & raw, vector<ofVec3f> & points, int step=1, vector<unsigned char> * valid=NULL) const;
+
+	/// number of points returned by getWorldCoordinates for a step
+	size_t getNumPoints(int step=1) const;
+
+	/// fill a mesh with the valid world coordinates of every step-th pixel,
+	/// texture coordinates are the pixel positions in the depth image
+	void getPointCloud(const ofShortPixels & raw, ofMesh & mesh, int step=1, bool bTexCoords=false) const;
+
+protected:
+
+	size_t processRow(const unsigned short * raw, int y, int step, float * xyz, unsigned char * valid) const;
+
+	int width, height;
+	float refPixelSize, refDistance;
+	float minDistance, maxDistance;
+	vector<float> rayX; ///< world x at 1mm for every column
+	vector<float> rayY; ///< world y at 1mm for every row
+};
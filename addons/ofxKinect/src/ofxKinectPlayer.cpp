@@ -0,0 +1,656 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectPlayer.h"
+
+#include "Poco/File.h"
+#include "Poco/SharedMemory.h"
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::ofxKinectPlayer() {
+	data = NULL;
+	dataSize = 0;
+	memset(&header, 0, sizeof(header));
+	bLoaded = false;
+	bPlaying = false;
+	bPaused = false;
+	bLoop = true;
+	bRealtime = true;
+	bUseTexture = true;
+	bNearWhite = true;
+	bIsFrameNew = false;
+	bFramePending = false;
+	nearClipping = 500;
+	farClipping = 4000;
+	speed = 1;
+	currentFrame = 0;
+	loadedFrame = -1;
+	startTime = 0;
+	startTimestamp = 0;
+}
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::~ofxKinectPlayer() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::load(string filename) {
+	close();
+
+	string path = ofToDataPath(filename);
+	try {
+		Poco::File file(path);
+		if(!file.exists() || file.getSize() < sizeof(ofxKinectRecorder::FileHeader)) {
+			ofLogError("ofxKinectPlayer") << "load(): \"" << filename << "\" doesn't exist or isn't a recording";
+			return false;
+		}
+		memory = make_shared<Poco::SharedMemory>(file, Poco::SharedMemory::AM_READ);
+	} catch(const Poco::Exception & e) {
+		ofLogError("ofxKinectPlayer") << "load(): couldn't map \"" << filename << "\": " << e.displayText();
+		return false;
+	}
+	data = (const unsigned char*)memory->begin();
+	dataSize = memory->end() - memory->begin();
+
+	memcpy(&header, data, sizeof(header));
+	if(memcmp(header.magic, ofxKinectRecorder::fileMagic, sizeof(header.magic)) != 0 || header.version != ofxKinectRecorder::version) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << filename << "\" isn't a recording or was made with a different version";
+		close();
+		return false;
+	}
+
+	if(!readIndex()) {
+		ofLogWarning("ofxKinectPlayer") << "load(): \"" << filename << "\" has no index, the recording wasn't closed. scanning frames";
+		if(!scanFrames()) {
+			close();
+			return false;
+		}
+	}
+	if(index.empty()) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << filename << "\" has no frames";
+		close();
+		return false;
+	}
+
+	depthProcessor.setup(header.depthWidth, header.depthHeight, header.refPixelSize, header.refDistance);
+	depthPixelsRaw.allocate(header.depthWidth, header.depthHeight, 1);
+	depthPixels.allocate(header.depthWidth, header.depthHeight, 1);
+	distancePixels.allocate(header.depthWidth, header.depthHeight, 1);
+	if(header.videoChannels > 0) {
+		videoPixels.allocate(header.videoWidth, header.videoHeight, header.videoChannels);
+	}
+	if(bUseTexture) {
+		depthTex.allocate(depthPixels);
+		if(videoPixels.isAllocated()) {
+			videoTex.allocate(videoPixels);
+		}
+	}
+
+	bLoaded = true;
+	currentFrame = 0;
+	loadedFrame = -1;
+	if(!loadFrame(0)) {
+		close();
+		return false;
+	}
+	bFramePending = true;
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::close() {
+	memory.reset();
+	data = NULL;
+	dataSize = 0;
+	index.clear();
+	depthPixelsRaw.clear();
+	depthPixels.clear();
+	distancePixels.clear();
+	videoPixels.clear();
+	depthTex.clear();
+	videoTex.clear();
+	bLoaded = false;
+	bPlaying = false;
+	bPaused = false;
+	bIsFrameNew = false;
+	bFramePending = false;
+	currentFrame = 0;
+	loadedFrame = -1;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isInitialized() const {
+	return bLoaded;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isFrameNew() const {
+	return bIsFrameNew;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::setPixelFormat(ofPixelFormat pixelFormat) {
+	return pixelFormat == getPixelFormat();
+}
+
+//--------------------------------------------------------------------
+ofPixelFormat ofxKinectPlayer::getPixelFormat() const {
+	switch(header.videoChannels) {
+		case 1: return OF_PIXELS_GRAY;
+		case 3: return OF_PIXELS_RGB;
+		case 4: return OF_PIXELS_RGBA;
+		default: return OF_PIXELS_UNKNOWN;
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::update() {
+	bIsFrameNew = false;
+	if(!bLoaded) {
+		return;
+	}
+
+	int numFrames = index.size();
+	if(bPlaying && !bPaused && !bFramePending) {
+		if(bRealtime) {
+			uint64_t now = ofGetElapsedTimeMicros();
+			uint64_t first = index.front().timestamp;
+			uint64_t last = index.back().timestamp;
+			uint64_t timestamp = startTimestamp + uint64_t((now - startTime) * (double)speed);
+			if(timestamp > last) {
+				if(bLoop) {
+					// one more frame period so the last frame is shown as long as the others
+					uint64_t period = numFrames > 1 ? (last - first) / (numFrames - 1) : 0;
+					uint64_t length = last - first + period;
+					timestamp = length > 0 ? first + (timestamp - first) % length : first;
+					startTime = now;
+					startTimestamp = timestamp;
+				} else {
+					timestamp = last;
+					bPlaying = false;
+				}
+			}
+			currentFrame = getFrameAt(timestamp);
+		} else if(currentFrame + 1 < numFrames) {
+			currentFrame++;
+		} else if(bLoop) {
+			currentFrame = 0;
+		} else {
+			bPlaying = false;
+		}
+	}
+
+	if(currentFrame != loadedFrame) {
+		if(!loadFrame(currentFrame)) {
+			return;
+		}
+		bFramePending = true;
+	}
+	if(bFramePending) {
+		bIsFrameNew = true;
+		bFramePending = false;
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::play() {
+	if(!bLoaded) {
+		return;
+	}
+	if(!bPlaying && !bLoop && currentFrame == getNumFrames() - 1) {
+		setFrame(0);
+	}
+	bPlaying = true;
+	bPaused = false;
+	startTime = ofGetElapsedTimeMicros();
+	startTimestamp = getFrameTimestamp(currentFrame);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::stop() {
+	bPlaying = false;
+	bPaused = false;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setPaused(bool bPaused) {
+	if(this->bPaused && !bPaused) {
+		// continue from the frame shown when paused
+		startTime = ofGetElapsedTimeMicros();
+		startTimestamp = getFrameTimestamp(currentFrame);
+	}
+	this->bPaused = bPaused;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isPlaying() const {
+	return bPlaying;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isPaused() const {
+	return bPaused;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setLoop(bool bLoop) {
+	this->bLoop = bLoop;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isLooping() const {
+	return bLoop;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setSpeed(float speed) {
+	// keep the current position when changing speed
+	startTime = ofGetElapsedTimeMicros();
+	startTimestamp = getFrameTimestamp(currentFrame);
+	this->speed = MAX(speed, 0);
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getSpeed() const {
+	return speed;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setRealtime(bool bRealtime) {
+	if(!this->bRealtime && bRealtime) {
+		startTime = ofGetElapsedTimeMicros();
+		startTimestamp = getFrameTimestamp(currentFrame);
+	}
+	this->bRealtime = bRealtime;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isRealtime() const {
+	return bRealtime;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectPlayer::getNumFrames() const {
+	return index.size();
+}
+
+//--------------------------------------------------------------------
+int ofxKinectPlayer::getCurrentFrame() const {
+	return currentFrame;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setFrame(int frame) {
+	if(!bLoaded) {
+		return;
+	}
+	currentFrame = ofClamp(frame, 0, getNumFrames() - 1);
+	startTime = ofGetElapsedTimeMicros();
+	startTimestamp = getFrameTimestamp(currentFrame);
+	bFramePending = true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::firstFrame() {
+	setFrame(0);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::nextFrame() {
+	setFrame(currentFrame + 1 < getNumFrames() ? currentFrame + 1 : (bLoop ? 0 : currentFrame));
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::previousFrame() {
+	setFrame(currentFrame > 0 ? currentFrame - 1 : (bLoop ? getNumFrames() - 1 : 0));
+}
+
+//--------------------------------------------------------------------
+uint64_t ofxKinectPlayer::getFrameTimestamp(int frame) const {
+	if(frame < 0 || frame >= (int)index.size()) {
+		return 0;
+	}
+	return index[frame].timestamp;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getDuration() const {
+	if(index.empty()) {
+		return 0;
+	}
+	return (index.back().timestamp - index.front().timestamp) / 1000000.0;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getPosition() const {
+	if(index.size() < 2 || index.back().timestamp == index.front().timestamp) {
+		return 0;
+	}
+	return double(getFrameTimestamp(currentFrame) - index.front().timestamp) / (index.back().timestamp - index.front().timestamp);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setPosition(float pct) {
+	if(index.empty()) {
+		return;
+	}
+	uint64_t first = index.front().timestamp;
+	uint64_t last = index.back().timestamp;
+	setFrame(getFrameAt(first + uint64_t(ofClamp(pct, 0, 1) * (last - first))));
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getDistanceAt(int x, int y) const {
+	return depthPixelsRaw[y * depthPixelsRaw.getWidth() + x];
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getDistanceAt(const ofPoint & p) const {
+	return getDistanceAt(p.x, p.y);
+}
+
+//--------------------------------------------------------------------
+ofVec3f ofxKinectPlayer::getWorldCoordinateAt(int x, int y) const {
+	return depthProcessor.getWorldCoordinateAt(x, y, getDistanceAt(x, y));
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectPlayer::getWorldCoordinates(vector<ofVec3f> & points, int step, vector<unsigned char> * valid) const {
+	return depthProcessor.getWorldCoordinates(depthPixelsRaw, points, step, valid);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::getPointCloud(ofMesh & mesh, int step, bool bTexCoords) const {
+	depthProcessor.getPointCloud(depthPixelsRaw, mesh, step, bTexCoords);
+}
+
+//--------------------------------------------------------------------
+ofxKinectDepthProcessor & ofxKinectPlayer::getDepthProcessor() {
+	return depthProcessor;
+}
+
+//--------------------------------------------------------------------
+const ofxKinectDepthProcessor & ofxKinectPlayer::getDepthProcessor() const {
+	return depthProcessor;
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getPixels() {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getPixels() const {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getDepthPixels() {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getDepthPixels() const {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+ofShortPixels & ofxKinectPlayer::getRawDepthPixels() {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+const ofShortPixels & ofxKinectPlayer::getRawDepthPixels() const {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+ofFloatPixels & ofxKinectPlayer::getDistancePixels() {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+const ofFloatPixels & ofxKinectPlayer::getDistancePixels() const {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getTexture() {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getTexture() const {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getDepthTexture() {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getDepthTexture() const {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::enableDepthNearValueWhite(bool bEnabled) {
+	bNearWhite = bEnabled;
+	updateDepthPixels();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isDepthNearValueWhite() const {
+	return bNearWhite;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setDepthClipping(float nearClip, float farClip) {
+	nearClipping = nearClip;
+	farClipping = farClip;
+	updateDepthPixels();
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getNearClipping() const {
+	return nearClipping;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getFarClipping() const {
+	return farClipping;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setUseTexture(bool bUse) {
+	bUseTexture = bUse;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isUsingTexture() const {
+	return bUseTexture;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::draw(float x, float y, float w, float h) const {
+	if(bUseTexture && videoTex.isAllocated()) {
+		videoTex.draw(x, y, w, h);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::draw(float x, float y) const {
+	draw(x, y, header.videoWidth, header.videoHeight);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::drawDepth(float x, float y, float w, float h) const {
+	if(bUseTexture && depthTex.isAllocated()) {
+		depthTex.draw(x, y, w, h);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::drawDepth(float x, float y) const {
+	drawDepth(x, y, header.depthWidth, header.depthHeight);
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getWidth() const {
+	return header.depthWidth;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getHeight() const {
+	return header.depthHeight;
+}
+
+/* ***** PROTECTED ***** */
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::readIndex() {
+	ofxKinectRecorder::Trailer trailer;
+	if(dataSize < sizeof(ofxKinectRecorder::FileHeader) + sizeof(trailer)) {
+		return false;
+	}
+	memcpy(&trailer, data + dataSize - sizeof(trailer), sizeof(trailer));
+	if(memcmp(trailer.magic, ofxKinectRecorder::trailerMagic, sizeof(trailer.magic)) != 0) {
+		return false;
+	}
+
+	ofxKinectRecorder::Chunk chunk;
+	ofxKinectRecorder::IndexHeader indexHeader;
+	uint64_t offset = trailer.indexOffset;
+	if(offset + sizeof(chunk) + sizeof(indexHeader) > dataSize) {
+		return false;
+	}
+	memcpy(&chunk, data + offset, sizeof(chunk));
+	memcpy(&indexHeader, data + offset + sizeof(chunk), sizeof(indexHeader));
+	offset += sizeof(chunk) + sizeof(indexHeader);
+	size_t indexSize = (size_t)indexHeader.numFrames * sizeof(ofxKinectRecorder::IndexEntry);
+	if(chunk.tag != ofxKinectRecorder::indexTag || offset + indexSize > dataSize) {
+		return false;
+	}
+	index.resize(indexHeader.numFrames);
+	if(indexSize > 0) {
+		memcpy(&index[0], data + offset, indexSize);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::scanFrames() {
+	index.clear();
+	uint64_t offset = sizeof(ofxKinectRecorder::FileHeader);
+	ofxKinectRecorder::Chunk chunk;
+	ofxKinectRecorder::FrameHeader frameHeader;
+	while(offset + sizeof(chunk) <= dataSize) {
+		memcpy(&chunk, data + offset, sizeof(chunk));
+		if(offset + sizeof(chunk) + chunk.size > dataSize) {
+			// the last frame was cut
+			break;
+		}
+		if(chunk.tag == ofxKinectRecorder::frameTag && chunk.size >= sizeof(frameHeader)) {
+			memcpy(&frameHeader, data + offset + sizeof(chunk), sizeof(frameHeader));
+			ofxKinectRecorder::IndexEntry entry;
+			entry.offset = offset;
+			entry.timestamp = frameHeader.timestamp;
+			index.push_back(entry);
+		} else if(chunk.tag != ofxKinectRecorder::indexTag) {
+			ofLogError("ofxKinectPlayer") << "scanFrames(): unknown chunk at " << offset;
+			return false;
+		}
+		offset += sizeof(chunk) + chunk.size;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::loadFrame(int frame) {
+	ofxKinectRecorder::Chunk chunk;
+	ofxKinectRecorder::FrameHeader frameHeader;
+	uint64_t offset = index[frame].offset;
+	if(offset + sizeof(chunk) + sizeof(frameHeader) > dataSize) {
+		ofLogError("ofxKinectPlayer") << "loadFrame(): frame " << frame << " is out of the file";
+		return false;
+	}
+	memcpy(&chunk, data + offset, sizeof(chunk));
+	memcpy(&frameHeader, data + offset + sizeof(chunk), sizeof(frameHeader));
+	offset += sizeof(chunk) + sizeof(frameHeader);
+	if(chunk.tag != ofxKinectRecorder::frameTag ||
+	   chunk.size != sizeof(frameHeader) + (uint64_t)frameHeader.depthSize + frameHeader.videoSize ||
+	   offset + frameHeader.depthSize + frameHeader.videoSize > dataSize ||
+	   (frameHeader.videoSize != 0 && frameHeader.videoSize != uint32_t(videoPixels.size()))) {
+		ofLogError("ofxKinectPlayer") << "loadFrame(): frame " << frame << " is corrupt";
+		return false;
+	}
+
+	if(!ofxKinectRecorder::decompressDepth(data + offset, frameHeader.depthSize, depthPixelsRaw.getData(), header.depthWidth, header.depthHeight)) {
+		ofLogError("ofxKinectPlayer") << "loadFrame(): couldn't decompress the depth of frame " << frame;
+		return false;
+	}
+	offset += frameHeader.depthSize;
+	if(frameHeader.videoSize > 0) {
+		memcpy(videoPixels.getData(), data + offset, frameHeader.videoSize);
+	}
+
+	ofxKinectDepthProcessor::toDistance(depthPixelsRaw, distancePixels);
+	loadedFrame = frame;
+	updateDepthPixels();
+
+	if(bUseTexture && videoPixels.isAllocated()) {
+		videoTex.loadData(videoPixels);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::updateDepthPixels() {
+	// converts the loaded frame again with the current clipping and near
+	// value, without reporting it as a new frame
+	if(loadedFrame < 0) {
+		return;
+	}
+	ofxKinectDepthProcessor::toGray(depthPixelsRaw, depthPixels, nearClipping, farClipping, bNearWhite);
+	if(bUseTexture) {
+		depthTex.loadData(depthPixels);
+	}
+}
+
+//--------------------------------------------------------------------
+int ofxKinectPlayer::getFrameAt(uint64_t timestamp) const {
+	// last frame recorded at or before timestamp
+	int lo = 0;
+	int hi = index.size();
+	while(lo < hi) {
+		int mid = (lo + hi) / 2;
+		if(index[mid].timestamp <= timestamp) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return MAX(lo - 1, 0);
+}
@@ -0,0 +1,217 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+#include "ofxBase3DVideo.h"
+#include "ofxKinectDepthProcessor.h"
+#include "ofxKinectRecorder.h"
+
+namespace Poco {
+	class SharedMemory;
+}
+
+/// \class ofxKinectPlayer
+///
+/// plays back recordings made with ofxKinectRecorder with the same pixel
+/// interface as ofxKinect
+///
+/// the file is memory mapped and frames are decoded when they are shown.
+/// by default frames are paced by their timestamps, disable real time to
+/// show one frame per update, ie for tests that need to see every frame
+///
+class ofxKinectPlayer : public ofxBase3DVideo {
+
+public:
+
+	ofxKinectPlayer();
+	virtual ~ofxKinectPlayer();
+
+/// \section Main
+
+	/// open a recording and load its first frame
+	bool load(string filename);
+
+	/// close the recording
+	void close();
+
+	bool isInitialized() const;
+
+	/// is the current frame new?
+	bool isFrameNew() const;
+
+	/// the video pixel format of the recording, it can't be changed
+	bool setPixelFormat(ofPixelFormat pixelFormat);
+	ofPixelFormat getPixelFormat() const;
+
+	/// advances the playback and updates the pixel buffers and textures
+	void update();
+
+/// \section Playback
+
+	void play();
+	void stop();
+	void setPaused(bool bPaused);
+	bool isPlaying() const;
+	bool isPaused() const;
+
+	/// start over when the end is reached, enabled by default
+	void setLoop(bool bLoop);
+	bool isLooping() const;
+
+	/// playback speed relative to the recording, only used in real time
+	void setSpeed(float speed);
+	float getSpeed() const;
+
+	/// real time: show the frame recorded at the current playback time,
+	/// skipping frames if update isn't called often enough
+	///
+	/// not real time: show the next frame on every update
+	void setRealtime(bool bRealtime);
+	bool isRealtime() const;
+
+/// \section Seeking
+
+	int getNumFrames() const;
+	int getCurrentFrame() const;
+
+	/// seek to a frame, the pixels are updated in the next update()
+	/// which reports it as a new frame
+	void setFrame(int frame);
+	void firstFrame();
+	void nextFrame();
+	void previousFrame();
+
+	/// timestamp of a frame in microseconds since the first one
+	uint64_t getFrameTimestamp(int frame) const;
+
+	/// duration in seconds
+	float getDuration() const;
+
+	/// position as a percentage of the duration
+	float getPosition() const;
+	void setPosition(float pct);
+
+/// \section Depth Data
+
+	/// get the calulated distance for a depth point
+	float getDistanceAt(int x, int y) const;
+	float getDistanceAt(const ofPoint & p) const;
+
+	/// calculates the coordinate in the world for the depth point
+	ofVec3f getWorldCoordinateAt(int x, int y) const;
+
+	/// see ofxKinect::getWorldCoordinates and ofxKinect::getPointCloud
+	size_t getWorldCoordinates(vector<ofVec3f> & points, int step=1, vector<unsigned char> * valid=NULL) const;
+	void getPointCloud(ofMesh & mesh, int step=1, bool bTexCoords=false) const;
+
+	/// set up with the calibration saved in the recording
+	ofxKinectDepthProcessor & getDepthProcessor();
+	const ofxKinectDepthProcessor & getDepthProcessor() const;
+
+/// \section Pixel Data
+
+	/// get the video pixels, empty if the recording has no video
+	ofPixels & getPixels();
+	const ofPixels & getPixels() const;
+
+	/// get the pixels of the current depth frame
+	ofPixels & getDepthPixels();       	///< grayscale values
+	const ofPixels & getDepthPixels() const;
+	ofShortPixels & getRawDepthPixels();	///< raw values
+	const ofShortPixels & getRawDepthPixels() const;
+
+	/// get the distance in millimeters to a given point as a float array
+	ofFloatPixels & getDistancePixels();
+	const ofFloatPixels & getDistancePixels() const;
+
+	ofTexture & getTexture();
+	const ofTexture & getTexture() const;
+	ofTexture & getDepthTexture();
+	const ofTexture & getDepthTexture() const;
+
+/// \section Grayscale Depth Value
+
+	/// see ofxKinect::enableDepthNearValueWhite and ofxKinect::setDepthClipping
+	void enableDepthNearValueWhite(bool bEnabled=true);
+	bool isDepthNearValueWhite() const;
+	void setDepthClipping(float nearClip=500, float farClip=4000);
+	float getNearClipping() const;
+	float getFarClipping() const;
+
+/// \section Draw
+
+	void setUseTexture(bool bUse);
+	bool isUsingTexture() const;
+
+	/// draw the video texture
+	void draw(float x, float y, float w, float h) const;
+	void draw(float x, float y) const;
+
+	/// draw the grayscale depth texture
+	void drawDepth(float x, float y, float w, float h) const;
+	void drawDepth(float x, float y) const;
+
+	float getWidth() const;
+	float getHeight() const;
+
+protected:
+
+	bool readIndex();
+	bool scanFrames();
+	bool loadFrame(int frame);
+	void updateDepthPixels();
+	int getFrameAt(uint64_t timestamp) const;
+
+	shared_ptr<Poco::SharedMemory> memory;
+	const unsigned char * data;
+	size_t dataSize;
+
+	ofxKinectRecorder::FileHeader header;
+	vector<ofxKinectRecorder::IndexEntry> index;
+
+	ofxKinectDepthProcessor depthProcessor;
+	ofShortPixels depthPixelsRaw;
+	ofPixels depthPixels;
+	ofFloatPixels distancePixels;
+	ofPixels videoPixels;
+	ofTexture depthTex;
+	ofTexture videoTex;
+
+	bool bLoaded;
+	bool bPlaying, bPaused, bLoop, bRealtime;
+	bool bUseTexture;
+	bool bNearWhite;
+	bool bIsFrameNew;
+	bool bFramePending; ///< the current frame hasn't been reported as new yet
+	float nearClipping, farClipping;
+	float speed;
+	int currentFrame;
+	int loadedFrame;
+
+	// real time playback: the recording time of startFrame is shown at startTime
+	uint64_t startTime;
+	uint64_t startTimestamp;
+};
@@ -0,0 +1,301 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectRecorder.h"
+#include "ofxKinect.h"
+
+const char ofxKinectRecorder::fileMagic[8] = {'O','F','X','K','R','E','C','\0'};
+const char ofxKinectRecorder::trailerMagic[8] = {'O','F','X','K','I','D','X','\0'};
+
+//--------------------------------------------------------------------
+static inline void writeVarint(unsigned char *& out, uint32_t value) {
+	while(value >= 0x80) {
+		*out++ = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	*out++ = value;
+}
+
+//--------------------------------------------------------------------
+static inline bool readVarint(const unsigned char *& in, const unsigned char * end, uint32_t & value) {
+	value = 0;
+	for(int shift = 0; shift < 35; shift += 7) {
+		if(in == end) {
+			return false;
+		}
+		unsigned char byte = *in++;
+		value |= uint32_t(byte & 0x7f) << shift;
+		if(!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::ofxKinectRecorder() {
+	bOpen = false;
+	bHeaderWritten = false;
+	numFrames = 0;
+	startTime = 0;
+	memset(&header, 0, sizeof(header));
+	ofxKinectDepthProcessor defaults;
+	setDepthCalibration(defaults.getReferencePixelSize(), defaults.getReferenceDistance());
+}
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::~ofxKinectRecorder() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::open(string filename) {
+	close();
+	if(!file.open(filename, ofFile::WriteOnly, true)) {
+		ofLogError("ofxKinectRecorder") << "open(): couldn't open \"" << filename << "\" for writing";
+		return false;
+	}
+	float refPixelSize = header.refPixelSize;
+	float refDistance = header.refDistance;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, fileMagic, sizeof(fileMagic));
+	header.version = version;
+	header.refPixelSize = refPixelSize;
+	header.refDistance = refDistance;
+	bHeaderWritten = false;
+	numFrames = 0;
+	index.clear();
+	bOpen = true;
+	startThread();
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::close() {
+	if(!bOpen) {
+		return;
+	}
+	// the thread writes the queued frames and the index when it gets this
+	Frame end;
+	end.bEnd = true;
+	channel.send(std::move(end));
+	waitForThread(false);
+	file.close();
+	bOpen = false;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::isOpen() const {
+	return bOpen;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::setDepthCalibration(float refPixelSize, float refDistance) {
+	header.refPixelSize = refPixelSize;
+	header.refDistance = refDistance;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::addFrame(const ofxKinect & kinect) {
+	if(numFrames == 0) {
+		setDepthCalibration(kinect.getDepthProcessor().getReferencePixelSize(), kinect.getDepthProcessor().getReferenceDistance());
+		startTime = ofGetElapsedTimeMicros();
+	}
+	return addFrame(kinect.getRawDepthPixels(), kinect.getPixels(), ofGetElapsedTimeMicros() - startTime);
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::addFrame(const ofShortPixels & rawDepth, const ofPixels & video, uint64_t timestamp) {
+	if(!bOpen) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): recording not open";
+		return false;
+	}
+	if(rawDepth.getNumChannels() != 1) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): depth pixels must have 1 channel";
+		return false;
+	}
+	if(numFrames == 0) {
+		header.depthWidth = rawDepth.getWidth();
+		header.depthHeight = rawDepth.getHeight();
+		header.videoWidth = video.getWidth();
+		header.videoHeight = video.getHeight();
+		header.videoChannels = video.getNumChannels();
+	} else if(uint32_t(rawDepth.getWidth()) != header.depthWidth || uint32_t(rawDepth.getHeight()) != header.depthHeight ||
+	          uint32_t(video.getWidth()) != header.videoWidth || uint32_t(video.getHeight()) != header.videoHeight ||
+	          uint32_t(video.getNumChannels()) != header.videoChannels) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): frame size or format doesn't match the first frame";
+		return false;
+	}
+
+	Frame frame;
+	frame.depth = rawDepth;
+	frame.video = video;
+	frame.timestamp = timestamp;
+	frame.bEnd = false;
+	channel.send(std::move(frame));
+	numFrames++;
+	return true;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectRecorder::getNumFrames() const {
+	return numFrames;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::threadedFunction() {
+	Frame frame;
+	while(channel.receive(frame)) {
+		if(frame.bEnd) {
+			break;
+		}
+		writeFrame(frame);
+	}
+
+	// an empty recording still gets a header so it can be recognized
+	if(!bHeaderWritten) {
+		file.write((const char*)&header, sizeof(header));
+		bHeaderWritten = true;
+	}
+
+	Trailer trailer;
+	trailer.indexOffset = file.tellp();
+	memcpy(trailer.magic, trailerMagic, sizeof(trailerMagic));
+
+	Chunk chunk;
+	chunk.tag = indexTag;
+	chunk.size = sizeof(IndexHeader) + index.size() * sizeof(IndexEntry);
+	IndexHeader indexHeader;
+	indexHeader.numFrames = index.size();
+	indexHeader.reserved = 0;
+	file.write((const char*)&chunk, sizeof(chunk));
+	file.write((const char*)&indexHeader, sizeof(indexHeader));
+	if(!index.empty()) {
+		file.write((const char*)&index[0], index.size() * sizeof(IndexEntry));
+	}
+	file.write((const char*)&trailer, sizeof(trailer));
+	file.flush();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::writeFrame(const Frame & frame) {
+	if(!bHeaderWritten) {
+		file.write((const char*)&header, sizeof(header));
+		bHeaderWritten = true;
+	}
+
+	compressDepth(frame.depth.getData(), frame.depth.getWidth(), frame.depth.getHeight(), compressed);
+
+	IndexEntry entry;
+	entry.offset = file.tellp();
+	entry.timestamp = frame.timestamp;
+	index.push_back(entry);
+
+	FrameHeader frameHeader;
+	frameHeader.timestamp = frame.timestamp;
+	frameHeader.depthSize = compressed.size();
+	frameHeader.videoSize = frame.video.size();
+
+	Chunk chunk;
+	chunk.tag = frameTag;
+	chunk.size = sizeof(FrameHeader) + frameHeader.depthSize + frameHeader.videoSize;
+
+	file.write((const char*)&chunk, sizeof(chunk));
+	file.write((const char*)&frameHeader, sizeof(frameHeader));
+	if(!compressed.empty()) {
+		file.write((const char*)&compressed[0], compressed.size());
+	}
+	if(frameHeader.videoSize > 0) {
+		file.write((const char*)frame.video.getData(), frameHeader.videoSize);
+	}
+	if(!file.good()) {
+		ofLogError("ofxKinectRecorder") << "writeFrame(): couldn't write frame " << index.size() - 1;
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectRecorder::compressDepth(const unsigned short * depth, int width, int height, vector<unsigned char> & data) {
+	size_t n = (size_t)width * height;
+	// worst case every value takes 3 bytes
+	data.resize(n * 3 + 10);
+	unsigned char * out = &data[0];
+	uint32_t run = 0;
+	for(int y = 0; y < height; y++) {
+		const unsigned short * row = depth + (size_t)y * width;
+		for(int x = 0; x < width; x++) {
+			int predicted = x > 0 ? row[x - 1] : (y > 0 ? row[x - width] : 0);
+			int delta = int(row[x]) - predicted;
+			if(delta == 0) {
+				run++;
+				continue;
+			}
+			if(run > 0) {
+				writeVarint(out, 0);
+				writeVarint(out, run);
+				run = 0;
+			}
+			// zigzag so small negative differences are small codes too
+			writeVarint(out, (uint32_t(delta) << 1) ^ uint32_t(delta >> 31));
+		}
+	}
+	if(run > 0) {
+		writeVarint(out, 0);
+		writeVarint(out, run);
+	}
+	data.resize(out - &data[0]);
+	return data.size();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::decompressDepth(const unsigned char * data, size_t size, unsigned short * depth, int width, int height) {
+	const unsigned char * in = data;
+	const unsigned char * end = data + size;
+	size_t n = (size_t)width * height;
+	size_t i = 0;
+	int x = 0;
+	while(i < n) {
+		uint32_t code;
+		if(!readVarint(in, end, code)) {
+			return false;
+		}
+		uint32_t count = 1;
+		int delta = 0;
+		if(code == 0) {
+			if(!readVarint(in, end, count) || count > n - i) {
+				return false;
+			}
+		} else {
+			delta = int(code >> 1) ^ -int(code & 1);
+		}
+		for(uint32_t j = 0; j < count; j++, i++) {
+			int predicted = x > 0 ? depth[i - 1] : (i >= (size_t)width ? depth[i - width] : 0);
+			depth[i] = predicted + delta;
+			if(++x == width) {
+				x = 0;
+			}
+		}
+	}
+	return in == end;
+}
@@ -0,0 +1,158 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+class ofxKinect;
+
+/// \class ofxKinectRecorder
+///
+/// records raw depth and video frames to a file that can be played back with
+/// ofxKinectPlayer, ie to run the same input through a pipeline without a device
+///
+/// frames are compressed and written on a separate thread. the file is made of
+/// chunks, one per frame, followed by an index with the offset and timestamp of
+/// every frame:
+///
+///     FileHeader
+///     Chunk FRAM + FrameHeader + compressed depth + raw video   (per frame)
+///     Chunk INDX + IndexHeader + IndexEntry                     (per frame)
+///     Trailer
+///
+/// the headers are written as they are in memory, in the byte order of the host,
+/// which is little endian on every platform ofxKinect runs on. depth is
+/// compressed losslessly: every value is stored as the difference with the value
+/// on its left (above for the first column) in a variable length code, runs of
+/// equal values are stored as a count.
+///
+class ofxKinectRecorder : protected ofThread {
+
+public:
+
+	ofxKinectRecorder();
+	virtual ~ofxKinectRecorder();
+
+/// \section Main
+
+	/// create a new recording, overwrites the file if it exists
+	bool open(string filename);
+
+	/// write the remaining frames and the index and close the file
+	void close();
+
+	bool isOpen() const;
+
+	/// set the zero plane info saved with the recording, used by the player
+	/// for world coordinates, see ofxKinectDepthProcessor::setup
+	///
+	/// must be called before the first frame is added
+	void setDepthCalibration(float refPixelSize, float refDistance);
+
+	/// add the current raw depth and video frames of a kinect,
+	/// the timestamp is the time since the first frame was added
+	bool addFrame(const ofxKinect & kinect);
+
+	/// add a frame with a timestamp in microseconds, the video can be empty
+	///
+	/// all the frames must have the same size and format as the first one
+	bool addFrame(const ofShortPixels & rawDepth, const ofPixels & video, uint64_t timestamp);
+
+	/// number of frames added since the recording was opened
+	int getNumFrames() const;
+
+/// \section Depth Compression
+
+	/// compress a raw depth frame into data, returns the compressed size
+	static size_t compressDepth(const unsigned short * depth, int width, int height, vector<unsigned char> & data);
+
+	/// decompress a depth frame, returns false if the data is corrupt
+	static bool decompressDepth(const unsigned char * data, size_t size, unsigned short * depth, int width, int height);
+
+/// \section File Format
+
+	static const char fileMagic[8];
+	static const char trailerMagic[8];
+	static const uint32_t version = 1;
+	static const uint32_t frameTag = 0x4d415246; ///< "FRAM"
+	static const uint32_t indexTag = 0x58444e49; ///< "INDX"
+
+	struct FileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t depthWidth, depthHeight;
+		uint32_t videoWidth, videoHeight, videoChannels;
+		float refPixelSize, refDistance;
+	};
+
+	struct Chunk {
+		uint32_t tag;
+		uint32_t size; ///< bytes following the chunk
+	};
+
+	struct FrameHeader {
+		uint64_t timestamp; ///< microseconds
+		uint32_t depthSize;
+		uint32_t videoSize;
+	};
+
+	struct IndexHeader {
+		uint32_t numFrames;
+		uint32_t reserved;
+	};
+
+	struct IndexEntry {
+		uint64_t offset; ///< offset of the frame chunk from the start of the file
+		uint64_t timestamp;
+	};
+
+	struct Trailer {
+		uint64_t indexOffset;
+		char magic[8];
+	};
+
+protected:
+
+	struct Frame {
+		ofShortPixels depth;
+		ofPixels video;
+		uint64_t timestamp;
+		bool bEnd;
+	};
+
+	void threadedFunction();
+	bool writeFrame(const Frame & frame);
+
+	ofThreadChannel<Frame> channel;
+	ofFile file;
+	bool bOpen;
+	bool bHeaderWritten;
+	int numFrames;
+	uint64_t startTime;
+	FileHeader header;
+
+	// only used from the writing thread
+	vector<IndexEntry> index;
+	vector<unsigned char> compressed;
+};
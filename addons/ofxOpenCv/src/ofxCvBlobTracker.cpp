@@ -0,0 +1,232 @@
+
+#include "ofxCvBlobTracker.h"
+
+// cost of a pair that can't be matched, bigger than any distance
+static const double forbidden = 1e12;
+
+
+//--------------------------------------------------------------------------------
+ofxCvBlobTracker::ofxCvBlobTracker() {
+    maxDistance = 50;
+    maxLostFrames = 5;
+    smoothing = 0.5;
+    nextId = 0;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::setMaxDistance( float _maxDistance ) {
+    maxDistance = _maxDistance;
+}
+
+//--------------------------------------------------------------------------------
+float ofxCvBlobTracker::getMaxDistance() const {
+    return maxDistance;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::setMaxLostFrames( int _maxLostFrames ) {
+    maxLostFrames = _maxLostFrames;
+}
+
+//--------------------------------------------------------------------------------
+int ofxCvBlobTracker::getMaxLostFrames() const {
+    return maxLostFrames;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::setVelocitySmoothing( float _smoothing ) {
+    smoothing = ofClamp( _smoothing, 0, 1 );
+}
+
+//--------------------------------------------------------------------------------
+float ofxCvBlobTracker::getVelocitySmoothing() const {
+    return smoothing;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::reset() {
+    blobs.clear();
+    lost.clear();
+    newIds.clear();
+    lostIds.clear();
+    nextId = 0;
+}
+
+//--------------------------------------------------------------------------------
+int ofxCvBlobTracker::track( const ofxCvContourFinder& finder ) {
+    return track( finder.blobs );
+}
+
+//--------------------------------------------------------------------------------
+int ofxCvBlobTracker::track( const vector<ofxCvBlob>& newBlobs ) {
+
+    newIds.clear();
+    lostIds.clear();
+
+    // every track alive, visible in the last frame or not
+    tracks.clear();
+    tracks.insert( tracks.end(), blobs.begin(), blobs.end() );
+    tracks.insert( tracks.end(), lost.begin(), lost.end() );
+    lost.clear();
+
+    int nTracks = tracks.size();
+    int nBlobs = newBlobs.size();
+
+    // the assignment needs rows <= cols, so the cost matrix is transposed
+    // when there's more tracks than blobs
+    bool bTransposed = nTracks > nBlobs;
+    int rows = bTransposed ? nBlobs : nTracks;
+    int cols = bTransposed ? nTracks : nBlobs;
+    cost.resize( rows * cols );
+    for( int t = 0; t < nTracks; t++ ) {
+        // where the track should be now if it kept moving at the same speed
+        ofPoint predicted = tracks[t].centroid + tracks[t].velocity * (tracks[t].lostFrames + 1);
+        for( int b = 0; b < nBlobs; b++ ) {
+            double distance = predicted.distance( newBlobs[b].centroid );
+            int i = bTransposed ? b * cols + t : t * cols + b;
+            cost[i] = distance > maxDistance ? forbidden : distance;
+        }
+    }
+
+    assign( rows, cols );
+
+    // blob -> track, -1 for new blobs
+    vector<int> matches( nBlobs, -1 );
+    vector<bool> matched( nTracks, false );
+    for( int r = 0; r < rows; r++ ) {
+        int c = assignment[r];
+        if( c < 0 || cost[r * cols + c] >= forbidden ) {
+            continue;
+        }
+        int t = bTransposed ? c : r;
+        int b = bTransposed ? r : c;
+        matches[b] = t;
+        matched[t] = true;
+    }
+
+    blobs.resize( nBlobs );
+    for( int b = 0; b < nBlobs; b++ ) {
+        ofxCvTrackedBlob& blob = blobs[b];
+        (ofxCvBlob&)blob = newBlobs[b];
+        int t = matches[b];
+        if( t >= 0 ) {
+            const ofxCvTrackedBlob& previous = tracks[t];
+            ofPoint displacement = (blob.centroid - previous.centroid) / (previous.lostFrames + 1);
+            blob.id = previous.id;
+            blob.velocity = previous.age == 0 ? displacement : previous.velocity * smoothing + displacement * (1 - smoothing);
+            blob.age = previous.age + 1;
+        } else {
+            blob.id = nextId++;
+            blob.velocity.set( 0, 0, 0 );
+            blob.age = 0;
+            newIds.push_back( blob.id );
+        }
+        blob.lostFrames = 0;
+    }
+
+    for( int t = 0; t < nTracks; t++ ) {
+        if( matched[t] ) {
+            continue;
+        }
+        tracks[t].lostFrames++;
+        if( tracks[t].lostFrames > maxLostFrames ) {
+            lostIds.push_back( tracks[t].id );
+        } else {
+            lost.push_back( tracks[t] );
+        }
+    }
+
+    return blobs.size();
+}
+
+//--------------------------------------------------------------------------------
+const vector<int>& ofxCvBlobTracker::getNewIds() const {
+    return newIds;
+}
+
+//--------------------------------------------------------------------------------
+const vector<int>& ofxCvBlobTracker::getLostIds() const {
+    return lostIds;
+}
+
+//--------------------------------------------------------------------------------
+const ofxCvTrackedBlob* ofxCvBlobTracker::getBlobById( int id ) const {
+    for( int i = 0; i < (int)blobs.size(); i++ ) {
+        if( blobs[i].id == id ) {
+            return &blobs[i];
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------
+// minimum cost assignment of every row of cost to a different column,
+// hungarian algorithm with potentials, O(rows^2 * cols). rows <= cols,
+// the result is the column for every row in assignment
+void ofxCvBlobTracker::assign( int rows, int cols ) {
+    const double inf = std::numeric_limits<double>::max();
+    u.assign( rows + 1, 0 );
+    v.assign( cols + 1, 0 );
+    p.assign( cols + 1, 0 );
+    way.assign( cols + 1, 0 );
+    for( int i = 1; i <= rows; i++ ) {
+        p[0] = i;
+        int j0 = 0;
+        minv.assign( cols + 1, inf );
+        used.assign( cols + 1, false );
+        do {
+            used[j0] = true;
+            int i0 = p[j0];
+            int j1 = 0;
+            double delta = inf;
+            for( int j = 1; j <= cols; j++ ) {
+                if( !used[j] ) {
+                    double cur = cost[(i0 - 1) * cols + j - 1] - u[i0] - v[j];
+                    if( cur < minv[j] ) {
+                        minv[j] = cur;
+                        way[j] = j0;
+                    }
+                    if( minv[j] < delta ) {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+            }
+            for( int j = 0; j <= cols; j++ ) {
+                if( used[j] ) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while( p[j0] != 0 );
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while( j0 != 0 );
+    }
+
+    assignment.assign( rows, -1 );
+    for( int j = 1; j <= cols; j++ ) {
+        if( p[j] != 0 ) {
+            assignment[p[j] - 1] = j - 1;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::draw( float x, float y ) const {
+    ofPushStyle();
+    for( int i = 0; i < (int)blobs.size(); i++ ) {
+        const ofxCvTrackedBlob& blob = blobs[i];
+        ofSetHexColor( 0xff0099 );
+        ofDrawLine( x + blob.centroid.x, y + blob.centroid.y,
+                    x + blob.centroid.x + blob.velocity.x * 10, y + blob.centroid.y + blob.velocity.y * 10 );
+        ofSetHexColor( 0xffffff );
+        ofDrawBitmapString( ofToString( blob.id ), x + blob.centroid.x, y + blob.centroid.y );
+    }
+    ofPopStyle();
+}
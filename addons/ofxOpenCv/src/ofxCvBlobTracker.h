@@ -0,0 +1,96 @@
+/*
+* ofxCvBlobTracker.h
+*
+* Matches the blobs found by ofxCvContourFinder from one frame to the
+* next and gives them persistent ids and a velocity.
+* Blobs are assigned to the tracks of the previous frame with the
+* minimum total distance (hungarian algorithm), pairs further apart
+* than the maximum distance are never matched.
+*
+*/
+
+#pragma once
+
+
+#include "ofxCvConstants.h"
+#include "ofxCvBlob.h"
+#include "ofxCvContourFinder.h"
+
+
+class ofxCvTrackedBlob : public ofxCvBlob {
+
+    public:
+
+        int                 id;
+        ofPoint             velocity;   // pixels per frame
+        int                 age;        // frames since the blob appeared
+        int                 lostFrames; // frames since the blob was last seen
+
+        //----------------------------------------
+        ofxCvTrackedBlob() {
+            id          = -1;
+            age         = 0;
+            lostFrames  = 0;
+        }
+};
+
+
+class ofxCvBlobTracker {
+
+  public:
+
+    vector<ofxCvTrackedBlob>  blobs;  // blobs found in the last frame
+
+    ofxCvBlobTracker();
+
+    // blobs further than this from the predicted position of a track
+    // can't be matched to it, default 50 pixels
+    void  setMaxDistance( float maxDistance );
+    float getMaxDistance() const;
+
+    // frames a track is kept after its blob disappears, default 5. a blob
+    // reappearing close enough in that time gets its old id back
+    void  setMaxLostFrames( int maxLostFrames );
+    int   getMaxLostFrames() const;
+
+    // 0 = velocity is the last displacement, closer to 1 = smoother
+    void  setVelocitySmoothing( float smoothing );
+    float getVelocitySmoothing() const;
+
+    // matches the blobs of a new frame against the existing tracks
+    virtual int  track( const vector<ofxCvBlob>& newBlobs );
+    virtual int  track( const ofxCvContourFinder& finder );
+
+    // ids of the tracks that started and ended in the last call to track,
+    // a track ends maxLostFrames after its blob was last seen
+    const vector<int>&  getNewIds() const;
+    const vector<int>&  getLostIds() const;
+
+    // NULL if no blob with that id was found in the last frame
+    const ofxCvTrackedBlob*  getBlobById( int id ) const;
+
+    virtual void  reset();
+
+    virtual void  draw( float x = 0, float y = 0 ) const;
+
+  protected:
+
+    void  assign( int rows, int cols );
+
+    float  maxDistance;
+    int    maxLostFrames;
+    float  smoothing;
+    int    nextId;
+
+    vector<ofxCvTrackedBlob>  lost;  // tracks not seen since maxLostFrames or less
+    vector<ofxCvTrackedBlob>  tracks;
+    vector<int>  newIds;
+    vector<int>  lostIds;
+
+    // assignment problem, reused between frames
+    vector<double>  cost;
+    vector<double>  u, v, minv;
+    vector<int>     p, way, assignment;
+    vector<bool>    used;
+
+};
@@ -4,13 +4,15 @@
 
 
 //--------------------------------------------------------------------------------
-static bool sort_carea_compare( const CvSeq* a, const CvSeq* b) {
-	
-	// use opencv to calc size, then sort based on size
-	float areaa = cvContourArea(a, CV_WHOLE_SEQ);
-	float areab = cvContourArea(b, CV_WHOLE_SEQ);
-	
-	return (areaa > areab);
+// true if the two rectangles overlap or are less than margin pixels apart
+static bool rects_near( const ofRectangle& a, const ofRectangle& b, float margin ) {
+	return a.x - margin < b.x + b.width && b.x - margin < a.x + a.width &&
+	       a.y - margin < b.y + b.height && b.y - margin < a.y + a.height;
+}
+
+//--------------------------------------------------------------------------------
+static bool sort_blob_area_compare( const ofxCvBlob& a, const ofxCvBlob& b ) {
+	return a.area > b.area;
 }
 
 
@@ -21,36 +23,32 @@ ofxCvContourFinder::ofxCvContourFinder() {
     _width = 0;
     _height = 0;
 	myMoments = (CvMoments*)malloc( sizeof(CvMoments) );
+	contour_storage = cvCreateMemStorage( 1000 );
+	bCacheValid = false;
 	reset();
 }
 
 //--------------------------------------------------------------------------------
 ofxCvContourFinder::~ofxCvContourFinder() {
 	free( myMoments );
+	cvReleaseMemStorage( &contour_storage );
 }
 
 //--------------------------------------------------------------------------------
 void ofxCvContourFinder::reset() {
-    cvSeqBlobs.clear();
+    contours.clear();
     blobs.clear();
     nBlobs = 0;
 }
 
 //--------------------------------------------------------------------------------
-int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
-									  int minArea,
-									  int maxArea,
-									  int nConsidered,
-									  bool bFindHoles,
-                                      bool bUseApproximation) {
+void ofxCvContourFinder::allocateInputCopy( ofxCvGrayscaleImage& input ) {
 
     // get width/height disregarding ROI
     IplImage* ipltemp = input.getCvImage();
     _width = ipltemp->width;
     _height = ipltemp->height;
 
-	reset();
-
 	// opencv will clober the image it detects contours on, so we want to
     // copy it into a copy before we detect contours.  That copy is allocated
     // if necessary (necessary = (a) not allocated or (b) wrong size)
@@ -69,91 +67,244 @@ int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
         inputCopy.clear();
         inputCopy.allocate( _width, _height );
 	}
+}
 
-    inputCopy.setROI( input.getROI() );
-    inputCopy = input;
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::findContourList( CvPoint offset,
+                                          int minArea,
+                                          int maxArea,
+                                          bool bFindHoles,
+                                          bool bUseApproximation,
+                                          vector<ofRectangle>* rects ) {
 
-	CvSeq* contour_list = NULL;
-	contour_storage = cvCreateMemStorage( 1000 );
-	storage	= cvCreateMemStorage( 1000 );
+	// reusing the storage, the sequences of the previous call are released here
+	cvClearMemStorage( contour_storage );
+	contours.clear();
 
+	CvSeq* contour_list = NULL;
 	int retrieve_mode
         = (bFindHoles) ? CV_RETR_LIST : CV_RETR_EXTERNAL;
 	cvFindContours( inputCopy.getCvImage(), contour_storage, &contour_list,
-                    sizeof(CvContour), retrieve_mode, bUseApproximation ? CV_CHAIN_APPROX_SIMPLE : CV_CHAIN_APPROX_NONE );
+                    sizeof(CvContour), retrieve_mode, bUseApproximation ? CV_CHAIN_APPROX_SIMPLE : CV_CHAIN_APPROX_NONE,
+                    offset );
 	CvSeq* contour_ptr = contour_list;
 
-	// put the contours from the linked list, into an array for sorting
+	// put the contours from the linked list, into an array for sorting.
+	// the area is only calculated once here and kept for sorting and the blobs
 	while( (contour_ptr != NULL) ) {
 		float area = cvContourArea(contour_ptr, CV_WHOLE_SEQ, bFindHoles); // oriented=true for holes
-		if(bFindHoles && area < 0) { // areas can be non negative in the case of holes
-			area = fabs(area);
+		// for some reason, changing the orientation when looking for holes
+		// yields negative areas for non holes and positive areas for holes
+		Contour contour;
+		contour.seq = contour_ptr;
+		contour.area = fabs(area);
+		contour.hole = bFindHoles && area > 0;
+		if((contour.area > minArea) && (contour.area < maxArea)) {
+			contours.push_back(contour);
 		}
-		if((area > minArea) && (area < maxArea)) {
-			cvSeqBlobs.push_back(contour_ptr);
+		if( rects != NULL ) {
+			CvRect rect = ((CvContour*)contour_ptr)->rect;
+			rects->push_back( ofRectangle( rect.x, rect.y, rect.width, rect.height ) );
 		}
 		contour_ptr = contour_ptr->h_next;
 	}
 
+	// sort based on size
+	if( contours.size() > 1 ) {
+        sort( contours.begin(), contours.end() );
+	}
+}
 
-	// sort the pointers based on size
-	if( cvSeqBlobs.size() > 1 ) {
-        sort( cvSeqBlobs.begin(), cvSeqBlobs.end(), sort_carea_compare );
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::contourToBlob( const Contour& contour, ofxCvBlob& blob ) {
+	CvRect rect	= cvBoundingRect( contour.seq, 0 );
+	cvMoments( contour.seq, myMoments );
+
+	blob.area                     = contour.area;
+	blob.length                   = cvArcLength(contour.seq);
+	blob.boundingRect.x           = rect.x;
+	blob.boundingRect.y           = rect.y;
+	blob.boundingRect.width       = rect.width;
+	blob.boundingRect.height      = rect.height;
+	blob.centroid.x               = (myMoments->m10 / myMoments->m00);
+	blob.centroid.y               = (myMoments->m01 / myMoments->m00);
+	blob.hole                     = contour.hole;
+
+	// get the points for the blob, resizing keeps the memory of the
+	// previous call around
+	CvPoint           pt;
+	CvSeqReader       reader;
+	cvStartReadSeq( contour.seq, &reader, 0 );
+
+	blob.pts.resize( contour.seq->total );
+	for( int j=0; j < contour.seq->total; j++ ) {
+		CV_READ_SEQ_ELEM( pt, reader );
+		blob.pts[j].set( (float)pt.x, (float)pt.y );
 	}
+	blob.nPts = blob.pts.size();
+}
 
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::copyBlobs( const vector<ofxCvBlob>& src, int nConsidered ) {
+	blobs.resize( MAX(0, MIN(nConsidered, (int)src.size())) );
+	for( int i = 0; i < (int)blobs.size(); i++ ) {
+		blobs[i].area         = src[i].area;
+		blobs[i].length       = src[i].length;
+		blobs[i].boundingRect = src[i].boundingRect;
+		blobs[i].centroid     = src[i].centroid;
+		blobs[i].hole         = src[i].hole;
+		blobs[i].pts.assign( src[i].pts.begin(), src[i].pts.end() );
+		blobs[i].nPts         = src[i].nPts;
+	}
+	nBlobs = blobs.size();
+}
 
-	// now, we have cvSeqBlobs.size() contours, sorted by size in the array
-    // cvSeqBlobs let's get the data out and into our structures that we like
-	for( int i = 0; i < MIN(nConsidered, (int)cvSeqBlobs.size()); i++ ) {
-		blobs.push_back( ofxCvBlob() );
-		float area = cvContourArea( cvSeqBlobs[i], CV_WHOLE_SEQ, bFindHoles ); // oriented=true for holes
-		CvRect rect	= cvBoundingRect( cvSeqBlobs[i], 0 );
-		cvMoments( cvSeqBlobs[i], myMoments );
-
-		blobs[i].area                     = bFindHoles ? fabs(area) : area; // only return positive areas
-		blobs[i].length 			      = cvArcLength(cvSeqBlobs[i]);
-		blobs[i].boundingRect.x           = rect.x;
-		blobs[i].boundingRect.y           = rect.y;
-		blobs[i].boundingRect.width       = rect.width;
-		blobs[i].boundingRect.height      = rect.height;
-		blobs[i].centroid.x 			  = (myMoments->m10 / myMoments->m00);
-		blobs[i].centroid.y 			  = (myMoments->m01 / myMoments->m00);
-
-		if(bFindHoles) {
-			// for some reason, changing the orientation when looking for holes
-			// yields negative areas for non holes and positive areas for holes
-			//
-			// negating the value here works, even though it feels like a hack
-			blobs[i].hole                 = -area < 0 ? true : false; // negative area denotes a hole
-		}
-		else {
-			blobs[i].hole                 = false; // no holes
-		}
+//--------------------------------------------------------------------------------
+int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
+									  int minArea,
+									  int maxArea,
+									  int nConsidered,
+									  bool bFindHoles,
+                                      bool bUseApproximation) {
+
+	allocateInputCopy( input );
+    inputCopy.setROI( input.getROI() );
+    inputCopy = input;
 
-		// get the points for the blob:
-		CvPoint           pt;
-		CvSeqReader       reader;
-		cvStartReadSeq( cvSeqBlobs[i], &reader, 0 );
+	// this call doesn't keep the cache for the dirty rect version up to date
+	bCacheValid = false;
 
-    	for( int j=0; j < cvSeqBlobs[i]->total; j++ ) {
-			CV_READ_SEQ_ELEM( pt, reader );
-            blobs[i].pts.push_back( ofPoint((float)pt.x, (float)pt.y) );
-		}
-		blobs[i].nPts = blobs[i].pts.size();
+	findContourList( cvPoint(0,0), minArea, maxArea, bFindHoles, bUseApproximation, NULL );
 
+	// now, we have contours.size() contours, sorted by size in the array
+    // let's get the data out and into our structures that we like.
+    // resizing instead of clearing reuses the points of the previous call
+	blobs.resize( MAX(0, MIN(nConsidered, (int)contours.size())) );
+	for( int i = 0; i < (int)blobs.size(); i++ ) {
+		contourToBlob( contours[i], blobs[i] );
 	}
 
     nBlobs = blobs.size();
 
-	// Free the storage memory.
-	// Warning: do this inside this function otherwise a strange memory leak
-	if( contour_storage != NULL ) { cvReleaseMemStorage(&contour_storage); }
-	if( storage != NULL ) { cvReleaseMemStorage(&storage); }
-
 	return nBlobs;
 
 }
 
+//--------------------------------------------------------------------------------
+int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
+									  const ofRectangle& dirtyRect,
+									  int minArea,
+									  int maxArea,
+									  int nConsidered,
+									  bool bFindHoles,
+                                      bool bUseApproximation) {
+
+	IplImage* ipltemp = input.getCvImage();
+	bool bFullImage = ipltemp->roi == NULL ||
+		( ipltemp->roi->xOffset == 0 && ipltemp->roi->yOffset == 0 &&
+		  ipltemp->roi->width == ipltemp->width && ipltemp->roi->height == ipltemp->height );
+	if( !bFullImage ) {
+		ofLogWarning("ofxCvContourFinder") << "findContours(): dirty rect search doesn't support a ROI, searching the whole ROI";
+		return findContours( input, minArea, maxArea, nConsidered, bFindHoles, bUseApproximation );
+	}
+
+	bool bReuse = bCacheValid &&
+		ipltemp->width == _width && ipltemp->height == _height &&
+		minArea == cachedMinArea && maxArea == cachedMaxArea &&
+		bFindHoles == bCachedFindHoles && bUseApproximation == bCachedApproximation;
+
+	allocateInputCopy( input );
+
+	if( !bReuse ) {
+		inputCopy.resetROI();
+		inputCopy = input;
+
+		cachedRects.clear();
+		findContourList( cvPoint(0,0), minArea, maxArea, bFindHoles, bUseApproximation, &cachedRects );
+		cachedBlobs.resize( contours.size() );
+		for( int i = 0; i < (int)contours.size(); i++ ) {
+			contourToBlob( contours[i], cachedBlobs[i] );
+		}
+
+		cachedMinArea = minArea;
+		cachedMaxArea = maxArea;
+		bCachedFindHoles = bFindHoles;
+		bCachedApproximation = bUseApproximation;
+		bCacheValid = true;
+
+		copyBlobs( cachedBlobs, nConsidered );
+		return nBlobs;
+	}
+
+	ofRectangle image( 0, 0, _width, _height );
+	ofRectangle region = dirtyRect.getIntersection( image );
+	if( region.isEmpty() ) {
+		copyBlobs( cachedBlobs, nConsidered );
+		return nBlobs;
+	}
+
+	// any contour touching or adjacent to the changed area can have changed
+	// (grown, merged, split...) so grow the region until it contains every
+	// contour that's close to it. contours outside the region are still valid
+	const float margin = 2;
+	vector<bool> invalid( cachedRects.size(), false );
+	bool bGrown = true;
+	while( bGrown ) {
+		bGrown = false;
+		for( int i = 0; i < (int)cachedRects.size(); i++ ) {
+			if( !invalid[i] && rects_near( cachedRects[i], region, margin ) ) {
+				invalid[i] = true;
+				region.growToInclude( cachedRects[i] );
+				bGrown = true;
+			}
+		}
+	}
+
+	// opencv clears the border pixels of the image it searches so add one
+	// pixel around the region, the pixels there can't belong to any contour
+	ofRectangle search( region.x - 1, region.y - 1, region.width + 2, region.height + 2 );
+	search = search.getIntersection( image );
+	CvRect roi = cvRect( search.x, search.y, search.width, search.height );
+
+	// only copy the searched area, the rest of inputCopy is stale
+	cvSetImageROI( inputCopy.getCvImage(), roi );
+	cvSetImageROI( ipltemp, roi );
+	cvCopy( ipltemp, inputCopy.getCvImage() );
+	cvResetImageROI( ipltemp );
+
+	vector<ofRectangle> foundRects;
+	findContourList( cvPoint(roi.x, roi.y), minArea, maxArea, bFindHoles, bUseApproximation, &foundRects );
+	cvResetImageROI( inputCopy.getCvImage() );
+
+	// the contours we found in the search rect replace the cached ones in it
+	int n = 0;
+	for( int i = 0; i < (int)cachedRects.size(); i++ ) {
+		if( !invalid[i] ) {
+			cachedRects[n++] = cachedRects[i];
+		}
+	}
+	cachedRects.resize( n );
+	cachedRects.insert( cachedRects.end(), foundRects.begin(), foundRects.end() );
+
+	n = 0;
+	for( int i = 0; i < (int)cachedBlobs.size(); i++ ) {
+		if( !rects_near( cachedBlobs[i].boundingRect, region, margin ) ) {
+			if( n != i ) {
+				std::swap( cachedBlobs[n], cachedBlobs[i] );
+			}
+			n++;
+		}
+	}
+	cachedBlobs.resize( n + contours.size() );
+	for( int i = 0; i < (int)contours.size(); i++ ) {
+		contourToBlob( contours[i], cachedBlobs[n + i] );
+	}
+	stable_sort( cachedBlobs.begin(), cachedBlobs.end(), sort_blob_area_compare );
+
+	copyBlobs( cachedBlobs, nConsidered );
+	return nBlobs;
+}
+
 //--------------------------------------------------------------------------------
 void ofxCvContourFinder::draw( float x, float y, float w, float h ) const {
 
@@ -37,6 +37,16 @@ class ofxCvContourFinder : public ofBaseDraws {
                                // of the contour, if the contour runs
                                // along a straight line, for example...
 
+    // same as above but only searches the area around dirtyRect, blobs from
+    // the previous call that don't touch it are reused. the whole image is
+    // searched if the size, the ROI or the parameters changed since the last
+    // call, so the first call always does a full search.
+    virtual int  findContours( ofxCvGrayscaleImage& input,
+                               const ofRectangle& dirtyRect,
+                               int minArea, int maxArea,
+                               int nConsidered, bool bFindHoles,
+                               bool bUseApproximation = true);
+
     virtual void  draw() const { draw(0,0, _width, _height); };
     virtual void  draw( float x, float y ) const { draw(x,y, _width, _height); };
     virtual void  draw( float x, float y, float w, float h ) const;
@@ -54,14 +64,39 @@ class ofxCvContourFinder : public ofBaseDraws {
     int  _width;
     int  _height;
     ofxCvGrayscaleImage     inputCopy;
-    CvMemStorage*           contour_storage;
-    CvMemStorage*           storage;
+    CvMemStorage*           contour_storage;  // cleared, not released, on every call
     CvMoments*              myMoments;
-    vector<CvSeq*>          cvSeqBlobs;  //these will become blobs
     
     ofPoint  anchor;
     bool  bAnchorIsPct;      
 
     virtual void reset();
 
+    struct Contour {
+        CvSeq* seq;
+        float  area;      // always positive
+        bool   hole;
+        bool operator<( const Contour& other ) const { return area > other.area; }
+    };
+
+    void allocateInputCopy( ofxCvGrayscaleImage& input );
+    void findContourList( CvPoint offset, int minArea, int maxArea,
+                          bool bFindHoles, bool bUseApproximation,
+                          vector<ofRectangle>* rects );
+    void contourToBlob( const Contour& contour, ofxCvBlob& blob );
+    void copyBlobs( const vector<ofxCvBlob>& src, int nConsidered );
+
+    vector<Contour>         contours;     // contours within the area limits, sorted by area
+
+    // state of the last image searched by the dirty rect version of
+    // findContours: every blob within the area limits sorted by area and the
+    // bounding box of every contour found, filtered or not
+    vector<ofxCvBlob>       cachedBlobs;
+    vector<ofRectangle>     cachedRects;
+    bool                    bCacheValid;
+    int                     cachedMinArea;
+    int                     cachedMaxArea;
+    bool                    bCachedFindHoles;
+    bool                    bCachedApproximation;
+
 };
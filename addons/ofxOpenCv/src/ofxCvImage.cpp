@@ -6,6 +6,35 @@
 #include "ofxCvBlob.h"
 #include "ofConstants.h"
 
+// bands smaller than this aren't worth the scheduling overhead
+static const int minRowsPerBand = 32;
+static int numBands = 0;
+
+namespace{
+    class ofxCvBandsBody: public cv::ParallelLoopBody {
+    public:
+        ofxCvBandsBody( int rows, int numBands, const std::function<void(int,int)> & op )
+        :rows(rows)
+        ,numBands(numBands)
+        ,op(op){}
+
+        void operator()( const cv::Range& range ) const {
+            for( int band = range.start; band < range.end; band++ ) {
+                int start = rows * band / numBands;
+                int end = rows * (band + 1) / numBands;
+                if( end > start ) {
+                    op( start, end );
+                }
+            }
+        }
+
+    private:
+        int rows;
+        int numBands;
+        const std::function<void(int,int)> & op;
+    };
+}
+
 
 
 
@@ -250,8 +279,11 @@ void ofxCvImage::operator -= ( float value ) {
 		ofLogError("ofxCvImage") << "operator-=: image not allocated";
 		return;		
 	}
-	cvSubS( cvImage, cvScalar(value), cvImageTemp );
-	swapTemp();
+	cv::Mat img = cv::cvarrToMat(cvImage);
+	parallelBands( img.rows, [&]( int start, int end ){
+		cv::Mat band = img.rowRange(start, end);
+		cv::subtract( band, cv::Scalar(value), band );
+	});
     flagImageChanged();
 }
 
@@ -261,8 +293,11 @@ void ofxCvImage::operator += ( float value ) {
 		ofLogError("ofxCvImage") << "operator-=: image not allocated";
 		return;		
 	}
-	cvAddS( cvImage, cvScalar(value), cvImageTemp );
-	swapTemp();
+	cv::Mat img = cv::cvarrToMat(cvImage);
+	parallelBands( img.rows, [&]( int start, int end ){
+		cv::Mat band = img.rowRange(start, end);
+		cv::add( band, cv::Scalar(value), band );
+	});
     flagImageChanged();
 }
 
@@ -283,8 +318,12 @@ void ofxCvImage::operator -= ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvSub( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cv::Mat img = cv::cvarrToMat(cvImage);
+            cv::Mat momImg = cv::cvarrToMat(mom.getCvImage());
+            parallelBands( img.rows, [&]( int start, int end ){
+                cv::Mat band = img.rowRange(start, end);
+                cv::subtract( band, momImg.rowRange(start, end), band );
+            });
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator-=: region of interest mismatch";
@@ -310,8 +349,12 @@ void ofxCvImage::operator += ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvAdd( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cv::Mat img = cv::cvarrToMat(cvImage);
+            cv::Mat momImg = cv::cvarrToMat(mom.getCvImage());
+            parallelBands( img.rows, [&]( int start, int end ){
+                cv::Mat band = img.rowRange(start, end);
+                cv::add( band, momImg.rowRange(start, end), band );
+            });
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator+=: region of interest mismatch";
@@ -338,8 +381,12 @@ void ofxCvImage::operator *= ( ofxCvImage& mom ) {
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
             float scalef = 1.0f / 255.0f;
-            cvMul( cvImage, mom.getCvImage(), cvImageTemp, scalef );
-            swapTemp();
+            cv::Mat img = cv::cvarrToMat(cvImage);
+            cv::Mat momImg = cv::cvarrToMat(mom.getCvImage());
+            parallelBands( img.rows, [&]( int start, int end ){
+                cv::Mat band = img.rowRange(start, end);
+                cv::multiply( band, momImg.rowRange(start, end), band, scalef );
+            });
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator*=: region of interest mismatch";
@@ -365,8 +412,12 @@ void ofxCvImage::operator &= ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvAnd( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cv::Mat img = cv::cvarrToMat(cvImage);
+            cv::Mat momImg = cv::cvarrToMat(mom.getCvImage());
+            parallelBands( img.rows, [&]( int start, int end ){
+                cv::Mat band = img.rowRange(start, end);
+                cv::bitwise_and( band, momImg.rowRange(start, end), band );
+            });
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator&=: region of interest mismatch";
@@ -501,7 +552,12 @@ void ofxCvImage::dilate() {
 		ofLogError("ofxCvImage") << "dilate(): image not allocated";
 		return;		
 	}
-	cvDilate( cvImage, cvImageTemp, 0, 1 );
+	cv::Mat src = cv::cvarrToMat(cvImage);
+	cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+	parallelBands( src.rows, [&]( int start, int end ){
+		cv::Mat dstBand = dst.rowRange(start, end);
+		cv::dilate( src.rowRange(start, end), dstBand, cv::Mat(), cv::Point(-1,-1), 1, cv::BORDER_REPLICATE );
+	});
 	swapTemp();
     flagImageChanged();
 }
@@ -512,7 +568,12 @@ void ofxCvImage::erode() {
 		ofLogError("ofxCvImage") << "erode(): image not allocated";
 		return;		
 	}
-	cvErode( cvImage, cvImageTemp, 0, 1 );
+	cv::Mat src = cv::cvarrToMat(cvImage);
+	cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+	parallelBands( src.rows, [&]( int start, int end ){
+		cv::Mat dstBand = dst.rowRange(start, end);
+		cv::erode( src.rowRange(start, end), dstBand, cv::Mat(), cv::Point(-1,-1), 1, cv::BORDER_REPLICATE );
+	});
 	swapTemp();
     flagImageChanged();
 }
@@ -527,7 +588,12 @@ void ofxCvImage::blur( int value ) {
         ofLogNotice("ofxCvImage") << "blur(): value " << value << " not odd, adding 1";
         value++;
     }
-	cvSmooth( cvImage, cvImageTemp, CV_BLUR , value);
+	cv::Mat src = cv::cvarrToMat(cvImage);
+	cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+	parallelBands( src.rows, [&]( int start, int end ){
+		cv::Mat dstBand = dst.rowRange(start, end);
+		cv::boxFilter( src.rowRange(start, end), dstBand, -1, cv::Size(value, value), cv::Point(-1,-1), true, cv::BORDER_REPLICATE );
+	});
 	swapTemp();
     flagImageChanged();
 }
@@ -542,7 +608,12 @@ void ofxCvImage::blurGaussian( int value ) {
         ofLogNotice("ofxCvImage") << "blurGaussian(): value " << value << " not odd, adding 1";
         value++;
     }
-	cvSmooth( cvImage, cvImageTemp, CV_GAUSSIAN ,value );
+	cv::Mat src = cv::cvarrToMat(cvImage);
+	cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+	parallelBands( src.rows, [&]( int start, int end ){
+		cv::Mat dstBand = dst.rowRange(start, end);
+		cv::GaussianBlur( src.rowRange(start, end), dstBand, cv::Size(value, value), 0, 0, cv::BORDER_REPLICATE );
+	});
 	swapTemp();
     flagImageChanged();
 }
@@ -553,7 +624,11 @@ void ofxCvImage::invert(){
 		ofLogError("ofxCvImage") << "invert(): image not allocated";
 		return;		
 	}
-    cvNot(cvImage, cvImage);
+	cv::Mat img = cv::cvarrToMat(cvImage);
+	parallelBands( img.rows, [&]( int start, int end ){
+		cv::Mat band = img.rowRange(start, end);
+		cv::bitwise_not( band, band );
+	});
     flagImageChanged();
 }
 
@@ -663,7 +738,20 @@ void ofxCvImage::remap( IplImage* mapX, IplImage* mapY ) {
 		ofLogError("ofxCvImage") << "remap(): image not allocated";
 		return;		
 	}	
-    cvRemap( cvImage, cvImageTemp, mapX, mapY );
+	cv::Mat src = cv::cvarrToMat(cvImage);
+	cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+	cv::Mat mapXMat = cv::cvarrToMat(mapX);
+	cv::Mat mapYMat = cv::cvarrToMat(mapY);
+	if( mapXMat.size() != dst.size() || mapYMat.size() != dst.size() ){
+		ofLogError("ofxCvImage") << "remap(): maps size doesn't match the image or its ROI";
+		return;
+	}
+	// every band reads from the whole source, only the output is split
+	parallelBands( dst.rows, [&]( int start, int end ){
+		cv::Mat dstBand = dst.rowRange(start, end);
+		cv::remap( src, dstBand, mapXMat.rowRange(start, end), mapYMat.rowRange(start, end),
+				   cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar() );
+	});
 	swapTemp();
     flagImageChanged();
 }
@@ -710,7 +798,8 @@ void ofxCvImage::warpPerspective( const ofPoint& A, const ofPoint& B, const ofPo
     cvsrc[3].y = D.y;
 
     cvGetPerspectiveTransform( cvsrc, cvdst, translate );  // calculate homography
-    cvWarpPerspective( cvImage, cvImageTemp, translate );
+    cv::Mat dst = cv::cvarrToMat(cvImageTemp);
+    warpPerspectiveBands( cv::cvarrToMat(cvImage), dst, cv::cvarrToMat(translate) );
     swapTemp();
     flagImageChanged();
     cvReleaseMat( &translate );
@@ -745,7 +834,8 @@ void ofxCvImage::warpIntoMe( ofxCvImage& mom, const ofPoint src[4], const ofPoin
     		cvdst[i].y = dst[i].y;
     	}
     	cvGetPerspectiveTransform( cvsrc, cvdst, translate );  // calculate homography
-    	cvWarpPerspective( mom.getCvImage(), cvImage, translate);
+    	cv::Mat dst = cv::cvarrToMat(cvImage);
+    	warpPerspectiveBands( cv::cvarrToMat(mom.getCvImage()), dst, cv::cvarrToMat(translate) );
         flagImageChanged();
     	cvReleaseMat( &translate );
 
@@ -785,8 +875,52 @@ int ofxCvImage::countNonZeroInRegion( int x, int y, int w, int h ) {
 
 
 
+// Parallel Execution
+
+//--------------------------------------------------------------------------------
+void ofxCvImage::setNumBands( int _numBands ) {
+    numBands = MAX( _numBands, 0 );
+}
+
+//--------------------------------------------------------------------------------
+int ofxCvImage::getNumBands() {
+    return numBands;
+}
+
+
+
+
 // private methods
 
+//--------------------------------------------------------------------------------
+void ofxCvImage::parallelBands( int rows, const std::function<void(int start, int end)> & op ) {
+    int bands = numBands == 0 ? cv::getNumThreads() : numBands;
+    bands = MIN( bands, rows / minRowsPerBand );
+    if( bands <= 1 ) {
+        op( 0, rows );
+    } else {
+        cv::parallel_for_( cv::Range(0, bands), ofxCvBandsBody(rows, bands, op) );
+    }
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvImage::warpPerspectiveBands( const cv::Mat& src, cv::Mat& dst, const cv::Mat& homography ) {
+    // same as cvWarpPerspective with the default flags but with the inverse
+    // map offset for every band so each one can be written independently.
+    cv::Mat inverse;
+    homography.convertTo( inverse, CV_64F );
+    cv::invert( inverse, inverse );
+    parallelBands( dst.rows, [&]( int start, int end ){
+        cv::Mat bandInverse = inverse.clone();
+        for( int i = 0; i < 3; i++ ) {
+            bandInverse.at<double>(i,2) += inverse.at<double>(i,1) * start;
+        }
+        cv::Mat dstBand = dst.rowRange(start, end);
+        cv::warpPerspective( src, dstBand, bandInverse, dstBand.size(),
+                             cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar() );
+    });
+}
+
 //--------------------------------------------------------------------------------
 void ofxCvImage::swapTemp() {
 	if (getROI().x != 0 ||
@@ -150,6 +150,15 @@ class ofxCvImage : public ofBaseImage {
     virtual int  countNonZeroInRegion( int x, int y, int w, int h );
 
 
+    // Parallel Execution
+    //
+    // filters, warps and arithmetic operators split the image (or its ROI)
+    // in horizontal bands that run on opencv's thread pool. 0 uses one band
+    // per opencv thread, 1 runs every operation on the calling thread.
+    static void setNumBands( int numBands );
+    static int  getNumBands();
+
+
 
 
   protected:
@@ -162,6 +171,12 @@ class ofxCvImage : public ofBaseImage {
 
     virtual void  rangeMap( IplImage* img, float min1, float max1, float min2, float max2 );
     virtual void  rangeMap( IplImage* mom, IplImage* kid, float min1, float max1, float min2, float max2 );
+
+    // calls op(start,end) for bands of rows in [0,rows) across opencv's
+    // thread pool. filters read the rows around each band from the parent
+    // image so the bands overlap by the kernel radius without copies.
+    static void parallelBands( int rows, const std::function<void(int start, int end)> & op );
+    static void warpPerspectiveBands( const cv::Mat& src, cv::Mat& dst, const cv::Mat& homography );
                                      
     virtual void swapTemp();  // swap cvImageTemp back
                               // to cvImage after an image operation
@@ -15,5 +15,6 @@
 //--------------------------
 // contours and blobs
 #include "ofxCvContourFinder.h"
+#include "ofxCvBlobTracker.h"
 
 #include "ofxCvHaarFinder.h"
@@ -69,6 +69,7 @@ void ofxXmlSettings::clear(){
 	//node - including the node itself!
 
 	storedHandle.ToNode()->Clear();
+	invalidateIndex();
 }
 
 //---------------------------------------------------------
@@ -86,6 +87,7 @@ bool ofxXmlSettings::loadFile(const string& xmlFile){
 	level = 0;
 
 	storedHandle = TiXmlHandle(&doc);
+	invalidateIndex();
 	return loadOkay;
 }
 
@@ -121,34 +123,15 @@ void ofxXmlSettings::clearTagContents(const string& tag, int which){
 //---------------------------------------------------------
 void ofxXmlSettings::removeTag(const string& tag, int which){
 
-	vector<string> tokens = tokenize(tag,":");
-
 	//no tags so we return
-	if( tokens.size() == 0 ) return;
-
-	//grab the handle from the level we are at
-	//normally this is the doc but could be a pushed node
-	TiXmlHandle tagHandle = storedHandle;
-
-	if(which < 0) which = 0;
-
-	for(int x=0;x<(int)tokens.size();x++){
-
-		//we only support multi tags
-		//with same name at root level
-		if(x > 0) which = 0;
-
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
-
-		if ( !isRealHandle.ToNode() ) break;
-		else{
-			if (x == (int)tokens.size()-1){
-				//if we are at the last tag and it exists
-				//we use its parent to remove it - haha
-				tagHandle.ToNode()->RemoveChild( isRealHandle.ToNode() );
-			}
-			tagHandle = isRealHandle;
-		}
+	if( tag.find_first_not_of(':') == string::npos ) return;
+
+	TiXmlNode* node = findNode(tag, which);
+	if( node ){
+		//if the last tag exists
+		//we use its parent to remove it - haha
+		node->Parent()->RemoveChild( node );
+		invalidateIndex();
 	}
 }
 
@@ -182,19 +165,69 @@ string ofxXmlSettings::getValue(const string& tag, const string& defaultValue, i
 //---------------------------------------------------------
 bool ofxXmlSettings::readTag(const string&  tag, TiXmlHandle& valHandle, int which){
 
-	vector<string> tokens = tokenize(tag,":");
-
-	TiXmlHandle tagHandle = storedHandle;
-	for(int x=0;x<(int)tokens.size();x++){
-		if(x == 0)tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else tagHandle = tagHandle.FirstChildElement( tokens.at(x) );
-	}
+	TiXmlHandle tagHandle( findNode(tag, which) );
 
 	// once we've walked, let's get that value...
 	valHandle = tagHandle.Child( 0 );
     return (valHandle.ToText() != NULL);
 }
 
+//---------------------------------------------------------
+const vector<TiXmlElement*> & ofxXmlSettings::getChildren(TiXmlNode* parent, const string& name){
+	static const vector<TiXmlElement*> none;
+	if( !parent ) return none;
+
+	//the children of a node are indexed all at once the first
+	//time one of them is looked up, instead of walking all of
+	//them every time one of them is read
+	auto found = elementsIndex.find(parent);
+	if( found == elementsIndex.end() ){
+		found = elementsIndex.emplace(parent, unordered_map<string, vector<TiXmlElement*> >()).first;
+		for(TiXmlElement* child = parent->FirstChildElement(); child; child = child->NextSiblingElement()){
+			found->second[child->ValueStr()].push_back(child);
+		}
+	}
+
+	auto children = found->second.find(name);
+	if( children == found->second.end() ) return none;
+	return children->second;
+}
+
+//---------------------------------------------------------
+TiXmlElement* ofxXmlSettings::findChild(TiXmlNode* parent, const string& name, int which){
+	const vector<TiXmlElement*> & children = getChildren(parent, name);
+	if( which < 0 ) which = 0;
+	if( which < (int)children.size() ) return children[which];
+	return NULL;
+}
+
+//---------------------------------------------------------
+TiXmlNode* ofxXmlSettings::findNode(const string& tag, int which){
+
+	//walks the tags in "a:b:c" from the level we are at
+	//without splitting them into a vector. we only support
+	//multi tags with same name at root level
+	TiXmlNode* node = storedHandle.ToNode();
+	string token;
+	size_t start = tag.find_first_not_of(':');
+	while( node && start != string::npos ){
+		size_t end = tag.find(':', start);
+		if( start == 0 && end == string::npos ){
+			node = findChild(node, tag, which);
+		}else{
+			token.assign(tag, start, end == string::npos ? string::npos : end - start);
+			node = findChild(node, token, which);
+		}
+		which = 0;
+		start = tag.find_first_not_of(':', end);
+	}
+	return node;
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::invalidateIndex(){
+	elementsIndex.clear();
+}
 
 //---------------------------------------------------------
 bool ofxXmlSettings::pushTag(const string&  tag, int which){
@@ -205,10 +238,10 @@ bool ofxXmlSettings::pushTag(const string&  tag, int which){
     string tagToFind((pos > 0) ? tag.substr(0,pos) :tag);
 
 	//we only allow to push one tag at a time.
-	TiXmlHandle isRealHandle = storedHandle.ChildElement(tagToFind, which);
+	TiXmlElement* isReal = findChild(storedHandle.ToNode(), tagToFind, which);
 
-	if( isRealHandle.ToNode() ){
-		storedHandle = isRealHandle;
+	if( isReal ){
+		storedHandle = TiXmlHandle(isReal);
 		level++;
 		return true;
 	}else{
@@ -241,37 +274,13 @@ int ofxXmlSettings::getPushLevel(){
 //---------------------------------------------------------
 bool ofxXmlSettings::tagExists(const string& tag, int which){
 
-	vector<string> tokens = tokenize(tag,":");
-
-	bool found = false;
-
-	//grab the handle from the level we are at
-	//normally this is the doc but could be a pushed node
-	TiXmlHandle tagHandle = storedHandle;
+	if( tag.find_first_not_of(':') == string::npos ) return false;
 
 	if(which < 0) which = 0;
 
-	for(int x=0;x<(int)tokens.size();x++){
-
-		//we only support multi tags
-		//with same name at root level
-		if(x > 0) which = 0;
-
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
-
-		//as soon as we find a tag that doesn't exist
-		//we return false;
-		if ( !isRealHandle.ToNode() ){
-			found = false;
-			break;
-		}
-		else{
-			found = true;
-			tagHandle = isRealHandle;
-		}
-	}
-
-	return found;
+	//as soon as we find a tag that doesn't exist
+	//findNode returns NULL
+	return findNode(tag, which) != NULL;
 }
 
 
@@ -284,21 +293,9 @@ int ofxXmlSettings::getNumTags(const string&  tag){
     // Either find the tag specified, or the first tag if colon-seperated.
     string tagToFind((pos > 0) ? tag.substr(0,pos) :tag);
 
-	//grab the handle from the level we are at
-	//normally this is the doc but could be a pushed node
-	//TiXmlHandle tagHandle = storedHandle;
-
-	int count = 0;
-
-	//ripped from tinyXML as doing this ourselves once is a LOT! faster
-	//than having this called n number of times in a while loop - we go from n*n iterations to n iterations
-
-	TiXmlElement* child = ( storedHandle.FirstChildElement( tagToFind ) ).ToElement();
-	for (count = 0; child; child = child->NextSiblingElement( tagToFind ), ++count){
-		//nothing
-	}
-
-	return count;
+	//the index already has all the tags with the
+	//same name at the level we are at
+	return getChildren(storedHandle.ToNode(), tagToFind).size();
 }
 
 
@@ -333,9 +330,9 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			addNewTag = false;
 		}
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlElement* isReal = findChild(tagHandle.ToNode(), tokens.at(x), which);
 
-		if ( !isRealHandle.ToNode() ||  addNewTag){
+		if ( !isReal ||  addNewTag){
 
 			for(int i=(int)tokens.size()-1;i>=x;i--){
 				if (i == (int)tokens.size()-1){
@@ -345,14 +342,23 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 				}
 			}
 
-			tagHandle.ToNode()->InsertEndChild(elements[x]);
+			TiXmlNode* inserted = tagHandle.ToNode()->InsertEndChild(elements[x]);
+
+			//the new tag goes last so if its parent is
+			//already indexed we only need to add it
+			auto parent = elementsIndex.find(tagHandle.ToNode());
+			if( inserted && parent != elementsIndex.end() ){
+				parent->second[tokens.at(x)].push_back(inserted->ToElement());
+			}
 
 			break;
 
 		} else {
-			 tagHandle = isRealHandle;
+			 tagHandle = TiXmlHandle(isReal);
 			 if (x == (int)tokens.size()-1){
 				// what we want to change : TiXmlHandle valHandle = tagHandle.Child( 0 );
+				// clearing a tag with other tags inside removes them
+				if( isReal->FirstChildElement() ) invalidateIndex();
 				tagHandle.ToNode()->Clear();
 				tagHandle.ToNode()->InsertEndChild(Value);
 			}
@@ -361,16 +367,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 
 
 	//lets count how many tags with our name exist so we can return an index
-
-	//ripped from tinyXML as doing this ourselves once is a LOT! faster
-	//than having this called n number of times in a while loop - we go from n*n iterations to n iterations
-	int numSameTags;
-	TiXmlElement* child = ( storedHandle.FirstChildElement( tokens.at(0) ) ).ToElement();
-	for (numSameTags = 0; child; child = child->NextSiblingElement( tokens.at(0) ), ++numSameTags){
-		//nothing
-	}
-
-	return numSameTags;
+	return getChildren(storedHandle.ToNode(), tokens.at(0)).size();
 }
 
 //---------------------------------------------------------
@@ -505,17 +502,8 @@ int ofxXmlSettings::addAttribute(const string& tag, const string& attribute, con
 
 //---------------------------------------------------------
 void ofxXmlSettings::removeAttribute(const string& tag, const string& attribute, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-
-	if (tagHandle.ToElement()) {
-		TiXmlElement* elem = tagHandle.ToElement();
+	TiXmlElement* elem = getElementForAttribute(tag, which);
+	if (elem) {
 		elem->RemoveAttribute(attribute);
 	}
 }
@@ -530,17 +518,8 @@ void ofxXmlSettings::clearTagAttributes(const string& tag, int which){
 
 //---------------------------------------------------------
 int ofxXmlSettings::getNumAttributes(const string& tag, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-
-	if (tagHandle.ToElement()) {
-		TiXmlElement* elem = tagHandle.ToElement();
+	TiXmlElement* elem = getElementForAttribute(tag, which);
+	if (elem) {
 
 		// Do stuff with the element here
 		TiXmlAttribute* first = elem->FirstAttribute();
@@ -556,17 +535,8 @@ int ofxXmlSettings::getNumAttributes(const string& tag, int which){
 
 //---------------------------------------------------------
 bool ofxXmlSettings::attributeExists(const string& tag, const string& attribute, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-
-	if (tagHandle.ToElement()) {
-		TiXmlElement* elem = tagHandle.ToElement();
+	TiXmlElement* elem = getElementForAttribute(tag, which);
+	if (elem) {
 
 		// Do stuff with the element here
 		for (TiXmlAttribute* a = elem->FirstAttribute(); a; a = a->Next()) {
@@ -579,17 +549,8 @@ bool ofxXmlSettings::attributeExists(const string& tag, const string& attribute,
 
 //---------------------------------------------------------
 bool ofxXmlSettings::getAttributeNames(const string& tag, vector<string>& outNames, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-
-	if (tagHandle.ToElement()) {
-		TiXmlElement* elem = tagHandle.ToElement();
+	TiXmlElement* elem = getElementForAttribute(tag, which);
+	if (elem) {
 
 		// Do stuff with the element here
 		for (TiXmlAttribute* a = elem->FirstAttribute(); a; a = a->Next())
@@ -643,15 +604,8 @@ int ofxXmlSettings::setAttribute(const string& tag, const string& attribute, con
 
 //---------------------------------------------------------
 TiXmlElement* ofxXmlSettings::getElementForAttribute(const string& tag, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-    return tagHandle.ToElement();
+	TiXmlNode* node = findNode(tag, which);
+	return node ? node->ToElement() : NULL;
 }
 
 //---------------------------------------------------------
@@ -690,28 +644,16 @@ bool ofxXmlSettings::readStringAttribute(const string& tag, const string& attrib
 
 //---------------------------------------------------------
 int ofxXmlSettings::writeAttribute(const string& tag, const string& attribute, const string& valueString, int which){
-	vector<string> tokens = tokenize(tag,":");
-	TiXmlHandle tagHandle = storedHandle;
-	for (int x = 0; x < (int)tokens.size(); x++) {
-		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
-	}
-
 	int ret = 0;
-	if (tagHandle.ToElement()) {
-		TiXmlElement* elem = tagHandle.ToElement();
+	TiXmlElement* elem = getElementForAttribute(tag, which);
+	if (elem) {
 		elem->SetAttribute(attribute, valueString);
 
         // Do we really need this?  We could just ignore this and remove the 'addAttribute' functions...
 		// Now, just get the ID.
-		int numSameTags;
-		TiXmlElement* child = ( storedHandle.FirstChildElement( tokens.at(0) ) ).ToElement();
-		for (numSameTags = 0; child; child = child->NextSiblingElement( tokens.at(0) ), ++numSameTags) {
-			// nothing
-		}
-		ret = numSameTags;
+		size_t start = tag.find_first_not_of(':');
+		if (start != string::npos)
+			ret = getChildren(storedHandle.ToNode(), tag.substr(start, tag.find(':', start) - start)).size();
 	}
 	return ret;
 }
@@ -723,6 +665,7 @@ bool ofxXmlSettings::loadFromBuffer( string buffer )
     bool loadOkay = doc.ReadFromMemory( buffer.c_str(), size);//, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING);
     storedHandle = TiXmlHandle(&doc);
     level = 0;
+    invalidateIndex();
     return loadOkay;
 }
 
@@ -2,6 +2,7 @@
 
 #include "ofMain.h"
 #include <string.h>
+#include <unordered_map>
 #if (_MSC_VER)
 #include "../libs/tinyxml.h"
 #else
@@ -150,6 +151,13 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		bool	loadFromBuffer( string buffer );
 		void	copyXmlToString(string & str);
 
+		//-- invalidateIndex
+		//tags are found through an index of the elements of the document
+		//by their name, which is built as they are read. it's kept up to date
+		//by all the methods of this class but if you change doc directly
+		//you need to call this so the index is built again.
+		void	invalidateIndex();
+
 		TiXmlDocument 	doc;
 		bool 			bDocLoaded;
 
@@ -158,6 +166,14 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		TiXmlHandle     storedHandle;
 		int             level;
 
+		// the child elements of every node read so far, by name and in the
+		// order they are in the document
+		unordered_map<const TiXmlNode*, unordered_map<string, vector<TiXmlElement*> > > elementsIndex;
+
+		const vector<TiXmlElement*> & getChildren(TiXmlNode* parent, const string& name);
+		TiXmlElement* findChild(TiXmlNode* parent, const string& name, int which);
+		TiXmlNode* findNode(const string& tag, int which);
+
 
 		int 	writeTag(const string&  tag, const string& valueString, int which = 0);
 		bool 	readTag(const string&  tag, TiXmlHandle& valHandle, int which = 0);	// max 1024 chars...
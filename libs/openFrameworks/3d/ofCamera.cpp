@@ -1,5 +1,7 @@
 #include "ofCamera.h"
 #include "ofLog.h"
+#include "ofBatchMath.h"
+#include <cstring>
 
 //----------------------------------------
 ofCamera::ofCamera() :
@@ -10,7 +12,9 @@ farClip(0),
 lensOffset(0.0f, 0.0f),
 forceAspectRatio(false),
 aspectRatio(4./3.),
-vFlip(false)
+vFlip(false),
+cacheValid(false),
+inverseCacheValid(false)
 {
 }
 
@@ -20,21 +24,25 @@ ofCamera::~ofCamera() {}
 //----------------------------------------
 void ofCamera::setFov(float f) {
 	fov = f;
+	invalidateCache();
 }
 
 //----------------------------------------
 void ofCamera::setNearClip(float f) {
 	nearClip = f;
+	invalidateCache();
 }
 
 //----------------------------------------
 void ofCamera::setFarClip(float f) {
 	farClip = f;
+	invalidateCache();
 }
 
 //----------------------------------------
 void ofCamera::setLensOffset(const ofVec2f & lensOffset){
 	this->lensOffset = lensOffset;
+	invalidateCache();
 }
 
 //----------------------------------------
@@ -46,6 +54,7 @@ void ofCamera::setAspectRatio(float aspectRatio){
 //----------------------------------------
 void ofCamera::setForceAspectRatio(bool forceAspectRatio){
 	this->forceAspectRatio = forceAspectRatio;
+	invalidateCache();
 }
 
 //----------------------------------------
@@ -109,11 +118,13 @@ bool ofCamera::isVFlipped() const{
 //----------------------------------------
 void ofCamera::enableOrtho() {
 	isOrtho = true;
+	invalidateCache();
 }
 
 //----------------------------------------
 void ofCamera::disableOrtho() {
 	isOrtho = false;
+	invalidateCache();
 }
 
 //----------------------------------------
@@ -168,15 +179,19 @@ ofMatrix4x4 ofCamera::getModelViewMatrix() const {
 
 //----------------------------------------
 ofMatrix4x4 ofCamera::getModelViewProjectionMatrix(ofRectangle viewport) const {
-	viewport = getViewport(viewport);
-	return getModelViewMatrix() * getProjectionMatrix(viewport);
+	return getCachedModelViewProjection(getViewport(viewport));
+}
+
+//----------------------------------------
+ofFrustum ofCamera::getFrustum(ofRectangle viewport) const {
+	return ofFrustum(getCachedModelViewProjection(getViewport(viewport)));
 }
 
 //----------------------------------------
 ofVec3f ofCamera::worldToScreen(ofVec3f WorldXYZ, ofRectangle viewport) const {
 	viewport = getViewport(viewport);
 
-	ofVec3f CameraXYZ = WorldXYZ * getModelViewProjectionMatrix(viewport);
+	ofVec3f CameraXYZ = WorldXYZ * getCachedModelViewProjection(viewport);
 	ofVec3f ScreenXYZ;
 
 	ScreenXYZ.x = (CameraXYZ.x + 1.0f) / 2.0f * viewport.width + viewport.x;
@@ -198,26 +213,57 @@ ofVec3f ofCamera::screenToWorld(ofVec3f ScreenXYZ, ofRectangle viewport) const {
 	CameraXYZ.y = 1.0f - 2.0f *(ScreenXYZ.y - viewport.y) / viewport.height;
 	CameraXYZ.z = ScreenXYZ.z;
 
-	//get inverse camera matrix
-	ofMatrix4x4 inverseCamera;
-	inverseCamera.makeInvertOf(getModelViewProjectionMatrix(viewport));
-
 	//convert camera to world
-	return CameraXYZ * inverseCamera;
+	return CameraXYZ * getCachedInverseModelViewProjection(viewport);
+
+}
+
+//----------------------------------------
+void ofCamera::worldToScreen(const ofVec3f * world, ofVec3f * screen, size_t n, ofRectangle viewport) const {
+	ofTransformPoints(getScreenMatrix(getViewport(viewport)), world, screen, n);
+}
 
+//----------------------------------------
+void ofCamera::worldToScreen(const vector<ofVec3f> & world, vector<ofVec3f> & screen, ofRectangle viewport) const {
+	screen.resize(world.size());
+	worldToScreen(world.data(), screen.data(), world.size(), viewport);
+}
+
+//----------------------------------------
+size_t ofCamera::worldToScreen(const vector<ofVec3f> & world, vector<ofVec3f> & screen, vector<uint8_t> & visible, ofRectangle viewport) const {
+	viewport = getViewport(viewport);
+	// the visibility is tested first in case world and screen are the
+	// same vector
+	size_t numVisible = getFrustum(viewport).getVisiblePoints(world, visible);
+	worldToScreen(world, screen, viewport);
+	return numVisible;
+}
+
+//----------------------------------------
+void ofCamera::screenToWorld(const ofVec3f * screen, ofVec3f * world, size_t n, ofRectangle viewport) const {
+	viewport = getViewport(viewport);
+	// the inverse of the viewport transform in screenToWorld followed by
+	// the inverse camera matrix
+	ofMatrix4x4 m = getCachedInverseModelViewProjection(viewport);
+	m.preMultScale(ofVec3f(2.0f / viewport.width, -2.0f / viewport.height, 1.0f));
+	m.preMultTranslate(ofVec3f(-viewport.x - viewport.width / 2.0f, -viewport.y - viewport.height / 2.0f, 0.0f));
+	ofTransformPoints(m, screen, world, n);
+}
+
+//----------------------------------------
+void ofCamera::screenToWorld(const vector<ofVec3f> & screen, vector<ofVec3f> & world, ofRectangle viewport) const {
+	world.resize(screen.size());
+	screenToWorld(screen.data(), world.data(), screen.size(), viewport);
 }
 
 //----------------------------------------
 ofVec3f ofCamera::worldToCamera(ofVec3f WorldXYZ, ofRectangle viewport) const {
-	return WorldXYZ * getModelViewProjectionMatrix(getViewport(viewport));
+	return WorldXYZ * getCachedModelViewProjection(getViewport(viewport));
 }
 
 //----------------------------------------
 ofVec3f ofCamera::cameraToWorld(ofVec3f CameraXYZ, ofRectangle viewport) const {
-	ofMatrix4x4 inverseCamera;
-	inverseCamera.makeInvertOf(getModelViewProjectionMatrix(getViewport(viewport)));
-
-	return CameraXYZ * inverseCamera;
+	return CameraXYZ * getCachedInverseModelViewProjection(getViewport(viewport));
 }
 
 //----------------------------------------
@@ -227,7 +273,50 @@ void ofCamera::calcClipPlanes(const ofRectangle & viewport) {
 		float dist = getImagePlaneDistance(getViewport(viewport));
 		nearClip = (nearClip == 0) ? dist / 100.0f : nearClip;
 		farClip = (farClip == 0) ? dist * 10.0f : farClip;
+		invalidateCache();
+	}
+}
+
+//----------------------------------------
+const ofMatrix4x4 & ofCamera::getCachedModelViewProjection(const ofRectangle & viewport) const {
+	const ofMatrix4x4 & transform = getGlobalTransformMatrix();
+	// comparing the global matrix catches changes in the camera and in any
+	// of its parents
+	if(!cacheValid || !(viewport == cachedViewport) || memcmp(transform.getPtr(), cachedTransform.getPtr(), sizeof(ofMatrix4x4)) != 0){
+		ofMatrix4x4 projection = getProjectionMatrix(viewport);
+		cachedModelViewProjection = transform.getInverse() * projection;
+		cachedTransform = transform;
+		cachedViewport = viewport;
+		cacheValid = true;
+		inverseCacheValid = false;
+	}
+	return cachedModelViewProjection;
+}
+
+//----------------------------------------
+const ofMatrix4x4 & ofCamera::getCachedInverseModelViewProjection(const ofRectangle & viewport) const {
+	getCachedModelViewProjection(viewport);
+	if(!inverseCacheValid){
+		cachedInverseModelViewProjection.makeInvertOf(cachedModelViewProjection);
+		inverseCacheValid = true;
 	}
+	return cachedInverseModelViewProjection;
+}
+
+//----------------------------------------
+ofMatrix4x4 ofCamera::getScreenMatrix(const ofRectangle & viewport) const {
+	// the camera matrix followed by the viewport transform in
+	// worldToScreen, which commutes with the divide by w
+	ofMatrix4x4 m = getCachedModelViewProjection(viewport);
+	m.postMultScale(viewport.width / 2.0f, -viewport.height / 2.0f, 1.0f);
+	m.postMultTranslate(viewport.x + viewport.width / 2.0f, viewport.y + viewport.height / 2.0f, 0.0f);
+	return m;
+}
+
+//----------------------------------------
+void ofCamera::invalidateCache() {
+	cacheValid = false;
+	inverseCacheValid = false;
 }
 
 ofRectangle ofCamera::getViewport(const ofRectangle & viewport) const{
@@ -4,6 +4,7 @@
 #include "ofRectangle.h"
 #include "ofGraphics.h"
 #include "ofNode.h"
+#include "ofFrustum.h"
 
 // \todo Use the public API of ofNode for all transformations
 // \todo add set projection matrix
@@ -171,6 +172,14 @@ public:
     /// \todo getModelViewProjectionMatrix()
     ofMatrix4x4 getModelViewProjectionMatrix(ofRectangle viewport = ofRectangle()) const;
 
+    /// \brief Get the volume visible from the camera in world coordinates.
+    ///
+    /// Extract it once per frame and use it to test which objects are
+    /// visible, see ofFrustum.
+    ///
+    /// \param viewport (Optional) A viewport. The default is ofGetCurrentViewport().
+    ofFrustum getFrustum(ofRectangle viewport = ofRectangle()) const;
+
     /// \}
     /// \name Coordinate Conversion
     /// \{
@@ -197,6 +206,30 @@ public:
 	/// \param ScreenXYZ A point on your screen, whose 3D world coordinates you wish to know.
 	ofVec3f screenToWorld(ofVec3f ScreenXYZ, ofRectangle viewport = ofRectangle()) const;
 	
+	/// \brief Obtain the screen coordinates of an array of 3D points.
+	///
+	/// The same as calling worldToScreen() for every point but the camera
+	/// matrices are computed once and the points are transformed with SIMD
+	/// instructions, see ofBatchMath.h. The destination can be the same
+	/// array as the source.
+	void worldToScreen(const ofVec3f * world, ofVec3f * screen, size_t n, ofRectangle viewport = ofRectangle()) const;
+	void worldToScreen(const vector<ofVec3f> & world, vector<ofVec3f> & screen, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the screen coordinates of an array of 3D points and
+	/// which of them are visible.
+	///
+	/// Points behind the camera are projected to the screen too, mirrored,
+	/// so check visible before using the result, for example to draw labels.
+	///
+	/// \param visible Set to 1 for the points inside the camera's frustum
+	///     and to 0 for the rest.
+	/// \returns The number of visible points.
+	size_t worldToScreen(const vector<ofVec3f> & world, vector<ofVec3f> & screen, vector<uint8_t> & visible, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the 3D world coordinates of an array of screen points.
+	void screenToWorld(const ofVec3f * screen, ofVec3f * world, size_t n, ofRectangle viewport = ofRectangle()) const;
+	void screenToWorld(const vector<ofVec3f> & screen, vector<ofVec3f> & world, ofRectangle viewport = ofRectangle()) const;
+
 	/// \todo worldToCamera()
 	ofVec3f worldToCamera(ofVec3f WorldXYZ, ofRectangle viewport = ofRectangle()) const;
 
@@ -216,6 +249,14 @@ protected:
 	void calcClipPlanes(const ofRectangle & viewport);
 	
 private:
+	// the matrices used by the coordinate conversions for the last
+	// viewport, recomputed when the camera moves or its settings change
+	const ofMatrix4x4 & getCachedModelViewProjection(const ofRectangle & viewport) const;
+	const ofMatrix4x4 & getCachedInverseModelViewProjection(const ofRectangle & viewport) const;
+	ofMatrix4x4 getScreenMatrix(const ofRectangle & viewport) const;
+	void invalidateCache();
+
+
 	bool isOrtho;
 	float fov;
 	float nearClip;
@@ -225,5 +266,12 @@ private:
 	float aspectRatio; // only used when forceAspect=true, = w / h
 	bool vFlip;
 	shared_ptr<ofBaseRenderer> renderer;
+
+	mutable bool cacheValid;
+	mutable bool inverseCacheValid;
+	mutable ofRectangle cachedViewport;
+	mutable ofMatrix4x4 cachedTransform;
+	mutable ofMatrix4x4 cachedModelViewProjection;
+	mutable ofMatrix4x4 cachedInverseModelViewProjection;
 };
 
@@ -0,0 +1,116 @@
+#include "ofFrustum.h"
+#include "ofBatchMath.h"
+#include "ofLog.h"
+
+//----------------------------------------------------------
+ofFrustum::ofFrustum(){
+	for(auto & plane: planes){
+		plane.set(0, 0, 0, 1);
+	}
+}
+
+//----------------------------------------------------------
+ofFrustum::ofFrustum(const ofMatrix4x4 & modelViewProjection){
+	set(modelViewProjection);
+}
+
+//----------------------------------------------------------
+void ofFrustum::set(const ofMatrix4x4 & m){
+	// points are transformed as p * m so column j of the matrix computes
+	// the clip coordinate j and a point is inside if -w <= x, y, z <= w
+	// (Gribb & Hartmann, "Fast extraction of viewing frustum planes")
+	for(int i = 0; i < 4; i++){
+		planes[Left][i] = m(i, 3) + m(i, 0);
+		planes[Right][i] = m(i, 3) - m(i, 0);
+		planes[Bottom][i] = m(i, 3) + m(i, 1);
+		planes[Top][i] = m(i, 3) - m(i, 1);
+		planes[Near][i] = m(i, 3) + m(i, 2);
+		planes[Far][i] = m(i, 3) - m(i, 2);
+	}
+	for(auto & plane: planes){
+		float length = ofVec3f(plane.x, plane.y, plane.z).length();
+		if(length > 0){
+			plane /= length;
+		}
+	}
+}
+
+//----------------------------------------------------------
+const ofVec4f & ofFrustum::getPlane(Plane plane) const{
+	return planes[plane];
+}
+
+//----------------------------------------------------------
+const ofVec4f * ofFrustum::getPlanes() const{
+	return planes;
+}
+
+//----------------------------------------------------------
+float ofFrustum::getDistance(Plane plane, const ofVec3f & point) const{
+	const ofVec4f & p = planes[plane];
+	return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+}
+
+//----------------------------------------------------------
+bool ofFrustum::isVisible(const ofVec3f & point) const{
+	return isSphereVisible(point, 0);
+}
+
+//----------------------------------------------------------
+bool ofFrustum::isSphereVisible(const ofVec3f & center, float radius) const{
+	for(int i = 0; i < 6; i++){
+		if(!(getDistance(Plane(i), center) >= -radius)){
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofFrustum::isBoxVisible(const ofVec3f & min, const ofVec3f & max) const{
+	uint8_t visible;
+	return ofBoxesInsidePlanes(planes, 6, &min, &max, &visible, 1) == 1;
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisiblePoints(const ofVec3f * points, uint8_t * visible, size_t n) const{
+	return ofPointsInsidePlanes(planes, 6, points, visible, n);
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisiblePoints(const std::vector<ofVec3f> & points, std::vector<uint8_t> & visible) const{
+	visible.resize(points.size());
+	return getVisiblePoints(points.data(), visible.data(), points.size());
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisibleSpheres(const ofVec3f * centers, const float * radii, uint8_t * visible, size_t n) const{
+	return ofSpheresInsidePlanes(planes, 6, centers, radii, visible, n);
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisibleSpheres(const std::vector<ofVec3f> & centers, const std::vector<float> & radii, std::vector<uint8_t> & visible) const{
+	if(radii.size() != centers.size()){
+		ofLogError("ofFrustum") << "getVisibleSpheres(): " << centers.size() << " centers but " << radii.size() << " radii";
+		visible.assign(centers.size(), 0);
+		return 0;
+	}
+	visible.resize(centers.size());
+	return getVisibleSpheres(centers.data(), radii.data(), visible.data(), centers.size());
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisibleBoxes(const ofVec3f * min, const ofVec3f * max, uint8_t * visible, size_t n) const{
+	return ofBoxesInsidePlanes(planes, 6, min, max, visible, n);
+}
+
+//----------------------------------------------------------
+size_t ofFrustum::getVisibleBoxes(const std::vector<ofVec3f> & min, const std::vector<ofVec3f> & max, std::vector<uint8_t> & visible) const{
+	if(min.size() != max.size()){
+		ofLogError("ofFrustum") << "getVisibleBoxes(): " << min.size() << " min corners but " << max.size() << " max corners";
+		visible.assign(min.size(), 0);
+		return 0;
+	}
+	visible.resize(min.size());
+	return getVisibleBoxes(min.data(), max.data(), visible.data(), min.size());
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ofVectorMath.h"
+#include <vector>
+#include <cstdint>
+
+/// \brief The volume visible from a camera, stored as 6 planes.
+///
+/// The planes are extracted from a model view projection matrix, usually
+/// from ofCamera::getFrustum(), once per frame and then used to test which
+/// points, spheres or boxes are visible before drawing or labeling them:
+///
+/// ~~~~{.cpp}
+/// ofFrustum frustum = camera.getFrustum();
+/// vector<uint8_t> visible;
+/// frustum.getVisibleSpheres(centers, radii, visible);
+/// for(size_t i = 0; i < centers.size(); i++){
+/// 	if(visible[i]){
+/// 		ofDrawSphere(centers[i], radii[i]);
+/// 	}
+/// }
+/// ~~~~
+///
+/// The batch tests use the SIMD functions in ofBatchMath.h.
+class ofFrustum{
+public:
+	enum Plane{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+	};
+
+	/// \brief Construct a frustum that contains every point.
+	ofFrustum();
+
+	/// \brief Construct the frustum of a model view projection matrix.
+	ofFrustum(const ofMatrix4x4 & modelViewProjection);
+
+	/// \brief Extracts the planes of a model view projection matrix.
+	///
+	/// With the camera's matrix the planes are in world coordinates, with a
+	/// projection matrix alone they are in camera coordinates.
+	void set(const ofMatrix4x4 & modelViewProjection);
+
+	/// \brief Get one of the planes as (a, b, c, d) with a normalized normal
+	/// (a, b, c) pointing to the inside of the frustum.
+	const ofVec4f & getPlane(Plane plane) const;
+
+	/// \brief Get the 6 planes in the order of the Plane enum.
+	const ofVec4f * getPlanes() const;
+
+	/// \brief Get the signed distance from a point to a plane, positive
+	/// inside the frustum.
+	float getDistance(Plane plane, const ofVec3f & point) const;
+
+	/// \name Visibility tests
+	/// \{
+
+	bool isVisible(const ofVec3f & point) const;
+
+	/// \brief true if any part of the sphere is inside the frustum.
+	bool isSphereVisible(const ofVec3f & center, float radius) const;
+
+	/// \brief true if any part of the axis aligned box might be inside the
+	/// frustum.
+	///
+	/// Big boxes close to the corners of the frustum can be reported as
+	/// visible while being outside of it, which is fine for culling.
+	bool isBoxVisible(const ofVec3f & min, const ofVec3f & max) const;
+
+	/// \brief Tests an array of points at once.
+	///
+	/// \param visible Set to 1 for the visible points and 0 for the rest.
+	/// \returns The number of visible points.
+	size_t getVisiblePoints(const ofVec3f * points, uint8_t * visible, size_t n) const;
+	size_t getVisiblePoints(const std::vector<ofVec3f> & points, std::vector<uint8_t> & visible) const;
+
+	/// \brief Tests an array of spheres at once.
+	size_t getVisibleSpheres(const ofVec3f * centers, const float * radii, uint8_t * visible, size_t n) const;
+	size_t getVisibleSpheres(const std::vector<ofVec3f> & centers, const std::vector<float> & radii, std::vector<uint8_t> & visible) const;
+
+	/// \brief Tests an array of axis aligned boxes at once.
+	size_t getVisibleBoxes(const ofVec3f * min, const ofVec3f * max, uint8_t * visible, size_t n) const;
+	size_t getVisibleBoxes(const std::vector<ofVec3f> & min, const std::vector<ofVec3f> & max, std::vector<uint8_t> & visible) const;
+
+	/// \}
+
+private:
+	ofVec4f planes[6];
+};
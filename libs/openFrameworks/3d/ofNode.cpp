@@ -3,11 +3,14 @@
 #include "ofMath.h"
 #include "ofLog.h"
 #include "of3dGraphics.h"
+#include <algorithm>
 
 //----------------------------------------
 ofNode::ofNode()
 :parent(nullptr)
-,legacyCustomDrawOverrided(true){
+,legacyCustomDrawOverrided(true)
+,globalTransformDirty(true)
+,globalOrientationDirty(true){
 	setPosition(ofVec3f(0, 0, 0));
 	setOrientation(ofVec3f(0, 0, 0));
 	setScale(1);
@@ -21,6 +24,10 @@ ofNode::~ofNode(){
 	if(parent){
 		parent->removeListener(*this);
 	}
+	for(auto child: children){
+		child->parent = nullptr;
+		child->markGlobalTransformDirty();
+	}
 }
 
 //----------------------------------------
@@ -28,7 +35,9 @@ ofNode::ofNode(const ofNode & node)
 :parent(node.parent)
 ,axis(node.axis)
 ,localTransformMatrix(node.localTransformMatrix)
-,legacyCustomDrawOverrided(true){
+,legacyCustomDrawOverrided(true)
+,globalTransformDirty(true)
+,globalOrientationDirty(true){
 	if(parent){
 		parent->addListener(*this);
 	}
@@ -48,15 +57,27 @@ ofNode::ofNode(ofNode && node)
 ,scale(std::move(node.scale))
 ,axis(std::move(node.axis))
 ,localTransformMatrix(std::move(node.localTransformMatrix))
-,legacyCustomDrawOverrided(std::move(node.legacyCustomDrawOverrided)){
+,legacyCustomDrawOverrided(std::move(node.legacyCustomDrawOverrided))
+,children(std::move(node.children))
+,globalTransformDirty(true)
+,globalOrientationDirty(true){
 	if(parent){
 		parent->addListener(*this);
 	}
+	// the parameters and their listeners are shared with the moved node so
+	// its children are now children of this one
+	node.children.clear();
+	for(auto child: children){
+		child->parent = this;
+	}
 }
 
 //----------------------------------------
 ofNode & ofNode::operator=(const ofNode & node){
 	if(this == &node) return *this;
+	if(parent){
+		parent->removeListener(*this);
+	}
 	parent = node.parent;
 	position = node.position;
 	orientation = node.orientation;
@@ -70,22 +91,42 @@ ofNode & ofNode::operator=(const ofNode & node){
 	if(parent){
 		parent->addListener(*this);
 	}
+	markGlobalTransformDirty();
 	return *this;
 }
 
 //----------------------------------------
 ofNode & ofNode::operator=(ofNode && node){
 	if(this == &node) return *this;
+	if(parent){
+		parent->removeListener(*this);
+	}
+	// the children of this node lose their parent, as when it's destroyed
+	auto oldChildren = children;
+	for(auto child: oldChildren){
+		removeListener(*child);
+		child->parent = nullptr;
+		child->markGlobalTransformDirty();
+	}
 	parent = node.parent;
 	position = std::move(node.position);
 	orientation = std::move(node.orientation);
 	scale = std::move(node.scale);
 	axis = std::move(node.axis);
 	localTransformMatrix = std::move(node.localTransformMatrix);
-	legacyCustomDrawOverrided = std::move(legacyCustomDrawOverrided);
+	legacyCustomDrawOverrided = std::move(node.legacyCustomDrawOverrided);
 	if(parent){
 		parent->addListener(*this);
 	}
+	// the parameters and their listeners are shared with the moved node so
+	// its children are now children of this one, like in the move constructor
+	children = std::move(node.children);
+	node.children.clear();
+	for(auto child: children){
+		child->parent = this;
+		child->markGlobalTransformDirty();
+	}
+	markGlobalTransformDirty();
 	return *this;
 }
 
@@ -97,6 +138,9 @@ void ofNode::addListener(ofNode & node){
 	position.enableEvents();
 	orientation.enableEvents();
 	scale.enableEvents();
+	if(std::find(children.begin(), children.end(), &node) == children.end()){
+		children.push_back(&node);
+	}
 }
 
 //----------------------------------------
@@ -109,18 +153,48 @@ void ofNode::removeListener(ofNode & node){
 		scale.disableEvents();
 		orientation.disableEvents();
 	}
+	children.erase(std::remove(children.begin(), children.end(), &node), children.end());
+}
+
+//----------------------------------------
+void ofNode::markGlobalTransformDirty(){
+	// the children of a dirty node are always dirty too since computing
+	// their global transform computes the parent's first
+	if(globalTransformDirty){
+		return;
+	}
+	globalTransformDirty = true;
+	globalOrientationDirty = true;
+	for(auto child: children){
+		child->markGlobalTransformDirty();
+	}
+}
+
+//----------------------------------------
+void ofNode::updateGlobalTransform() const{
+	if(parent){
+		globalTransformMatrix = getLocalTransformMatrix() * parent->getGlobalTransformMatrix();
+	}else{
+		globalTransformMatrix = getLocalTransformMatrix();
+	}
+	globalTransformDirty = false;
 }
 
 //----------------------------------------
 void ofNode::setParent(ofNode& parent, bool bMaintainGlobalTransform) {
-    if(bMaintainGlobalTransform) {
-		ofMatrix4x4 postParentGlobalTransform = getGlobalTransformMatrix() * parent.getGlobalTransformMatrix().getInverse();
-		parent.addListener(*this);
-		setTransformMatrix(postParentGlobalTransform);
-	} else {
-		parent.addListener(*this);
+	ofMatrix4x4 postParentGlobalTransform;
+	if(bMaintainGlobalTransform) {
+		postParentGlobalTransform = getGlobalTransformMatrix() * parent.getGlobalTransformMatrix().getInverse();
+	}
+	if(this->parent){
+		this->parent->removeListener(*this);
 	}
+	parent.addListener(*this);
 	this->parent = &parent;
+	markGlobalTransformDirty();
+	if(bMaintainGlobalTransform) {
+		setTransformMatrix(postParentGlobalTransform);
+	}
 }
 
 //----------------------------------------
@@ -135,6 +209,7 @@ void ofNode::clearParent(bool bMaintainGlobalTransform) {
     } else {
         this->parent = nullptr;
     }
+	markGlobalTransformDirty();
 }
 
 //----------------------------------------
@@ -142,6 +217,32 @@ ofNode* ofNode::getParent() const {
 	return parent;
 }
 
+//----------------------------------------
+const std::vector<ofNode*> & ofNode::getChildren() const {
+	return children;
+}
+
+//----------------------------------------
+void ofNode::getDescendants(std::vector<ofNode*> & nodes) const {
+	// breadth first, every node is added after its parent
+	size_t first = nodes.size();
+	nodes.insert(nodes.end(), children.begin(), children.end());
+	for(size_t i = first; i < nodes.size(); i++){
+		nodes.insert(nodes.end(), nodes[i]->children.begin(), nodes[i]->children.end());
+	}
+}
+
+//----------------------------------------
+void ofNode::updateGlobalTransforms(const std::vector<ofNode*> & nodes) {
+	// parents come first so every update is a single multiplication by
+	// an already computed matrix
+	for(auto node: nodes){
+		if(node->globalTransformDirty){
+			node->updateGlobalTransform();
+		}
+	}
+}
+
 //----------------------------------------
 void ofNode::setTransformMatrix(const ofMatrix4x4 &m44) {
 	localTransformMatrix = m44;
@@ -155,6 +256,7 @@ void ofNode::setTransformMatrix(const ofMatrix4x4 &m44) {
 	this->orientation = orientation;
 	this->scale = scale;
 	updateAxis();
+	markGlobalTransformDirty();
 	
 	onPositionChanged();
 	onOrientationChanged();
@@ -170,6 +272,7 @@ void ofNode::setPosition(float px, float py, float pz) {
 void ofNode::setPosition(const ofVec3f& p) {
 	position = p;
 	localTransformMatrix.setTranslation(position);
+	markGlobalTransformDirty();
 	onPositionChanged();
 }
 
@@ -271,6 +374,7 @@ void ofNode::move(float x, float y, float z) {
 void ofNode::move(const ofVec3f& offset) {
 	position += offset;
 	localTransformMatrix.setTranslation(position);
+	markGlobalTransformDirty();
 	onPositionChanged();
 }
 
@@ -437,9 +541,11 @@ const ofMatrix4x4& ofNode::getLocalTransformMatrix() const {
 }
 
 //----------------------------------------
-ofMatrix4x4 ofNode::getGlobalTransformMatrix() const {
-	if(parent) return getLocalTransformMatrix() * parent->getGlobalTransformMatrix();
-	else return getLocalTransformMatrix();
+const ofMatrix4x4& ofNode::getGlobalTransformMatrix() const {
+	if(globalTransformDirty){
+		updateGlobalTransform();
+	}
+	return globalTransformMatrix;
 }
 
 //----------------------------------------
@@ -449,7 +555,11 @@ ofVec3f ofNode::getGlobalPosition() const {
 
 //----------------------------------------
 ofQuaternion ofNode::getGlobalOrientation() const {
-	return getGlobalTransformMatrix().getRotate();
+	if(globalTransformDirty || globalOrientationDirty){
+		globalOrientation = getGlobalTransformMatrix().getRotate();
+		globalOrientationDirty = false;
+	}
+	return globalOrientation;
 }
 
 //----------------------------------------
@@ -525,6 +635,7 @@ void ofNode::createMatrix() {
 	localTransformMatrix.setTranslation(position);
 	
 	updateAxis();
+	markGlobalTransformDirty();
 }
 
 
@@ -6,6 +6,7 @@
 #include "ofAppRunner.h"
 #include "ofParameter.h"
 #include <array>
+#include <vector>
 
 
 /// \brief A generic 3d object in space with transformation (position, rotation, scale).
@@ -38,7 +39,7 @@
 /// your node is upside down in relation to the rest of your OF world (really 
 /// an OpenGL context, but let's not get into that quite yet).
 
-// TODO: cache inverseMatrix, local and global
+// TODO: cache inverseMatrix
 class ofNode {
 public:
 	/// \cond INTERNAL
@@ -65,6 +66,30 @@ public:
 	/// \brief Get the parent node that this node is linked to
 	ofNode* getParent() const;
 
+	/// \brief Get the nodes that have this node as their parent
+	const std::vector<ofNode*> & getChildren() const;
+
+	/// \brief Appends all the nodes below this one in the hierarchy to
+	/// nodes, every node comes after its parent.
+	///
+	/// The result can be passed to updateGlobalTransforms().
+	void getDescendants(std::vector<ofNode*> & nodes) const;
+
+	/// \}
+	/// \name Global Transforms
+	/// \{
+
+	/// \brief Updates the cached global transformation matrix of every
+	/// node in nodes in a single pass.
+	///
+	/// Global matrices are cached and only recomputed when the node or one
+	/// of its parents moves, the first time they are queried. For big
+	/// hierarchies this computes all of them in one go instead, for example
+	/// before querying them from several threads. Every node has to come
+	/// after its parent in the list, if the parent is in it, as returned by
+	/// getDescendants().
+	static void updateGlobalTransforms(const std::vector<ofNode*> & nodes);
+
 	/// \}
 	/// \name Getters
 	/// \{
@@ -112,10 +137,12 @@ public:
 
 	const ofMatrix4x4& getLocalTransformMatrix() const;
 	
-	// TODO: optimize and cache these
-	// (parent would need to know about its children so it can inform them 
-	// to update their global matrices if it itself transforms)
-	ofMatrix4x4 getGlobalTransformMatrix() const;
+	/// \brief Get the transformation of the node combined with the ones of
+	/// all its parents.
+	///
+	/// The matrix is cached, it's only recomputed after the node or one of
+	/// its parents changes.
+	const ofMatrix4x4& getGlobalTransformMatrix() const;
 	ofVec3f getGlobalPosition() const;
 	ofQuaternion getGlobalOrientation() const;
 	ofVec3f getGlobalScale() const;
@@ -277,5 +304,12 @@ private:
 
 	void addListener(ofNode & node);
 	void removeListener(ofNode & node);
-//	ofMatrix4x4 globalTransformMatrix;
+	void markGlobalTransformDirty();
+	void updateGlobalTransform() const;
+
+	std::vector<ofNode*> children;
+	mutable ofMatrix4x4 globalTransformMatrix;
+	mutable ofQuaternion globalOrientation;
+	mutable bool globalTransformDirty;
+	mutable bool globalOrientationDirty;
 };
@@ -0,0 +1,560 @@
+#include "ofNodeHierarchy.h"
+#include "ofNode.h"
+#include "ofBufferObject.h"
+#include "ofLog.h"
+#include "ofWorkerThreads.h"
+#include <algorithm>
+
+static const uint32_t noNode = UINT32_MAX;
+
+//----------------------------------------------------------
+// runs f over contiguous ranges of [begin, end) in numThreads threads of
+// the worker pool, since update() calls this for every level every frame
+template<typename Function>
+static void parallelFor(size_t begin, size_t end, int numThreads, Function f){
+	// below this many nodes per thread handing them to the threads costs
+	// more than what they save
+	const size_t minNodesPerThread = 1024;
+	numThreads = of::priv::getNumWorkThreads(numThreads, (end - begin) / minNodesPerThread);
+	if(numThreads == 1){
+		f(begin, end);
+		return;
+	}
+	of::priv::runInWorkerThreads(numThreads, [&](int thread){
+		f(begin + (end - begin) * thread / numThreads, begin + (end - begin) * (thread + 1) / numThreads);
+	});
+}
+
+//----------------------------------------------------------
+template<typename T>
+static void permute(std::vector<T> & v, const std::vector<uint32_t> & order){
+	std::vector<T> permuted;
+	permuted.reserve(v.size());
+	for(auto i: order){
+		permuted.push_back(v[i]);
+	}
+	v.swap(permuted);
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node::Node()
+:hierarchy(nullptr){
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node::Node(ofNodeHierarchy & hierarchy, Handle handle)
+:hierarchy(&hierarchy)
+,handle(handle){
+}
+
+//----------------------------------------------------------
+bool ofNodeHierarchy::Node::isValid() const{
+	return hierarchy && hierarchy->isValid(handle);
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Handle ofNodeHierarchy::Node::getHandle() const{
+	return handle;
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy * ofNodeHierarchy::Node::getHierarchy() const{
+	return hierarchy;
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setParent(const Node & parent){
+	if(parent.hierarchy != hierarchy){
+		ofLogError("ofNodeHierarchy") << "setParent(): the parent belongs to another hierarchy";
+		return;
+	}
+	hierarchy->setParent(handle, parent.handle);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::clearParent(){
+	hierarchy->setParent(handle, Handle());
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node ofNodeHierarchy::Node::getParent() const{
+	return Node(*hierarchy, hierarchy->getParent(handle));
+}
+
+//----------------------------------------------------------
+ofVec3f ofNodeHierarchy::Node::getPosition() const{
+	return hierarchy->getPosition(handle);
+}
+
+//----------------------------------------------------------
+ofQuaternion ofNodeHierarchy::Node::getOrientationQuat() const{
+	return hierarchy->getOrientation(handle);
+}
+
+//----------------------------------------------------------
+ofVec3f ofNodeHierarchy::Node::getScale() const{
+	return hierarchy->getScale(handle);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setPosition(float px, float py, float pz){
+	setPosition(ofVec3f(px, py, pz));
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setPosition(const ofVec3f & p){
+	hierarchy->setPosition(handle, p);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setOrientation(const ofQuaternion & q){
+	hierarchy->setOrientation(handle, q);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setOrientation(const ofVec3f & eulerAngles){
+	setOrientation(ofQuaternion(eulerAngles.x, ofVec3f(1, 0, 0), eulerAngles.z, ofVec3f(0, 0, 1), eulerAngles.y, ofVec3f(0, 1, 0)));
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setScale(float s){
+	setScale(ofVec3f(s, s, s));
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setScale(float sx, float sy, float sz){
+	setScale(ofVec3f(sx, sy, sz));
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setScale(const ofVec3f & s){
+	hierarchy->setScale(handle, s);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::move(const ofVec3f & offset){
+	setPosition(getPosition() + offset);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::rotate(const ofQuaternion & q){
+	setOrientation(getOrientationQuat() * q);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::setTransform(const ofNode & node){
+	setPosition(node.getPosition());
+	setOrientation(node.getOrientationQuat());
+	setScale(node.getScale());
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::applyTransform(ofNode & node) const{
+	node.setPosition(getPosition());
+	node.setOrientation(getOrientationQuat());
+	node.setScale(getScale());
+}
+
+//----------------------------------------------------------
+const ofMatrix4x4 & ofNodeHierarchy::Node::getLocalTransformMatrix() const{
+	return hierarchy->getLocalTransformMatrix(handle);
+}
+
+//----------------------------------------------------------
+const ofMatrix4x4 & ofNodeHierarchy::Node::getGlobalTransformMatrix() const{
+	return hierarchy->getGlobalTransformMatrix(handle);
+}
+
+//----------------------------------------------------------
+ofVec3f ofNodeHierarchy::Node::getGlobalPosition() const{
+	return getGlobalTransformMatrix().getTranslation();
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::Node::remove(){
+	hierarchy->remove(handle);
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node ofNodeHierarchy::add(Handle parent){
+	uint32_t parentIndex = noNode;
+	uint32_t depth = 0;
+	if(parent != Handle()){
+		parentIndex = indexOf(parent);
+		if(parentIndex == noNode){
+			ofLogError("ofNodeHierarchy") << "add(): invalid parent, adding the node as a root";
+		}else{
+			depth = depths[parentIndex] + 1;
+		}
+	}
+
+	Handle handle;
+	if(freeSlots.empty()){
+		handle.id = slots.size();
+		slots.push_back({0, 0});
+	}else{
+		handle.id = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	uint32_t index = positions.size();
+	handle.generation = slots[handle.id].generation;
+	slots[handle.id].index = index;
+
+	// nodes are always added after their parent so the arrays stay
+	// sorted unless this one is shallower than the last one
+	if(sorted){
+		if(depth == levels.size()){
+			levels.push_back(index);
+		}else if(depth + 1 < levels.size()){
+			sorted = false;
+		}
+	}
+
+	positions.emplace_back(0, 0, 0);
+	orientations.emplace_back();
+	scales.emplace_back(1, 1, 1);
+	parents.push_back(parentIndex);
+	depths.push_back(depth);
+	ids.push_back(handle.id);
+	dirty.push_back(1);
+	localMatrices.emplace_back();
+	globalMatrices.emplace_back();
+	return Node(*this, handle);
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node ofNodeHierarchy::add(const Node & parent){
+	if(parent.getHierarchy() != this){
+		ofLogError("ofNodeHierarchy") << "add(): the parent belongs to another hierarchy, adding the node as a root";
+		return add();
+	}
+	return add(parent.getHandle());
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node ofNodeHierarchy::add(const ofNode & node, Handle parent){
+	auto added = add(parent);
+	added.setTransform(node);
+	return added;
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::remove(Handle node){
+	uint32_t index = indexOf(node);
+	if(index == noNode){
+		ofLogError("ofNodeHierarchy") << "remove(): invalid node";
+		return;
+	}
+	if(!sorted){
+		sortByDepth();
+		index = indexOf(node);
+	}
+
+	// parents come before their children so a single pass finds the whole
+	// subtree, the rest is compacted keeping the order
+	std::vector<uint32_t> newIndices(positions.size(), noNode);
+	std::vector<uint32_t> order;
+	order.reserve(positions.size());
+	for(uint32_t i = 0; i < positions.size(); i++){
+		bool removed = i == index || (parents[i] != noNode && newIndices[parents[i]] == noNode);
+		if(removed){
+			auto & slot = slots[ids[i]];
+			slot.index = noNode;
+			slot.generation++;
+			freeSlots.push_back(ids[i]);
+		}else{
+			newIndices[i] = order.size();
+			order.push_back(i);
+		}
+	}
+	permute(positions, order);
+	permute(orientations, order);
+	permute(scales, order);
+	permute(parents, order);
+	permute(depths, order);
+	permute(ids, order);
+	permute(dirty, order);
+	permute(localMatrices, order);
+	permute(globalMatrices, order);
+	for(uint32_t i = 0; i < positions.size(); i++){
+		if(parents[i] != noNode){
+			parents[i] = newIndices[parents[i]];
+		}
+		slots[ids[i]].index = i;
+	}
+
+	levels.clear();
+	for(uint32_t i = 0; i < depths.size(); i++){
+		if(depths[i] == levels.size()){
+			levels.push_back(i);
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::clear(){
+	for(auto id: ids){
+		slots[id].index = noNode;
+		slots[id].generation++;
+		freeSlots.push_back(id);
+	}
+	positions.clear();
+	orientations.clear();
+	scales.clear();
+	parents.clear();
+	depths.clear();
+	ids.clear();
+	dirty.clear();
+	localMatrices.clear();
+	globalMatrices.clear();
+	levels.clear();
+	sorted = true;
+}
+
+//----------------------------------------------------------
+size_t ofNodeHierarchy::size() const{
+	return positions.size();
+}
+
+//----------------------------------------------------------
+uint32_t ofNodeHierarchy::indexOf(Handle node) const{
+	if(node.id >= slots.size() || slots[node.id].generation != node.generation){
+		return noNode;
+	}
+	return slots[node.id].index;
+}
+
+//----------------------------------------------------------
+bool ofNodeHierarchy::isValid(Handle node) const{
+	return indexOf(node) != noNode;
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Node ofNodeHierarchy::get(Handle node){
+	return Node(*this, node);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::setParent(Handle node, Handle parent){
+	uint32_t index = indexOf(node);
+	if(index == noNode){
+		ofLogError("ofNodeHierarchy") << "setParent(): invalid node";
+		return;
+	}
+	uint32_t parentIndex = noNode;
+	if(parent != Handle()){
+		parentIndex = indexOf(parent);
+		if(parentIndex == noNode){
+			ofLogError("ofNodeHierarchy") << "setParent(): invalid parent";
+			return;
+		}
+		for(uint32_t i = parentIndex; i != noNode; i = parents[i]){
+			if(i == index){
+				ofLogError("ofNodeHierarchy") << "setParent(): a node can't be the child of one of its descendants";
+				return;
+			}
+		}
+	}
+	if(parents[index] == parentIndex){
+		return;
+	}
+	parents[index] = parentIndex;
+	dirty[index] = 1;
+	// the depths of the whole subtree change, they are recomputed when
+	// sorting in the next update
+	sorted = false;
+}
+
+//----------------------------------------------------------
+ofNodeHierarchy::Handle ofNodeHierarchy::getParent(Handle node) const{
+	uint32_t index = indexOf(node);
+	if(index == noNode || parents[index] == noNode){
+		return Handle();
+	}
+	return {ids[parents[index]], slots[ids[parents[index]]].generation};
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::setPosition(Handle node, const ofVec3f & position){
+	uint32_t index = indexOf(node);
+	if(index != noNode){
+		positions[index] = position;
+		dirty[index] = 1;
+	}
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::setOrientation(Handle node, const ofQuaternion & orientation){
+	uint32_t index = indexOf(node);
+	if(index != noNode){
+		orientations[index] = orientation;
+		dirty[index] = 1;
+	}
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::setScale(Handle node, const ofVec3f & scale){
+	uint32_t index = indexOf(node);
+	if(index != noNode){
+		scales[index] = scale;
+		dirty[index] = 1;
+	}
+}
+
+//----------------------------------------------------------
+const ofVec3f & ofNodeHierarchy::getPosition(Handle node) const{
+	return positions[indexOf(node)];
+}
+
+//----------------------------------------------------------
+const ofQuaternion & ofNodeHierarchy::getOrientation(Handle node) const{
+	return orientations[indexOf(node)];
+}
+
+//----------------------------------------------------------
+const ofVec3f & ofNodeHierarchy::getScale(Handle node) const{
+	return scales[indexOf(node)];
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::sortByDepth(){
+	// after reparenting the arrays might not be in topological order so
+	// the depths are computed walking up to the first known one
+	const uint32_t unknown = UINT32_MAX;
+	std::fill(depths.begin(), depths.end(), unknown);
+	std::vector<uint32_t> path;
+	for(uint32_t i = 0; i < positions.size(); i++){
+		uint32_t j = i;
+		while(j != noNode && depths[j] == unknown){
+			path.push_back(j);
+			j = parents[j];
+		}
+		uint32_t depth = j == noNode ? 0 : depths[j] + 1;
+		for(auto it = path.rbegin(); it != path.rend(); ++it){
+			depths[*it] = depth++;
+		}
+		path.clear();
+	}
+
+	// stable counting sort by depth
+	uint32_t maxDepth = 0;
+	for(auto depth: depths){
+		maxDepth = std::max(maxDepth, depth);
+	}
+	levels.assign(positions.empty() ? 0 : maxDepth + 1, 0);
+	std::vector<size_t> counts(levels.size(), 0);
+	for(auto depth: depths){
+		counts[depth]++;
+	}
+	for(size_t d = 1; d < levels.size(); d++){
+		levels[d] = levels[d - 1] + counts[d - 1];
+	}
+	std::vector<uint32_t> order(positions.size());
+	std::vector<uint32_t> newIndices(positions.size());
+	std::vector<size_t> next = levels;
+	for(uint32_t i = 0; i < positions.size(); i++){
+		newIndices[i] = next[depths[i]]++;
+		order[newIndices[i]] = i;
+	}
+
+	permute(positions, order);
+	permute(orientations, order);
+	permute(scales, order);
+	permute(parents, order);
+	permute(depths, order);
+	permute(ids, order);
+	permute(dirty, order);
+	permute(localMatrices, order);
+	permute(globalMatrices, order);
+	for(uint32_t i = 0; i < positions.size(); i++){
+		if(parents[i] != noNode){
+			parents[i] = newIndices[parents[i]];
+		}
+		slots[ids[i]].index = i;
+	}
+	sorted = true;
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::update(int numThreads){
+	if(!sorted){
+		sortByDepth();
+	}
+
+	// every level only depends on the previous ones, a node is updated if
+	// it or any of its parents changed
+	auto updateRange = [this](size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			uint32_t parent = parents[i];
+			if(parent != noNode && dirty[parent]){
+				dirty[i] = 1;
+			}
+			if(dirty[i]){
+				ofMatrix4x4 & local = localMatrices[i];
+				local.makeScaleMatrix(scales[i]);
+				local.rotate(orientations[i]);
+				local.setTranslation(positions[i]);
+				if(parent == noNode){
+					globalMatrices[i] = local;
+				}else{
+					globalMatrices[i].makeFromMultiplicationOf(local, globalMatrices[parent]);
+				}
+			}
+		}
+	};
+	for(size_t d = 0; d < levels.size(); d++){
+		size_t end = d + 1 < levels.size() ? levels[d + 1] : positions.size();
+		parallelFor(levels[d], end, numThreads, updateRange);
+	}
+	std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+//----------------------------------------------------------
+const ofMatrix4x4 & ofNodeHierarchy::getLocalTransformMatrix(Handle node) const{
+	return localMatrices[indexOf(node)];
+}
+
+//----------------------------------------------------------
+const ofMatrix4x4 & ofNodeHierarchy::getGlobalTransformMatrix(Handle node) const{
+	return globalMatrices[indexOf(node)];
+}
+
+//----------------------------------------------------------
+const std::vector<ofMatrix4x4> & ofNodeHierarchy::getGlobalTransformMatrices() const{
+	return globalMatrices;
+}
+
+//----------------------------------------------------------
+size_t ofNodeHierarchy::getIndex(Handle node) const{
+	return indexOf(node);
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::getGlobalTransformMatrices(const std::vector<Handle> & nodes, ofMatrix4x4 * dst) const{
+	for(size_t i = 0; i < nodes.size(); i++){
+		uint32_t index = indexOf(nodes[i]);
+		dst[i] = index == noNode ? ofMatrix4x4() : globalMatrices[index];
+	}
+}
+
+//----------------------------------------------------------
+static void uploadMatrices(ofBufferObject & buffer, const ofMatrix4x4 * matrices, size_t numMatrices){
+	GLsizeiptr bytes = numMatrices * sizeof(ofMatrix4x4);
+	if(!buffer.isAllocated() || buffer.size() < bytes){
+		buffer.allocate(bytes, matrices, GL_STREAM_DRAW);
+	}else{
+		buffer.updateData(0, bytes, matrices);
+	}
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::updateInstanceBuffer(ofBufferObject & buffer) const{
+	uploadMatrices(buffer, globalMatrices.data(), globalMatrices.size());
+}
+
+//----------------------------------------------------------
+void ofNodeHierarchy::updateInstanceBuffer(ofBufferObject & buffer, const std::vector<Handle> & nodes) const{
+	std::vector<ofMatrix4x4> matrices(nodes.size());
+	getGlobalTransformMatrices(nodes, matrices.data());
+	uploadMatrices(buffer, matrices.data(), matrices.size());
+}
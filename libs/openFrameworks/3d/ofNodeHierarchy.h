@@ -0,0 +1,224 @@
+#pragma once
+
+#include "ofVectorMath.h"
+#include <vector>
+#include <cstdint>
+
+class ofNode;
+class ofBufferObject;
+
+/// \brief A container for big hierarchies of transforms, like the instances
+/// of a mesh drawn with ofVboMesh::drawInstanced.
+///
+/// ofNode stores every transform in its own object and notifies its
+/// children when it moves, which is convenient for a few nodes but slow for
+/// tens of thousands of them. ofNodeHierarchy stores the position,
+/// orientation and scale of all its nodes in contiguous arrays, sorted so
+/// every node comes after its parent, and computes all the global matrices
+/// in one linear pass in update().
+///
+/// Nodes are referenced by handles which stay valid while other nodes are
+/// added or removed. Node is a lightweight proxy with an API similar to
+/// ofNode's that wraps a handle and the hierarchy it belongs to:
+///
+/// ~~~~{.cpp}
+/// ofNodeHierarchy hierarchy;
+/// auto root = hierarchy.add();
+/// for(int i = 0; i < 10000; i++){
+/// 	auto node = hierarchy.add(root);
+/// 	node.setPosition(ofRandom(-100, 100), 0, ofRandom(-100, 100));
+/// }
+///
+/// // every frame
+/// root.rotate(ofQuaternion(1, ofVec3f(0, 1, 0)));
+/// hierarchy.update();
+/// hierarchy.updateInstanceBuffer(matricesBuffer);
+/// ~~~~
+class ofNodeHierarchy{
+public:
+	/// \brief Stable reference to a node in a hierarchy.
+	///
+	/// A default constructed handle doesn't reference any node, it's used
+	/// as the parent of root nodes.
+	struct Handle{
+		Handle()
+		:id(UINT32_MAX)
+		,generation(0){}
+
+		Handle(uint32_t id, uint32_t generation)
+		:id(id)
+		,generation(generation){}
+
+		uint32_t id;
+		uint32_t generation;
+
+		bool operator==(const Handle & handle) const{
+			return id == handle.id && generation == handle.generation;
+		}
+		bool operator!=(const Handle & handle) const{
+			return !(*this == handle);
+		}
+	};
+
+	/// \brief Proxy to a node in a hierarchy with the same API as ofNode.
+	///
+	/// Proxies are just a handle and a pointer to the hierarchy so they can
+	/// be copied and stored freely.
+	class Node{
+	public:
+		Node();
+		Node(ofNodeHierarchy & hierarchy, Handle handle);
+
+		/// \brief true if the node hasn't been removed from its hierarchy
+		bool isValid() const;
+		Handle getHandle() const;
+		ofNodeHierarchy * getHierarchy() const;
+
+		void setParent(const Node & parent);
+		void clearParent();
+		Node getParent() const;
+
+		ofVec3f getPosition() const;
+		ofQuaternion getOrientationQuat() const;
+		ofVec3f getScale() const;
+
+		void setPosition(float px, float py, float pz);
+		void setPosition(const ofVec3f & p);
+		void setOrientation(const ofQuaternion & q);
+		void setOrientation(const ofVec3f & eulerAngles);
+		void setScale(float s);
+		void setScale(float sx, float sy, float sz);
+		void setScale(const ofVec3f & s);
+		void move(const ofVec3f & offset);
+		void rotate(const ofQuaternion & q);
+
+		/// \brief Copies the position, orientation and scale of node.
+		void setTransform(const ofNode & node);
+
+		/// \brief Copies the position, orientation and scale to node.
+		void applyTransform(ofNode & node) const;
+
+		/// \brief Get the local matrix, as computed in the last update().
+		const ofMatrix4x4 & getLocalTransformMatrix() const;
+
+		/// \brief Get the global matrix, as computed in the last update().
+		const ofMatrix4x4 & getGlobalTransformMatrix() const;
+		ofVec3f getGlobalPosition() const;
+
+		/// \brief Removes the node and all its descendants from the
+		/// hierarchy.
+		void remove();
+
+	private:
+		ofNodeHierarchy * hierarchy;
+		Handle handle;
+	};
+
+	/// \brief Adds a node with no transformation as a child of parent or as
+	/// a root if parent is the default handle.
+	Node add(Handle parent = Handle());
+	Node add(const Node & parent);
+
+	/// \brief Adds a node with the local transform of node.
+	Node add(const ofNode & node, Handle parent = Handle());
+
+	/// \brief Removes a node and all its descendants.
+	///
+	/// This compacts the arrays so it's linear in the number of nodes.
+	void remove(Handle node);
+
+	/// \brief Removes every node, invalidating all the handles.
+	void clear();
+
+	/// \brief Get the number of nodes in the hierarchy.
+	size_t size() const;
+
+	/// \brief true if the handle references a node in this hierarchy.
+	bool isValid(Handle node) const;
+
+	/// \brief Get a proxy for a node.
+	Node get(Handle node);
+
+	/// \brief Changes the parent of a node, a default handle makes it a
+	/// root.
+	///
+	/// Making a node the child of one of its descendants fails with an
+	/// error.
+	void setParent(Handle node, Handle parent);
+	Handle getParent(Handle node) const;
+
+	void setPosition(Handle node, const ofVec3f & position);
+	void setOrientation(Handle node, const ofQuaternion & orientation);
+	void setScale(Handle node, const ofVec3f & scale);
+	const ofVec3f & getPosition(Handle node) const;
+	const ofQuaternion & getOrientation(Handle node) const;
+	const ofVec3f & getScale(Handle node) const;
+
+	/// \brief Recomputes the local and global matrices of the nodes that
+	/// changed since the last update and of their descendants.
+	///
+	/// Nodes are processed one depth level at a time, the nodes in every
+	/// level are split among the threads. The threads are started the
+	/// first time and reused by the following updates.
+	///
+	/// \param numThreads Number of threads to use, 0 uses one per core.
+	void update(int numThreads = 1);
+
+	const ofMatrix4x4 & getLocalTransformMatrix(Handle node) const;
+	const ofMatrix4x4 & getGlobalTransformMatrix(Handle node) const;
+
+	/// \brief Get the global matrices of all the nodes, sorted so every
+	/// node comes after its parent.
+	///
+	/// getIndex() returns the position of a node in this array, which can
+	/// change when nodes are added, removed or reparented.
+	const std::vector<ofMatrix4x4> & getGlobalTransformMatrices() const;
+
+	/// \brief Get the position of a node in getGlobalTransformMatrices()
+	/// after the last update().
+	size_t getIndex(Handle node) const;
+
+	/// \brief Copies the global matrices of some nodes to dst in the same
+	/// order, for example the instances of one of several meshes.
+	void getGlobalTransformMatrices(const std::vector<Handle> & nodes, ofMatrix4x4 * dst) const;
+
+	/// \brief Uploads all the global matrices to a buffer, allocating it if
+	/// it's too small, so they can be read from a shader as a buffer
+	/// texture while drawing with ofVboMesh::drawInstanced.
+	///
+	/// Instance i uses the matrix of the node with getIndex() == i.
+	void updateInstanceBuffer(ofBufferObject & buffer) const;
+
+	/// \brief Uploads the global matrices of some nodes to a buffer in the
+	/// order of the handles.
+	void updateInstanceBuffer(ofBufferObject & buffer, const std::vector<Handle> & nodes) const;
+
+private:
+	struct Slot{
+		uint32_t index;
+		uint32_t generation;
+	};
+
+	uint32_t indexOf(Handle node) const;
+	void sortByDepth();
+
+	// handles index slots which hold the current position of the node in
+	// the arrays below
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+
+	// one element per node, sorted by depth after update()
+	std::vector<ofVec3f> positions;
+	std::vector<ofQuaternion> orientations;
+	std::vector<ofVec3f> scales;
+	std::vector<uint32_t> parents;
+	std::vector<uint32_t> depths;
+	std::vector<uint32_t> ids;
+	std::vector<uint8_t> dirty;
+	std::vector<ofMatrix4x4> localMatrices;
+	std::vector<ofMatrix4x4> globalMatrices;
+
+	// first node of every depth level
+	std::vector<size_t> levels;
+	bool sorted = true;
+};
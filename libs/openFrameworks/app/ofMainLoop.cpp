@@ -8,6 +8,7 @@
 #include <ofMainLoop.h>
 #include "ofWindowSettings.h"
 #include "ofConstants.h"
+#include "ofFrameProfiler.h"
 
 //========================================================================
 // default windowing
@@ -143,6 +144,7 @@ void ofMainLoop::loopOnce(){
 		}
 	}
 	if(pollEvents){
+		ofProfileScope scope("events", "phase");
 		pollEvents();
 	}
 }
@@ -1,4 +1,5 @@
 #include "ofEvents.h"
+#include "ofFrameProfiler.h"
 
 
 static ofEventArgs voidEventArgs;
@@ -190,20 +191,26 @@ int ofCoreEvents::getPreviousMouseY() const{
 
 //------------------------------------------
 void ofCoreEvents::notifySetup(){
+	ofProfileScope scope("setup", "phase");
 	ofNotifyEvent( setup, voidEventArgs );
 }
 
 #include "ofGraphics.h"
 //------------------------------------------
 void ofCoreEvents::notifyUpdate(){
+	ofProfileScope scope("update", "phase");
 	ofNotifyEvent( update, voidEventArgs );
 }
 
 //------------------------------------------
 void ofCoreEvents::notifyDraw(){
-	ofNotifyEvent( draw, voidEventArgs );
+	{
+		ofProfileScope scope("draw", "phase");
+		ofNotifyEvent( draw, voidEventArgs );
+	}
 
 	if (bFrameRateSet){
+		ofProfileScope scope("wait", "phase");
 		timer.waitNext();
 	}
 	
@@ -218,7 +225,11 @@ void ofCoreEvents::notifyDraw(){
 		}*/
 	}
 	fps.newFrame();
-	
+
+	// the first frame counts from the creation of the counter
+	if(fps.getNumFrames()>1){
+		ofGetFrameProfiler().newFrame(fps.getLastFrameNanos());
+	}
 }
 
 //------------------------------------------
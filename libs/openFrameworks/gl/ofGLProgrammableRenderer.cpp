@@ -42,6 +42,7 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 {
 	programmableRendererCreated = true;
 	bBackgroundAuto = true;
+	bBatching = false;
 
 	lineMesh.getVertices().resize(2);
 	lineMesh.setMode(OF_PRIMITIVE_LINES);
@@ -100,6 +101,7 @@ void ofGLProgrammableRenderer::startRender() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::finishRender() {
+	flushBatch();
 	if (!uniqueShader) {
 		glUseProgram(0);
 		if(!usingCustomShader) currentShader = nullptr;
@@ -110,6 +112,7 @@ void ofGLProgrammableRenderer::finishRender() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
+	flushBatch();
 	if (vertexData.getVertices().empty()) return;
 	
 	
@@ -226,6 +229,7 @@ void ofGLProgrammableRenderer::draw(const ofVboMesh & mesh, ofPolyRenderMode ren
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVboMesh & mesh, ofPolyRenderMode renderType, int primCount) const{
+	flushBatch();
 	if(mesh.getNumVertices()==0) return;
 	GLuint mode = ofGetGLPrimitiveMode(mesh.getMode());
 #ifndef TARGET_OPENGLES
@@ -292,6 +296,7 @@ void ofGLProgrammableRenderer::draw(const ofNode& node) const{
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const{
+	flushBatch();
 	if(poly.getVertices().empty()) return;
 
 	// use smoothness, if requested:
@@ -320,6 +325,7 @@ void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const{
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofPath & shape) const{
+	flushBatch();
 	ofColor prevColor;
 	if(shape.getUseShapeColor()){
 		prevColor = currentStyle.color;
@@ -350,6 +356,7 @@ void ofGLProgrammableRenderer::draw(const ofPath & shape) const{
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	flushBatch();
 	if(image.isUsingTexture()){
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,false,true,false);
 		const ofTexture& tex = image.getTexture();
@@ -365,6 +372,7 @@ void ofGLProgrammableRenderer::draw(const ofImage & image, float x, float y, flo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	flushBatch();
 	if(image.isUsingTexture()){
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,false,true,false);
 		const ofTexture& tex = image.getTexture();
@@ -380,6 +388,7 @@ void ofGLProgrammableRenderer::draw(const ofFloatImage & image, float x, float y
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	flushBatch();
 	if(image.isUsingTexture()){
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,false,true,false);
 		const ofTexture& tex = image.getTexture();
@@ -395,6 +404,7 @@ void ofGLProgrammableRenderer::draw(const ofShortImage & image, float x, float y
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofTexture & tex, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	flushBatch();
 	const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,false,true,false);
 	if(tex.isAllocated()) {
 		const_cast<ofGLProgrammableRenderer*>(this)->bind(tex,0);
@@ -407,6 +417,7 @@ void ofGLProgrammableRenderer::draw(const ofTexture & tex, float x, float y, flo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const{
+	flushBatch();
 	if(!video.isInitialized() || !video.isUsingTexture() || video.getTexturePlanes().empty()){
 		return;
 	}
@@ -417,6 +428,7 @@ void ofGLProgrammableRenderer::draw(const ofBaseVideoDraws & video, float x, flo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int first, int total) const{
+	flushBatch();
 	if(vbo.getUsingVerts()) {
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
@@ -427,6 +439,7 @@ void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int firs
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode, int amt, int offsetelements) const{
+	flushBatch();
 	if(vbo.getUsingVerts()) {
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
@@ -441,6 +454,7 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode, int first, int total, int primCount) const{
+	flushBatch();
 	if(vbo.getUsingVerts()) {
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
@@ -459,6 +473,7 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint drawMode, int amt, int primCount) const{
+	flushBatch();
 	if(vbo.getUsingVerts()) {
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
@@ -482,6 +497,7 @@ ofPath & ofGLProgrammableRenderer::getPath(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseVideoDraws & video){
+	flushBatch();
 	if(!video.isInitialized() || !video.isUsingTexture() || video.getTexturePlanes().empty()){
 		return;
 	}
@@ -502,6 +518,7 @@ void ofGLProgrammableRenderer::bind(const ofBaseVideoDraws & video){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofBaseVideoDraws & video){
+	flushBatch();
 	if(!video.isInitialized() || !video.isUsingTexture() || video.getTexturePlanes().empty()){
 		return;
 	}
@@ -515,11 +532,13 @@ void ofGLProgrammableRenderer::unbind(const ofBaseVideoDraws & video){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::pushView() {
+	flushBatch();
 	matrixStack.pushView();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::popView() {
+	flushBatch();
 	matrixStack.popView();
 	uploadMatrices();
 	viewport(matrixStack.getCurrentViewport());
@@ -532,6 +551,7 @@ void ofGLProgrammableRenderer::viewport(ofRectangle viewport_){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::viewport(float x, float y, float width, float height, bool vflip) {
+	flushBatch();
 	matrixStack.viewport(x,y,width,height,vflip);
 	ofRectangle nativeViewport = matrixStack.getNativeViewport();
 	glViewport(nativeViewport.x,nativeViewport.y,nativeViewport.width,nativeViewport.height);
@@ -574,6 +594,7 @@ ofHandednessType ofGLProgrammableRenderer::getCoordHandedness() const{
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setOrientation(ofOrientation orientation, bool vFlip){
+	flushBatch();
 	matrixStack.setOrientation(orientation,vFlip);
 	uploadMatrices();
 
@@ -581,6 +602,7 @@ void ofGLProgrammableRenderer::setOrientation(ofOrientation orientation, bool vF
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setupScreenPerspective(float width, float height, float fov, float nearDist, float farDist) {
+	flushBatch();
 	float viewW, viewH;
 	if(width<0 || height<0){
 		ofRectangle currentViewport = getCurrentViewport();
@@ -617,6 +639,7 @@ void ofGLProgrammableRenderer::setupScreenPerspective(float width, float height,
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setupScreenOrtho(float width, float height, float nearDist, float farDist) {
+	flushBatch();
 	float viewW, viewH;
 	if(width<0 || height<0){
 		ofRectangle currentViewport = getCurrentViewport();
@@ -678,6 +701,7 @@ void ofGLProgrammableRenderer::pushMatrix(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::popMatrix(){
+	flushBatchIfNotModelView();
 	matrixStack.popMatrix();
 	uploadCurrentMatrix();
 }
@@ -689,18 +713,21 @@ void ofGLProgrammableRenderer::translate(const ofVec3f& p){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::translate(float x, float y, float z){
+	flushBatchIfNotModelView();
 	matrixStack.translate(x,y,z);
 	uploadCurrentMatrix();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::scale(float xAmnt, float yAmnt, float zAmnt){
+	flushBatchIfNotModelView();
 	matrixStack.scale(xAmnt, yAmnt, zAmnt);
 	uploadCurrentMatrix();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::rotate(float degrees, float vecX, float vecY, float vecZ){
+	flushBatchIfNotModelView();
 	matrixStack.rotate(degrees, vecX, vecY, vecZ);
 	uploadCurrentMatrix();
 }
@@ -733,6 +760,7 @@ void ofGLProgrammableRenderer::matrixMode(ofMatrixMode mode){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::loadIdentityMatrix (void){
+	flushBatchIfNotModelView();
 	matrixStack.loadIdentityMatrix();
 	uploadCurrentMatrix();
 }
@@ -744,6 +772,7 @@ void ofGLProgrammableRenderer::loadMatrix (const ofMatrix4x4 & m){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::loadMatrix (const float *m){
+	flushBatchIfNotModelView();
 	matrixStack.loadMatrix(m);
 	uploadCurrentMatrix();
 }
@@ -755,6 +784,7 @@ void ofGLProgrammableRenderer::multMatrix (const ofMatrix4x4 & m){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::multMatrix (const float *m){
+	flushBatchIfNotModelView();
 	matrixStack.multMatrix(m);
 	uploadCurrentMatrix();
 }
@@ -847,6 +877,7 @@ void ofGLProgrammableRenderer::setColor(int _r, int _g, int _b){
 void ofGLProgrammableRenderer::setColor(int _r, int _g, int _b, int _a){
 	ofColor newColor(_r,_g,_b,_a);
 	if(newColor!=currentStyle.color){
+		flushBatch();
         currentStyle.color = newColor;
 		if(currentShader){
 			currentShader->setUniform4f(COLOR_UNIFORM,_r/255.,_g/255.,_b/255.,_a/255.);
@@ -874,11 +905,13 @@ void ofGLProgrammableRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(){
+	flushBatch();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(float r, float g, float b, float a) {
+	flushBatch();
 	glClearColor(r / 255., g / 255., b / 255., a / 255.);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -890,6 +923,7 @@ void ofGLProgrammableRenderer::clear(float brightness, float a) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clearAlpha() {
+	flushBatch();
 	glColorMask(0, 0, 0, 1);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -919,6 +953,7 @@ void ofGLProgrammableRenderer::setBackgroundColor(const ofColor & c){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::background(const ofColor & c){
+	flushBatch();
 	setBackgroundColor(c);
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 }
@@ -985,6 +1020,9 @@ void ofGLProgrammableRenderer::setLineWidth(float lineWidth){
 	// INVALID_VALUE error".
 	// use geometry shaders to draw lines of varying thickness...
 
+	if(lineWidth!=currentStyle.lineWidth){
+		flushBatch();
+	}
 	currentStyle.lineWidth = lineWidth;
 	if(!currentStyle.bFill){
 		path.setStrokeWidth(lineWidth);
@@ -994,6 +1032,7 @@ void ofGLProgrammableRenderer::setLineWidth(float lineWidth){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setDepthTest(bool depthTest) {
+	flushBatch();
 	if(depthTest) {
 		glEnable(GL_DEPTH_TEST);
 	} else {
@@ -1018,6 +1057,9 @@ void ofGLProgrammableRenderer::endSmoothing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setBlendMode(ofBlendMode blendMode){
+	if(blendMode!=currentStyle.blendingMode){
+		flushBatch();
+	}
 	switch (blendMode){
 		case OF_BLENDMODE_DISABLED:
 			glDisable(GL_BLEND);
@@ -1061,6 +1103,7 @@ void ofGLProgrammableRenderer::setBlendMode(ofBlendMode blendMode){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enablePointSprites(){
+	flushBatch();
 #ifdef TARGET_OPENGLES
 	#ifndef TARGET_PROGRAMMABLE_GL
 		glEnable(GL_POINT_SPRITE_OES);
@@ -1072,6 +1115,7 @@ void ofGLProgrammableRenderer::enablePointSprites(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disablePointSprites(){
+	flushBatch();
 #ifdef TARGET_OPENGLES
 	#ifndef TARGET_PROGRAMMABLE_GL
 		glEnable(GL_POINT_SPRITE_OES);
@@ -1084,6 +1128,7 @@ void ofGLProgrammableRenderer::disablePointSprites(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableAntiAliasing(){
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glEnable(GL_MULTISAMPLE);
 #endif
@@ -1091,6 +1136,7 @@ void ofGLProgrammableRenderer::enableAntiAliasing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableAntiAliasing(){
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glDisable(GL_MULTISAMPLE);
 #endif
@@ -1205,6 +1251,7 @@ void ofGLProgrammableRenderer::setAttributes(bool vertices, bool color, bool tex
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableTextureTarget(const ofTexture & tex, int textureLocation){
+	flushBatch();
 	bool wasUsingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	currentTextureTarget = tex.texData.textureTarget;
 
@@ -1224,6 +1271,7 @@ void ofGLProgrammableRenderer::enableTextureTarget(const ofTexture & tex, int te
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableTextureTarget(int textureTarget, int textureLocation){
+	flushBatch();
 	bool wasUsingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	currentTextureTarget = OF_NO_TEXTURE;
 
@@ -1247,6 +1295,7 @@ GLenum ofGLProgrammableRenderer::getCurrentTextureTarget(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setAlphaMaskTex(const ofTexture & tex){
+	flushBatch();
 	alphaMaskTextureTarget = tex.getTextureData().textureTarget;
 	if(alphaMaskTextureTarget==GL_TEXTURE_2D){
 		alphaMask2DShader.begin();
@@ -1258,6 +1307,7 @@ void ofGLProgrammableRenderer::setAlphaMaskTex(const ofTexture & tex){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableAlphaMask(){
+	flushBatch();
 	disableTextureTarget(alphaMaskTextureTarget,1);
 	if(alphaMaskTextureTarget==GL_TEXTURE_2D){
 		alphaMask2DShader.end();
@@ -1268,6 +1318,7 @@ void ofGLProgrammableRenderer::disableAlphaMask(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofShader & shader){
+	flushBatch();
     if(currentShader && *currentShader==shader){
 		return;
     }
@@ -1283,6 +1334,7 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShader & shader){
+	flushBatch();
 	glUseProgram(0);
 	usingCustomShader = false;
 	beginDefaultShader();
@@ -1291,6 +1343,7 @@ void ofGLProgrammableRenderer::unbind(const ofShader & shader){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::begin(const ofFbo & fbo, bool setupPerspective){
+	flushBatch();
 	pushView();
 	pushStyle();
 	matrixStack.setRenderSurface(fbo);
@@ -1305,6 +1358,7 @@ void ofGLProgrammableRenderer::begin(const ofFbo & fbo, bool setupPerspective){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::end(const ofFbo & fbo){
+	flushBatch();
 	unbind(fbo);
 	matrixStack.setRenderSurface(*window);
 	uploadMatrices();
@@ -1314,6 +1368,7 @@ void ofGLProgrammableRenderer::end(const ofFbo & fbo){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofFbo & fbo){
+	flushBatch();
 	if (currentFramebufferId == fbo.getId()){
 		ofLogWarning() << "Framebuffer with id: " << fbo.getId() << " cannot be bound onto itself. \n" <<
 			"Most probably you forgot to end() the current framebuffer before calling begin() again or you forgot to allocate() before calling begin().";
@@ -1332,6 +1387,7 @@ void ofGLProgrammableRenderer::bind(const ofFbo & fbo){
 #ifndef TARGET_OPENGLES
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fboDst, int attachmentPoint){
+	flushBatch();
 	if (currentFramebufferId == fboSrc.getId()){
 		ofLogWarning() << "Framebuffer with id: " << fboSrc.getId() << " cannot be bound onto itself. \n" <<
 			"Most probably you forgot to end() the current framebuffer before calling getTexture().";
@@ -1353,6 +1409,7 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
+	flushBatch();
 	if(framebufferIdStack.empty()){
 		ofLogError() << "unbalanced fbo bind/unbind binding default framebuffer";
 		currentFramebufferId = defaultFramebufferId;
@@ -1366,6 +1423,7 @@ void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material){
+	flushBatch();
     currentMaterial = &material;
     // FIXME: this invalidates the previous shader to avoid that
     // when binding 2 materials one after another, the second won't
@@ -1376,6 +1434,7 @@ void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofBaseMaterial &){
+	flushBatch();
     currentMaterial = nullptr;
 }
 
@@ -1405,6 +1464,7 @@ bool ofGLProgrammableRenderer::getLightingEnabled(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofTexture & texture, int location){
+	flushBatch();
 	//we could check if it has been allocated - but we don't do that in draw()
 	if(texture.getAlphaMask()){
 		setAlphaMaskTex(*texture.getAlphaMask());
@@ -1437,6 +1497,7 @@ void ofGLProgrammableRenderer::bind(const ofTexture & texture, int location){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofTexture & texture, int location){
+	flushBatch();
 	disableTextureTarget(texture.texData.textureTarget,location);
 	if(texture.getAlphaMask()){
 		disableAlphaMask();
@@ -1451,6 +1512,7 @@ void ofGLProgrammableRenderer::unbind(const ofTexture & texture, int location){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofCamera & camera, const ofRectangle & _viewport){
+	flushBatch();
 	pushView();
 	viewport(_viewport);
 	setOrientation(matrixStack.getOrientation(),camera.isVFlipped());
@@ -1462,6 +1524,7 @@ void ofGLProgrammableRenderer::bind(const ofCamera & camera, const ofRectangle &
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofCamera & camera){
+	flushBatch();
 	popView();
 }
 
@@ -1554,11 +1617,61 @@ void ofGLProgrammableRenderer::beginDefaultShader(){
 	}
 }
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setBatching(bool batching){
+	if(!batching){
+		flushBatch();
+	}
+	bBatching = batching;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::isBatching() const{
+	return bBatching;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBatch() const{
+	if(batch.isEmpty() || batch.isFlushing()) return;
+	// the batch is drawn with the model view matrix set to identity
+	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
+	ofMatrixMode matrixMode = matrixStack.getCurrentMatrixMode();
+	if(matrixMode!=OF_MATRIX_MODELVIEW){
+		mutThis->matrixStack.matrixMode(OF_MATRIX_MODELVIEW);
+	}
+	batch.flush(*mutThis);
+	if(matrixMode!=OF_MATRIX_MODELVIEW){
+		mutThis->matrixStack.matrixMode(matrixMode);
+	}
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBatchIfNotModelView() const{
+	if(matrixStack.getCurrentMatrixMode()!=OF_MATRIX_MODELVIEW){
+		flushBatch();
+	}
+}
+
+//----------------------------------------------------------
+const ofDrawBatch & ofGLProgrammableRenderer::getBatch() const{
+	return batch;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::addToBatch(const ofMesh & primitive, bool smooth) const{
+	// the batch is drawn without smoothing, smoothed primitives are drawn
+	// on their own after flushing it
+	if(!bBatching || smooth) return false;
+	batch.add(*const_cast<ofGLProgrammableRenderer*>(this), primitive, matrixStack.getModelViewMatrix(), currentStyle.color, currentStyle.lineWidth, currentStyle.blendingMode);
+	return true;
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
 	lineMesh.getVertices()[0].set(x1,y1,z1);
 	lineMesh.getVertices()[1].set(x2,y2,z2);
+	if(addToBatch(lineMesh, currentStyle.smoothing)) return;
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->startSmoothing();
@@ -1584,10 +1697,12 @@ void ofGLProgrammableRenderer::drawRectangle(float x, float y, float z, float w,
 		rectMesh.getVertices()[3].set(x-w/2.0f, y+h/2.0f, z);
 	}
     
+	rectMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP);
+	if(addToBatch(rectMesh, currentStyle.smoothing && !currentStyle.bFill)) return;
+
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
-	rectMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP);
 	draw(rectMesh,OF_MESH_FILL,false,false,false);
     
 	// use smoothness, if requested:
@@ -1601,10 +1716,12 @@ void ofGLProgrammableRenderer::drawTriangle(float x1, float y1, float z1, float
 	triangleMesh.getVertices()[1].set(x2,y2,z2);
 	triangleMesh.getVertices()[2].set(x3,y3,z3);
     
+	triangleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_STRIP : OF_PRIMITIVE_LINE_LOOP);
+	if(addToBatch(triangleMesh, currentStyle.smoothing && !currentStyle.bFill)) return;
+
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
-	triangleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_STRIP : OF_PRIMITIVE_LINE_LOOP);
 	draw(triangleMesh,OF_MESH_FILL,false,false,false);
     
 	// use smoothness, if requested:
@@ -1619,10 +1736,12 @@ void ofGLProgrammableRenderer::drawCircle(float x, float y, float z,  float radi
 		circleMesh.getVertices()[i].set(radius*circleCache[i].x+x,radius*circleCache[i].y+y,z);
 	}
     
+	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
+	if(addToBatch(circleMesh, currentStyle.smoothing && !currentStyle.bFill)) return;
+
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
-	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
 	draw(circleMesh,OF_MESH_FILL,false,false,false);
 	
 	// use smoothness, if requested:
@@ -1639,10 +1758,12 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 		circleMesh.getVertices()[i].set(radiusX*circlePolyline[i].x+x,radiusY*circlePolyline[i].y+y,z);
 	}
     
+	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
+	if(addToBatch(circleMesh, currentStyle.smoothing && !currentStyle.bFill)) return;
+
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
-	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
 	draw(circleMesh,OF_MESH_FILL,false,false,false);
     
 	// use smoothness, if requested:
@@ -1651,6 +1772,7 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawString(string textString, float x, float y, float z) const{
+	flushBatch();
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
 	float sx = 0;
 	float sy = 0;
@@ -1802,14 +1924,19 @@ void ofGLProgrammableRenderer::drawString(string textString, float x, float y, f
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
+	flushBatch();
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
 	ofBlendMode blendMode = currentStyle.blendingMode;
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
-	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
-	mutThis->unbind(font.getFontTexture(),0);
+	const vector<ofMesh> & meshes = font.getStringMeshes(text,x,y,isVFlipped());
+	for(size_t page=0;page<meshes.size();page++){
+		if(meshes[page].getNumVertices()==0) continue;
+		mutThis->bind(font.getFontTexture(page),0);
+		draw(meshes[page],OF_MESH_FILL);
+		mutThis->unbind(font.getFontTexture(page),0);
+	}
 
 	mutThis->setBlendMode(blendMode);
 }
@@ -2547,6 +2674,7 @@ void ofGLProgrammableRenderer::saveFullViewport(ofPixels & pixels){
 }
 
 void ofGLProgrammableRenderer::saveScreen(int x, int y, int w, int h, ofPixels & pixels){
+	flushBatch();
 
     int sh = getViewportHeight();
 
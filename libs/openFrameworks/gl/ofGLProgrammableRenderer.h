@@ -9,6 +9,7 @@
 #include "ofBitmapFont.h"
 #include "ofPath.h"
 #include "ofMaterial.h"
+#include "ofDrawBatch.h"
 
 
 class ofShapeTessellation;
@@ -168,6 +169,20 @@ public:
 	void drawString(string text, float x, float y, float z) const;
 	void drawString(const ofTrueTypeFont & font, string text, float x, float y) const;
 
+	/// \brief Merges consecutive lines, rectangles, triangles, circles and
+	/// ellipses drawn with the same color, line width and blend mode into
+	/// one draw call. Smoothed lines and outlines aren't batched.
+	///
+	/// Disabled by default. The batch is drawn when the renderer state changes
+	/// through the renderer and at the end of the frame, call flushBatch()
+	/// before changing the OpenGL state directly.
+	void setBatching(bool batching);
+	bool isBatching() const;
+
+	/// \brief Draws the primitives accumulated while batching.
+	void flushBatch() const;
+	const ofDrawBatch & getBatch() const;
+
 
 	void enableTextureTarget(const ofTexture & tex, int textureLocation);
 	void disableTextureTarget(int textureTarget, int textureLocation);
@@ -246,7 +261,11 @@ private:
 	mutable ofMesh rectMesh;
 	mutable ofMesh lineMesh;
 	mutable ofVbo meshVbo;
+	mutable ofDrawBatch batch;
+	bool bBatching;
 
+	bool addToBatch(const ofMesh & primitive, bool smooth) const;
+	void flushBatchIfNotModelView() const;
 	void uploadCurrentMatrix();
 
 
@@ -1692,9 +1692,13 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, string text, float x,
     glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
-	mutThis->unbind(font.getFontTexture(),0);
+	const vector<ofMesh> & meshes = font.getStringMeshes(text,x,y,isVFlipped());
+	for(size_t page=0;page<meshes.size();page++){
+		if(meshes[page].getNumVertices()==0) continue;
+		mutThis->bind(font.getFontTexture(page),0);
+		draw(meshes[page],OF_MESH_FILL);
+		mutThis->unbind(font.getFontTexture(page),0);
+	}
 
 	if(!blendEnabled){
 		glDisable(GL_BLEND);
@@ -7,6 +7,9 @@
 #include "ofTrueTypeFont.h"
 #include "ofNode.h"
 #include "ofGraphics.h"
+#include "ofRecordingRenderer.h"
+#include "ofWorkerThreads.h"
+#include <atomic>
 
 const string ofCairoRenderer::TYPE="cairo";
 
@@ -25,6 +28,7 @@ ofCairoRenderer::ofCairoRenderer()
 	multiPage = false;
 	b3D = false;
 	currentMatrixMode=OF_MATRIX_MODELVIEW;
+	fontMutex = nullptr;
 }
 
 ofCairoRenderer::~ofCairoRenderer(){
@@ -104,6 +108,77 @@ void ofCairoRenderer::setupMemoryOnly(Type _type, bool multiPage_, bool b3D_, of
 	setup("",_type,multiPage_,b3D_,outputsize);
 }
 
+void ofCairoRenderer::setupTile(const ofCairoRenderer & parent, const ofRectangle & tile){
+	type = IMAGE;
+	filename = "";
+	streamBuffer.clear();
+
+	// the tile surface points into the parent pixels, the device offset
+	// moves the tile origin so the same coordinates can be used everywhere
+	auto & pixels = parent.imageBuffer;
+	unsigned char * data = const_cast<unsigned char*>(pixels.getData()) + (int(tile.y) * pixels.getWidth() + int(tile.x)) * 4;
+	surface = cairo_image_surface_create_for_data(data,CAIRO_FORMAT_ARGB32,tile.width,tile.height,pixels.getWidth()*4);
+	cairo_surface_set_device_offset(surface,-tile.x,-tile.y);
+
+	cr = cairo_create(surface);
+	cairo_set_antialias(cr,cairo_get_antialias(parent.cr));
+	originalViewport = parent.originalViewport;
+	viewportRect = originalViewport;
+	viewport(viewportRect);
+	page = 0;
+	b3D = parent.b3D;
+	multiPage = false;
+	currentStyle = parent.currentStyle;
+	bBackgroundAuto = parent.bBackgroundAuto;
+}
+
+void ofCairoRenderer::drawTiled(const ofRecordingRenderer & recording, int tileWidth, int tileHeight, int numThreads){
+	if(type!=IMAGE || !surface){
+		ofLogError("ofCairoRenderer") << "drawTiled(): can only draw tiled on an image surface";
+		return;
+	}
+	if(tileWidth<=0 || tileHeight<=0){
+		ofLogError("ofCairoRenderer") << "drawTiled(): tile size has to be greater than 0";
+		return;
+	}
+
+	int width = imageBuffer.getWidth();
+	int height = imageBuffer.getHeight();
+	int cols = (width + tileWidth - 1) / tileWidth;
+	int rows = (height + tileHeight - 1) / tileHeight;
+	int numTiles = cols * rows;
+	numThreads = of::priv::getNumWorkThreads(numThreads, numTiles);
+
+	// anything drawn with this context has to be in the pixels before the
+	// tiles draw on them
+	cairo_surface_flush(surface);
+
+	// tiles are handed to the threads one by one so slow tiles with lots of
+	// geometry don't keep one thread busy while the others are idle. tiles
+	// don't overlap so every pixel is only written by one thread
+	std::atomic<int> nextTile(0);
+	std::mutex tilesFontMutex;
+	auto drawTiles = [&](int){
+		ofCairoRenderer renderer;
+		renderer.fontMutex = &tilesFontMutex;
+		int i;
+		while((i = nextTile++) < numTiles){
+			int x = (i % cols) * tileWidth;
+			int y = (i / cols) * tileHeight;
+			ofRectangle tile(x, y, std::min(tileWidth, width - x), std::min(tileHeight, height - y));
+			renderer.setupTile(*this, tile);
+			renderer.startRender();
+			recording.replay(renderer);
+			renderer.finishRender();
+			renderer.close();
+		}
+	};
+
+	of::priv::runInThreads(numThreads, drawTiles);
+
+	cairo_surface_mark_dirty(surface);
+}
+
 void ofCairoRenderer::flush(){
 	if(surface){
 		cairo_surface_flush(surface);
@@ -1369,7 +1444,21 @@ void ofCairoRenderer::drawString(string text, float x, float y, float z) const{
 }
 
 void ofCairoRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
-	font.drawStringAsShapes(text,x,y);
+	// drawStringAsShapes would draw through the current renderer which is
+	// not this one when drawing tiles
+	vector<ofTTFCharacter> shapes;
+	if(fontMutex){
+		// the font caches glyphs and kerning lazily, tiles can't use it
+		// at the same time
+		std::unique_lock<std::mutex> lock(*fontMutex);
+		shapes = font.getStringAsPoints(text, isVFlipped(), currentStyle.bFill);
+	}else{
+		shapes = font.getStringAsPoints(text, isVFlipped(), currentStyle.bFill);
+	}
+	for(auto & shape: shapes){
+		shape.translate(ofPoint(x,y));
+		draw(shape);
+	}
 }
 
 cairo_t * ofCairoRenderer::getCairoContext(){
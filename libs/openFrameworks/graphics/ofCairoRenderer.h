@@ -7,11 +7,14 @@
 #include "cairo.h"
 #include <deque>
 #include <stack>
+#include <mutex>
 #include "ofMatrix4x4.h"
 #include "ofBaseTypes.h"
 #include "ofPath.h"
 #include "of3dGraphics.h"
 
+class ofRecordingRenderer;
+
 class ofCairoRenderer: public ofBaseRenderer{
 public:
 	ofCairoRenderer();
@@ -161,6 +164,24 @@ public:
 	ofPixels & getImageSurfacePixels();
 	ofBuffer & getContentBuffer();
 
+	/// \brief Replays a recording on an IMAGE surface using several threads.
+	///
+	/// The surface is split in tiles of tileWidth x tileHeight pixels and
+	/// every tile is rendered by its own cairo context, clipped to the tile
+	/// and writing directly on the pixels returned by getImageSurfacePixels,
+	/// so the tiles don't need to be copied back. Every tile replays the
+	/// whole recording starting from the current style, the state of this
+	/// renderer isn't changed by the recording.
+	///
+	/// The images and videos the recording references are read from several
+	/// threads at the same time. Fonts aren't thread safe so the tiles take
+	/// turns to get the outlines of the strings they draw, the font can't be
+	/// used from other threads until this returns.
+	///
+	/// \param numThreads Number of threads to render with, 0 uses one per
+	/// core.
+	void drawTiled(const ofRecordingRenderer & recording, int tileWidth = 512, int tileHeight = 512, int numThreads = 0);
+
 
 	virtual void bind(const ofCamera & camera, const ofRectangle & viewport){}
 	virtual void unbind(const ofCamera & camera){}
@@ -172,8 +193,11 @@ private:
 	ofVec3f transform(ofVec3f vec) const;
 	static _cairo_status stream_function(void *closure,const unsigned char *data, unsigned int length);
 	void draw(const ofPixels & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void setupTile(const ofCairoRenderer & parent, const ofRectangle & tile);
 
 	mutable deque<ofPoint> curvePoints;
+	// shared by the tiles of drawTiled, null otherwise
+	std::mutex * fontMutex;
 	cairo_t * cr;
 	cairo_surface_t * surface;
 	bool bBackgroundAuto;
@@ -0,0 +1,176 @@
+#include "ofDrawBatch.h"
+#include "ofBaseTypes.h"
+
+//----------------------------------------------------------
+ofDrawBatch::ofDrawBatch()
+:numPrimitives(0)
+,numFlushes(0)
+,maxVertices(65535)
+,bFlushing(false)
+,bLines(false)
+,lineWidth(1)
+,blendMode(OF_BLENDMODE_DISABLED){
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
+//----------------------------------------------------------
+bool ofDrawBatch::isBatchable(ofPrimitiveMode mode){
+	switch(mode){
+	case OF_PRIMITIVE_TRIANGLES:
+	case OF_PRIMITIVE_TRIANGLE_STRIP:
+	case OF_PRIMITIVE_TRIANGLE_FAN:
+	case OF_PRIMITIVE_LINES:
+	case OF_PRIMITIVE_LINE_STRIP:
+	case OF_PRIMITIVE_LINE_LOOP:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------
+bool ofDrawBatch::canMerge(bool lines, const ofColor & color, float lineWidth, ofBlendMode blendMode) const{
+	if(numPrimitives==0) return true;
+	return bLines==lines && this->color==color && this->blendMode==blendMode && (!lines || this->lineWidth==lineWidth);
+}
+
+//----------------------------------------------------------
+void ofDrawBatch::add(ofBaseRenderer & renderer, const ofMesh & primitive, const ofMatrix4x4 & modelViewMatrix, const ofColor & color, float lineWidth, ofBlendMode blendMode){
+	ofPrimitiveMode mode = primitive.getMode();
+	if(!isBatchable(mode)){
+		ofLogError("ofDrawBatch") << "add(): primitive mode " << mode << " can't be batched";
+		return;
+	}
+	size_t numVertices = primitive.getNumVertices();
+	if(numVertices==0) return;
+
+	bool lines = mode==OF_PRIMITIVE_LINES || mode==OF_PRIMITIVE_LINE_STRIP || mode==OF_PRIMITIVE_LINE_LOOP;
+	if(!canMerge(lines, color, lineWidth, blendMode) || mesh.getNumVertices() + numVertices > maxVertices){
+		flush(renderer);
+	}
+	if(numPrimitives==0){
+		bLines = lines;
+		this->color = color;
+		this->lineWidth = lineWidth;
+		this->blendMode = blendMode;
+		mesh.setMode(lines ? OF_PRIMITIVE_LINES : OF_PRIMITIVE_TRIANGLES);
+	}
+
+	auto & vertices = mesh.getVertices();
+	auto & indices = mesh.getIndices();
+	ofIndexType offset = vertices.size();
+	const vector<ofVec3f> & src = primitive.getVertices();
+	if(modelViewMatrix.isIdentity()){
+		vertices.insert(vertices.end(), src.begin(), src.end());
+	}else{
+		for(auto & v: src){
+			vertices.push_back(modelViewMatrix.preMult(v));
+		}
+	}
+
+	ofIndexType n = numVertices;
+	switch(mode){
+	case OF_PRIMITIVE_TRIANGLES:
+	case OF_PRIMITIVE_LINES:
+		for(ofIndexType i=0;i<n;i++){
+			indices.push_back(offset + i);
+		}
+		break;
+	case OF_PRIMITIVE_TRIANGLE_STRIP:
+		// keep the winding of every triangle in the strip
+		for(ofIndexType i=0;i+2<n;i++){
+			if(i%2==0){
+				indices.push_back(offset + i);
+				indices.push_back(offset + i + 1);
+			}else{
+				indices.push_back(offset + i + 1);
+				indices.push_back(offset + i);
+			}
+			indices.push_back(offset + i + 2);
+		}
+		break;
+	case OF_PRIMITIVE_TRIANGLE_FAN:
+		for(ofIndexType i=1;i+1<n;i++){
+			indices.push_back(offset);
+			indices.push_back(offset + i);
+			indices.push_back(offset + i + 1);
+		}
+		break;
+	case OF_PRIMITIVE_LINE_STRIP:
+	case OF_PRIMITIVE_LINE_LOOP:
+		for(ofIndexType i=0;i+1<n;i++){
+			indices.push_back(offset + i);
+			indices.push_back(offset + i + 1);
+		}
+		if(mode==OF_PRIMITIVE_LINE_LOOP && n>2){
+			indices.push_back(offset + n - 1);
+			indices.push_back(offset);
+		}
+		break;
+	default:
+		break;
+	}
+	numPrimitives++;
+}
+
+//----------------------------------------------------------
+void ofDrawBatch::flush(ofBaseRenderer & renderer){
+	// drawing the mesh can make the renderer flush again
+	if(bFlushing || numPrimitives==0) return;
+	bFlushing = true;
+	renderer.pushMatrix();
+	renderer.loadIdentityMatrix();
+	renderer.draw(mesh, OF_MESH_FILL, false, false, false);
+	renderer.popMatrix();
+	numFlushes++;
+	clear();
+	bFlushing = false;
+}
+
+//----------------------------------------------------------
+void ofDrawBatch::clear(){
+	// clear the vectors directly so they keep their capacity
+	mesh.getVertices().clear();
+	mesh.getIndices().clear();
+	numPrimitives = 0;
+}
+
+//----------------------------------------------------------
+bool ofDrawBatch::isEmpty() const{
+	return numPrimitives==0;
+}
+
+//----------------------------------------------------------
+bool ofDrawBatch::isFlushing() const{
+	return bFlushing;
+}
+
+//----------------------------------------------------------
+size_t ofDrawBatch::getNumPrimitives() const{
+	return numPrimitives;
+}
+
+//----------------------------------------------------------
+size_t ofDrawBatch::getNumVertices() const{
+	return mesh.getNumVertices();
+}
+
+//----------------------------------------------------------
+const ofMesh & ofDrawBatch::getMesh() const{
+	return mesh;
+}
+
+//----------------------------------------------------------
+size_t ofDrawBatch::getNumFlushes() const{
+	return numFlushes;
+}
+
+//----------------------------------------------------------
+void ofDrawBatch::setMaxVertices(size_t maxVertices){
+	this->maxVertices = maxVertices;
+}
+
+//----------------------------------------------------------
+size_t ofDrawBatch::getMaxVertices() const{
+	return maxVertices;
+}
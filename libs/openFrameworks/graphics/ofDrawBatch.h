@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofMesh.h"
+#include "ofColor.h"
+#include "ofMatrix4x4.h"
+
+class ofBaseRenderer;
+
+/// \brief Accumulates small immediate mode primitives into one mesh.
+///
+/// Renderers use an ofDrawBatch to merge the shapes drawn by ofDrawRectangle,
+/// ofDrawCircle, ofDrawLine... into a single draw call. Every primitive is
+/// converted to indexed triangles or lines and its vertices are transformed by
+/// the model view matrix when added, so transforming the shapes doesn't break
+/// the batch. The batch is drawn when a primitive with a
+/// different color, line width, blend mode or primitive type is added, when
+/// it reaches the maximum number of vertices or when the renderer calls
+/// flush(), which it has to do before any other change in its state.
+class ofDrawBatch{
+public:
+	ofDrawBatch();
+
+	/// \brief Returns true if primitives of this mode can be batched.
+	///
+	/// Points, primitives with adjacency and patches can't.
+	static bool isBatchable(ofPrimitiveMode mode);
+
+	/// \brief Adds a primitive, drawing the batch first through renderer if
+	/// the primitive can't be merged with it.
+	///
+	/// \param primitive Vertices and primitive mode of the shape, indices,
+	/// colors, normals and texture coordinates are ignored.
+	/// \param modelViewMatrix Transformation applied to the vertices.
+	/// \param color Color the shape is drawn with.
+	/// \param lineWidth Line width the shape is drawn with.
+	/// \param blendMode Blend mode the shape is drawn with.
+	void add(ofBaseRenderer & renderer, const ofMesh & primitive, const ofMatrix4x4 & modelViewMatrix, const ofColor & color, float lineWidth, ofBlendMode blendMode);
+
+	/// \brief Draws the accumulated primitives with renderer and clears the
+	/// batch.
+	///
+	/// The mesh is drawn with the model view matrix set to identity, the
+	/// projection, color and the rest of the state have to be the same as
+	/// when the primitives were added.
+	void flush(ofBaseRenderer & renderer);
+
+	/// \brief Discards the accumulated primitives without drawing them.
+	void clear();
+
+	bool isEmpty() const;
+	bool isFlushing() const;
+	size_t getNumPrimitives() const;
+	size_t getNumVertices() const;
+	const ofMesh & getMesh() const;
+
+	/// \brief Number of times the batch has been drawn.
+	size_t getNumFlushes() const;
+
+	/// \brief Sets the number of vertices after which the batch is drawn,
+	/// 65535 by default so the indices fit in 16 bits.
+	void setMaxVertices(size_t maxVertices);
+	size_t getMaxVertices() const;
+
+private:
+	bool canMerge(bool lines, const ofColor & color, float lineWidth, ofBlendMode blendMode) const;
+
+	ofMesh mesh;
+	size_t numPrimitives;
+	size_t numFlushes;
+	size_t maxVertices;
+	bool bFlushing;
+
+	// state the primitives in the batch were added with
+	bool bLines;
+	ofColor color;
+	float lineWidth;
+	ofBlendMode blendMode;
+};
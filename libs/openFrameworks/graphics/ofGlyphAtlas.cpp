@@ -0,0 +1,371 @@
+#include "ofGlyphAtlas.h"
+#include "ofLog.h"
+
+static const size_t noShelf = std::numeric_limits<size_t>::max();
+
+//----------------------------------------------------------
+ofGlyphAtlas::ofGlyphAtlas()
+:pageWidth(0)
+,pageHeight(0)
+,maxPages(0)
+,pixelFormat(OF_PIXELS_GRAY_ALPHA)
+,padding(1)
+,batch(0)
+,version(0)
+,numEvictions(0){
+
+}
+
+//----------------------------------------------------------
+ofGlyphAtlas::ofGlyphAtlas(const ofGlyphAtlas & mom){
+	*this = mom;
+}
+
+//----------------------------------------------------------
+ofGlyphAtlas & ofGlyphAtlas::operator=(const ofGlyphAtlas & mom){
+	if(this == &mom) return *this;
+	pages = mom.pages;
+	entries = mom.entries;
+	lru = mom.lru;
+	pageWidth = mom.pageWidth;
+	pageHeight = mom.pageHeight;
+	maxPages = mom.maxPages;
+	pixelFormat = mom.pixelFormat;
+	padding = mom.padding;
+	batch = mom.batch;
+	version = mom.version;
+	numEvictions = mom.numEvictions;
+
+	// the copied entries point to the list of mom
+	for(auto it = lru.begin(); it != lru.end(); ++it){
+		entries[*it].lru = it;
+	}
+	return *this;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::setup(int _pageWidth, int _pageHeight, size_t _maxPages, ofPixelFormat _pixelFormat, int _padding){
+	clear();
+	pageWidth = _pageWidth;
+	pageHeight = _pageHeight;
+	maxPages = _maxPages;
+	pixelFormat = _pixelFormat;
+	padding = _padding;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::clear(){
+	pages.clear();
+	entries.clear();
+	lru.clear();
+	batch = 0;
+	numEvictions = 0;
+	version++;
+}
+
+//----------------------------------------------------------
+const ofGlyphAtlas::Region * ofGlyphAtlas::find(uint32_t key){
+	auto it = entries.find(key);
+	if(it == entries.end()){
+		return nullptr;
+	}
+	Entry & entry = it->second;
+	if(!entry.pinned){
+		lru.splice(lru.begin(), lru, entry.lru);
+	}
+	entry.batch = batch;
+	return &entry.region;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::contains(uint32_t key) const{
+	return entries.find(key) != entries.end();
+}
+
+//----------------------------------------------------------
+const ofGlyphAtlas::Region * ofGlyphAtlas::add(uint32_t key, const ofPixels & pixels, bool pinned){
+	auto it = entries.find(key);
+	if(it != entries.end()){
+		release(it->second);
+		if(!it->second.pinned){
+			lru.erase(it->second.lru);
+		}
+		entries.erase(it);
+		version++;
+	}
+
+	Entry entry;
+	entry.region.page = 0;
+	entry.region.x = 0;
+	entry.region.y = 0;
+	entry.region.width = pixels.getWidth();
+	entry.region.height = pixels.getHeight();
+	entry.shelf = noShelf;
+	entry.batch = batch;
+	entry.pinned = pinned;
+
+	// empty glyphs, like spaces, don't take any space in the atlas
+	if(entry.region.width > 0 && entry.region.height > 0){
+		if(pixels.getPixelFormat() != pixelFormat){
+			ofLogError("ofGlyphAtlas") << "add(): glyph " << key << " has a different pixel format than the atlas";
+			return nullptr;
+		}
+		int width = entry.region.width + padding * 2;
+		int height = entry.region.height + padding * 2;
+		if(width > pageWidth || height > pageHeight){
+			ofLogError("ofGlyphAtlas") << "add(): glyph " << key << " of " << entry.region.width << "x" << entry.region.height
+					<< " doesn't fit in pages of " << pageWidth << "x" << pageHeight;
+			return nullptr;
+		}
+		while(!allocate(width, height, entry.region, entry.shelf)){
+			if(!evictOne()){
+				ofLogError("ofGlyphAtlas") << "add(): no space left for glyph " << key << ", all glyphs are pinned or in use";
+				return nullptr;
+			}
+		}
+		Page & page = pages[entry.region.page];
+		clearRegion(page, entry.region.x - padding, entry.region.y - padding, width, height);
+		pixels.pasteInto(page.pixels, entry.region.x, entry.region.y);
+		page.dirty = true;
+	}
+
+	if(!pinned){
+		lru.push_front(key);
+		entry.lru = lru.begin();
+	}
+	return &(entries[key] = entry).region;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::beginBatch(){
+	batch++;
+}
+
+//----------------------------------------------------------
+size_t ofGlyphAtlas::getNumGlyphs() const{
+	return entries.size();
+}
+
+//----------------------------------------------------------
+size_t ofGlyphAtlas::getNumPages() const{
+	return pages.size();
+}
+
+//----------------------------------------------------------
+size_t ofGlyphAtlas::getMaxPages() const{
+	return maxPages;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getPageWidth() const{
+	return pageWidth;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getPageHeight() const{
+	return pageHeight;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getPadding() const{
+	return padding;
+}
+
+//----------------------------------------------------------
+size_t ofGlyphAtlas::getNumEvictions() const{
+	return numEvictions;
+}
+
+//----------------------------------------------------------
+unsigned int ofGlyphAtlas::getVersion() const{
+	return version;
+}
+
+//----------------------------------------------------------
+const ofPixels & ofGlyphAtlas::getPage(size_t page) const{
+	return pages[page].pixels;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::isPageDirty(size_t page) const{
+	return pages[page].dirty;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::markPageClean(size_t page){
+	pages[page].dirty = false;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::markPageDirty(size_t page){
+	pages[page].dirty = true;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::allocate(int width, int height, Region & region, size_t & shelf){
+	size_t bestPage = 0;
+	size_t bestShelf = noShelf;
+
+	// first try shelves that aren't much taller than the glyph so small
+	// glyphs don't waste the space of tall shelves
+	findShelf(width, height, height + height / 2, bestPage, bestShelf);
+
+	// then open a new shelf in a page with space left or in a new page
+	for(size_t p = 0; p <= pages.size() && bestShelf == noShelf; p++){
+		if(p == pages.size()){
+			if(pages.size() >= maxPages){
+				break;
+			}
+			Page page;
+			page.pixels.allocate(pageWidth, pageHeight, pixelFormat);
+			page.end = 0;
+			page.dirty = true;
+			clearRegion(page, 0, 0, pageWidth, pageHeight);
+			pages.push_back(std::move(page));
+		}
+		Page & page = pages[p];
+		if(page.end + height <= pageHeight){
+			Shelf newShelf;
+			newShelf.y = page.end;
+			newShelf.height = height;
+			newShelf.end = 0;
+			page.shelves.push_back(newShelf);
+			page.end += height;
+			bestPage = p;
+			bestShelf = page.shelves.size() - 1;
+		}
+	}
+
+	// finally use any shelf the glyph fits in
+	if(bestShelf == noShelf){
+		findShelf(width, height, pageHeight, bestPage, bestShelf);
+	}
+
+	if(bestShelf == noShelf){
+		return false;
+	}
+
+	allocateInShelf(bestPage, bestShelf, width, region);
+	region.x += padding;
+	region.y += padding;
+	shelf = bestShelf;
+	return true;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::findShelf(int width, int height, int maxHeight, size_t & bestPage, size_t & bestShelf) const{
+	int bestHeight = maxHeight + 1;
+	for(size_t p = 0; p < pages.size(); p++){
+		for(size_t s = 0; s < pages[p].shelves.size(); s++){
+			const Shelf & shelf = pages[p].shelves[s];
+			if(shelf.height < height || shelf.height >= bestHeight){
+				continue;
+			}
+			bool fits = shelf.end + width <= pageWidth;
+			for(size_t i = 0; i < shelf.slots.size() && !fits; i++){
+				fits = !shelf.slots[i].used && shelf.slots[i].width >= width;
+			}
+			if(fits){
+				bestPage = p;
+				bestShelf = s;
+				bestHeight = shelf.height;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::allocateInShelf(size_t p, size_t s, int width, Region & region){
+	Shelf & shelf = pages[p].shelves[s];
+	region.page = p;
+	region.y = shelf.y;
+	for(size_t i = 0; i < shelf.slots.size(); i++){
+		Slot & slot = shelf.slots[i];
+		if(!slot.used && slot.width >= width){
+			if(slot.width > width){
+				Slot rest{slot.x + width, slot.width - width, false};
+				shelf.slots.insert(shelf.slots.begin() + i + 1, rest);
+			}
+			Slot & used = shelf.slots[i];
+			used.width = width;
+			used.used = true;
+			region.x = used.x;
+			return true;
+		}
+	}
+	if(shelf.end + width <= pageWidth){
+		shelf.slots.push_back(Slot{shelf.end, width, true});
+		region.x = shelf.end;
+		shelf.end += width;
+		return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::evictOne(){
+	for(auto it = lru.rbegin(); it != lru.rend(); ++it){
+		auto entry = entries.find(*it);
+		if(entry->second.batch != batch){
+			release(entry->second);
+			lru.erase(std::next(it).base());
+			entries.erase(entry);
+			numEvictions++;
+			version++;
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::release(const Entry & entry){
+	if(entry.shelf == noShelf){
+		return;
+	}
+	Page & page = pages[entry.region.page];
+	Shelf & shelf = page.shelves[entry.shelf];
+	int x = entry.region.x - padding;
+	for(size_t i = 0; i < shelf.slots.size(); i++){
+		if(shelf.slots[i].x != x){
+			continue;
+		}
+		shelf.slots[i].used = false;
+		// merge with the free neighbours
+		if(i + 1 < shelf.slots.size() && !shelf.slots[i + 1].used){
+			shelf.slots[i].width += shelf.slots[i + 1].width;
+			shelf.slots.erase(shelf.slots.begin() + i + 1);
+		}
+		if(i > 0 && !shelf.slots[i - 1].used){
+			shelf.slots[i - 1].width += shelf.slots[i].width;
+			shelf.slots.erase(shelf.slots.begin() + i);
+		}
+		break;
+	}
+	// give the free space at the end back to the shelf and empty shelves at
+	// the bottom back to the page so they can be opened with another height
+	if(!shelf.slots.empty() && !shelf.slots.back().used){
+		shelf.end = shelf.slots.back().x;
+		shelf.slots.pop_back();
+	}
+	while(!page.shelves.empty() && page.shelves.back().slots.empty()){
+		page.end = page.shelves.back().y;
+		page.shelves.pop_back();
+	}
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::clearRegion(Page & page, int x, int y, int width, int height){
+	size_t channels = page.pixels.getNumChannels();
+	bool hasAlpha = channels == 2 || channels == 4;
+	for(int j = y; j < y + height; j++){
+		unsigned char * pixel = page.pixels.getData() + (j * pageWidth + x) * channels;
+		for(int i = 0; i < width; i++){
+			for(size_t c = 0; c < channels; c++){
+				// transparent white so filtering doesn't darken the edges
+				pixel[c] = hasAlpha ? (c == channels - 1 ? 0 : 255) : 0;
+			}
+			pixel += channels;
+		}
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+#include <list>
+#include <unordered_map>
+
+/// \brief Packs glyph bitmaps into pages of pixels as they are needed.
+///
+/// ofTrueTypeFont uses an ofGlyphAtlas to rasterize glyphs on demand
+/// instead of only the ones in a fixed character set. Glyphs are packed
+/// into shelves, rows as tall as the first glyph placed in them, on pages
+/// of a fixed size. When every page is full the least recently used glyphs
+/// are evicted to make room for new ones.
+///
+/// Glyphs added as pinned, and glyphs used since the last call to
+/// beginBatch(), are never evicted so the glyphs referenced by the mesh of
+/// the string being built stay in the atlas.
+///
+/// The atlas only deals with pixels, uploading the pages that changed to
+/// textures is left to the user, see isPageDirty().
+class ofGlyphAtlas{
+public:
+	/// \brief Position of a glyph in the atlas.
+	struct Region{
+		size_t page;
+		int x, y;
+		int width, height;
+	};
+
+	ofGlyphAtlas();
+	ofGlyphAtlas(const ofGlyphAtlas & mom);
+	ofGlyphAtlas & operator=(const ofGlyphAtlas & mom);
+
+	/// \brief Clears the atlas and sets the size and format of its pages.
+	///
+	/// \param pageWidth Width of every page in pixels.
+	/// \param pageHeight Height of every page in pixels.
+	/// \param maxPages Number of pages after which glyphs are evicted.
+	/// \param pixelFormat Format of the pages, glyphs added have to be in
+	/// the same format.
+	/// \param padding Empty pixels left around each glyph so they don't
+	/// bleed into each other when the texture is filtered.
+	void setup(int pageWidth, int pageHeight, size_t maxPages, ofPixelFormat pixelFormat = OF_PIXELS_GRAY_ALPHA, int padding = 1);
+
+	/// \brief Removes every glyph and page.
+	void clear();
+
+	/// \brief Returns the glyph with that key and marks it as used, nullptr
+	/// if it isn't in the atlas.
+	const Region * find(uint32_t key);
+
+	/// \brief Returns true if the glyph is in the atlas without marking it
+	/// as used.
+	bool contains(uint32_t key) const;
+
+	/// \brief Packs a glyph in the atlas, evicting the least recently used
+	/// ones if there's no space left.
+	///
+	/// Adding a key that is already in the atlas replaces it.
+	///
+	/// \param pinned Pinned glyphs are never evicted.
+	/// \returns The position of the glyph or nullptr if there's no space
+	/// left even after evicting every glyph that can be evicted.
+	const Region * add(uint32_t key, const ofPixels & pixels, bool pinned = false);
+
+	/// \brief Starts a new batch, the glyphs used since the previous call
+	/// can be evicted again.
+	void beginBatch();
+
+	size_t getNumGlyphs() const;
+	size_t getNumPages() const;
+	size_t getMaxPages() const;
+	int getPageWidth() const;
+	int getPageHeight() const;
+	int getPadding() const;
+
+	/// \brief Number of glyphs evicted since setup.
+	size_t getNumEvictions() const;
+
+	/// \brief Returns a number that changes every time glyphs are removed
+	/// from the atlas, regions found before stay valid while it doesn't.
+	unsigned int getVersion() const;
+
+	const ofPixels & getPage(size_t page) const;
+
+	/// \brief Returns true if glyphs were added to the page since the last
+	/// call to markPageClean().
+	bool isPageDirty(size_t page) const;
+	void markPageClean(size_t page);
+
+	/// \brief Marks a page to be uploaded again, for example to a new
+	/// texture.
+	void markPageDirty(size_t page);
+
+private:
+	struct Slot{
+		int x;
+		int width;
+		bool used;
+	};
+
+	struct Shelf{
+		int y;
+		int height;
+		int end;
+		vector<Slot> slots;
+	};
+
+	struct Page{
+		ofPixels pixels;
+		vector<Shelf> shelves;
+		int end;
+		bool dirty;
+	};
+
+	struct Entry{
+		Region region;
+		size_t shelf;
+		list<uint32_t>::iterator lru;
+		unsigned int batch;
+		bool pinned;
+	};
+
+	bool allocate(int width, int height, Region & region, size_t & shelf);
+	void findShelf(int width, int height, int maxHeight, size_t & bestPage, size_t & bestShelf) const;
+	bool allocateInShelf(size_t page, size_t shelf, int width, Region & region);
+	bool evictOne();
+	void release(const Entry & entry);
+	void clearRegion(Page & page, int x, int y, int width, int height);
+
+	vector<Page> pages;
+	unordered_map<uint32_t, Entry> entries;
+	list<uint32_t> lru;
+	int pageWidth;
+	int pageHeight;
+	size_t maxPages;
+	ofPixelFormat pixelFormat;
+	int padding;
+	unsigned int batch;
+	unsigned int version;
+	size_t numEvictions;
+};
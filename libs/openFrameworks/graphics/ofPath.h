@@ -371,6 +371,7 @@ public:
 	/// \}
 	
 private:
+	friend class ofTessellator;
 
 	ofPolyline & lastPolyline();
 	void addCommand(const Command & command);
@@ -2,13 +2,27 @@
 #include "ofAppRunner.h"
 
 //----------------------------------------------------------
-ofPolyline::ofPolyline(){
+ofPolyline::ofPolyline()
+:area(0)
+,areaSum(0)
+,lengthsValid(0)
+,areaValid(0)
+,vertexDataValid(0)
+,normalsValid(0)
+,queriesSinceChange(0){
     setRightVector();
 	clear();
 }
 
 //----------------------------------------------------------
-ofPolyline::ofPolyline(const vector<ofPoint>& verts){
+ofPolyline::ofPolyline(const vector<ofPoint>& verts)
+:area(0)
+,areaSum(0)
+,lengthsValid(0)
+,areaValid(0)
+,vertexDataValid(0)
+,normalsValid(0)
+,queriesSinceChange(0){
     setRightVector();
 	clear();
 	addVertices(verts);
@@ -37,35 +51,36 @@ void ofPolyline::clear() {
 void ofPolyline::addVertex(const ofPoint& p) {
 	curveVertices.clear();
 	points.push_back(p);
-    flagHasChanged();
+    flagVerticesChanged(points.size() - 1);
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertex(float x, float y, float z) {
 	curveVertices.clear();
 	addVertex(ofPoint(x,y,z));
-    flagHasChanged();
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertices(const vector<ofPoint>& verts) {
 	curveVertices.clear();
+	size_t firstVertex = points.size();
 	points.insert( points.end(), verts.begin(), verts.end() );
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertices(const ofPoint* verts, int numverts) {
 	curveVertices.clear();
+	size_t firstVertex = points.size();
 	points.insert( points.end(), verts, verts + numverts );
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::insertVertex(const ofPoint &p, int index) {
     curveVertices.clear();
     points.insert(points.begin()+index, p);
-    flagHasChanged();
+    flagVerticesChanged(index);
 }
 
 //----------------------------------------------------------
@@ -86,20 +101,25 @@ const ofPoint& ofPolyline::operator[] (int index) const {
 
 //----------------------------------------------------------
 ofPoint& ofPolyline::operator[] (int index) {
-    flagHasChanged();
+    flagVerticesChanged(index);
 	return points[index];
 }
 
 //----------------------------------------------------------
 void ofPolyline::resize(size_t size){
+	// when removing vertices the new last one loses its next neighbour
+	size_t firstVertex = size < points.size() ? std::max(size, size_t(1)) - 1 : points.size();
 	points.resize(size);
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::setClosed( bool tf ) {
 	bClosed = tf;
+	// the area and centroid don't depend on the polyline being closed
+	size_t areaValid = this->areaValid;
     flagHasChanged();
+	this->areaValid = areaValid;
 }
 
 //----------------------------------------------------------
@@ -124,8 +144,23 @@ bool ofPolyline::hasChanged(){
 
 //----------------------------------------------------------
 void ofPolyline::flagHasChanged() {
+    flagVerticesChanged(0);
+}
+
+//----------------------------------------------------------
+void ofPolyline::flagVerticesChanged(size_t firstVertex) {
     bHasChanged = true;
-    bCacheIsDirty = true;
+    lengthsValid = std::min(lengthsValid, firstVertex);
+    // the area sums can only be extended
+    if(firstVertex < areaValid) {
+        areaValid = 0;
+    }
+    // tangents, angles and normals also depend on the previous vertex
+    size_t firstNeighbour = firstVertex > 0 ? firstVertex - 1 : 0;
+    vertexDataValid = std::min(vertexDataValid, firstNeighbour);
+    normalsValid = std::min(normalsValid, firstNeighbour);
+    spatialIndex.reset();
+    queriesSinceChange = 0;
 }
 
 //----------------------------------------------------------
@@ -167,6 +202,7 @@ float ofPolyline::wrapAngle(float angleRadians) {
 
 //----------------------------------------------------------
 void ofPolyline::bezierTo( const ofPoint & cp1, const ofPoint & cp2, const ofPoint & to, int curveResolution ){
+	size_t firstVertex = points.size();
 	// if, and only if poly vertices has points, we can make a bezier
 	// from the last point
 	curveVertices.clear();
@@ -208,11 +244,12 @@ void ofPolyline::bezierTo( const ofPoint & cp1, const ofPoint & cp2, const ofPoi
 			points.push_back(ofPoint(x,y,z));
 		}
 	}
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::quadBezierTo(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, int curveResolution){
+	size_t firstVertex = points.size();
 	curveVertices.clear();
 	for(int i=0; i <= curveResolution; i++){
 		double t = (double)i / (double)(curveResolution);
@@ -224,11 +261,12 @@ void ofPolyline::quadBezierTo(float x1, float y1, float z1, float x2, float y2,
 		double z = a * z1 + b * z2 + c * z3;
 		points.push_back(ofPoint(x, y, z));
 	}
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::curveTo( const ofPoint & to, int curveResolution ){
+	size_t firstVertex = points.size();
     
 	curveVertices.push_back(to);
     
@@ -275,11 +313,12 @@ void ofPolyline::curveTo( const ofPoint & to, int curveResolution ){
 		}
 		curveVertices.pop_front();
 	}
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
 void ofPolyline::arc(const ofPoint & center, float radiusX, float radiusY, float angleBegin, float angleEnd, bool clockwise, int circleResolution){
+	size_t firstVertex = points.size();
     
     if(circleResolution<=1) circleResolution=2;
     setCircleResolution(circleResolution);
@@ -373,7 +412,7 @@ void ofPolyline::arc(const ofPoint & center, float radiusX, float radiusY, float
             remainingAngle = 0; // call it finished, the next while loop test will fail
         }
     }
-    flagHasChanged();
+    flagVerticesChanged(firstVertex);
 }
 
 //----------------------------------------------------------
@@ -381,20 +420,20 @@ float ofPolyline::getPerimeter() const {
     if(points.size() < 2) {
         return 0;
     } else {
-        updateCache();
+        updateLengths();
         return lengths.back();
     }
 }
 
 //----------------------------------------------------------
 float ofPolyline::getArea() const{
-    updateCache();
+    updateArea();
     return area;
 }
 
 //----------------------------------------------------------
 ofPoint ofPolyline::getCentroid2D() const{
-    updateCache();
+    updateArea();
     return centroid2D;
 }
 
@@ -517,42 +556,274 @@ static ofPoint getClosestPointUtil(const ofPoint& p1, const ofPoint& p2, const o
 }
 
 //----------------------------------------------------------
-// a much faster but less accurate version would check distances to vertices first,
-// which assumes vertices are evenly spaced
-ofPoint ofPolyline::getClosestPoint(const ofPoint& target, unsigned int* nearestIndex) const {
-	const ofPolyline & polyline = *this;
-    
-	if(polyline.size() < 2) {
-		if(nearestIndex != nullptr) {
-			nearestIndex = 0;
+struct ofPolyline::SpatialIndex{
+	SpatialIndex(const ofPolyline & polyline);
+
+	// calls f with the index of every segment in the cells at distance ring
+	// from cell cx, cy
+	template<typename F>
+	void forEachSegmentInRing(int cx, int cy, int ring, F f) const;
+
+	// smallest distance in the xy plane from p to the cells outside ring,
+	// -1 if the ring already covers the whole grid
+	float distanceOutsideRing(const ofPoint & p, int cx, int cy, int ring) const;
+
+	bool inside(float x, float y) const;
+
+	// closest point: uniform grid over the xy bounding box, every cell lists
+	// the segments whose bounding box overlaps it
+	float minX, minY, cellSize;
+	int cols, rows;
+	vector<unsigned int> cellStart;
+	vector<unsigned int> cellSegments;
+
+	// inside: the polygon edges sorted in horizontal bands, an edge is
+	// stored in every band its y range overlaps
+	float bandsMinY, bandsMaxY, bandHeight;
+	int numBands;
+	vector<unsigned int> bandStart;
+	vector<float> edgeX1, edgeY1, edgeX2, edgeY2;
+};
+
+//----------------------------------------------------------
+ofPolyline::SpatialIndex::SpatialIndex(const ofPolyline & polyline){
+	const auto & points = polyline.getVertices();
+	unsigned int numPoints = points.size();
+	unsigned int numSegments = polyline.isClosed() ? numPoints : numPoints - 1;
+	ofRectangle bounds = polyline.getBoundingBox();
+
+	// around one segment per cell
+	minX = bounds.getMinX();
+	minY = bounds.getMinY();
+	float w = bounds.getWidth();
+	float h = bounds.getHeight();
+	if(w > 0 && h > 0){
+		cellSize = sqrt(w * h / numSegments);
+	}else{
+		cellSize = max(w, h) / numSegments;
+	}
+	if(cellSize <= 0){
+		cellSize = 1;
+	}
+	cols = ofClamp(ceil(w / cellSize), 1, numSegments);
+	rows = ofClamp(ceil(h / cellSize), 1, numSegments);
+
+	auto cellX = [&](float x){ return int(ofClamp((x - minX) / cellSize, 0, cols - 1)); };
+	auto cellY = [&](float y){ return int(ofClamp((y - minY) / cellSize, 0, rows - 1)); };
+	auto forEachCell = [&](unsigned int segment, std::function<void(int)> f){
+		const ofPoint & p1 = points[segment];
+		const ofPoint & p2 = points[(segment + 1) % numPoints];
+		int x0 = cellX(min(p1.x, p2.x)), x1 = cellX(max(p1.x, p2.x));
+		int y0 = cellY(min(p1.y, p2.y)), y1 = cellY(max(p1.y, p2.y));
+		for(int y = y0; y <= y1; y++){
+			for(int x = x0; x <= x1; x++){
+				f(y * cols + x);
+			}
 		}
-		return target;
+	};
+
+	cellStart.assign(cols * rows + 1, 0);
+	for(unsigned int i = 0; i < numSegments; i++){
+		forEachCell(i, [&](int cell){ cellStart[cell + 1]++; });
 	}
-	
+	for(size_t i = 1; i < cellStart.size(); i++){
+		cellStart[i] += cellStart[i - 1];
+	}
+	cellSegments.resize(cellStart.back());
+	vector<unsigned int> cellEnd(cellStart.begin(), cellStart.end() - 1);
+	for(unsigned int i = 0; i < numSegments; i++){
+		forEachCell(i, [&](int cell){ cellSegments[cellEnd[cell]++] = i; });
+	}
+
+	// inside always treats the polyline as closed
+	bandsMinY = minY;
+	bandsMaxY = bounds.getMaxY();
+	numBands = h > 0 ? max(1u, numPoints / 4) : 1;
+	bandHeight = h > 0 ? h / numBands : 1;
+	auto band = [&](float y){ return int(ofClamp((y - bandsMinY) / bandHeight, 0, numBands - 1)); };
+
+	bandStart.assign(numBands + 1, 0);
+	for(unsigned int i = 0; i < numPoints; i++){
+		const ofPoint & p1 = points[i];
+		const ofPoint & p2 = points[(i + 1) % numPoints];
+		for(int b = band(min(p1.y, p2.y)); b <= band(max(p1.y, p2.y)); b++){
+			bandStart[b + 1]++;
+		}
+	}
+	for(size_t i = 1; i < bandStart.size(); i++){
+		bandStart[i] += bandStart[i - 1];
+	}
+	size_t numEdges = bandStart.back();
+	edgeX1.resize(numEdges);
+	edgeY1.resize(numEdges);
+	edgeX2.resize(numEdges);
+	edgeY2.resize(numEdges);
+	vector<unsigned int> bandEnd(bandStart.begin(), bandStart.end() - 1);
+	for(unsigned int i = 0; i < numPoints; i++){
+		const ofPoint & p1 = points[i];
+		const ofPoint & p2 = points[(i + 1) % numPoints];
+		for(int b = band(min(p1.y, p2.y)); b <= band(max(p1.y, p2.y)); b++){
+			auto e = bandEnd[b]++;
+			edgeX1[e] = p1.x;
+			edgeY1[e] = p1.y;
+			edgeX2[e] = p2.x;
+			edgeY2[e] = p2.y;
+		}
+	}
+}
+
+//----------------------------------------------------------
+template<typename F>
+void ofPolyline::SpatialIndex::forEachSegmentInRing(int cx, int cy, int ring, F f) const{
+	int y0 = max(cy - ring, 0);
+	int y1 = min(cy + ring, rows - 1);
+	for(int y = y0; y <= y1; y++){
+		bool fullRow = y == cy - ring || y == cy + ring;
+		int step = fullRow ? 1 : ring * 2;
+		for(int x = cx - ring; x <= cx + ring; x += max(step, 1)){
+			if(x < 0 || x >= cols){
+				continue;
+			}
+			int cell = y * cols + x;
+			for(auto i = cellStart[cell]; i < cellStart[cell + 1]; i++){
+				f(cellSegments[i]);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+float ofPolyline::SpatialIndex::distanceOutsideRing(const ofPoint & p, int cx, int cy, int ring) const{
+	float distance = std::numeric_limits<float>::max();
+	bool outside = false;
+	if(cx - ring > 0){
+		distance = min(distance, max(0.f, p.x - (minX + (cx - ring) * cellSize)));
+		outside = true;
+	}
+	if(cx + ring < cols - 1){
+		distance = min(distance, max(0.f, minX + (cx + ring + 1) * cellSize - p.x));
+		outside = true;
+	}
+	if(cy - ring > 0){
+		distance = min(distance, max(0.f, p.y - (minY + (cy - ring) * cellSize)));
+		outside = true;
+	}
+	if(cy + ring < rows - 1){
+		distance = min(distance, max(0.f, minY + (cy + ring + 1) * cellSize - p.y));
+		outside = true;
+	}
+	return outside ? distance : -1;
+}
+
+//----------------------------------------------------------
+bool ofPolyline::SpatialIndex::inside(float x, float y) const{
+	// same test as ofPolyline::inside, written without branches so the
+	// loop over the edges of a band can be vectorized
+	if(!(y > bandsMinY && y <= bandsMaxY)){
+		return false;
+	}
+	int b = ofClamp((y - bandsMinY) / bandHeight, 0, numBands - 1);
+	const float * x1 = edgeX1.data();
+	const float * y1 = edgeY1.data();
+	const float * x2 = edgeX2.data();
+	const float * y2 = edgeY2.data();
+	int counter = 0;
+	for(auto e = bandStart[b]; e < bandStart[b + 1]; e++){
+		double xinters = (y - y1[e]) * (x2[e] - x1[e]) / (y2[e] - y1[e]) + x1[e];
+		counter += (y > min(y1[e], y2[e])) & (y <= max(y1[e], y2[e])) & (x <= max(x1[e], x2[e])) &
+			(y1[e] != y2[e]) & ((x1[e] == x2[e]) | (x <= xinters));
+	}
+	return counter % 2 != 0;
+}
+
+//----------------------------------------------------------
+const ofPolyline::SpatialIndex * ofPolyline::getSpatialIndex(size_t numQueries) const{
+	// below this many vertices testing every segment is as fast
+	const size_t minVertices = 64;
+	if(spatialIndex){
+		return spatialIndex.get();
+	}
+	if(points.size() < minVertices){
+		return nullptr;
+	}
+	// building the index costs more than a single query, only build it when
+	// the polyline is queried again before changing
+	queriesSinceChange += numQueries;
+	if(queriesSinceChange < 2){
+		return nullptr;
+	}
+	spatialIndex = make_shared<SpatialIndex>(*this);
+	return spatialIndex.get();
+}
+
+//----------------------------------------------------------
+ofPoint ofPolyline::findClosestPoint(const ofPoint& target, const SpatialIndex * index, unsigned int & nearest, float & normalizedPosition) const {
+	const ofPolyline & polyline = *this;
 	float distance = 0;
 	ofPoint nearestPoint;
-	unsigned int nearest = 0;
-	float normalizedPosition = 0;
-	unsigned int lastPosition = polyline.size() - 1;
-	if(polyline.isClosed()) {
-		lastPosition++;
-	}
-	for(int i = 0; i < (int) lastPosition; i++) {
-		bool repeatNext = i == (int) (polyline.size() - 1);
-		
+	bool found = false;
+	nearest = 0;
+	normalizedPosition = 0;
+
+	auto testSegment = [&](unsigned int i){
+		bool repeatNext = i == polyline.size() - 1;
+
 		const ofPoint& cur = polyline[i];
 		const ofPoint& next = repeatNext ? polyline[0] : polyline[i + 1];
-		
+
 		float curNormalizedPosition = 0;
 		ofPoint curNearestPoint = getClosestPointUtil(cur, next, target, &curNormalizedPosition);
 		float curDistance = curNearestPoint.distance(target);
-		if(i == 0 || curDistance < distance) {
+		// on ties keep the first segment so the result doesn't depend on
+		// the order the segments are tested in
+		if(!found || curDistance < distance || (curDistance == distance && i < nearest)) {
+			found = true;
 			distance = curDistance;
 			nearest = i;
 			nearestPoint = curNearestPoint;
 			normalizedPosition = curNormalizedPosition;
 		}
+	};
+
+	if(index){
+		// search the grid in rings of cells around the target until the
+		// cells left are further than the closest point found. the distance
+		// in the xy plane is never bigger than the distance in 3d
+		int cx = ofClamp((target.x - index->minX) / index->cellSize, 0, index->cols - 1);
+		int cy = ofClamp((target.y - index->minY) / index->cellSize, 0, index->rows - 1);
+		for(int ring = 0;; ring++){
+			index->forEachSegmentInRing(cx, cy, ring, testSegment);
+			float outside = index->distanceOutsideRing(target, cx, cy, ring);
+			if(outside < 0 || (found && distance <= outside)){
+				break;
+			}
+		}
+	}else{
+		unsigned int lastPosition = polyline.size() - 1;
+		if(polyline.isClosed()) {
+			lastPosition++;
+		}
+		for(unsigned int i = 0; i < lastPosition; i++) {
+			testSegment(i);
+		}
 	}
+	return nearestPoint;
+}
+
+//----------------------------------------------------------
+ofPoint ofPolyline::getClosestPoint(const ofPoint& target, unsigned int* nearestIndex) const {
+	const ofPolyline & polyline = *this;
+    
+	if(polyline.size() < 2) {
+		if(nearestIndex != nullptr) {
+			nearestIndex = 0;
+		}
+		return target;
+	}
+	
+	unsigned int nearest;
+	float normalizedPosition;
+	ofPoint nearestPoint = findClosestPoint(target, getSpatialIndex(1), nearest, normalizedPosition);
 	
 	if(nearestIndex != nullptr) {
 		if(normalizedPosition > .5) {
@@ -567,6 +838,37 @@ ofPoint ofPolyline::getClosestPoint(const ofPoint& target, unsigned int* nearest
 	return nearestPoint;
 }
 
+//----------------------------------------------------------
+void ofPolyline::getClosestPoints(const vector<ofPoint> & targets, vector<ofPoint> & closest, vector<unsigned int> * nearestIndices) const {
+	closest.resize(targets.size());
+	if(nearestIndices != nullptr) {
+		nearestIndices->resize(targets.size());
+	}
+	if(size() < 2) {
+		closest = targets;
+		if(nearestIndices != nullptr) {
+			std::fill(nearestIndices->begin(), nearestIndices->end(), 0);
+		}
+		return;
+	}
+
+	auto index = getSpatialIndex(targets.size());
+	for(size_t i = 0; i < targets.size(); i++) {
+		unsigned int nearest;
+		float normalizedPosition;
+		closest[i] = findClosestPoint(targets[i], index, nearest, normalizedPosition);
+		if(nearestIndices != nullptr) {
+			if(normalizedPosition > .5) {
+				nearest++;
+				if(nearest == size()) {
+					nearest = 0;
+				}
+			}
+			(*nearestIndices)[i] = nearest;
+		}
+	}
+}
+
 //--------------------------------------------------
 bool ofPolyline::inside(const ofPoint & p, const ofPolyline & polyline){
 	return ofPolyline::inside(p.x,p.y,polyline);
@@ -574,6 +876,11 @@ bool ofPolyline::inside(const ofPoint & p, const ofPolyline & polyline){
 
 //--------------------------------------------------
 bool ofPolyline::inside(float x, float y, const ofPolyline & polyline){
+	auto index = polyline.getSpatialIndex(1);
+	if(index){
+		return index->inside(x, y);
+	}
+
 	int counter = 0;
 	int i;
 	double xinters;
@@ -602,6 +909,19 @@ bool ofPolyline::inside(float x, float y, const ofPolyline & polyline){
 	else return true;
 }
 
+//--------------------------------------------------
+void ofPolyline::inside(const vector<ofPoint> & points, vector<bool> & result) const {
+	result.resize(points.size());
+	if(this->points.empty()){
+		std::fill(result.begin(), result.end(), false);
+		return;
+	}
+	auto index = getSpatialIndex(points.size());
+	for(size_t i = 0; i < points.size(); i++){
+		result[i] = index ? index->inside(points[i].x, points[i].y) : inside(points[i].x, points[i].y, *this);
+	}
+}
+
 //--------------------------------------------------
 bool ofPolyline::inside(float x, float y) const {
     return ofPolyline::inside(x, y, *this);
@@ -733,7 +1053,7 @@ void ofPolyline::simplify(float tol){
 	}else{
 		points = sV;
 	}
-    
+    flagHasChanged();
 }
 
 //--------------------------------------------------
@@ -744,7 +1064,8 @@ void ofPolyline::draw() const{
 //--------------------------------------------------
 void ofPolyline::setRightVector(ofVec3f v) {
     rightVector = v;
-    flagHasChanged();
+    bHasChanged = true;
+    normalsValid = 0;
 }
 
 //--------------------------------------------------
@@ -756,7 +1077,7 @@ ofVec3f ofPolyline::getRightVector() const {
 //--------------------------------------------------
 float ofPolyline::getIndexAtLength(float length) const {
     if(points.size() < 2) return 0;
-    updateCache();
+    updateLengths();
     
     float totalLength = getPerimeter();
     length = ofClamp(length, 0, totalLength);
@@ -796,14 +1117,14 @@ float ofPolyline::getIndexAtPercent(float f) const {
 //--------------------------------------------------
 float ofPolyline::getLengthAtIndex(int index) const {
     if(points.size() < 2) return 0;
-    updateCache();
+    updateLengths();
     return lengths[getWrappedIndex(index)];
 }
 
 //--------------------------------------------------
 float ofPolyline::getLengthAtIndexInterpolated(float findex) const {
     if(points.size() < 2) return 0;
-    updateCache();
+    updateLengths();
     int i1, i2;
     float t;
     getInterpolationParams(findex, i1, i2, t);
@@ -814,7 +1135,7 @@ float ofPolyline::getLengthAtIndexInterpolated(float findex) const {
 //--------------------------------------------------
 ofPoint ofPolyline::getPointAtLength(float f) const {
     if(points.size() < 2) return ofPoint();
-    updateCache();
+    updateLengths();
     return getPointAtIndexInterpolated(getIndexAtLength(f));
 }
 
@@ -840,7 +1161,7 @@ ofPoint ofPolyline::getPointAtIndexInterpolated(float findex) const {
 //--------------------------------------------------
 float ofPolyline::getAngleAtIndex(int index) const {
     if(points.size() < 2) return 0;
-    updateCache();
+    updateVertexData();
     return angles[getWrappedIndex(index)];
 }
 
@@ -856,7 +1177,7 @@ float ofPolyline::getAngleAtIndexInterpolated(float findex) const {
 //--------------------------------------------------
 ofVec3f ofPolyline::getRotationAtIndex(int index) const {
     if(points.size() < 2) return ofVec3f();
-    updateCache();
+    updateVertexData();
     return rotations[getWrappedIndex(index)];
 }
 
@@ -872,7 +1193,7 @@ ofVec3f ofPolyline::getRotationAtIndexInterpolated(float findex) const {
 //--------------------------------------------------
 ofVec3f ofPolyline::getTangentAtIndex(int index) const {
     if(points.size() < 2) return ofVec3f();
-    updateCache();
+    updateVertexData();
     return tangents[getWrappedIndex(index)];
 }
 
@@ -888,7 +1209,7 @@ ofVec3f ofPolyline::getTangentAtIndexInterpolated(float findex) const {
 //--------------------------------------------------
 ofVec3f ofPolyline::getNormalAtIndex(int index) const {
     if(points.size() < 2) return ofVec3f();
-    updateCache();
+    updateNormals();
     return normals[getWrappedIndex(index)];
 }
 
@@ -903,7 +1224,7 @@ ofVec3f ofPolyline::getNormalAtIndexInterpolated(float findex) const {
 
 
 //--------------------------------------------------
-void ofPolyline::calcData(int index, ofVec3f &tangent, float &angle, ofVec3f &rotation, ofVec3f &normal) const {
+void ofPolyline::calcData(int index, ofVec3f &tangent, float &angle, ofVec3f &rotation) const {
     int i1 = getWrappedIndex(index - 1);
     int i2 = getWrappedIndex(index);
     int i3 = getWrappedIndex(index + 1);
@@ -922,9 +1243,6 @@ void ofPolyline::calcData(int index, ofVec3f &tangent, float &angle, ofVec3f &ro
     
     rotation = v1.getCrossed(v2);
     angle = 180 - ofRadToDeg(acos(ofClamp(v1.x * v2.x + v1.y * v2.y + v1.z * v2.z, -1, 1)));
-
-    normal = rightVector.getCrossed(tangent);
-    normal.normalize();
 }
 
 
@@ -946,70 +1264,118 @@ void ofPolyline::getInterpolationParams(float findex, int &i1, int &i2, float &t
 }
 
 //--------------------------------------------------
-void ofPolyline::updateCache(bool bForceUpdate) const {
-    if(bCacheIsDirty || bForceUpdate) {
+void ofPolyline::updateLengths() const {
+    if(points.size() < 2) {
         lengths.clear();
-        angles.clear();
-        rotations.clear();
-        normals.clear();
-        tangents.clear();
+        lengthsValid = 0;
+        return;
+    }
+    if(lengthsValid == points.size()) return;
+
+    // keep the lengths of the vertices that didn't change and continue
+    // from the last one, the closing length is always recalculated
+    lengths.resize(lengthsValid);
+    float length = 0;
+    if(lengthsValid > 0) {
+        length = lengths.back() + points[lengthsValid - 1].distance(points[lengthsValid]);
+    }
+    for(int i=lengthsValid; i<(int)points.size(); i++) {
+        lengths.push_back(length);
+        length += points[i].distance(points[getWrappedIndex(i + 1)]);
+    }
+
+    if(isClosed()) lengths.push_back(length);
+    lengthsValid = points.size();
+}
+
+//--------------------------------------------------
+void ofPolyline::updateArea() const {
+    if(points.size() < 2) {
         area = 0;
+        areaSum = 0;
         centroid2D.set(0, 0, 0);
-        bCacheIsDirty = false;
-        
-        if(points.size() < 2) return;
+        centroidSum.set(0, 0, 0);
+        areaValid = 0;
+        return;
+    }
+    if(areaValid == points.size()) return;
 
-        // area
-        for(int i=0;i<(int)points.size()-1;i++){
-            area += points[i].x * points[i+1].y - points[i+1].x * points[i].y;
-        }
-        area += points[points.size()-1].x * points[0].y - points[0].x * points[points.size()-1].y;
-        area *= 0.5;
-        
-        if(fabsf(area) < FLT_EPSILON) {
-            centroid2D = getBoundingBox().getCenter();
-        } else {
-            // centroid
-            // TODO: doesn't seem to work on all concave shapes
-            for(int i=0;i<(int)points.size()-1;i++){
-                centroid2D.x += (points[i].x + points[i+1].x) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
-                centroid2D.y += (points[i].y + points[i+1].y) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
-            }
-            centroid2D.x += (points[points.size()-1].x + points[0].x) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
-            centroid2D.y += (points[points.size()-1].y + points[0].y) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
-            
-            centroid2D.x /= (6*area);
-            centroid2D.y /= (6*area);
-        }
+    if(areaValid == 0) {
+        areaSum = 0;
+        centroidSum.set(0, 0, 0);
+        areaValid = 1;
+    }
+    // sums over the segments between vertices, the closing segment is
+    // added at the end so more vertices can be added to the sums later
+    for(int i=areaValid-1;i<(int)points.size()-1;i++){
+        areaSum += points[i].x * points[i+1].y - points[i+1].x * points[i].y;
+        centroidSum.x += (points[i].x + points[i+1].x) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
+        centroidSum.y += (points[i].y + points[i+1].y) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
+    }
+    areaValid = points.size();
 
-        
-        // per vertex cache
-        lengths.resize(points.size());
-        tangents.resize(points.size());
-        angles.resize(points.size());
-        normals.resize(points.size());
-        rotations.resize(points.size());
-        
-        float angle;
-        ofVec3f rotation;
-        ofVec3f normal;
-        ofVec3f tangent;
-
-        float length = 0;
-        for(int i=0; i<(int)points.size(); i++) {
-            lengths[i] = length;
-
-            calcData(i, tangent, angle, rotation, normal);
-            tangents[i] = tangent;
-            angles[i] = angle;
-            rotations[i] = rotation;
-            normals[i] = normal;
-            
-            length += points[i].distance(points[getWrappedIndex(i + 1)]);
-        }
-        
-        if(isClosed()) lengths.push_back(length);
+    area = areaSum;
+    area += points[points.size()-1].x * points[0].y - points[0].x * points[points.size()-1].y;
+    area *= 0.5;
+
+    if(fabsf(area) < FLT_EPSILON) {
+        centroid2D = getBoundingBox().getCenter();
+    } else {
+        // centroid
+        // TODO: doesn't seem to work on all concave shapes
+        centroid2D = centroidSum;
+        centroid2D.x += (points[points.size()-1].x + points[0].x) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
+        centroid2D.y += (points[points.size()-1].y + points[0].y) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
+
+        centroid2D.x /= (6*area);
+        centroid2D.y /= (6*area);
+    }
+}
+
+//--------------------------------------------------
+void ofPolyline::updateVertexData() const {
+    if(points.size() < 2) {
+        tangents.clear();
+        angles.clear();
+        rotations.clear();
+        vertexDataValid = 0;
+        return;
+    }
+    if(vertexDataValid == points.size()) return;
+
+    tangents.resize(points.size());
+    angles.resize(points.size());
+    rotations.resize(points.size());
+    for(int i=vertexDataValid; i<(int)points.size(); i++) {
+        calcData(i, tangents[i], angles[i], rotations[i]);
+    }
+    // the first vertex of a closed polyline depends on the last one
+    if(isClosed() && vertexDataValid > 0) {
+        calcData(0, tangents[0], angles[0], rotations[0]);
+    }
+    vertexDataValid = points.size();
+}
+
+//--------------------------------------------------
+void ofPolyline::updateNormals() const {
+    updateVertexData();
+    if(points.size() < 2) {
+        normals.clear();
+        normalsValid = 0;
+        return;
+    }
+    if(normalsValid == points.size()) return;
+
+    normals.resize(points.size());
+    for(int i=normalsValid; i<(int)points.size(); i++) {
+        normals[i] = rightVector.getCrossed(tangents[i]);
+        normals[i].normalize();
+    }
+    if(isClosed() && normalsValid > 0) {
+        normals[0] = rightVector.getCrossed(tangents[0]);
+        normals[0].normalize();
     }
+    normalsValid = points.size();
 }
 
 
@@ -376,6 +376,16 @@ public:
 	static bool inside(const ofPoint & p, const ofPolyline & polyline);
     /// \brief Tests whether the ofPoint is within a closed ofPolyline.
 	bool inside(const ofPoint & p) const;
+
+	/// \brief Tests whether each of the points is within a closed ofPolyline.
+	///
+	/// Faster than testing the points one by one for big polylines, the
+	/// edges are sorted in horizontal bands so every point is only tested
+	/// against the edges that cross its band.
+	///
+	/// \param points The points to test.
+	/// \param result Set to one value per point, true if it's inside.
+	void inside(const vector<ofPoint> & points, vector<bool> & result) const;
     
 	/// \brief Get the bounding box of the polyline , taking into account 
 	/// all the points to determine the extents of the polyline.
@@ -396,6 +406,18 @@ public:
 	/// optionally pass a pointer to/address of an unsigned int to get the
 	/// index of the closest vertex	
 	ofPoint getClosestPoint(const ofPoint& target, unsigned int* nearestIndex = nullptr) const;
+
+	/// \brief Gets the point on the line closest to each of the targets.
+	///
+	/// Same as calling getClosestPoint for every target but the segments of
+	/// big polylines are sorted in a grid so only the segments around each
+	/// target are tested.
+	///
+	/// \param targets The points to find the closest points to.
+	/// \param closest Set to the closest point for each target.
+	/// \param nearestIndices If not null set to the index of the closest
+	/// vertex for each target.
+	void getClosestPoints(const vector<ofPoint> & targets, vector<ofPoint> & closest, vector<unsigned int> * nearestIndices = nullptr) const;
 	
 
 	/// \}
@@ -485,7 +507,10 @@ private:
 	vector<ofPoint> points;
     ofVec3f rightVector;
     
-    // cache
+    // cache, every attribute is only computed when it's requested. the
+    // *Valid counters store how many vertices from the start still have
+    // valid values, so when vertices are only appended just the new ones
+    // are computed
     mutable vector<float> lengths;    // cumulative lengths, stored per point (lengths[n] is the distance to the n'th point, zero based)
     mutable vector<ofVec3f> tangents;   // tangent at vertex, stored per point
     mutable vector<ofVec3f> normals;    //
@@ -493,6 +518,12 @@ private:
     mutable vector<float> angles;    // angle (degrees) between adjacent segments, stored per point (asin(cross product))
     mutable ofPoint centroid2D;
     mutable float area;
+    mutable float areaSum;   // area and centroid sums without the closing segment, so they can be extended
+    mutable ofPoint centroidSum;
+    mutable size_t lengthsValid;
+    mutable size_t areaValid;
+    mutable size_t vertexDataValid;   // tangents, rotations and angles
+    mutable size_t normalsValid;
     
     
 	deque<ofPoint> curveVertices;
@@ -500,13 +531,29 @@ private:
 
 	bool bClosed;
 	bool bHasChanged;   // public API has access to this
-    mutable bool bCacheIsDirty;   // used only internally, no public API to read
     
-    void updateCache(bool bForceUpdate = false) const;
+    // flags the polyline as changed and discards the cached values that
+    // depend on vertices from firstVertex on
+    void flagVerticesChanged(size_t firstVertex);
+    
+    void updateLengths() const;
+    void updateArea() const;
+    void updateVertexData() const;
+    void updateNormals() const;
     
     // given an interpolated index (e.g. 5.75) return neighboring indices and interolation factor (e.g. 5, 6, 0.75)
     void getInterpolationParams(float findex, int &i1, int &i2, float &t) const;
     
-    void calcData(int index, ofVec3f &tangent, float &angle, ofVec3f &rotation, ofVec3f &normal) const;
+    void calcData(int index, ofVec3f &tangent, float &angle, ofVec3f &rotation) const;
+
+    // grid of segments and bands of edges used to accelerate getClosestPoint
+    // and inside on big polylines, built on demand once the polyline is
+    // queried more than once without changing. it's never modified once
+    // built so copies of the polyline can share it
+    struct SpatialIndex;
+    mutable shared_ptr<const SpatialIndex> spatialIndex;
+    mutable size_t queriesSinceChange;
+    const SpatialIndex * getSpatialIndex(size_t numQueries) const;
+    ofPoint findClosestPoint(const ofPoint& target, const SpatialIndex * index, unsigned int & segment, float & normalizedPosition) const;
 };
 
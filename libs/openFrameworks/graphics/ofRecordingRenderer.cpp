@@ -0,0 +1,1681 @@
+#include "ofRecordingRenderer.h"
+#include "ofImage.h"
+#include "ofTrueTypeFont.h"
+#include "ofCamera.h"
+#include "of3dPrimitives.h"
+#include <cstring>
+
+const string ofRecordingRenderer::TYPE="recording";
+
+enum ofRecordingRenderer::Command: unsigned char{
+	DrawPolyline,
+	DrawPath,
+	DrawMesh,
+	DrawImage,
+	DrawFloatImage,
+	DrawShortImage,
+	DrawVideo,
+	PushView,
+	PopView,
+	Viewport,
+	SetupScreenPerspective,
+	SetupScreenOrtho,
+	SetOrientation,
+	SetCoordHandedness,
+	PushMatrix,
+	PopMatrix,
+	Translate,
+	Scale,
+	Rotate,
+	MatrixMode,
+	LoadIdentityMatrix,
+	LoadMatrix,
+	MultMatrix,
+	LoadViewMatrix,
+	MultViewMatrix,
+	BindCamera,
+	UnbindCamera,
+	SetupGraphicDefaults,
+	SetupScreen,
+	SetRectMode,
+	SetFillMode,
+	SetLineWidth,
+	SetDepthTest,
+	SetBlendMode,
+	SetLineSmoothing,
+	SetCircleResolution,
+	EnableAntiAliasing,
+	DisableAntiAliasing,
+	SetColor,
+	SetBitmapTextMode,
+	SetBackgroundColor,
+	Background,
+	SetBackgroundAuto,
+	Clear,
+	ClearColor,
+	ClearAlpha,
+	DrawLine,
+	DrawRectangle,
+	DrawTriangle,
+	DrawCircle,
+	DrawEllipse,
+	DrawString,
+	DrawStringFont,
+	SetStyle,
+	PushStyle,
+	PopStyle,
+	SetCurveResolution,
+	SetPolyMode,
+	NumCommands
+};
+
+// format of the serialized recordings, increase when the commands change
+static const char recordingMagic[] = {'o','f','r','e','c'};
+static const unsigned int recordingVersion = 1;
+
+namespace{
+	// 64 bit FNV-1a, used to find identical meshes and polylines
+	class Hash{
+	public:
+		unsigned long long value = 14695981039346656037ULL;
+
+		void add(const void * data, size_t size){
+			auto bytes = static_cast<const unsigned char*>(data);
+			for(size_t i=0;i<size;i++){
+				value ^= bytes[i];
+				value *= 1099511628211ULL;
+			}
+		}
+
+		template<typename T>
+		void add(const vector<T> & v){
+			size_t size = v.size();
+			add(&size, sizeof(size));
+			if(!v.empty()){
+				add(v.data(), v.size() * sizeof(T));
+			}
+		}
+	};
+
+	// reads values written with ofRecordingRenderer::write or Writer,
+	// reading past the end sets ok to false and returns zeros
+	class Reader{
+	public:
+		Reader(const unsigned char * data, size_t size)
+		:data(data)
+		,end(data + size)
+		,ok(true){}
+
+		void read(void * dst, size_t size){
+			if(size_t(end - data) < size){
+				ok = false;
+				memset(dst, 0, size);
+				return;
+			}
+			memcpy(dst, data, size);
+			data += size;
+		}
+
+		template<typename T>
+		T read(){
+			T value;
+			read(&value, sizeof(T));
+			return value;
+		}
+
+		template<typename T>
+		void read(vector<T> & v){
+			auto size = read<unsigned int>();
+			if(size_t(end - data) / sizeof(T) < size){
+				ok = false;
+				v.clear();
+				return;
+			}
+			v.resize(size);
+			if(size){
+				read(v.data(), size * sizeof(T));
+			}
+		}
+
+		string readString(){
+			auto size = read<unsigned int>();
+			if(size_t(end - data) < size){
+				ok = false;
+				return "";
+			}
+			string str(reinterpret_cast<const char*>(data), size);
+			data += size;
+			return str;
+		}
+
+		size_t remaining() const{
+			return end - data;
+		}
+
+		bool atEnd() const{
+			return data == end;
+		}
+
+		const unsigned char * data;
+		const unsigned char * end;
+		bool ok;
+	};
+
+	class Writer{
+	public:
+		Writer(ofBuffer & buffer)
+		:buffer(buffer){}
+
+		template<typename T>
+		void write(const T & value){
+			buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		void write(const vector<T> & v){
+			write<unsigned int>(v.size());
+			if(!v.empty()){
+				buffer.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+			}
+		}
+
+		void writeString(const string & str){
+			write<unsigned int>(str.size());
+			buffer.append(str.c_str(), str.size());
+		}
+
+		ofBuffer & buffer;
+	};
+
+	unsigned long long hashOf(const ofMesh & mesh){
+		Hash hash;
+		auto mode = mesh.getMode();
+		bool usage[] = {mesh.usingColors(), mesh.usingTextures(), mesh.usingNormals(), mesh.usingIndices()};
+		hash.add(&mode, sizeof(mode));
+		hash.add(usage, sizeof(usage));
+		hash.add(mesh.getVertices());
+		hash.add(mesh.getColors());
+		hash.add(mesh.getNormals());
+		hash.add(mesh.getTexCoords());
+		hash.add(mesh.getIndices());
+		return hash.value;
+	}
+
+	bool equal(const ofMesh & m1, const ofMesh & m2){
+		return m1.getMode() == m2.getMode() &&
+			m1.usingColors() == m2.usingColors() &&
+			m1.usingTextures() == m2.usingTextures() &&
+			m1.usingNormals() == m2.usingNormals() &&
+			m1.usingIndices() == m2.usingIndices() &&
+			m1.getVertices() == m2.getVertices() &&
+			m1.getColors() == m2.getColors() &&
+			m1.getNormals() == m2.getNormals() &&
+			m1.getTexCoords() == m2.getTexCoords() &&
+			m1.getIndices() == m2.getIndices();
+	}
+
+	unsigned long long hashOf(const ofPolyline & polyline){
+		Hash hash;
+		bool closed = polyline.isClosed();
+		hash.add(&closed, sizeof(closed));
+		hash.add(polyline.getVertices());
+		return hash.value;
+	}
+
+	bool equal(const ofPolyline & p1, const ofPolyline & p2){
+		return p1.isClosed() == p2.isClosed() && p1.getVertices() == p2.getVertices();
+	}
+
+	void writeMesh(Writer & writer, const ofMesh & mesh){
+		writer.write<int>(mesh.getMode());
+		writer.write<unsigned char>(mesh.usingColors());
+		writer.write<unsigned char>(mesh.usingTextures());
+		writer.write<unsigned char>(mesh.usingNormals());
+		writer.write<unsigned char>(mesh.usingIndices());
+		writer.write(mesh.getVertices());
+		writer.write(mesh.getColors());
+		writer.write(mesh.getNormals());
+		writer.write(mesh.getTexCoords());
+		writer.write(mesh.getIndices());
+	}
+
+	void readMesh(Reader & reader, ofMesh & mesh){
+		mesh.setMode(ofPrimitiveMode(reader.read<int>()));
+		bool colors = reader.read<unsigned char>();
+		bool textures = reader.read<unsigned char>();
+		bool normals = reader.read<unsigned char>();
+		bool indices = reader.read<unsigned char>();
+		reader.read(mesh.getVertices());
+		reader.read(mesh.getColors());
+		reader.read(mesh.getNormals());
+		reader.read(mesh.getTexCoords());
+		reader.read(mesh.getIndices());
+		colors ? mesh.enableColors() : mesh.disableColors();
+		textures ? mesh.enableTextures() : mesh.disableTextures();
+		normals ? mesh.enableNormals() : mesh.disableNormals();
+		indices ? mesh.enableIndices() : mesh.disableIndices();
+	}
+
+	void writePolyline(Writer & writer, const ofPolyline & polyline){
+		writer.write<unsigned char>(polyline.isClosed());
+		writer.write(polyline.getVertices());
+	}
+
+	void readPolyline(Reader & reader, ofPolyline & polyline){
+		bool closed = reader.read<unsigned char>();
+		vector<ofPoint> vertices;
+		reader.read(vertices);
+		polyline.clear();
+		polyline.addVertices(vertices);
+		polyline.setClosed(closed);
+	}
+
+	void writePath(Writer & writer, const ofPath & constPath){
+		// some of the ofPath getters aren't const
+		auto & path = const_cast<ofPath&>(constPath);
+		writer.write<int>(path.getMode());
+		writer.write<unsigned char>(path.isFilled());
+		writer.write(path.getFillColor());
+		writer.write(path.getStrokeColor());
+		writer.write(path.getStrokeWidth());
+		writer.write<int>(path.getWindingMode());
+		writer.write<unsigned char>(path.getUseShapeColor());
+		writer.write<int>(path.getCurveResolution());
+		writer.write<int>(path.getCircleResolution());
+		if(path.getMode() == ofPath::COMMANDS){
+			auto & commands = path.getCommands();
+			writer.write<unsigned int>(commands.size());
+			for(auto & command: commands){
+				writer.write<int>(command.type);
+				writer.write(command.to);
+				writer.write(command.cp1);
+				writer.write(command.cp2);
+				writer.write(command.radiusX);
+				writer.write(command.radiusY);
+				writer.write(command.angleBegin);
+				writer.write(command.angleEnd);
+			}
+		}else{
+			auto & outline = path.getOutline();
+			writer.write<unsigned int>(outline.size());
+			for(auto & polyline: outline){
+				writePolyline(writer, polyline);
+			}
+		}
+	}
+
+	void readPath(Reader & reader, ofPath & path){
+		auto mode = ofPath::Mode(reader.read<int>());
+		path.clear();
+		path.setMode(mode);
+		path.setFilled(reader.read<unsigned char>());
+		path.setFillColor(reader.read<ofColor>());
+		path.setStrokeColor(reader.read<ofColor>());
+		path.setStrokeWidth(reader.read<float>());
+		path.setPolyWindingMode(ofPolyWindingMode(reader.read<int>()));
+		path.setUseShapeColor(reader.read<unsigned char>());
+		path.setCurveResolution(reader.read<int>());
+		path.setCircleResolution(reader.read<int>());
+		auto size = reader.read<unsigned int>();
+		if(mode == ofPath::COMMANDS){
+			for(unsigned int i=0;i<size && reader.ok;i++){
+				ofPath::Command command(ofPath::Command::Type(reader.read<int>()));
+				command.to = reader.read<ofPoint>();
+				command.cp1 = reader.read<ofPoint>();
+				command.cp2 = reader.read<ofPoint>();
+				command.radiusX = reader.read<float>();
+				command.radiusY = reader.read<float>();
+				command.angleBegin = reader.read<float>();
+				command.angleEnd = reader.read<float>();
+				path.getCommands().push_back(command);
+			}
+		}else{
+			for(unsigned int i=0;i<size && reader.ok;i++){
+				ofPolyline polyline;
+				readPolyline(reader, polyline);
+				for(auto & v: polyline.getVertices()){
+					if(&v == &polyline.getVertices().front()){
+						path.moveTo(v);
+					}else{
+						path.lineTo(v);
+					}
+				}
+				if(polyline.isClosed()){
+					path.close();
+				}
+			}
+		}
+	}
+
+	void writeStyle(vector<unsigned char> & commands, const ofStyle & style){
+		auto append = [&](const void * data, size_t size){
+			auto bytes = static_cast<const unsigned char*>(data);
+			commands.insert(commands.end(), bytes, bytes + size);
+		};
+		int values[] = {style.polyMode, style.rectMode, style.bFill, style.drawBitmapMode, style.blendingMode, style.smoothing, style.circleResolution, style.sphereResolution, style.curveResolution};
+		append(&style.color, sizeof(style.color));
+		append(&style.bgColor, sizeof(style.bgColor));
+		append(values, sizeof(values));
+		append(&style.lineWidth, sizeof(style.lineWidth));
+	}
+
+	ofStyle readStyle(Reader & reader){
+		ofStyle style;
+		style.color = reader.read<ofColor>();
+		style.bgColor = reader.read<ofColor>();
+		style.polyMode = ofPolyWindingMode(reader.read<int>());
+		style.rectMode = ofRectMode(reader.read<int>());
+		style.bFill = reader.read<int>();
+		style.drawBitmapMode = ofDrawBitmapMode(reader.read<int>());
+		style.blendingMode = ofBlendMode(reader.read<int>());
+		style.smoothing = reader.read<int>();
+		style.circleResolution = reader.read<int>();
+		style.sphereResolution = reader.read<int>();
+		style.curveResolution = reader.read<int>();
+		style.lineWidth = reader.read<float>();
+		return style;
+	}
+
+	template<typename T>
+	const T * readPointer(Reader & reader){
+		return static_cast<const T*>(reader.read<const void*>());
+	}
+}
+
+//----------------------------------------------------------
+ofRecordingRenderer::ofRecordingRenderer()
+:numCommands(0)
+,numReferences(0)
+,bBackgroundAuto(true)
+,currentMatrixMode(OF_MATRIX_MODELVIEW)
+,vFlipped(true)
+,handedness(OF_LEFT_HANDED)
+,graphics3d(this){
+	path.setMode(ofPath::COMMANDS);
+	path.setUseShapeColor(false);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setup(float width, float height){
+	nativeViewport.set(0, 0, width, height);
+	currentViewport = nativeViewport;
+}
+
+//----------------------------------------------------------
+template<typename T>
+void ofRecordingRenderer::write(const T & value) const{
+	auto bytes = reinterpret_cast<const unsigned char*>(&value);
+	commands.insert(commands.end(), bytes, bytes + sizeof(T));
+}
+
+//----------------------------------------------------------
+template<typename T, typename... Args>
+void ofRecordingRenderer::write(const T & value, const Args&... args) const{
+	write(value);
+	write(args...);
+}
+
+//----------------------------------------------------------
+template<typename... Args>
+void ofRecordingRenderer::record(Command command, const Args&... args) const{
+	commands.push_back(command);
+	write(args...);
+	numCommands++;
+}
+
+// commands without arguments
+template<>
+void ofRecordingRenderer::record(Command command) const{
+	commands.push_back(command);
+	numCommands++;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getArgumentsSize(unsigned char command){
+	const int pointer = sizeof(const void*);
+	switch(command){
+	case DrawPolyline:
+	case DrawPath:
+		return sizeof(unsigned int);
+	case DrawMesh:
+		return sizeof(unsigned int) + 4;
+	case DrawImage:
+	case DrawFloatImage:
+	case DrawShortImage:
+		return pointer + 9 * sizeof(float);
+	case DrawVideo:
+		return pointer + 4 * sizeof(float);
+	case PushView:
+	case PopView:
+	case PushMatrix:
+	case PopMatrix:
+	case LoadIdentityMatrix:
+	case SetupGraphicDefaults:
+	case SetupScreen:
+	case EnableAntiAliasing:
+	case DisableAntiAliasing:
+	case Clear:
+	case ClearAlpha:
+	case PushStyle:
+	case PopStyle:
+		return 0;
+	case Viewport:
+		return 4 * sizeof(float) + 1;
+	case SetupScreenPerspective:
+		return 5 * sizeof(float);
+	case SetupScreenOrtho:
+		return 4 * sizeof(float);
+	case SetOrientation:
+		return sizeof(int) + 1;
+	case SetCoordHandedness:
+	case MatrixMode:
+	case SetRectMode:
+	case SetFillMode:
+	case SetBlendMode:
+	case SetCircleResolution:
+	case SetBitmapTextMode:
+	case SetCurveResolution:
+	case SetPolyMode:
+		return sizeof(int);
+	case Translate:
+	case Scale:
+		return sizeof(ofVec3f);
+	case Rotate:
+		return sizeof(float) + sizeof(ofVec3f);
+	case LoadMatrix:
+	case MultMatrix:
+	case LoadViewMatrix:
+	case MultViewMatrix:
+		return sizeof(ofMatrix4x4);
+	case BindCamera:
+		return pointer + sizeof(ofRectangle);
+	case UnbindCamera:
+		return pointer;
+	case SetLineWidth:
+		return sizeof(float);
+	case SetDepthTest:
+	case SetLineSmoothing:
+	case SetBackgroundAuto:
+		return 1;
+	case SetColor:
+	case SetBackgroundColor:
+	case Background:
+		return sizeof(ofColor);
+	case ClearColor:
+		return 4 * sizeof(float);
+	case DrawLine:
+		return 6 * sizeof(float);
+	case DrawRectangle:
+		return 5 * sizeof(float);
+	case DrawTriangle:
+		return 9 * sizeof(float);
+	case DrawCircle:
+		return 4 * sizeof(float);
+	case DrawEllipse:
+		return 5 * sizeof(float);
+	case DrawString:
+		return sizeof(unsigned int) + sizeof(ofVec3f);
+	case DrawStringFont:
+		return pointer + sizeof(unsigned int) + sizeof(ofVec2f);
+	case SetStyle:
+		return 2 * sizeof(ofColor) + 9 * sizeof(int) + sizeof(float);
+	default:
+		return -1;
+	}
+}
+
+//----------------------------------------------------------
+unsigned int ofRecordingRenderer::intern(const ofMesh & mesh) const{
+	auto & candidates = meshIndex[hashOf(mesh)];
+	for(auto index: candidates){
+		if(equal(meshes[index], mesh)){
+			return index;
+		}
+	}
+	unsigned int index = meshes.size();
+	meshes.push_back(mesh);
+	candidates.push_back(index);
+	return index;
+}
+
+//----------------------------------------------------------
+unsigned int ofRecordingRenderer::intern(const ofPolyline & polyline) const{
+	auto & candidates = polylineIndex[hashOf(polyline)];
+	for(auto index: candidates){
+		if(equal(polylines[index], polyline)){
+			return index;
+		}
+	}
+	unsigned int index = polylines.size();
+	polylines.push_back(polyline);
+	candidates.push_back(index);
+	return index;
+}
+
+//----------------------------------------------------------
+unsigned int ofRecordingRenderer::intern(const string & text) const{
+	auto it = stringIndex.find(text);
+	if(it != stringIndex.end()){
+		return it->second;
+	}
+	unsigned int index = strings.size();
+	strings.push_back(text);
+	stringIndex[text] = index;
+	return index;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::replay(ofBaseRenderer & renderer) const{
+	auto inRange = [](unsigned int index, size_t size, const char * type){
+		if(index < size){
+			return true;
+		}
+		ofLogError("ofRecordingRenderer") << "replay(): " << type << " " << index << " out of range, recording is corrupted";
+		return false;
+	};
+	Reader reader(commands.data(), commands.size());
+	while(!reader.atEnd()){
+		auto command = Command(reader.read<unsigned char>());
+		auto argumentsSize = getArgumentsSize(command);
+		if(argumentsSize < 0){
+			ofLogError("ofRecordingRenderer") << "replay(): unknown command " << int(command) << ", recording is corrupted";
+			return;
+		}
+		if(reader.remaining() < size_t(argumentsSize)){
+			ofLogError("ofRecordingRenderer") << "replay(): recording ends in the middle of a command";
+			return;
+		}
+		switch(command){
+		case DrawPolyline:{
+			auto index = reader.read<unsigned int>();
+			if(!inRange(index, polylines.size(), "polyline")) return;
+			renderer.draw(polylines[index]);
+			break;
+		}
+		case DrawPath:{
+			auto index = reader.read<unsigned int>();
+			if(!inRange(index, paths.size(), "path")) return;
+			renderer.draw(paths[index]);
+			break;
+		}
+		case DrawMesh:{
+			auto index = reader.read<unsigned int>();
+			if(!inRange(index, meshes.size(), "mesh")) return;
+			auto & mesh = meshes[index];
+			auto renderType = ofPolyRenderMode(reader.read<unsigned char>());
+			bool useColors = reader.read<unsigned char>();
+			bool useTextures = reader.read<unsigned char>();
+			bool useNormals = reader.read<unsigned char>();
+			renderer.draw(mesh, renderType, useColors, useTextures, useNormals);
+			break;
+		}
+		case DrawImage:
+		case DrawFloatImage:
+		case DrawShortImage:{
+			auto image = reader.read<const void*>();
+			float v[9];
+			reader.read(v, sizeof(v));
+			if(command == DrawImage){
+				renderer.draw(*static_cast<const ofImage*>(image), v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]);
+			}else if(command == DrawFloatImage){
+				renderer.draw(*static_cast<const ofFloatImage*>(image), v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]);
+			}else{
+				renderer.draw(*static_cast<const ofShortImage*>(image), v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]);
+			}
+			break;
+		}
+		case DrawVideo:{
+			auto video = readPointer<ofBaseVideoDraws>(reader);
+			float v[4];
+			reader.read(v, sizeof(v));
+			renderer.draw(*video, v[0], v[1], v[2], v[3]);
+			break;
+		}
+		case PushView:
+			renderer.pushView();
+			break;
+		case PopView:
+			renderer.popView();
+			break;
+		case Viewport:{
+			float v[4];
+			reader.read(v, sizeof(v));
+			bool vflip = reader.read<unsigned char>();
+			renderer.viewport(v[0], v[1], v[2], v[3], vflip);
+			break;
+		}
+		case SetupScreenPerspective:{
+			float v[5];
+			reader.read(v, sizeof(v));
+			renderer.setupScreenPerspective(v[0], v[1], v[2], v[3], v[4]);
+			break;
+		}
+		case SetupScreenOrtho:{
+			float v[4];
+			reader.read(v, sizeof(v));
+			renderer.setupScreenOrtho(v[0], v[1], v[2], v[3]);
+			break;
+		}
+		case SetOrientation:{
+			auto orientation = ofOrientation(reader.read<int>());
+			bool vflip = reader.read<unsigned char>();
+			renderer.setOrientation(orientation, vflip);
+			break;
+		}
+		case SetCoordHandedness:
+			renderer.setCoordHandedness(ofHandednessType(reader.read<int>()));
+			break;
+		case PushMatrix:
+			renderer.pushMatrix();
+			break;
+		case PopMatrix:
+			renderer.popMatrix();
+			break;
+		case Translate:{
+			auto p = reader.read<ofVec3f>();
+			renderer.translate(p.x, p.y, p.z);
+			break;
+		}
+		case Scale:{
+			auto s = reader.read<ofVec3f>();
+			renderer.scale(s.x, s.y, s.z);
+			break;
+		}
+		case Rotate:{
+			auto degrees = reader.read<float>();
+			auto axis = reader.read<ofVec3f>();
+			renderer.rotate(degrees, axis.x, axis.y, axis.z);
+			break;
+		}
+		case MatrixMode:
+			renderer.matrixMode(ofMatrixMode(reader.read<int>()));
+			break;
+		case LoadIdentityMatrix:
+			renderer.loadIdentityMatrix();
+			break;
+		case LoadMatrix:
+			renderer.loadMatrix(reader.read<ofMatrix4x4>());
+			break;
+		case MultMatrix:
+			renderer.multMatrix(reader.read<ofMatrix4x4>());
+			break;
+		case LoadViewMatrix:
+			renderer.loadViewMatrix(reader.read<ofMatrix4x4>());
+			break;
+		case MultViewMatrix:
+			renderer.multViewMatrix(reader.read<ofMatrix4x4>());
+			break;
+		case BindCamera:{
+			auto camera = readPointer<ofCamera>(reader);
+			renderer.bind(*camera, reader.read<ofRectangle>());
+			break;
+		}
+		case UnbindCamera:
+			renderer.unbind(*readPointer<ofCamera>(reader));
+			break;
+		case SetupGraphicDefaults:
+			renderer.setupGraphicDefaults();
+			break;
+		case SetupScreen:
+			renderer.setupScreen();
+			break;
+		case SetRectMode:
+			renderer.setRectMode(ofRectMode(reader.read<int>()));
+			break;
+		case SetFillMode:
+			renderer.setFillMode(ofFillFlag(reader.read<int>()));
+			break;
+		case SetLineWidth:
+			renderer.setLineWidth(reader.read<float>());
+			break;
+		case SetDepthTest:
+			renderer.setDepthTest(reader.read<unsigned char>());
+			break;
+		case SetBlendMode:
+			renderer.setBlendMode(ofBlendMode(reader.read<int>()));
+			break;
+		case SetLineSmoothing:
+			renderer.setLineSmoothing(reader.read<unsigned char>());
+			break;
+		case SetCircleResolution:
+			renderer.setCircleResolution(reader.read<int>());
+			break;
+		case EnableAntiAliasing:
+			renderer.enableAntiAliasing();
+			break;
+		case DisableAntiAliasing:
+			renderer.disableAntiAliasing();
+			break;
+		case SetColor:
+			renderer.setColor(reader.read<ofColor>());
+			break;
+		case SetBitmapTextMode:
+			renderer.setBitmapTextMode(ofDrawBitmapMode(reader.read<int>()));
+			break;
+		case SetBackgroundColor:
+			renderer.setBackgroundColor(reader.read<ofColor>());
+			break;
+		case Background:
+			renderer.background(reader.read<ofColor>());
+			break;
+		case SetBackgroundAuto:
+			renderer.setBackgroundAuto(reader.read<unsigned char>());
+			break;
+		case Clear:
+			renderer.clear();
+			break;
+		case ClearColor:{
+			float c[4];
+			reader.read(c, sizeof(c));
+			renderer.clear(c[0], c[1], c[2], c[3]);
+			break;
+		}
+		case ClearAlpha:
+			renderer.clearAlpha();
+			break;
+		case DrawLine:{
+			float v[6];
+			reader.read(v, sizeof(v));
+			renderer.drawLine(v[0], v[1], v[2], v[3], v[4], v[5]);
+			break;
+		}
+		case DrawRectangle:{
+			float v[5];
+			reader.read(v, sizeof(v));
+			renderer.drawRectangle(v[0], v[1], v[2], v[3], v[4]);
+			break;
+		}
+		case DrawTriangle:{
+			float v[9];
+			reader.read(v, sizeof(v));
+			renderer.drawTriangle(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]);
+			break;
+		}
+		case DrawCircle:{
+			float v[4];
+			reader.read(v, sizeof(v));
+			renderer.drawCircle(v[0], v[1], v[2], v[3]);
+			break;
+		}
+		case DrawEllipse:{
+			float v[5];
+			reader.read(v, sizeof(v));
+			renderer.drawEllipse(v[0], v[1], v[2], v[3], v[4]);
+			break;
+		}
+		case DrawString:{
+			auto index = reader.read<unsigned int>();
+			if(!inRange(index, strings.size(), "string")) return;
+			auto & text = strings[index];
+			auto p = reader.read<ofVec3f>();
+			renderer.drawString(text, p.x, p.y, p.z);
+			break;
+		}
+		case DrawStringFont:{
+			auto font = readPointer<ofTrueTypeFont>(reader);
+			auto index = reader.read<unsigned int>();
+			if(!inRange(index, strings.size(), "string")) return;
+			auto & text = strings[index];
+			auto p = reader.read<ofVec2f>();
+			renderer.drawString(*font, text, p.x, p.y);
+			break;
+		}
+		case SetStyle:
+			renderer.setStyle(readStyle(reader));
+			break;
+		case PushStyle:
+			renderer.pushStyle();
+			break;
+		case PopStyle:
+			renderer.popStyle();
+			break;
+		case SetCurveResolution:
+			renderer.setCurveResolution(reader.read<int>());
+			break;
+		case SetPolyMode:
+			renderer.setPolyMode(ofPolyWindingMode(reader.read<int>()));
+			break;
+		default:
+			ofLogError("ofRecordingRenderer") << "replay(): unknown command " << int(command) << ", recording is corrupted";
+			return;
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clearRecording(){
+	commands.clear();
+	numCommands = 0;
+	numReferences = 0;
+	meshes.clear();
+	polylines.clear();
+	paths.clear();
+	strings.clear();
+	meshIndex.clear();
+	polylineIndex.clear();
+	stringIndex.clear();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumCommands() const{
+	return numCommands;
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumMeshes() const{
+	return meshes.size();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumPolylines() const{
+	return polylines.size();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumPaths() const{
+	return paths.size();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumStrings() const{
+	return strings.size();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getCommandsSize() const{
+	return commands.size();
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::hasReferences() const{
+	return numReferences > 0;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::save(ofBuffer & buffer) const{
+	if(hasReferences()){
+		ofLogError("ofRecordingRenderer") << "save(): the recording draws images, videos, fonts or cameras which can't be saved";
+		return false;
+	}
+	buffer.clear();
+	Writer writer(buffer);
+	buffer.append(recordingMagic, sizeof(recordingMagic));
+	writer.write(recordingVersion);
+	writer.write<unsigned long long>(numCommands);
+	writer.write<unsigned int>(strings.size());
+	for(auto & str: strings){
+		writer.writeString(str);
+	}
+	writer.write<unsigned int>(meshes.size());
+	for(auto & mesh: meshes){
+		writeMesh(writer, mesh);
+	}
+	writer.write<unsigned int>(polylines.size());
+	for(auto & polyline: polylines){
+		writePolyline(writer, polyline);
+	}
+	writer.write<unsigned int>(paths.size());
+	for(auto & path: paths){
+		writePath(writer, path);
+	}
+	writer.write(commands);
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::save(const string & path) const{
+	ofBuffer buffer;
+	if(!save(buffer)){
+		return false;
+	}
+	return ofBufferToFile(path, buffer, true);
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::load(const ofBuffer & buffer){
+	clearRecording();
+	Reader reader(reinterpret_cast<const unsigned char*>(buffer.getData()), buffer.size());
+	char magic[sizeof(recordingMagic)];
+	reader.read(magic, sizeof(magic));
+	if(!reader.ok || memcmp(magic, recordingMagic, sizeof(magic)) != 0){
+		ofLogError("ofRecordingRenderer") << "load(): buffer doesn't contain a recording";
+		return false;
+	}
+	auto version = reader.read<unsigned int>();
+	if(version != recordingVersion){
+		ofLogError("ofRecordingRenderer") << "load(): unsupported recording version " << version;
+		return false;
+	}
+	numCommands = reader.read<unsigned long long>();
+	auto numStrings = reader.read<unsigned int>();
+	for(unsigned int i=0;i<numStrings && reader.ok;i++){
+		strings.push_back(reader.readString());
+		stringIndex[strings.back()] = i;
+	}
+	auto numMeshes = reader.read<unsigned int>();
+	for(unsigned int i=0;i<numMeshes && reader.ok;i++){
+		meshes.emplace_back();
+		readMesh(reader, meshes.back());
+		meshIndex[hashOf(meshes.back())].push_back(i);
+	}
+	auto numPolylines = reader.read<unsigned int>();
+	for(unsigned int i=0;i<numPolylines && reader.ok;i++){
+		polylines.emplace_back();
+		readPolyline(reader, polylines.back());
+		polylineIndex[hashOf(polylines.back())].push_back(i);
+	}
+	auto numPaths = reader.read<unsigned int>();
+	for(unsigned int i=0;i<numPaths && reader.ok;i++){
+		paths.emplace_back();
+		readPath(reader, paths.back());
+	}
+	reader.read(commands);
+	if(!reader.ok){
+		ofLogError("ofRecordingRenderer") << "load(): recording is truncated";
+		clearRecording();
+		return false;
+	}
+
+	// check every command once so replay() can't read past the recording,
+	// recordings with references can't be saved so they can't be loaded
+	Reader commandsReader(commands.data(), commands.size());
+	unsigned long long numRead = 0;
+	while(!commandsReader.atEnd()){
+		auto command = commandsReader.read<unsigned char>();
+		auto argumentsSize = getArgumentsSize(command);
+		string error;
+		if(argumentsSize < 0){
+			error = "unknown command " + ofToString(int(command));
+		}else if(commandsReader.remaining() < size_t(argumentsSize)){
+			error = "recording ends in the middle of a command";
+		}else{
+			auto arguments = commandsReader.data;
+			switch(command){
+			case DrawImage:
+			case DrawFloatImage:
+			case DrawShortImage:
+			case DrawVideo:
+			case BindCamera:
+			case UnbindCamera:
+			case DrawStringFont:
+				error = "command " + ofToString(int(command)) + " references memory of the recording process";
+				break;
+			case DrawPolyline:
+				if(commandsReader.read<unsigned int>() >= polylines.size()) error = "polyline index out of range";
+				break;
+			case DrawPath:
+				if(commandsReader.read<unsigned int>() >= paths.size()) error = "path index out of range";
+				break;
+			case DrawMesh:
+				if(commandsReader.read<unsigned int>() >= meshes.size()) error = "mesh index out of range";
+				break;
+			case DrawString:
+				if(commandsReader.read<unsigned int>() >= strings.size()) error = "string index out of range";
+				break;
+			}
+			commandsReader.data = arguments + argumentsSize;
+		}
+		if(!error.empty()){
+			ofLogError("ofRecordingRenderer") << "load(): " << error << ", recording is corrupted";
+			clearRecording();
+			return false;
+		}
+		numRead++;
+	}
+	if(numRead != numCommands){
+		ofLogError("ofRecordingRenderer") << "load(): recording has " << numRead << " commands instead of " << numCommands;
+		clearRecording();
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::load(const string & path){
+	auto buffer = ofBufferFromFile(path, true);
+	if(buffer.size() == 0){
+		ofLogError("ofRecordingRenderer") << "load(): couldn't read \"" << path << "\"";
+		return false;
+	}
+	return load(buffer);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::startRender(){
+	if(bBackgroundAuto){
+		currentViewport = nativeViewport;
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::finishRender(){
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPolyline & poly) const{
+	record(DrawPolyline, intern(poly));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPath & shape) const{
+	unsigned int index = paths.size();
+	paths.push_back(shape);
+	record(DrawPath, index);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
+	record(DrawMesh, intern(vertexData), (unsigned char)renderType, (unsigned char)useColors, (unsigned char)useTextures, (unsigned char)useNormals);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const of3dPrimitive& model, ofPolyRenderMode renderType) const{
+	auto mut_this = const_cast<ofRecordingRenderer*>(this);
+	mut_this->pushMatrix();
+	mut_this->multMatrix(model.getGlobalTransformMatrix());
+	auto & mesh = const_cast<of3dPrimitive&>(model).getMesh();
+	draw(mesh, renderType, mesh.usingColors(), mesh.usingTextures(), mesh.usingNormals());
+	mut_this->popMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofNode& node) const{
+	auto mut_this = const_cast<ofRecordingRenderer*>(this);
+	mut_this->pushMatrix();
+	mut_this->multMatrix(node.getGlobalTransformMatrix());
+	node.customDraw(this);
+	mut_this->popMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(DrawImage, (const void*)&image, x, y, z, w, h, sx, sy, sw, sh);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(DrawFloatImage, (const void*)&image, x, y, z, w, h, sx, sy, sw, sh);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(DrawShortImage, (const void*)&image, x, y, z, w, h, sx, sy, sw, sh);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const{
+	record(DrawVideo, (const void*)&video, x, y, w, h);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushView(){
+	record(PushView);
+	viewportStack.push(currentViewport);
+	projectionStack.push(projection);
+	modelViewStack.push(modelView);
+	viewStack.push(view);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popView(){
+	record(PopView);
+	if(viewportStack.empty()){
+		ofLogWarning("ofRecordingRenderer") << "popView(): popping view stack without push";
+		return;
+	}
+	currentViewport = viewportStack.top();
+	viewportStack.pop();
+	projection = projectionStack.top();
+	projectionStack.pop();
+	modelView = modelViewStack.top();
+	modelViewStack.pop();
+	view = viewStack.top();
+	viewStack.pop();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(ofRectangle viewport){
+	this->viewport(viewport.x, viewport.y, viewport.width, viewport.height, isVFlipped());
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(float x, float y, float width, float height, bool vflip){
+	record(Viewport, x, y, width, height, (unsigned char)vflip);
+	if(width < 0 || height < 0){
+		width = nativeViewport.width;
+		height = nativeViewport.height;
+	}
+	currentViewport.set(x, y, width, height);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenPerspective(float width, float height, float fov, float nearDist, float farDist){
+	record(SetupScreenPerspective, width, height, fov, nearDist, farDist);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenOrtho(float width, float height, float nearDist, float farDist){
+	record(SetupScreenOrtho, width, height, nearDist, farDist);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setOrientation(ofOrientation orientation, bool vFlip){
+	record(SetOrientation, (int)orientation, (unsigned char)vFlip);
+	vFlipped = vFlip;
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getCurrentViewport() const{
+	return currentViewport;
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getNativeViewport() const{
+	return nativeViewport;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportWidth() const{
+	return currentViewport.width;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportHeight() const{
+	return currentViewport.height;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::isVFlipped() const{
+	return vFlipped;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCoordHandedness(ofHandednessType handedness){
+	record(SetCoordHandedness, (int)handedness);
+	this->handedness = handedness;
+}
+
+//----------------------------------------------------------
+ofHandednessType ofRecordingRenderer::getCoordHandedness() const{
+	return handedness;
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 & ofRecordingRenderer::currentMatrix(){
+	switch(currentMatrixMode){
+	case OF_MATRIX_PROJECTION:
+		return projection;
+	case OF_MATRIX_TEXTURE:
+		return texture;
+	case OF_MATRIX_MODELVIEW:
+	default:
+		return modelView;
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushMatrix(){
+	record(PushMatrix);
+	switch(currentMatrixMode){
+	case OF_MATRIX_PROJECTION:
+		projectionStack.push(projection);
+		break;
+	case OF_MATRIX_TEXTURE:
+		textureStack.push(texture);
+		break;
+	case OF_MATRIX_MODELVIEW:
+	default:
+		modelViewStack.push(modelView);
+		break;
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popMatrix(){
+	record(PopMatrix);
+	stack<ofMatrix4x4> * matrixStack;
+	switch(currentMatrixMode){
+	case OF_MATRIX_PROJECTION:
+		matrixStack = &projectionStack;
+		break;
+	case OF_MATRIX_TEXTURE:
+		matrixStack = &textureStack;
+		break;
+	case OF_MATRIX_MODELVIEW:
+	default:
+		matrixStack = &modelViewStack;
+		break;
+	}
+	if(matrixStack->empty()){
+		ofLogWarning("ofRecordingRenderer") << "popMatrix(): popping matrix stack without push";
+		return;
+	}
+	currentMatrix() = matrixStack->top();
+	matrixStack->pop();
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentMatrix(ofMatrixMode matrixMode_) const{
+	switch(matrixMode_){
+	case OF_MATRIX_PROJECTION:
+		return projection;
+	case OF_MATRIX_TEXTURE:
+		return texture;
+	case OF_MATRIX_MODELVIEW:
+	default:
+		return modelView;
+	}
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentOrientationMatrix() const{
+	return ofMatrix4x4();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(float x, float y, float z){
+	record(Translate, ofVec3f(x, y, z));
+	currentMatrix().glTranslate(x, y, z);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(const ofPoint & p){
+	translate(p.x, p.y, p.z);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::scale(float xAmnt, float yAmnt, float zAmnt){
+	record(Scale, ofVec3f(xAmnt, yAmnt, zAmnt));
+	currentMatrix().glScale(xAmnt, yAmnt, zAmnt);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotate(float degrees, float vecX, float vecY, float vecZ){
+	record(Rotate, degrees, ofVec3f(vecX, vecY, vecZ));
+	currentMatrix().glRotate(degrees, vecX, vecY, vecZ);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateX(float degrees){
+	rotate(degrees, 1, 0, 0);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateY(float degrees){
+	rotate(degrees, 0, 1, 0);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateZ(float degrees){
+	rotate(degrees, 0, 0, 1);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotate(float degrees){
+	rotateZ(degrees);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::matrixMode(ofMatrixMode mode){
+	record(MatrixMode, (int)mode);
+	currentMatrixMode = mode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadIdentityMatrix(){
+	record(LoadIdentityMatrix);
+	currentMatrix().makeIdentityMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const ofMatrix4x4 & m){
+	record(LoadMatrix, m);
+	currentMatrix() = m;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const float * m){
+	loadMatrix(ofMatrix4x4(m));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const ofMatrix4x4 & m){
+	record(MultMatrix, m);
+	currentMatrix().preMult(m);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const float * m){
+	multMatrix(ofMatrix4x4(m));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadViewMatrix(const ofMatrix4x4 & m){
+	record(LoadViewMatrix, m);
+	view = m;
+	modelView = m;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multViewMatrix(const ofMatrix4x4 & m){
+	record(MultViewMatrix, m);
+	view.preMult(m);
+	modelView.preMult(m);
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentViewMatrix() const{
+	return view;
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentNormalMatrix() const{
+	return ofMatrix4x4::getTransposedOf(modelView.getInverse());
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::bind(const ofCamera & camera, const ofRectangle & viewport){
+	record(BindCamera, (const void*)&camera, viewport);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::unbind(const ofCamera & camera){
+	record(UnbindCamera, (const void*)&camera);
+	numReferences++;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupGraphicDefaults(){
+	record(SetupGraphicDefaults);
+	currentStyle = ofStyle();
+	path.setMode(ofPath::COMMANDS);
+	path.setUseShapeColor(false);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreen(){
+	record(SetupScreen);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setRectMode(ofRectMode mode){
+	record(SetRectMode, (int)mode);
+	currentStyle.rectMode = mode;
+}
+
+//----------------------------------------------------------
+ofRectMode ofRecordingRenderer::getRectMode(){
+	return currentStyle.rectMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setFillMode(ofFillFlag fill){
+	record(SetFillMode, (int)fill);
+	currentStyle.bFill = fill;
+	if(currentStyle.bFill){
+		path.setFilled(true);
+		path.setStrokeWidth(0);
+	}else{
+		path.setFilled(false);
+		path.setStrokeWidth(currentStyle.lineWidth);
+	}
+}
+
+//----------------------------------------------------------
+ofFillFlag ofRecordingRenderer::getFillMode(){
+	if(currentStyle.bFill){
+		return OF_FILLED;
+	}else{
+		return OF_OUTLINE;
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineWidth(float lineWidth){
+	record(SetLineWidth, lineWidth);
+	currentStyle.lineWidth = lineWidth;
+	if(!currentStyle.bFill){
+		path.setStrokeWidth(lineWidth);
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setDepthTest(bool depthTest){
+	record(SetDepthTest, (unsigned char)depthTest);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBlendMode(ofBlendMode blendMode){
+	record(SetBlendMode, (int)blendMode);
+	currentStyle.blendingMode = blendMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineSmoothing(bool smooth){
+	record(SetLineSmoothing, (unsigned char)smooth);
+	currentStyle.smoothing = smooth;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCircleResolution(int res){
+	record(SetCircleResolution, res);
+	currentStyle.circleResolution = res;
+	path.setCircleResolution(res);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::enableAntiAliasing(){
+	record(EnableAntiAliasing);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::disableAntiAliasing(){
+	record(DisableAntiAliasing);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b){
+	setColor(ofColor(r, g, b));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b, int a){
+	setColor(ofColor(r, g, b, a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color){
+	record(SetColor, color);
+	currentStyle.color = color;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color, int _a){
+	setColor(ofColor(color, _a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int gray){
+	setColor(ofColor(gray));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setHexColor(int hexColor){
+	setColor(ofColor::fromHex(hexColor));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
+	record(SetBitmapTextMode, (int)mode);
+	currentStyle.drawBitmapMode = mode;
+}
+
+//----------------------------------------------------------
+ofColor ofRecordingRenderer::getBackgroundColor(){
+	return currentStyle.bgColor;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundColor(const ofColor & c){
+	record(SetBackgroundColor, c);
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(const ofColor & c){
+	record(Background, c);
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(float brightness){
+	background(ofColor(brightness));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int hexColor, float _a){
+	background(ofColor::fromHex(hexColor, _a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int r, int g, int b, int a){
+	background(ofColor(r, g, b, a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundAuto(bool bAuto){
+	record(SetBackgroundAuto, (unsigned char)bAuto);
+	bBackgroundAuto = bAuto;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::getBackgroundAuto(){
+	return bBackgroundAuto;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(){
+	record(Clear);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float r, float g, float b, float a){
+	record(ClearColor, r, g, b, a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float brightness, float a){
+	clear(brightness, brightness, brightness, a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clearAlpha(){
+	record(ClearAlpha);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
+	record(DrawLine, x1, y1, z1, x2, y2, z2);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawRectangle(float x, float y, float z, float w, float h) const{
+	record(DrawRectangle, x, y, z, w, h);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const{
+	record(DrawTriangle, x1, y1, z1, x2, y2, z2, x3, y3, z3);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawCircle(float x, float y, float z, float radius) const{
+	record(DrawCircle, x, y, z, radius);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawEllipse(float x, float y, float z, float width, float height) const{
+	record(DrawEllipse, x, y, z, width, height);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(string text, float x, float y, float z) const{
+	record(DrawString, intern(text), ofVec3f(x, y, z));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
+	record(DrawStringFont, (const void*)&font, intern(text), ofVec2f(x, y));
+	numReferences++;
+}
+
+//----------------------------------------------------------
+ofPath & ofRecordingRenderer::getPath(){
+	return path;
+}
+
+//----------------------------------------------------------
+ofStyle ofRecordingRenderer::getStyle() const{
+	return currentStyle;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setStyle(const ofStyle & style){
+	commands.push_back(SetStyle);
+	writeStyle(commands, style);
+	numCommands++;
+	currentStyle = style;
+	path.setFilled(style.bFill);
+	path.setStrokeWidth(style.bFill ? 0 : style.lineWidth);
+	path.setCircleResolution(style.circleResolution);
+	path.setCurveResolution(style.curveResolution);
+	path.setPolyWindingMode(style.polyMode);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushStyle(){
+	record(PushStyle);
+	styleHistory.push_back(currentStyle);
+	if( styleHistory.size() > OF_MAX_STYLE_HISTORY ){
+		styleHistory.pop_front();
+		ofLogWarning("ofGraphics") << "ofPushStyle(): maximum number of style pushes << " << OF_MAX_STYLE_HISTORY << " reached, did you forget to pop somewhere?";
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popStyle(){
+	record(PopStyle);
+	if( styleHistory.size() ){
+		currentStyle = styleHistory.back();
+		styleHistory.pop_back();
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCurveResolution(int resolution){
+	record(SetCurveResolution, resolution);
+	currentStyle.curveResolution = resolution;
+	path.setCurveResolution(resolution);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setPolyMode(ofPolyWindingMode mode){
+	record(SetPolyMode, (int)mode);
+	currentStyle.polyMode = mode;
+	path.setPolyWindingMode(mode);
+}
+
+//----------------------------------------------------------
+const of3dGraphics & ofRecordingRenderer::get3dGraphics() const{
+	return graphics3d;
+}
+
+//----------------------------------------------------------
+of3dGraphics & ofRecordingRenderer::get3dGraphics(){
+	return graphics3d;
+}
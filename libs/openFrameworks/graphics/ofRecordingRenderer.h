@@ -0,0 +1,249 @@
+#pragma once
+
+#include "ofBaseTypes.h"
+#include "ofPath.h"
+#include "of3dGraphics.h"
+#include "ofFileUtils.h"
+#include <deque>
+#include <stack>
+#include <unordered_map>
+
+/// \brief A renderer that records the calls made to it so they can be
+/// replayed later on any other renderer.
+///
+/// Every call is appended to a compact command buffer, meshes, polylines and
+/// strings are copied once and referenced by index so drawing the same mesh
+/// many times only stores it once. A recording can be replayed as many times
+/// as needed which allows to record static layers once, to record on one
+/// thread and replay on the GL thread, or to save the recording and replay it
+/// with an ofCairoRenderer to compare the output in regression tests.
+///
+/// To record the calls made through the global drawing functions set it as
+/// the current renderer:
+///
+/// ~~~~{.cpp}
+/// auto recorder = make_shared<ofRecordingRenderer>();
+/// auto renderer = ofGetCurrentRenderer();
+/// ofSetCurrentRenderer(recorder, true);
+/// ofDrawCircle(100, 100, 50);
+/// ofSetCurrentRenderer(renderer);
+///
+/// // later, in draw()
+/// recorder->replay(*ofGetCurrentRenderer());
+/// ~~~~
+///
+/// Images, videos, fonts and cameras are recorded by reference, they need to
+/// be alive when the recording is replayed and a recording that contains them
+/// can't be saved. startRender and finishRender aren't recorded.
+///
+/// The matrices and viewport returned by the getters are tracked from the
+/// recorded matrix calls, setupScreenPerspective, setupScreenOrtho and
+/// camera binds are recorded but don't change them.
+class ofRecordingRenderer: public ofBaseRenderer{
+public:
+	ofRecordingRenderer();
+
+	static const string TYPE;
+	const string & getType(){ return TYPE; }
+
+	/// \brief Sets the size of the surface being recorded, returned by
+	/// getNativeViewport and used by viewport calls with no size.
+	void setup(float width, float height);
+
+	/// \brief Replays every recorded call on renderer in the same order.
+	void replay(ofBaseRenderer & renderer) const;
+
+	/// \brief Discards everything recorded so far.
+	void clearRecording();
+
+	size_t getNumCommands() const;
+	size_t getNumMeshes() const;
+	size_t getNumPolylines() const;
+	size_t getNumPaths() const;
+	size_t getNumStrings() const;
+
+	/// \brief Size in bytes of the command buffer, without the meshes,
+	/// polylines, paths and strings it references.
+	size_t getCommandsSize() const;
+
+	/// \brief Returns true if the recording draws images, videos, fonts or
+	/// binds cameras, which are recorded by reference and can't be saved.
+	bool hasReferences() const;
+
+	/// \brief Serializes the recording into buffer.
+	/// \returns false if the recording has references.
+	bool save(ofBuffer & buffer) const;
+	bool save(const string & path) const;
+
+	/// \brief Replaces the recording with one serialized with save.
+	bool load(const ofBuffer & buffer);
+	bool load(const string & path);
+
+	void startRender();
+	void finishRender();
+
+	using ofBaseRenderer::draw;
+	void draw(const ofPolyline & poly) const;
+	void draw(const ofPath & shape) const;
+	void draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const;
+	void draw(const of3dPrimitive& model, ofPolyRenderMode renderType) const;
+	void draw(const ofNode& model) const;
+	void draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const;
+
+	void pushView();
+	void popView();
+	void viewport(ofRectangle viewport);
+	void viewport(float x = 0, float y = 0, float width = -1, float height = -1, bool vflip=true);
+	void setupScreenPerspective(float width = -1, float height = -1, float fov = 60, float nearDist = 0, float farDist = 0);
+	void setupScreenOrtho(float width = -1, float height = -1, float nearDist = -1, float farDist = 1);
+	void setOrientation(ofOrientation orientation, bool vFlip);
+	ofRectangle getCurrentViewport() const;
+	ofRectangle getNativeViewport() const;
+	int getViewportWidth() const;
+	int getViewportHeight() const;
+	bool isVFlipped() const;
+
+	void setCoordHandedness(ofHandednessType handedness);
+	ofHandednessType getCoordHandedness() const;
+
+	void pushMatrix();
+	void popMatrix();
+	ofMatrix4x4 getCurrentMatrix(ofMatrixMode matrixMode_) const;
+	ofMatrix4x4 getCurrentOrientationMatrix() const;
+	void translate(float x, float y, float z = 0);
+	void translate(const ofPoint & p);
+	void scale(float xAmnt, float yAmnt, float zAmnt = 1);
+	void rotate(float degrees, float vecX, float vecY, float vecZ);
+	void rotateX(float degrees);
+	void rotateY(float degrees);
+	void rotateZ(float degrees);
+	void rotate(float degrees);
+	void matrixMode(ofMatrixMode mode);
+	void loadIdentityMatrix (void);
+	void loadMatrix (const ofMatrix4x4 & m);
+	void loadMatrix (const float *m);
+	void multMatrix (const ofMatrix4x4 & m);
+	void multMatrix (const float *m);
+	void loadViewMatrix(const ofMatrix4x4 & m);
+	void multViewMatrix(const ofMatrix4x4 & m);
+	ofMatrix4x4 getCurrentViewMatrix() const;
+	ofMatrix4x4 getCurrentNormalMatrix() const;
+
+	void bind(const ofCamera & camera, const ofRectangle & viewport);
+	void unbind(const ofCamera & camera);
+
+	void setupGraphicDefaults();
+	void setupScreen();
+
+	void setRectMode(ofRectMode mode);
+	ofRectMode getRectMode();
+	void setFillMode(ofFillFlag fill);
+	ofFillFlag getFillMode();
+	void setLineWidth(float lineWidth);
+	void setDepthTest(bool depthTest);
+	void setBlendMode(ofBlendMode blendMode);
+	void setLineSmoothing(bool smooth);
+	void setCircleResolution(int res);
+	void enableAntiAliasing();
+	void disableAntiAliasing();
+
+	void setColor(int r, int g, int b);
+	void setColor(int r, int g, int b, int a);
+	void setColor(const ofColor & color);
+	void setColor(const ofColor & color, int _a);
+	void setColor(int gray);
+	void setHexColor( int hexColor );
+
+	void setBitmapTextMode(ofDrawBitmapMode mode);
+
+	ofColor getBackgroundColor();
+	void setBackgroundColor(const ofColor & c);
+	void background(const ofColor & c);
+	void background(float brightness);
+	void background(int hexColor, float _a=255.0f);
+	void background(int r, int g, int b, int a=255);
+
+	void setBackgroundAuto(bool bManual);
+	bool getBackgroundAuto();
+
+	void clear();
+	void clear(float r, float g, float b, float a=0);
+	void clear(float brightness, float a=0);
+	void clearAlpha();
+
+	void drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const;
+	void drawRectangle(float x, float y, float z, float w, float h) const;
+	void drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const;
+	void drawCircle(float x, float y, float z, float radius) const;
+	void drawEllipse(float x, float y, float z, float width, float height) const;
+	void drawString(string text, float x, float y, float z) const;
+	void drawString(const ofTrueTypeFont & font, string text, float x, float y) const;
+
+	ofPath & getPath();
+
+	ofStyle getStyle() const;
+	void setStyle(const ofStyle & style);
+	void pushStyle();
+	void popStyle();
+
+	void setCurveResolution(int resolution);
+	void setPolyMode(ofPolyWindingMode mode);
+
+	const of3dGraphics & get3dGraphics() const;
+	of3dGraphics & get3dGraphics();
+
+private:
+	enum Command: unsigned char;
+
+	template<typename T>
+	void write(const T & value) const;
+	template<typename T, typename... Args>
+	void write(const T & value, const Args&... args) const;
+	template<typename... Args>
+	void record(Command command, const Args&... args) const;
+	// bytes of arguments after a command or -1 if it's not a valid command
+	static int getArgumentsSize(unsigned char command);
+
+	unsigned int intern(const ofMesh & mesh) const;
+	unsigned int intern(const ofPolyline & polyline) const;
+	unsigned int intern(const string & text) const;
+
+	ofMatrix4x4 & currentMatrix();
+
+	// recording
+	mutable vector<unsigned char> commands;
+	mutable size_t numCommands;
+	mutable size_t numReferences;
+	mutable vector<ofMesh> meshes;
+	mutable vector<ofPolyline> polylines;
+	mutable vector<ofPath> paths;
+	mutable vector<string> strings;
+	mutable unordered_map<unsigned long long, vector<unsigned int>> meshIndex;
+	mutable unordered_map<unsigned long long, vector<unsigned int>> polylineIndex;
+	mutable unordered_map<string, unsigned int> stringIndex;
+
+	// state returned by the getters
+	ofStyle currentStyle;
+	deque<ofStyle> styleHistory;
+	bool bBackgroundAuto;
+	ofMatrixMode currentMatrixMode;
+	ofMatrix4x4 modelView;
+	ofMatrix4x4 projection;
+	ofMatrix4x4 texture;
+	ofMatrix4x4 view;
+	stack<ofMatrix4x4> modelViewStack;
+	stack<ofMatrix4x4> projectionStack;
+	stack<ofMatrix4x4> textureStack;
+	stack<ofMatrix4x4> viewStack;
+	stack<ofRectangle> viewportStack;
+	ofRectangle nativeViewport;
+	ofRectangle currentViewport;
+	bool vFlipped;
+	ofHandednessType handedness;
+
+	of3dGraphics graphics3d;
+	ofPath path;
+};
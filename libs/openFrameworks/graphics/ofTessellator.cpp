@@ -1,4 +1,7 @@
 #include "ofTessellator.h"
+#include "ofPath.h"
+#include "ofWorkerThreads.h"
+#include <mutex>
 
 
 
@@ -38,17 +41,133 @@
 // ------------------------------------
 
 
-void * memAllocator( void *userData, unsigned int size ){
-	return malloc(size);
-}
+//----------------------------------------------------------
+// bump allocator for libtess2. everything a tessellation allocates is
+// released at once when the next one starts so frees are ignored and
+// realloc can usually grow the last block in place. the tessellator
+// object itself is allocated when the arena is persistent and uses
+// the heap so it survives the resets.
+class ofTessellator::Arena{
+public:
+	Arena()
+	:bPersistent(false)
+	,current(0)
+	,offset(0)
+	,last(nullptr){}
+
+	~Arena(){
+		for(auto & block: blocks){
+			::free(block.data);
+		}
+		for(auto ptr: heap){
+			::free(ptr);
+		}
+	}
 
-void * memReallocator( void *userData, void* ptr, unsigned int size ){
-	return realloc(ptr,size);
-}
+	void reset(){
+		// merge the blocks used by the last tessellation so the
+		// next one of a similar size fits in just one
+		if(current>0){
+			size_t total = 0;
+			for(auto & block: blocks){
+				total += block.size;
+				::free(block.data);
+			}
+			blocks.clear();
+			addBlock(total);
+		}
+		current = 0;
+		offset = 0;
+		last = nullptr;
+	}
 
-void memFree( void *userData, void *ptr ){
-	free (ptr);
-}
+	void * allocate(size_t size){
+		if(bPersistent){
+			void * ptr = ::malloc(size);
+			heap.push_back(ptr);
+			return ptr;
+		}
+		size_t total = align(sizeof(Header) + size);
+		// reset() leaves at most one block so a full block is always the
+		// last one
+		if(blocks.empty() || offset + total > blocks[current].size){
+			addBlock(std::max(total, blocks.empty() ? initialSize : blocks.back().size * 2));
+			current = blocks.size()-1;
+			offset = 0;
+		}
+		Header * header = (Header*)(blocks[current].data + offset);
+		header->size = size;
+		offset += total;
+		last = header + 1;
+		return last;
+	}
+
+	void * reallocate(void * ptr, size_t size){
+		if(ptr==nullptr){
+			return allocate(size);
+		}
+		auto it = std::find(heap.begin(), heap.end(), ptr);
+		if(it!=heap.end()){
+			*it = ::realloc(ptr, size);
+			return *it;
+		}
+		Header * header = (Header*)ptr - 1;
+		if(size <= header->size){
+			return ptr;
+		}
+		if(ptr==last){
+			size_t start = (char*)header - blocks[current].data;
+			size_t total = align(sizeof(Header) + size);
+			if(start + total <= blocks[current].size){
+				header->size = size;
+				offset = start + total;
+				return ptr;
+			}
+		}
+		void * newPtr = allocate(size);
+		memcpy(newPtr, ptr, header->size);
+		return newPtr;
+	}
+
+	void deallocate(void * ptr){
+		auto it = std::find(heap.begin(), heap.end(), ptr);
+		if(it!=heap.end()){
+			::free(ptr);
+			heap.erase(it);
+		}
+	}
+
+	bool bPersistent;
+
+private:
+	// 16 bytes so allocations keep the alignment of malloc
+	struct Header{
+		size_t size;
+		size_t padding;
+	};
+	struct Block{
+		char * data;
+		size_t size;
+	};
+	static const size_t initialSize = 64 * 1024;
+
+	static size_t align(size_t size){
+		return (size + 15) & ~size_t(15);
+	}
+
+	void addBlock(size_t size){
+		Block block;
+		block.data = (char*)::malloc(size);
+		block.size = size;
+		blocks.push_back(block);
+	}
+
+	vector<Block> blocks;
+	vector<void*> heap;
+	size_t current;
+	size_t offset;
+	void * last;
+};
 
 //----------------------------------------------------------
 ofTessellator::ofTessellator()
@@ -66,10 +185,7 @@ ofTessellator::~ofTessellator(){
 ofTessellator::ofTessellator(const ofTessellator & mom)
   : cacheTess(nullptr)
 {
-	if(&mom != this){
-		if(cacheTess) tessDeleteTess(cacheTess);
-		init();
-	}
+	init();
 }
 
 //----------------------------------------------------------
@@ -83,21 +199,78 @@ ofTessellator & ofTessellator::operator=(const ofTessellator & mom){
 
 //----------------------------------------------------------
 void ofTessellator::init(){
-	tessAllocator.memalloc = memAllocator;
-	tessAllocator.memrealloc = memReallocator;
-	tessAllocator.memfree = memFree;
-	tessAllocator.meshEdgeBucketSize=0;
-	tessAllocator.meshVertexBucketSize=0;
-	tessAllocator.meshFaceBucketSize=0;
-	tessAllocator.dictNodeBucketSize=0;
-	tessAllocator.regionBucketSize=0;
-	tessAllocator.extraVertices=0;
+	if(!arena){
+		arena.reset(new Arena);
+	}
+	tessAllocator.memalloc = [](void * userData, unsigned int size){
+		return ((Arena*)userData)->allocate(size);
+	};
+	tessAllocator.memrealloc = [](void * userData, void * ptr, unsigned int size){
+		return ((Arena*)userData)->reallocate(ptr, size);
+	};
+	tessAllocator.memfree = [](void * userData, void * ptr){
+		((Arena*)userData)->deallocate(ptr);
+	};
+	tessAllocator.userData = arena.get();
+	// the buckets come from the arena so they are cheap to allocate, smaller
+	// ones than libtess2's defaults touch less memory for the small shapes
+	// most paths are made of
+	tessAllocator.meshEdgeBucketSize=256;
+	tessAllocator.meshVertexBucketSize=256;
+	tessAllocator.meshFaceBucketSize=128;
+	tessAllocator.dictNodeBucketSize=128;
+	tessAllocator.regionBucketSize=128;
+	tessAllocator.extraVertices=64;
+	arena->bPersistent = true;
 	cacheTess = tessNewTess( &tessAllocator );
+	arena->bPersistent = false;
+}
+
+//----------------------------------------------------------
+void ofTessellator::addContours( const vector<ofPolyline>& src, bool bIs2D ){
+	arena->reset();
+
+	// pass vertex pointers to GLU tessellator
+	for ( int i=0; i<(int)src.size(); ++i ) {
+		if (src[i].size() > 0) {
+			ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
+
+			tessAddContour(cacheTess, bIs2D ? 2 : 3, &polyline.getVertices()[0].x, sizeof(ofPoint), polyline.size());
+		}
+	}
+}
+
+//----------------------------------------------------------
+bool ofTessellator::tessellate( ofPolyWindingMode polyWindingMode, int elementType, int polySize ){
+	if(tessTesselate(cacheTess, polyWindingMode, elementType, polySize, 3, 0)){
+		return true;
+	}
+	// a failed tessellation can leave the contours in the tessellator,
+	// start again with a new one
+	tessDeleteTess(cacheTess);
+	init();
+	return false;
+}
+
+//----------------------------------------------------------
+void ofTessellator::appendTessellation( ofMesh & dstmesh ){
+	int numVertices = tessGetVertexCount( cacheTess );
+	int numIndices = tessGetElementCount( cacheTess )*3;
+	ofIndexType offset = dstmesh.getNumVertices();
+
+	dstmesh.addVertices((ofVec3f*)tessGetVertices(cacheTess),numVertices);
+	const ofIndexType * elements = (const ofIndexType*)tessGetElements(cacheTess);
+	auto & indices = dstmesh.getIndices();
+	indices.reserve(indices.size() + numIndices);
+	for(int i=0;i<numIndices;i++){
+		indices.push_back(elements[i] + offset);
+	}
 }
 
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D){
 
+	arena->reset();
 	ofPolyline& polyline = const_cast<ofPolyline&>(src);
 	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
 
@@ -108,22 +281,14 @@ void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, ofMesh & dstmesh, bool bIs2D ) {
 
-
-	// pass vertex pointers to GLU tessellator
-	for ( int i=0; i<(int)src.size(); ++i ) {
-		if (src[i].size() > 0) {
-			ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
-
-			tessAddContour(cacheTess, bIs2D ? 2 : 3, &polyline.getVertices()[0].x, sizeof(ofPoint), polyline.size());
-		}
-	}
-
+	addContours( src, bIs2D );
 	performTessellation( polyWindingMode, dstmesh, bIs2D );
 }
 
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D){
 
+	arena->reset();
 	if (src.size() > 0) {
 		ofPolyline& polyline = const_cast<ofPolyline&>(src);
 		tessAddContour(cacheTess, bIs2D ? 2 : 3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
@@ -134,16 +299,7 @@ void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWinding
 
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
-
-	// pass vertex pointers to GLU tessellator
-	for ( int i=0; i<(int)src.size(); ++i ) {
-		if (src[i].size() > 0) {
-			ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
-
-			tessAddContour(cacheTess, bIs2D ? 2 : 3, &polyline.getVertices()[0].x, sizeof(ofPoint), polyline.size());
-		}
-	}
-
+	addContours( src, bIs2D );
 	performTessellation( polyWindingMode, dstpoly, bIs2D );
 }
 
@@ -151,7 +307,7 @@ void ofTessellator::tessellateToPolylines( const vector<ofPolyline>& src, ofPoly
 //----------------------------------------------------------
 void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D ) {
 
-	if (!tessTesselate(cacheTess, polyWindingMode, TESS_POLYGONS, 3, 3, 0)){
+	if (!tessellate(polyWindingMode, TESS_POLYGONS, 3)){
 		ofLogError("ofTessellator") << "performTessellation(): mesh polygon tessellation failed, winding mode " << polyWindingMode;
 		return;
 	}
@@ -174,7 +330,7 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 
 //----------------------------------------------------------
 void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
-	if (!tessTesselate(cacheTess, polyWindingMode, TESS_BOUNDARY_CONTOURS, 0, 3, 0)){
+	if (!tessellate(polyWindingMode, TESS_BOUNDARY_CONTOURS, 0)){
 		ofLogError("ofTessellator") << "performTesselation(): polyline boundary contours tessellation failed, winding mode " << polyWindingMode;
 		return;
 	}
@@ -192,3 +348,86 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vecto
 			dstpoly[i].setClosed(true);
 	}
 }
+
+
+//----------------------------------------------------------
+// tessellators used by the batch calls, kept between calls so their
+// arenas are already grown to the size of the paths being tessellated
+static std::mutex tessellatorsMutex;
+static vector<unique_ptr<ofTessellator>> tessellatorsPool;
+
+static unique_ptr<ofTessellator> acquireTessellator(){
+	std::unique_lock<std::mutex> lock(tessellatorsMutex);
+	if(tessellatorsPool.empty()){
+		return unique_ptr<ofTessellator>(new ofTessellator);
+	}
+	auto tessellator = std::move(tessellatorsPool.back());
+	tessellatorsPool.pop_back();
+	return tessellator;
+}
+
+static void releaseTessellator(unique_ptr<ofTessellator> && tessellator){
+	std::unique_lock<std::mutex> lock(tessellatorsMutex);
+	tessellatorsPool.push_back(std::move(tessellator));
+}
+
+//----------------------------------------------------------
+void ofTessellator::tessellateToMesh( const vector<ofPath> & paths, ofMesh & dstmesh, int numThreads ){
+	// below this many paths per thread starting the threads costs
+	// more than what they save
+	const size_t minPathsPerThread = 32;
+	numThreads = of::priv::getNumWorkThreads(numThreads, paths.size() / minPathsPerThread);
+
+	// each thread tessellates a contiguous range of paths into its own mesh,
+	// the meshes are appended in order afterwards so the result doesn't
+	// depend on the number of threads
+	vector<ofMesh> meshes(numThreads);
+	auto tessellateRange = [&](int thread){
+		auto tessellator = acquireTessellator();
+		size_t begin = paths.size() * thread / numThreads;
+		size_t end = paths.size() * (thread + 1) / numThreads;
+		for(size_t i=begin;i<end;i++){
+			// every path is only accessed from one thread
+			ofPath & path = const_cast<ofPath&>(paths[i]);
+			if(!path.isFilled()){
+				continue;
+			}
+			path.generatePolylinesFromCommands();
+			tessellator->addContours( path.polylines, false );
+			if (!tessellator->tessellate( path.getWindingMode(), TESS_POLYGONS, 3 )){
+				ofLogError("ofTessellator") << "tessellateToMesh(): mesh polygon tessellation failed for path " << i << ", winding mode " << path.getWindingMode();
+				continue;
+			}
+			tessellator->appendTessellation( meshes[thread] );
+		}
+		releaseTessellator( std::move(tessellator) );
+	};
+
+	of::priv::runInThreads(numThreads, tessellateRange);
+
+	dstmesh.clear();
+	dstmesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	if(numThreads==1){
+		dstmesh.getVertices().swap(meshes[0].getVertices());
+		dstmesh.getIndices().swap(meshes[0].getIndices());
+		return;
+	}
+
+	size_t numVertices = 0;
+	size_t numIndices = 0;
+	for(auto & mesh: meshes){
+		numVertices += mesh.getNumVertices();
+		numIndices += mesh.getNumIndices();
+	}
+	auto & vertices = dstmesh.getVertices();
+	auto & indices = dstmesh.getIndices();
+	vertices.reserve(numVertices);
+	indices.reserve(numIndices);
+	for(auto & mesh: meshes){
+		ofIndexType offset = vertices.size();
+		vertices.insert(vertices.end(), mesh.getVertices().begin(), mesh.getVertices().end());
+		for(auto index: mesh.getIndices()){
+			indices.push_back(index + offset);
+		}
+	}
+}
@@ -6,6 +6,8 @@
 #include "ofPolyline.h"
 #include "tesselator.h"
 
+class ofPath;
+
 /// \brief
 /// ofTessellator exists for one purpose: to turn ofPolylines into ofMeshes so
 /// that they can be more efficiently displayed using OpenGL. The ofPath class
@@ -48,12 +50,28 @@ public:
 	/// \brief Tessellate multiple polylines into a single polyline.
 	void tessellateToPolylines( const ofPolyline & src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D=false );
 
+	/// \brief Tessellates the fill of many paths into a single ofMesh.
+	///
+	/// The paths are split in contiguous ranges which are tessellated in
+	/// parallel, each thread with its own tessellator. The result is the same
+	/// as tessellating the paths one after another and appending the meshes,
+	/// in the same order. Paths that aren't filled are skipped and the fill
+	/// colors are not added to the mesh.
+	///
+	/// \param numThreads Number of threads to use, 0 uses one per core.
+	static void tessellateToMesh( const vector<ofPath> & paths, ofMesh & dstmesh, int numThreads=0 );
+
 private:
-	
+	class Arena;
+
+	void addContours( const vector<ofPolyline>& src, bool bIs2D );
+	bool tessellate( ofPolyWindingMode polyWindingMode, int elementType, int polySize );
+	void appendTessellation( ofMesh & dstmesh );
 	void performTessellation( ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D );
 	void performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D );
 	void init();
 
+	unique_ptr<Arena> arena;
 	TESStesselator * cacheTess;
 	TESSalloc tessAllocator;
 };
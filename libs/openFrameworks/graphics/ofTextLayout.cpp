@@ -0,0 +1,268 @@
+#include "ofTextLayout.h"
+#include "ofTrueTypeFont.h"
+#include "ofGraphics.h"
+#include "ofGLUtils.h"
+#include "ofAppRunner.h"
+#include "ofUtils.h"
+
+//----------------------------------------------------------
+// same truncation drawString has always done so text is snapped to pixels
+static inline void glyphQuad(const ofTextLayout::Glyph & glyph, float x, float y, bool vflip, float & xmin, float & ymin, float & xmax, float & ymax){
+	float X = x + glyph.x;
+	float Y = vflip ? y + glyph.y : y - glyph.y;
+	xmin = int(glyph.xmin + X);
+	xmax = int(glyph.xmax + X);
+	ymin = int((vflip ? glyph.ymin : -glyph.ymin) + Y);
+	ymax = int((vflip ? glyph.ymax : -glyph.ymax) + Y);
+}
+
+//----------------------------------------------------------
+static ofRectangle glyphsBoundingBox(const vector<ofTextLayout::Glyph> & glyphs, float x, float y, bool vflip){
+	ofRectangle bb(std::numeric_limits<float>::max(),std::numeric_limits<float>::max(),0,0);
+	float maxX = std::numeric_limits<float>::min();
+	float maxY = std::numeric_limits<float>::min();
+	for(const auto & glyph: glyphs){
+		float xmin, ymin, xmax, ymax;
+		glyphQuad(glyph, x, y, vflip, xmin, ymin, xmax, ymax);
+		bb.x = min(min(xmin, xmax), bb.x);
+		bb.y = min(min(ymin, ymax), bb.y);
+		maxX = max(max(xmin, xmax), maxX);
+		maxY = max(max(ymin, ymax), maxY);
+	}
+	bb.width = maxX - bb.x;
+	bb.height = maxY - bb.y;
+	return bb;
+}
+
+//----------------------------------------------------------
+ofTextLayout::ofTextLayout()
+:font(nullptr)
+,drawX(0)
+,drawY(0)
+,drawVFlip(true)
+,atlasVersion(0){
+
+}
+
+//----------------------------------------------------------
+ofTextLayout::ofTextLayout(const ofTrueTypeFont & font, const std::string & text)
+:font(nullptr)
+,drawX(0)
+,drawY(0)
+,drawVFlip(true)
+,atlasVersion(0){
+	setup(font, text);
+}
+
+//----------------------------------------------------------
+void ofTextLayout::setup(const ofTrueTypeFont & _font, const std::string & _text){
+	font = &_font;
+	text = _text;
+	layout();
+}
+
+//----------------------------------------------------------
+void ofTextLayout::update() const{
+	if(!isUpToDate()){
+		layout();
+	}
+}
+
+//----------------------------------------------------------
+bool ofTextLayout::isUpToDate() const{
+	return font == nullptr || font->glyphAtlas.getVersion() == atlasVersion;
+}
+
+//----------------------------------------------------------
+void ofTextLayout::layout() const{
+	glyphs.clear();
+	lines.clear();
+	meshes.clear();
+	drawMeshes.clear();
+	if(font == nullptr || !font->isLoaded()){
+		boundingBox.set(0, 0, 0, 0);
+		return;
+	}
+
+	const ofGlyphAtlas & atlas = font->glyphAtlas;
+	float pageWidth = atlas.getPageWidth();
+	float pageHeight = atlas.getPageHeight();
+
+	// the glyphs of this text can't be evicted while it's laid out
+	font->glyphAtlas.beginBatch();
+
+	float X = 0;
+	float Y = 0;
+	int prevC = -1;
+	lines.push_back(Line{0, 0, 0, 0});
+	try{
+		for(auto c: ofUTF8Iterator(text)){
+			ofGlyphAtlas::Region region;
+			const charProps * props;
+			if (c == '\n') {
+				lines.back().width = X;
+				Y += font->lineHeight;
+				X = 0;
+				prevC = -1;
+				lines.push_back(Line{glyphs.size(), 0, Y, 0});
+			} else if( c == ' ' && font->spaceSize>0 ) {
+				X += font->spaceSize;
+				if(prevC > -1) {
+					X += font->getKerning(c,prevC) * font->letterSpacing;
+				}
+			} else if((props = font->getGlyph(c, region)) != nullptr) {
+				if(prevC > -1) {
+					X += font->getKerning(c,prevC) * font->letterSpacing;
+				}
+				Glyph glyph;
+				glyph.codepoint = c;
+				glyph.line = lines.size() - 1;
+				glyph.x = X;
+				glyph.y = Y;
+				glyph.xmin = props->xmin;
+				glyph.xmax = props->xmax;
+				glyph.ymin = props->ymin;
+				glyph.ymax = props->ymax;
+				glyph.page = region.page;
+				glyph.t1 = region.x / pageWidth;
+				glyph.v1 = region.y / pageHeight;
+				glyph.t2 = (region.x + props->tW) / pageWidth;
+				glyph.v2 = (region.y + props->tH) / pageHeight;
+				glyphs.push_back(glyph);
+				lines.back().numGlyphs++;
+				X += props->advance * font->letterSpacing;
+			}
+			prevC = c;
+		}
+	}catch(...){
+
+	}
+	lines.back().width = X;
+
+	// glyphs rasterized while laying out can evict others but not the
+	// ones of this text
+	atlasVersion = atlas.getVersion();
+	boundingBox = glyphsBoundingBox(glyphs, 0, 0, true);
+}
+
+//----------------------------------------------------------
+const std::string & ofTextLayout::getText() const{
+	return text;
+}
+
+//----------------------------------------------------------
+const ofTrueTypeFont * ofTextLayout::getFont() const{
+	return font;
+}
+
+//----------------------------------------------------------
+const vector<ofTextLayout::Glyph> & ofTextLayout::getGlyphs() const{
+	update();
+	return glyphs;
+}
+
+//----------------------------------------------------------
+const vector<ofTextLayout::Line> & ofTextLayout::getLines() const{
+	return lines;
+}
+
+//----------------------------------------------------------
+ofRectangle ofTextLayout::getBoundingBox(float x, float y, bool vflip) const{
+	if(x == 0 && y == 0 && vflip){
+		return boundingBox;
+	}
+	return glyphsBoundingBox(glyphs, x, y, vflip);
+}
+
+//----------------------------------------------------------
+float ofTextLayout::getWidth() const{
+	return boundingBox.width;
+}
+
+//----------------------------------------------------------
+float ofTextLayout::getHeight() const{
+	return boundingBox.height;
+}
+
+//----------------------------------------------------------
+const vector<ofMesh> & ofTextLayout::getMeshes() const{
+	update();
+	if(meshes.empty() && !glyphs.empty()){
+		getMeshes(meshes, 0, 0, true);
+	}
+	return meshes;
+}
+
+//----------------------------------------------------------
+void ofTextLayout::getMeshes(vector<ofMesh> & pageMeshes, float x, float y, bool vflip) const{
+	update();
+	for(auto & mesh: pageMeshes){
+		mesh.clear();
+	}
+	for(const auto & glyph: glyphs){
+		if(pageMeshes.size() <= glyph.page){
+			pageMeshes.resize(glyph.page + 1);
+			for(auto & mesh: pageMeshes){
+				mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+			}
+		}
+		ofMesh & quads = pageMeshes[glyph.page];
+
+		float xmin, ymin, xmax, ymax;
+		glyphQuad(glyph, x, y, vflip, xmin, ymin, xmax, ymax);
+
+		int firstIndex = quads.getVertices().size();
+
+		quads.addVertex(ofVec3f(xmin,ymin));
+		quads.addVertex(ofVec3f(xmax,ymin));
+		quads.addVertex(ofVec3f(xmax,ymax));
+		quads.addVertex(ofVec3f(xmin,ymax));
+
+		quads.addTexCoord(ofVec2f(glyph.t1,glyph.v1));
+		quads.addTexCoord(ofVec2f(glyph.t2,glyph.v1));
+		quads.addTexCoord(ofVec2f(glyph.t2,glyph.v2));
+		quads.addTexCoord(ofVec2f(glyph.t1,glyph.v2));
+
+		quads.addIndex(firstIndex);
+		quads.addIndex(firstIndex+1);
+		quads.addIndex(firstIndex+2);
+		quads.addIndex(firstIndex+2);
+		quads.addIndex(firstIndex+3);
+		quads.addIndex(firstIndex);
+	}
+}
+
+//----------------------------------------------------------
+void ofTextLayout::draw(float x, float y) const{
+	if(font == nullptr || !font->isLoaded()){
+		ofLogError("ofTextLayout") << "draw(): font not allocated";
+		return;
+	}
+
+	shared_ptr<ofBaseGLRenderer> renderer = ofGetGLRenderer();
+	if(!renderer){
+		ofGetCurrentRenderer()->drawString(*font, text, x, y);
+		return;
+	}
+
+	// the glyphs are snapped to pixels at their final position, translating
+	// meshes built somewhere else would snap them differently
+	update();
+	bool vflip = renderer->isVFlipped();
+	if(drawMeshes.empty() || x != drawX || y != drawY || vflip != drawVFlip){
+		getMeshes(drawMeshes, x, y, vflip);
+		drawX = x;
+		drawY = y;
+		drawVFlip = vflip;
+	}
+
+	ofBlendMode blendMode = renderer->getStyle().blendingMode;
+	renderer->setBlendMode(OF_BLENDMODE_ALPHA);
+	for(size_t page = 0; page < drawMeshes.size(); page++){
+		if(drawMeshes[page].getNumVertices() == 0) continue;
+		renderer->bind(font->getFontTexture(page), 0);
+		renderer->draw(drawMeshes[page], OF_MESH_FILL);
+		renderer->unbind(font->getFontTexture(page), 0);
+	}
+	renderer->setBlendMode(blendMode);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofMesh.h"
+#include "ofRectangle.h"
+
+class ofTrueTypeFont;
+
+/// \brief The result of laying out a string with an ofTrueTypeFont.
+///
+/// Laying out a string decodes the UTF-8 text, finds every glyph in the
+/// font's atlas, rasterizing the ones that aren't there yet, and applies
+/// kerning, letter spacing and line breaks. An ofTextLayout does that once
+/// and keeps the position of every glyph, the lines and the bounding box so
+/// a string that doesn't change can be measured and drawn many times
+/// without doing it again.
+///
+/// ofTrueTypeFont keeps a cache of the layouts of the last strings it drew
+/// or measured, see ofTrueTypeFont::getTextLayout(), so drawString() and
+/// stringWidth() don't need to lay out the same string every frame. Labels
+/// that are drawn every frame can also keep their own layout:
+///
+/// ~~~~{.cpp}
+/// ofTextLayout label(font, "Hello world");
+///
+/// // in draw()
+/// label.draw(20, 40);
+/// ~~~~
+///
+/// Positions are in the same coordinates as drawString() with the y axis
+/// pointing down, y = 0 is the baseline of the first line.
+///
+/// The layout keeps a pointer to the font which has to outlive it. It has
+/// to be setup again if the font is loaded again or its line height, letter
+/// spacing or space size change, if glyphs it uses are evicted from the
+/// font's atlas it's updated automatically the next time it's used.
+class ofTextLayout{
+public:
+	/// \brief A glyph placed in the layout.
+	struct Glyph{
+		uint32_t codepoint;
+		size_t line;
+		float x, y;               ///< Pen position, y is the baseline.
+		int xmin, xmax, ymin, ymax; ///< Quad relative to the pen position.
+		size_t page;              ///< Page of the font's atlas.
+		float t1, v1, t2, v2;     ///< Texture coordinates in that page.
+	};
+
+	/// \brief A line of text, lines are separated by '\\n'.
+	struct Line{
+		size_t firstGlyph;
+		size_t numGlyphs;
+		float y;                  ///< Baseline of the line.
+		float width;              ///< Position of the pen at the end of the line.
+	};
+
+	ofTextLayout();
+	ofTextLayout(const ofTrueTypeFont & font, const std::string & text);
+
+	/// \brief Lays out text with font.
+	void setup(const ofTrueTypeFont & font, const std::string & text);
+
+	/// \brief Lays out the text again if glyphs it used were evicted from
+	/// the font's atlas since it was laid out.
+	void update() const;
+
+	/// \brief Returns true if the texture coordinates of the glyphs are
+	/// still valid for the font's atlas.
+	bool isUpToDate() const;
+
+	const std::string & getText() const;
+	const ofTrueTypeFont * getFont() const;
+	const vector<Glyph> & getGlyphs() const;
+	const vector<Line> & getLines() const;
+
+	/// \brief Bounding box of the glyphs drawn at x, y, the same as
+	/// ofTrueTypeFont::getStringBoundingBox().
+	ofRectangle getBoundingBox(float x = 0, float y = 0, bool vflip = true) const;
+	float getWidth() const;
+	float getHeight() const;
+
+	/// \brief One mesh per page of the font's atlas with the quads of the
+	/// glyphs at the origin, each has to be drawn with the texture returned
+	/// by ofTrueTypeFont::getFontTexture() for the same page.
+	const vector<ofMesh> & getMeshes() const;
+
+	/// \brief Fills pageMeshes with the quads of the glyphs drawn at x, y, the
+	/// vertices are snapped to pixels like drawString() does.
+	void getMeshes(vector<ofMesh> & pageMeshes, float x, float y, bool vflip = true) const;
+
+	/// \brief Draws the text at x, y with the current renderer.
+	///
+	/// With a GL renderer the meshes are built at x, y and snapped to pixels
+	/// like drawString() does, they are only built again when the text is
+	/// drawn somewhere else. Other renderers draw it with drawString().
+	void draw(float x, float y) const;
+
+private:
+	void layout() const;
+
+	const ofTrueTypeFont * font;
+	std::string text;
+	mutable vector<Glyph> glyphs;
+	mutable vector<Line> lines;
+	mutable vector<ofMesh> meshes;
+	// meshes of the last draw() and where they were built
+	mutable vector<ofMesh> drawMeshes;
+	mutable float drawX, drawY;
+	mutable bool drawVFlip;
+	mutable ofRectangle boundingBox;
+	mutable unsigned int atlasVersion;
+};
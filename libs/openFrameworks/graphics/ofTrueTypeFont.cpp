@@ -17,11 +17,13 @@
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
+#include "ofWorkerThreads.h"
 
 static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
 static FT_Library library;
+static std::string fontCacheDirectory;
 
 //--------------------------------------------------------
 void ofTrueTypeShutdown(){
@@ -177,6 +179,9 @@ static ofTTFCharacter makeContoursForCharacter(FT_Face face){
 
 //------------------------------------------------------------------
 bool compare_cps(const charProps & c1, const charProps & c2){
+	// characters of the same size are sorted by index so the packing
+	// doesn't depend on the sort implementation
+	if(c1.tH == c2.tH && c1.tW == c2.tW) return c1.characterIndex < c2.characterIndex;
 	if(c1.tH == c2.tH) return c1.tW > c2.tW;
 	else return c1.tH > c2.tH;
 }
@@ -370,6 +375,11 @@ ofTrueTypeFont::ofTrueTypeFont(){
 	nCharacters = 0;
 	simplifyAmt = 0;
 	useKerning = false;
+	glyphCachePageSize = 0;
+	glyphCacheMaxPages = 4;
+	bPreloadCharacterSet = true;
+	numLoadThreads = 0;
+	textLayoutCacheSize = 1024;
 }
 
 //------------------------------------------------------------------
@@ -414,7 +424,17 @@ ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont& mom){
 
     filename = mom.filename;
 
-    texAtlas = mom.texAtlas;
+    glyphAtlas = mom.glyphAtlas;
+    clearAtlasTextures(); // the copy adds glyphs to its own atlas, it uploads it to its own textures
+    glyphs = mom.glyphs;
+    glyphCachePageSize = mom.glyphCachePageSize;
+    glyphCacheMaxPages = mom.glyphCacheMaxPages;
+    bPreloadCharacterSet = mom.bPreloadCharacterSet;
+    numLoadThreads = mom.numLoadThreads;
+    kerningTable = mom.kerningTable;
+    kerningPairs = mom.kerningPairs;
+    textLayoutCacheSize = mom.textLayoutCacheSize;
+    clearTextLayouts(); // the layouts of mom point to mom
     useKerning = mom.useKerning;
     face = mom.face;
 }
@@ -454,7 +474,17 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont& mom){
 
     filename = mom.filename;
 
-    texAtlas = mom.texAtlas;
+    glyphAtlas = mom.glyphAtlas;
+    clearAtlasTextures(); // the copy adds glyphs to its own atlas, it uploads it to its own textures
+    glyphs = mom.glyphs;
+    glyphCachePageSize = mom.glyphCachePageSize;
+    glyphCacheMaxPages = mom.glyphCacheMaxPages;
+    bPreloadCharacterSet = mom.bPreloadCharacterSet;
+    numLoadThreads = mom.numLoadThreads;
+    kerningTable = mom.kerningTable;
+    kerningPairs = mom.kerningPairs;
+    textLayoutCacheSize = mom.textLayoutCacheSize;
+    clearTextLayouts(); // the layouts of mom point to mom
     useKerning = mom.useKerning;
     face = mom.face;
     return *this;
@@ -494,7 +524,18 @@ ofTrueTypeFont::ofTrueTypeFont(ofTrueTypeFont&& mom){
 
     filename = mom.filename;
 
-    texAtlas = mom.texAtlas;
+    glyphAtlas = mom.glyphAtlas;
+    atlasTextures = std::move(mom.atlasTextures);
+    mom.clearAtlasTextures();
+    glyphs = mom.glyphs;
+    glyphCachePageSize = mom.glyphCachePageSize;
+    glyphCacheMaxPages = mom.glyphCacheMaxPages;
+    bPreloadCharacterSet = mom.bPreloadCharacterSet;
+    numLoadThreads = mom.numLoadThreads;
+    kerningTable = mom.kerningTable;
+    kerningPairs = mom.kerningPairs;
+    textLayoutCacheSize = mom.textLayoutCacheSize;
+    clearTextLayouts(); // the layouts of mom point to mom
     useKerning = mom.useKerning;
     face = mom.face;
 }
@@ -534,7 +575,18 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 
     filename = mom.filename;
 
-    texAtlas = mom.texAtlas;
+    glyphAtlas = mom.glyphAtlas;
+    atlasTextures = std::move(mom.atlasTextures);
+    mom.clearAtlasTextures();
+    glyphs = mom.glyphs;
+    glyphCachePageSize = mom.glyphCachePageSize;
+    glyphCacheMaxPages = mom.glyphCacheMaxPages;
+    bPreloadCharacterSet = mom.bPreloadCharacterSet;
+    numLoadThreads = mom.numLoadThreads;
+    kerningTable = mom.kerningTable;
+    kerningPairs = mom.kerningPairs;
+    textLayoutCacheSize = mom.textLayoutCacheSize;
+    clearTextLayouts(); // the layouts of mom point to mom
     useKerning = mom.useKerning;
     face = mom.face;
     return *this;
@@ -543,7 +595,16 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 //------------------------------------------------------------------
 void ofTrueTypeFont::unloadTextures(){
 	if(!bLoadedOk) return;
-	texAtlas.clear();
+	clearAtlasTextures();
+}
+
+//------------------------------------------------------------------
+void ofTrueTypeFont::clearAtlasTextures(){
+	// every page is uploaded again the next time its texture is used
+	atlasTextures.clear();
+	for(size_t page = 0; page < glyphAtlas.getNumPages(); page++){
+		glyphAtlas.markPageDirty(page);
+	}
 }
 
 //------------------------------------------------------------------
@@ -553,6 +614,280 @@ void ofTrueTypeFont::reloadTextures(){
 	}
 }
 
+//------------------------------------------------------------------
+static void copyGlyphBitmap(FT_GlyphSlot slot, bool bAntiAliased, charProps & props, ofPixels & pixels){
+	FT_Bitmap& bitmap= slot->bitmap;
+
+	// Note: Using decltype here to avoid warnings across
+	// platforms using differing versions of freetype 2.
+	decltype(bitmap.width) width  = bitmap.width;
+	decltype(bitmap.rows) height = bitmap.rows;
+
+	props.height 			= slot->metrics.height>>6;
+	props.width 			= slot->metrics.width>>6;
+	props.bearingX			= slot->metrics.horiBearingX>>6;
+	props.bearingY			= slot->metrics.horiBearingY>>6;
+	props.xmin				= slot->bitmap_left;
+	props.xmax				= props.xmin + props.width;
+	props.ymin				= -slot->bitmap_top;
+	props.ymax				= props.ymin + props.height;
+	props.advance			= slot->metrics.horiAdvance>>6;
+	props.tW				= props.width;
+	props.tH				= props.height;
+	props.t1 = props.t2 = props.v1 = props.v2 = 0;
+
+	if(width==0 || height==0){
+		pixels.clear();
+		return;
+	}
+
+	// Allocate Memory For The Texture Data.
+	pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+	//-------------------------------- clear data:
+	pixels.set(0,255); // every luminance pixel = 255
+	pixels.set(1,0);
+
+
+	if (bAntiAliased == true){
+		ofPixels bitmapPixels;
+		bitmapPixels.setFromExternalPixels(bitmap.buffer,width,height,OF_PIXELS_GRAY);
+		pixels.setChannel(1,bitmapPixels);
+	} else {
+		//-----------------------------------
+		// true type packs monochrome info in a
+		// 1-bit format, hella funky
+		// here we unpack it:
+		unsigned char *src =  bitmap.buffer;
+		for(decltype(height) j=0; j < height; j++) {
+			unsigned char b=0;
+			unsigned char *bptr =  src;
+			for(decltype(width) k=0; k < width; k++){
+				pixels[2*(k+j*width)] = 255;
+
+				if (k%8==0){
+					b = (*bptr++);
+				}
+
+				pixels[2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
+				b <<= 1;
+			}
+			src += bitmap.pitch;
+		}
+		//-----------------------------------
+	}
+}
+
+//------------------------------------------------------------------
+// format of the font cache files, increase when what's saved changes
+static const char fontCacheMagic[] = {'o','f','t','t','f'};
+static const unsigned int fontCacheVersion = 1;
+
+namespace{
+	// 64 bit FNV-1a
+	class FontCacheHash{
+	public:
+		unsigned long long value = 14695981039346656037ULL;
+
+		void add(const void * data, size_t size){
+			auto bytes = static_cast<const unsigned char*>(data);
+			for(size_t i=0;i<size;i++){
+				value ^= bytes[i];
+				value *= 1099511628211ULL;
+			}
+		}
+
+		template<typename T>
+		void add(const T & value){
+			add(&value, sizeof(T));
+		}
+	};
+
+	// reads values written with FontCacheWriter, reading past the end sets
+	// ok to false and returns zeros
+	class FontCacheReader{
+	public:
+		FontCacheReader(const ofBuffer & buffer)
+		:data(reinterpret_cast<const unsigned char*>(buffer.getData()))
+		,end(data + buffer.size())
+		,ok(true){}
+
+		void read(void * dst, size_t size){
+			if(size_t(end - data) < size){
+				ok = false;
+				memset(dst, 0, size);
+				return;
+			}
+			memcpy(dst, data, size);
+			data += size;
+		}
+
+		template<typename T>
+		T read(){
+			T value;
+			read(&value, sizeof(T));
+			return value;
+		}
+
+		ofPoint readPoint(){
+			float x = read<float>();
+			float y = read<float>();
+			float z = read<float>();
+			return ofPoint(x, y, z);
+		}
+
+		size_t remaining() const{
+			return end - data;
+		}
+
+		const unsigned char * data;
+		const unsigned char * end;
+		bool ok;
+	};
+
+	class FontCacheWriter{
+	public:
+		FontCacheWriter(ofBuffer & buffer)
+		:buffer(buffer){}
+
+		void write(const void * data, size_t size){
+			buffer.append(reinterpret_cast<const char*>(data), size);
+		}
+
+		template<typename T>
+		void write(const T & value){
+			write(&value, sizeof(T));
+		}
+
+		void writePoint(const ofPoint & p){
+			write(p.x);
+			write(p.y);
+			write(p.z);
+		}
+
+		ofBuffer & buffer;
+	};
+}
+
+//------------------------------------------------------------------
+// identifies a load of a font file with some options, the contents of the
+// file are hashed so a font that changes gets a new key
+static unsigned long long fontCacheKey(const std::string & filename, int fontSize, int dpi, int faceIndex, int nCharacters, bool bAntiAliased, bool bFullCharacterSet, bool bMakeContours){
+	ofBuffer file = ofBufferFromFile(filename, true);
+	FontCacheHash hash;
+	hash.add(file.getData(), file.size());
+	hash.add(fontSize);
+	hash.add(dpi);
+	hash.add(faceIndex);
+	hash.add(nCharacters);
+	hash.add(bAntiAliased);
+	hash.add(bFullCharacterSet);
+	hash.add(bMakeContours);
+	// glyphs can be rasterized differently by other versions of freetype
+	hash.add(int(FREETYPE_MAJOR));
+	hash.add(int(FREETYPE_MINOR));
+	hash.add(int(FREETYPE_PATCH));
+	hash.add(fontCacheVersion);
+	return hash.value;
+}
+
+//------------------------------------------------------------------
+// the outlines are saved as the commands from the font, before they are
+// simplified, so they are the same as the ones made when loading
+static bool readFontCache(const std::string & path, unsigned long long key, int nCharacters, bool bMakeContours, vector<charProps> & props, vector<ofPixels> & pixels, vector<vector<ofPath::Command>> & outlines){
+	ofBuffer buffer = ofBufferFromFile(path, true);
+	FontCacheReader reader(buffer);
+	char magic[sizeof(fontCacheMagic)];
+	reader.read(magic, sizeof(magic));
+	if(!reader.ok || memcmp(magic, fontCacheMagic, sizeof(magic)) != 0 ||
+	   reader.read<unsigned int>() != fontCacheVersion ||
+	   reader.read<unsigned long long>() != key ||
+	   reader.read<int>() != nCharacters){
+		ofLogWarning("ofTrueTypeFont") << "load(): ignoring font cache \"" << path << "\" created for a different font";
+		return false;
+	}
+
+	props.resize(nCharacters);
+	pixels.resize(nCharacters);
+	outlines.resize(bMakeContours ? nCharacters : 0);
+	for(int i = 0; i < nCharacters && reader.ok; i++){
+		reader.read(&props[i], sizeof(charProps));
+		auto width = reader.read<int>();
+		auto height = reader.read<int>();
+		if(width > 0 && height > 0 && size_t(width) * height * 2 <= reader.remaining()){
+			pixels[i].allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+			reader.read(pixels[i].getData(), pixels[i].size());
+		}else if(width != 0 || height != 0){
+			reader.ok = false;
+		}else{
+			pixels[i].clear();
+		}
+		if(bMakeContours){
+			auto numCommands = reader.read<unsigned int>();
+			if(numCommands > reader.remaining()){
+				reader.ok = false;
+				break;
+			}
+			outlines[i].clear();
+			outlines[i].reserve(numCommands);
+			for(unsigned int j = 0; j < numCommands && reader.ok; j++){
+				ofPath::Command command(ofPath::Command::Type(reader.read<int>()));
+				command.to = reader.readPoint();
+				command.cp1 = reader.readPoint();
+				command.cp2 = reader.readPoint();
+				command.radiusX = reader.read<float>();
+				command.radiusY = reader.read<float>();
+				command.angleBegin = reader.read<float>();
+				command.angleEnd = reader.read<float>();
+				outlines[i].push_back(command);
+			}
+		}
+	}
+
+	if(!reader.ok){
+		ofLogWarning("ofTrueTypeFont") << "load(): ignoring truncated font cache \"" << path << "\"";
+		return false;
+	}
+	ofLogVerbose("ofTrueTypeFont") << "load(): read character set from font cache \"" << path << "\"";
+	return true;
+}
+
+//------------------------------------------------------------------
+static void writeFontCache(const std::string & path, unsigned long long key, const vector<charProps> & props, const vector<ofPixels> & pixels, const vector<ofTTFCharacter> & outlines, bool bMakeContours){
+	ofBuffer buffer;
+	FontCacheWriter writer(buffer);
+	writer.write(fontCacheMagic, sizeof(fontCacheMagic));
+	writer.write(fontCacheVersion);
+	writer.write(key);
+	writer.write(int(props.size()));
+	for(size_t i = 0; i < props.size(); i++){
+		writer.write(&props[i], sizeof(charProps));
+		writer.write(int(pixels[i].getWidth()));
+		writer.write(int(pixels[i].getHeight()));
+		if(pixels[i].isAllocated()){
+			writer.write(pixels[i].getData(), pixels[i].size());
+		}
+		if(bMakeContours){
+			const auto & commands = outlines[i].getCommands();
+			writer.write((unsigned int)commands.size());
+			for(const auto & command: commands){
+				writer.write(int(command.type));
+				writer.writePoint(command.to);
+				writer.writePoint(command.cp1);
+				writer.writePoint(command.cp2);
+				writer.write(command.radiusX);
+				writer.write(command.radiusY);
+				writer.write(command.angleBegin);
+				writer.write(command.angleEnd);
+			}
+		}
+	}
+
+	ofDirectory::createDirectory(ofFilePath::getEnclosingDirectory(path), true, true);
+	if(!ofBufferToFile(path, buffer, true)){
+		ofLogWarning("ofTrueTypeFont") << "load(): couldn't save font cache \"" << path << "\"";
+	}
+}
+
 //------------------------------------------------------------------
 static std::shared_ptr<FT_FaceRec_> loadFontFace(const std::string& _fontname, int _fontSize, std::string& filename){
     FT_Face face;
@@ -652,16 +987,22 @@ bool ofTrueTypeFont::load(const std::string& _filename, int _fontSize, bool _bAn
 				  (face->bbox.xMax - face->bbox.xMin) * fontUnitScale,
 				  (face->bbox.yMax - face->bbox.yMin) * fontUnitScale);
 	useKerning = FT_HAS_KERNING( face );
+	kerningTable.clear();
+	kerningPairs.clear();
+	clearTextLayouts();
 
 	//------------------------------------------------------
 	//kerning would be great to support:
 	//ofLogNotice("ofTrueTypeFont") << "FT_HAS_KERNING ? " <<  FT_HAS_KERNING(face);
 	//------------------------------------------------------
 
-	nCharacters = (bFullCharacterSet ? 256 : 128) - NUM_CHARACTER_TO_START;
+	bool preload = bPreloadCharacterSet || bMakeContours;
+	nCharacters = preload ? (bFullCharacterSet ? 256 : 128) - NUM_CHARACTER_TO_START : 0;
 
 	//--------------- initialize character info and textures
 	cps.resize(nCharacters);
+	glyphs.clear();
+	atlasTextures.clear();
 
 	if(bMakeContours){
 		charOutlines.assign(nCharacters, ofTTFCharacter());
@@ -675,195 +1016,198 @@ bool ofTrueTypeFont::load(const std::string& _filename, int _fontSize, bool _bAn
 	vector<ofPixels> expanded_data(nCharacters);
 
 	long areaSum=0;
-	FT_Error err;
 
+	//--------------------- read the cache -----------------------
+	// the character set and its contours can be read from a previous load
+	// of the same font file with the same options
+	std::string cachePath;
+	unsigned long long cacheKey = 0;
+	vector<charProps> cachedProps;
+	vector<vector<ofPath::Command>> cachedOutlines;
+	bool fromCache = false;
+	if(!fontCacheDirectory.empty() && nCharacters > 0){
+		cacheKey = fontCacheKey(filename, fontSize, dpi, face->face_index, nCharacters, bAntiAliased, bFullCharacterSet, bMakeContours);
+		cachePath = ofFilePath::join(fontCacheDirectory, ofToHex(cacheKey) + ".ofttf");
+		if(ofFile::doesFileExist(cachePath)){
+			fromCache = readFontCache(cachePath, cacheKey, nCharacters, bMakeContours, cachedProps, expanded_data, cachedOutlines);
+		}
+	}
 
 	//--------------------- load each char -----------------------
-	for (int i = 0 ; i < nCharacters; i++){
-
-		//------------------------------------------ anti aliased or not:
-		int glyph = (unsigned char)(i+NUM_CHARACTER_TO_START);
-		if (glyph == 0xA4) glyph = 0x20AC; // hack to load the euro sign, all codes in 8859-15 match with utf-32 except for this one
-        err = FT_Load_Glyph( face.get(), FT_Get_Char_Index( face.get(), glyph ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
-        if(err){
-			ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for char " << i << ": FT_Error " << err;
-
+	// the characters are split in contiguous ranges loaded in parallel,
+	// each thread with its own face since a face can't be used from several
+	// threads at the same time. every thread only writes the characters in
+	// its range so the result doesn't depend on the number of threads
+	const int minCharactersPerThread = 32;
+	int numThreads = of::priv::getNumWorkThreads(numLoadThreads, nCharacters / minCharactersPerThread);
+
+	// creating faces isn't thread safe, they are all created here and
+	// destroyed after the threads finish
+	vector<std::shared_ptr<FT_FaceRec_>> faces{face};
+	while(!fromCache && int(faces.size()) < numThreads){
+		FT_Face threadFace;
+		if(FT_New_Face( library, filename.c_str(), face->face_index, &threadFace )){
+			break;
 		}
+		FT_Set_Char_Size( threadFace, fontSize << 6, fontSize << 6, dpi, dpi);
+		faces.emplace_back(threadFace, FT_Done_Face);
+	}
+	if(!fromCache){
+		numThreads = faces.size();
+	}else if(!bMakeContours){
+		// only the contours are left to do for a font read from the cache
+		numThreads = 1;
+	}
 
-		if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-		else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+	auto loadRange = [&](int thread){
+		FT_Face threadFace = fromCache ? nullptr : faces[thread].get();
+		int begin = nCharacters * thread / numThreads;
+		int end = nCharacters * (thread + 1) / numThreads;
+		for (int i = begin ; i < end; i++){
 
-		//------------------------------------------
+			int glyph = (unsigned char)(i+NUM_CHARACTER_TO_START);
+			if (glyph == 0xA4) glyph = 0x20AC; // hack to load the euro sign, all codes in 8859-15 match with utf-32 except for this one
 
+			//------------------------------------------ anti aliased or not:
+			if(!fromCache){
+				FT_Error err = FT_Load_Glyph( threadFace, FT_Get_Char_Index( threadFace, glyph ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+				if(err){
+					ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for char " << i << ": FT_Error " << err;
 
-		if(bMakeContours){
-			if(printVectorInfo){
-				ofLogNotice("ofTrueTypeFont") <<  "character " << char(i+NUM_CHARACTER_TO_START);
-			}
+				}
 
-			//int character = i + NUM_CHARACTER_TO_START;
-            charOutlines[i] = makeContoursForCharacter( face.get() );
-			charOutlinesContour[i] = charOutlines[i];
-			charOutlinesContour[i].setFilled(false);
-			charOutlinesContour[i].setStrokeWidth(1);
-
-			charOutlinesNonVFlipped[i] = charOutlines[i];
-			charOutlinesNonVFlipped[i].translate(ofVec3f(0,cps[i].height));
-			charOutlinesNonVFlipped[i].scale(1,-1);
-			charOutlinesNonVFlippedContour[i] = charOutlines[i];
-			charOutlinesNonVFlippedContour[i].setFilled(false);
-			charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
-
-
-			if(simplifyAmt>0){
-				charOutlines[i].simplify(simplifyAmt);
-				charOutlinesNonVFlipped[i].simplify(simplifyAmt);
-				charOutlinesContour[i].simplify(simplifyAmt);
-				charOutlinesNonVFlippedContour[i].simplify(simplifyAmt);
+				if (bAntiAliased == true) FT_Render_Glyph(threadFace->glyph, FT_RENDER_MODE_NORMAL);
+				else FT_Render_Glyph(threadFace->glyph, FT_RENDER_MODE_MONO);
 			}
-		}
 
+			//------------------------------------------
 
-		// -------------------------
-		// info about the character:
-		FT_Bitmap& bitmap= face->glyph->bitmap;
 
-		// Note: Using decltype here to avoid warnings across
-		// platforms using differing versions of freetype 2.
-		decltype(bitmap.width) width  = bitmap.width;
-		decltype(bitmap.rows) height = bitmap.rows;
+			if(bMakeContours){
+				if(printVectorInfo){
+					ofLogNotice("ofTrueTypeFont") <<  "character " << char(i+NUM_CHARACTER_TO_START);
+				}
+
+				//int character = i + NUM_CHARACTER_TO_START;
+				if(fromCache){
+					charOutlines[i] = ofTTFCharacter();
+					charOutlines[i].setUseShapeColor(false);
+					charOutlines[i].getCommands() = std::move(cachedOutlines[i]);
+				}else{
+					charOutlines[i] = makeContoursForCharacter( threadFace );
+				}
+				charOutlinesNonVFlipped[i] = charOutlines[i];
+				charOutlinesNonVFlipped[i].translate(ofVec3f(0,cps[i].height));
+				charOutlinesNonVFlipped[i].scale(1,-1);
+
+				// the contours have the same commands as the filled outline,
+				// they are copied after simplifying it instead of simplifying
+				// the same shape again
+				if(simplifyAmt>0){
+					charOutlines[i].simplify(simplifyAmt);
+					charOutlinesNonVFlipped[i].simplify(simplifyAmt);
+				}
 
-		cps[i].characterIndex	= i;
-		cps[i].glyph			= glyph;
-		cps[i].height 			= face->glyph->metrics.height>>6;
-		cps[i].width 			= face->glyph->metrics.width>>6;
-		cps[i].bearingX			= face->glyph->metrics.horiBearingX>>6;
-		cps[i].bearingY			= face->glyph->metrics.horiBearingY>>6;
-		cps[i].xmin				= face->glyph->bitmap_left;
-		cps[i].xmax				= cps[i].xmin + cps[i].width;
-		cps[i].ymin				= -face->glyph->bitmap_top;
-		cps[i].ymax				= cps[i].ymin + cps[i].height;
-		cps[i].advance			= face->glyph->metrics.horiAdvance>>6;
+				charOutlinesContour[i] = charOutlines[i];
+				charOutlinesContour[i].setFilled(false);
+				charOutlinesContour[i].setStrokeWidth(1);
 
+				charOutlinesNonVFlippedContour[i] = charOutlines[i];
+				charOutlinesNonVFlippedContour[i].setFilled(false);
+				charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
+			}
 
-		cps[i].tW				= cps[i].width;
-		cps[i].tH				= cps[i].height;
+			// -------------------------
+			// info about the character:
+			if(fromCache){
+				cps[i] = cachedProps[i];
+			}else{
+				copyGlyphBitmap(threadFace->glyph, bAntiAliased, cps[i], expanded_data[i]);
+			}
+			cps[i].characterIndex	= i;
+			cps[i].glyph			= glyph;
+		}
+	};
 
+	of::priv::runInThreads(numThreads, loadRange);
+	faces.clear();
 
+	for (int i = 0 ; i < nCharacters; i++){
 		areaSum += (cps[i].tW+border*2)*(cps[i].tH+border*2);
+	}
 
-		if(width==0 || height==0) continue;
-
-		// Allocate Memory For The Texture Data.
-		expanded_data[i].allocate(width, height, OF_PIXELS_GRAY_ALPHA);
-		//-------------------------------- clear data:
-		expanded_data[i].set(0,255); // every luminance pixel = 255
-		expanded_data[i].set(1,0);
-
-
-		if (bAntiAliased == true){
-			ofPixels bitmapPixels;
-			bitmapPixels.setFromExternalPixels(bitmap.buffer,width,height,OF_PIXELS_GRAY);
-			expanded_data[i].setChannel(1,bitmapPixels);
-		} else {
-			//-----------------------------------
-			// true type packs monochrome info in a
-			// 1-bit format, hella funky
-			// here we unpack it:
-			unsigned char *src =  bitmap.buffer;
-			for(decltype(height) j=0; j < height; j++) {
-				unsigned char b=0;
-				unsigned char *bptr =  src;
-				for(decltype(width) k=0; k < width; k++){
-					expanded_data[i][2*(k+j*width)] = 255;
-
-					if (k%8==0){
-						b = (*bptr++);
-					}
+	if(!fromCache && !cachePath.empty()){
+		writeFontCache(cachePath, cacheKey, cps, expanded_data, charOutlines, bMakeContours);
+	}
 
-					expanded_data[i][2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
-					b <<= 1;
-				}
-				src += bitmap.pitch;
-			}
-			//-----------------------------------
+	// size the pages so the character set fits in the first one, algorithm
+	// to calculate min w/h from
+	// http://upcommons.upc.edu/pfc/bitstream/2099.1/7720/1/TesiMasterJonas.pdf
+	// and so there's space for a few hundred more glyphs
+	int pageSize = glyphCachePageSize;
+	if(pageSize <= 0){
+		int glyphSize = ceil(max(lineHeight, glyphBBox.height)) + border*2;
+		pageSize = ofNextPow2(glyphSize * 16);
+		pageSize = ofClamp(pageSize, 256, 2048);
+		if(areaSum > 0){
+			float alpha = logf(areaSum)*1.44269;
+			pageSize = max(pageSize, int(pow(2,floor((alpha/2.f) + 0.5)))); // there doesn't seem to be a round in cmath for windows.
 		}
+		pageSize = max(pageSize, ofNextPow2(glyphSize));
 	}
 
+	// the character set is packed tallest first and pinned so it's never
+	// evicted, if the estimated size was too small try again with bigger
+	// pages
 	vector<charProps> sortedCopy = cps;
 	sort(sortedCopy.begin(),sortedCopy.end(),&compare_cps);
-
-	// pack in a texture, algorithm to calculate min w/h from
-	// http://upcommons.upc.edu/pfc/bitstream/2099.1/7720/1/TesiMasterJonas.pdf
-	//ofLogNotice("ofTrueTypeFont") << "loadFont(): areaSum: " << areaSum
-
-	bool packed = false;
-	float alpha = logf(areaSum)*1.44269;
-
-	int w;
-	int h;
-	while(!packed){
-		w = pow(2,floor((alpha/2.f) + 0.5)); // there doesn't seem to be a round in cmath for windows.
-		//w = pow(2,round(alpha/2.f));
-		h = w;//pow(2,round(alpha - round(alpha/2.f)));
-		int x=0;
-		int y=0;
-		int maxRowHeight = sortedCopy[0].tH + border*2;
-		for(int i=0;i<(int)cps.size();i++){
-			if(x+sortedCopy[i].tW + border*2>w){
-				x = 0;
-				y += maxRowHeight;
-				maxRowHeight = sortedCopy[i].tH + border*2;
-				if(y + maxRowHeight > h){
-					alpha++;
-					break;
-				}
+	while(true){
+		glyphAtlas.setup(pageSize, pageSize, max(glyphCacheMaxPages, size_t(1)), OF_PIXELS_GRAY_ALPHA, border);
+		for(const auto & sorted: sortedCopy){
+			int i = sorted.characterIndex;
+			const ofGlyphAtlas::Region * region = glyphAtlas.add(i + NUM_CHARACTER_TO_START, expanded_data[i], true);
+			if(region){
+				cps[i].t1		= float(region->x)/float(pageSize);
+				cps[i].v1		= float(region->y)/float(pageSize);
+				cps[i].t2		= float(region->x + cps[i].tW)/float(pageSize);
+				cps[i].v2		= float(region->y + cps[i].tH)/float(pageSize);
 			}
-			x+= sortedCopy[i].tW + border*2;
-			if(i==(int)cps.size()-1) packed = true;
 		}
-
+		if(glyphCachePageSize > 0 || glyphAtlas.getNumPages() <= 1 || pageSize >= 4096){
+			break;
+		}
+		pageSize *= 2;
 	}
 
+	// ------------- close the library and typeface
+  	bLoadedOk = true;
+	return true;
+}
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::setGlyphCacheSize(int pageSize, size_t maxPages){
+	glyphCachePageSize = pageSize;
+	glyphCacheMaxPages = maxPages;
+}
 
-	ofPixels atlasPixelsLuminanceAlpha;
-	atlasPixelsLuminanceAlpha.allocate(w,h,OF_PIXELS_GRAY_ALPHA);
-	atlasPixelsLuminanceAlpha.set(0,255);
-	atlasPixelsLuminanceAlpha.set(1,0);
-
-
-	int x=0;
-	int y=0;
-	int maxRowHeight = sortedCopy[0].tH + border*2;
-	for(int i=0;i<(int)cps.size();i++){
-		ofPixels & charPixels = expanded_data[sortedCopy[i].characterIndex];
-
-		if(x+sortedCopy[i].tW + border*2>w){
-			x = 0;
-			y += maxRowHeight;
-			maxRowHeight = sortedCopy[i].tH + border*2;
-		}
+//-----------------------------------------------------------
+void ofTrueTypeFont::setPreloadCharacterSet(bool preload){
+	bPreloadCharacterSet = preload;
+}
 
-		cps[sortedCopy[i].characterIndex].t1		= float(x + border)/float(w);
-		cps[sortedCopy[i].characterIndex].v1		= float(y + border)/float(h);
-		cps[sortedCopy[i].characterIndex].t2		= float(cps[sortedCopy[i].characterIndex].tW + x + border)/float(w);
-		cps[sortedCopy[i].characterIndex].v2		= float(cps[sortedCopy[i].characterIndex].tH + y + border)/float(h);
-		charPixels.pasteInto(atlasPixelsLuminanceAlpha,x+border,y+border);
-		x+= sortedCopy[i].tW + border*2;
-	}
-	texAtlas.allocate(atlasPixelsLuminanceAlpha,false);
+//-----------------------------------------------------------
+void ofTrueTypeFont::setNumLoadThreads(int numThreads){
+	numLoadThreads = numThreads;
+}
 
-	if(bAntiAliased && fontSize>20){
-		texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
-	}else{
-		texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
-	}
-	texAtlas.loadData(atlasPixelsLuminanceAlpha);
+//-----------------------------------------------------------
+void ofTrueTypeFont::setCacheDirectory(const std::string& directory){
+	fontCacheDirectory = directory;
+}
 
-	// ------------- close the library and typeface
-  	bLoadedOk = true;
-	return true;
+//-----------------------------------------------------------
+const std::string& ofTrueTypeFont::getCacheDirectory(){
+	return fontCacheDirectory;
 }
 
 //-----------------------------------------------------------
@@ -889,6 +1233,7 @@ int ofTrueTypeFont::getSize() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	clearTextLayouts();
 }
 
 //-----------------------------------------------------------
@@ -914,6 +1259,7 @@ const ofRectangle & ofTrueTypeFont::getGlyphBBox() const {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	clearTextLayouts();
 }
 
 //-----------------------------------------------------------
@@ -924,6 +1270,7 @@ float ofTrueTypeFont::getLetterSpacing() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	clearTextLayouts();
 }
 
 //-----------------------------------------------------------
@@ -959,60 +1306,87 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(int character, bool vflip, b
 }
 
 //-----------------------------------------------------------
-void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
-
-	if (c >= nCharacters){
-		//ofLogError("ofTrueTypeFont") << "drawChar(): char " << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
-		return;
+const charProps * ofTrueTypeFont::getGlyph(uint32_t c, ofGlyphAtlas::Region & region) const{
+	if(c < NUM_CHARACTER_TO_START){
+		return nullptr;
 	}
 
-
-	int	xmin, ymin, xmax, ymax;
-	float t1, v1, t2, v2;
-	t2		= cps[c].t2;
-	v2		= cps[c].v2;
-	t1		= cps[c].t1;
-	v1		= cps[c].v1;
-
-	xmin		= cps[c].xmin+x;
-	ymin		= cps[c].ymin;
-	xmax		= cps[c].xmax+x;
-	ymax		= cps[c].ymax;
-
-	if(!vFlipped){
-       ymin *= -1;
-       ymax *= -1;
+	int cy = c - NUM_CHARACTER_TO_START;
+	const charProps * props = nullptr;
+	if(cy < nCharacters){
+		props = &cps[cy];
+	}else{
+		auto it = glyphs.find(c);
+		if(it != glyphs.end()){
+			props = &it->second;
+		}
 	}
 
-    ymin += y;
-    ymax += y;
-
-	int firstIndex = stringQuads.getVertices().size();
+	const ofGlyphAtlas::Region * atlasRegion = glyphAtlas.find(c);
+	if(!atlasRegion){
+		// outside of the character set: rasterize it now, this also
+		// happens again for glyphs that were evicted from the atlas
+		if(!face) return nullptr;
+		FT_Error err = FT_Load_Glyph( face.get(), FT_Get_Char_Index( face.get(), c ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+		if(err){
+			ofLogError("ofTrueTypeFont") << "getGlyph(): FT_Load_Glyph failed for char " << c << ": FT_Error " << err;
+			return nullptr;
+		}
+		if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+		else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
 
-	stringQuads.addVertex(ofVec3f(xmin,ymin));
-	stringQuads.addVertex(ofVec3f(xmax,ymin));
-	stringQuads.addVertex(ofVec3f(xmax,ymax));
-	stringQuads.addVertex(ofVec3f(xmin,ymax));
+		charProps & newProps = glyphs[c];
+		ofPixels pixels;
+		newProps.characterIndex = -1;
+		newProps.glyph = c;
+		copyGlyphBitmap(face->glyph, bAntiAliased, newProps, pixels);
+		props = &newProps;
 
-	stringQuads.addTexCoord(ofVec2f(t1,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v2));
-	stringQuads.addTexCoord(ofVec2f(t1,v2));
+		atlasRegion = glyphAtlas.add(c, pixels);
+		if(!atlasRegion){
+			return nullptr;
+		}
+	}
 
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
+	region = *atlasRegion;
+	return props;
 }
 
+//-----------------------------------------------------------
+static const short unknownKerning = std::numeric_limits<short>::min();
+
 //-----------------------------------------------------------
 int ofTrueTypeFont::getKerning(int c, int prevC) const{
     if(useKerning){
+        // kerning is looked up once per pair and kept in a table for the
+        // character set and in a map for any other pair
+        int cy = c - NUM_CHARACTER_TO_START;
+        int prevCy = prevC - NUM_CHARACTER_TO_START;
+        short * cached = nullptr;
+        if(cy >= 0 && cy < nCharacters && prevCy >= 0 && prevCy < nCharacters){
+            if(kerningTable.empty()){
+                kerningTable.assign(nCharacters * nCharacters, unknownKerning);
+            }
+            cached = &kerningTable[prevCy * nCharacters + cy];
+            if(*cached != unknownKerning){
+                return *cached;
+            }
+        }else{
+            auto it = kerningPairs.find((unsigned long long)prevC << 32 | (unsigned int)c);
+            if(it != kerningPairs.end()){
+                return it->second;
+            }
+        }
+
         FT_Vector kerning;
         FT_Get_Kerning(face.get(), FT_Get_Char_Index(face.get(), prevC), FT_Get_Char_Index(face.get(), c), FT_KERNING_UNFITTED, &kerning);
-        return kerning.x>>6;
+        int value = kerning.x>>6;
+        if(cached){
+            *cached = value;
+        }else{
+            kerningPairs[(unsigned long long)prevC << 32 | (unsigned int)c] = value;
+        }
+        return value;
     }else{
         return 0;
     }
@@ -1100,19 +1474,7 @@ float ofTrueTypeFont::stringWidth(const std::string& c) const{
 
 //-----------------------------------------------------------
 ofRectangle ofTrueTypeFont::getStringBoundingBox(const std::string& c, float x, float y, bool vflip) const{
-	ofMesh mesh = getStringMesh(c,x,y,vflip);
-	ofRectangle bb(std::numeric_limits<float>::max(),std::numeric_limits<float>::max(),0,0);
-	float maxX = std::numeric_limits<float>::min();
-	float maxY = std::numeric_limits<float>::min();
-	for(const auto & v: mesh.getVertices()){
-		bb.x = min(v.x,bb.x);
-		bb.y = min(v.y,bb.y);
-		maxX = max(v.x,maxX);
-		maxY = max(v.y,maxY);
-	}
-	bb.width = maxX - bb.x;
-	bb.height = maxY - bb.y;
-	return bb;
+	return getTextLayout(c)->getBoundingBox(x,y,vflip);
 }
 
 //-----------------------------------------------------------
@@ -1123,54 +1485,106 @@ float ofTrueTypeFont::stringHeight(const std::string& c) const{
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y, bool vFlipped) const{
-	stringQuads.clear();
-	GLfloat		X		= x;
-	GLfloat		Y		= y;
-	int newLineDirection		= 1;
+	getTextLayout(str)->getMeshes(pageQuads,x,y,vFlipped);
+}
 
-	if(!vFlipped){
-		// this would align multiline texts to the last line when vflip is disabled
-		//int lines = ofStringTimesInString(c,"\n");
-		//Y = lines*lineHeight;
-		newLineDirection = -1;
+//-----------------------------------------------------------
+shared_ptr<const ofTextLayout> ofTrueTypeFont::getTextLayout(const std::string& str) const{
+	auto it = textLayouts.find(str);
+	if(it != textLayouts.end()){
+		textLayoutsLru.splice(textLayoutsLru.begin(), textLayoutsLru, it->second.second);
+		it->second.first->update();
+		return it->second.first;
 	}
 
-	int prevC = -1;
-	try{
-		for(auto c: ofUTF8Iterator(str)){
-			int cy = c - NUM_CHARACTER_TO_START;
-			if (c == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
-				prevC = -1;
-            } else if( c == ' ' && spaceSize>0 ) {
-                X += spaceSize;
-                if(prevC > -1) {
-                    X += getKerning(c,prevC) * letterSpacing;
-                }
-            } else if(cy >=0 && cy<nCharacters) {
-				if(prevC > -1) {
-					X += getKerning(c,prevC) * letterSpacing;
-				}
-				drawChar(cy, X, Y, vFlipped);
-				X += cps[cy].advance * letterSpacing;
-			}
-			prevC = c;
-		}
-	}catch(...){
+	auto layout = std::make_shared<ofTextLayout>(*this, str);
+	if(textLayoutCacheSize == 0){
+		return layout;
+	}
+	if(textLayouts.size() >= textLayoutCacheSize){
+		textLayouts.erase(*textLayoutsLru.back());
+		textLayoutsLru.pop_back();
+	}
+	auto inserted = textLayouts.emplace(str, std::make_pair(layout, textLayoutsLru.end())).first;
+	textLayoutsLru.push_front(&inserted->first);
+	inserted->second.second = textLayoutsLru.begin();
+	return layout;
+}
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::setTextLayoutCacheSize(size_t size){
+	textLayoutCacheSize = size;
+	while(textLayouts.size() > textLayoutCacheSize){
+		textLayouts.erase(*textLayoutsLru.back());
+		textLayoutsLru.pop_back();
 	}
 }
 
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getTextLayoutCacheSize() const{
+	return textLayoutCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearTextLayouts() const{
+	textLayouts.clear();
+	textLayoutsLru.clear();
+}
+
 //-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(const std::string& c, float x, float y, bool vFlipped) const{
 	createStringMesh(c,x,y,vFlipped);
+	if(pageQuads.size() == 1){
+		return pageQuads[0];
+	}
+	stringQuads.clear();
+	for(const auto & mesh: pageQuads){
+		stringQuads.append(mesh);
+	}
 	return stringQuads;
 }
 
+//-----------------------------------------------------------
+const vector<ofMesh> & ofTrueTypeFont::getStringMeshes(const std::string& c, float x, float y, bool vFlipped) const{
+	createStringMesh(c,x,y,vFlipped);
+	return pageQuads;
+}
+
 //-----------------------------------------------------------
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
-	return texAtlas;
+	return getFontTexture(0);
+}
+
+//-----------------------------------------------------------
+const ofTexture & ofTrueTypeFont::getFontTexture(size_t page) const{
+	if(atlasTextures.size() < max(glyphAtlas.getNumPages(), page + 1)){
+		atlasTextures.resize(max(glyphAtlas.getNumPages(), page + 1));
+	}
+	if(page < glyphAtlas.getNumPages() && glyphAtlas.isPageDirty(page)){
+		const ofPixels & pixels = glyphAtlas.getPage(page);
+		ofTexture & texture = atlasTextures[page];
+		if(!texture.isAllocated()){
+			texture.allocate(pixels,false);
+			if(bAntiAliased && fontSize>20){
+				texture.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+			}else{
+				texture.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+			}
+		}
+		texture.loadData(pixels);
+		glyphAtlas.markPageClean(page);
+	}
+	return atlasTextures[page];
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getNumAtlasPages() const{
+	return glyphAtlas.getNumPages();
+}
+
+//-----------------------------------------------------------
+const ofGlyphAtlas & ofTrueTypeFont::getGlyphAtlas() const{
+	return glyphAtlas;
 }
 
 //-----------------------------------------------------------
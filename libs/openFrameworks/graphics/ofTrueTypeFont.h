@@ -7,6 +7,10 @@
 #include "ofPath.h"
 #include "ofTexture.h"
 #include "ofMesh.h"
+#include "ofGlyphAtlas.h"
+#include "ofTextLayout.h"
+#include <list>
+#include <unordered_map>
 
 /// \file
 /// The ofTrueTypeFont class provides an interface to load fonts into
@@ -112,6 +116,54 @@ public:
                   float simplifyAmt=0.3f,
                   int dpi=0));
 	
+	/// \brief Sets the size of the pages of the glyph atlas and the number
+	/// of pages after which the least recently used glyphs are evicted.
+	///
+	/// Characters outside of the loaded character set are rasterized the
+	/// first time they are drawn or measured and packed in the atlas.
+	/// Has to be called before load. By default the pages are big enough
+	/// for the character set and a few hundred more glyphs and the atlas
+	/// has 4 pages.
+	///
+	/// \param pageSize Width and height of each page, 0 to compute it from
+	/// the font size.
+	/// \param maxPages Maximum number of pages, each page is a texture.
+	void setGlyphCacheSize(int pageSize, size_t maxPages);
+
+	/// \brief Sets if load rasterizes the character set up front, true by
+	/// default.
+	///
+	/// When disabled load only reads the font metrics and every glyph is
+	/// rasterized the first time it's used which makes loading faster,
+	/// getNumCharacters() returns 0 then. Has to be called before load, it's
+	/// ignored for fonts loaded with makeContours.
+	void setPreloadCharacterSet(bool preload);
+
+	/// \brief Sets how many threads load uses to rasterize the character
+	/// set and extract its contours.
+	///
+	/// Each thread opens its own face of the font file and loads a range of
+	/// characters, the result is the same with any number of threads. Has
+	/// to be called before load.
+	///
+	/// \param numThreads Number of threads, 0 (the default) uses one per
+	/// core. Small character sets are loaded with fewer threads.
+	void setNumLoadThreads(int numThreads);
+
+	/// \brief Sets a directory where load saves the rasterized character
+	/// set and the contours of the fonts it loads.
+	///
+	/// Loading the same font file again with the same size, dpi and options
+	/// reads them back instead of rasterizing the characters again. The
+	/// files are named after a hash of the contents of the font file, its
+	/// size, dpi and load options so a font that changes gets a new one.
+	/// Empty by default, which disables the cache.
+	///
+	/// \param directory Path of the directory, relative to the data folder
+	/// or absolute. It's created when the first font is saved.
+	static void setCacheDirectory(const std::string& directory);
+	static const std::string& getCacheDirectory();
+
 	/// \brief Has the font been loaded successfully?
 	/// \returns true if the font was loaded.
 	bool isLoaded() const;
@@ -238,6 +290,23 @@ public:
 	/// \returns the bounding box of a string as a rectangle.
 	ofRectangle getStringBoundingBox(const std::string& s, float x, float y, bool vflip=true) const;
 
+	/// \brief Returns the layout of a string, the positions of its glyphs,
+	/// its lines and bounding box.
+	///
+	/// The font keeps the layouts of the last strings it laid out so
+	/// drawing or measuring the same string again doesn't need to decode
+	/// it, look up its glyphs and kerning again.
+	///
+	/// \param s The string to lay out.
+	/// \returns the layout of the string, it stays valid after it's removed
+	/// from the cache.
+	shared_ptr<const ofTextLayout> getTextLayout(const std::string& s) const;
+
+	/// \brief Sets how many text layouts the font keeps, 1024 by default,
+	/// 0 disables the cache.
+	void setTextLayoutCacheSize(size_t size);
+	size_t getTextLayoutCacheSize() const;
+
 	/// \}
 	/// \name Drawing
 	/// \{
@@ -262,6 +331,25 @@ public:
 	const ofMesh & getStringMesh(const std::string& s, float x, float y, bool vflip=true) const;
 	const ofTexture & getFontTexture() const;
 
+	/// \brief Returns one mesh per page of the glyph atlas with the
+	/// characters of the string that are packed in that page.
+	///
+	/// Each mesh has to be drawn with the texture returned by
+	/// getFontTexture(page) for the same index, getStringMesh() returns all
+	/// the characters in one mesh which is only correct to draw when the
+	/// atlas has one page.
+	const vector<ofMesh> & getStringMeshes(const std::string& s, float x, float y, bool vflip=true) const;
+
+	/// \brief Returns the texture for a page of the glyph atlas, uploading
+	/// the glyphs rasterized since the last call.
+	const ofTexture & getFontTexture(size_t page) const;
+
+	/// \brief Number of pages in the glyph atlas.
+	size_t getNumAtlasPages() const;
+
+	/// \brief The CPU side of the glyph atlas.
+	const ofGlyphAtlas & getGlyphAtlas() const;
+
 	/// \}
 	
 protected:
@@ -293,15 +381,30 @@ protected:
 
 
     int getKerning(int c, int prevC) const;
-	void drawChar(int c, float x, float y, bool vFlipped) const;
+	const charProps * getGlyph(uint32_t c, ofGlyphAtlas::Region & region) const;
 	void drawCharAsShape(int c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(const std::string& s, float x, float y, bool vFlipped) const;
+	void clearAtlasTextures();
 	
 	std::string filename;
 
-	ofTexture texAtlas;
+	mutable ofGlyphAtlas glyphAtlas;
+	mutable vector<ofTexture> atlasTextures;
+	mutable unordered_map<uint32_t, charProps> glyphs; // characters outside of the character set
+	int glyphCachePageSize;
+	size_t glyphCacheMaxPages;
+	bool bPreloadCharacterSet;
+	int numLoadThreads;
 	mutable ofMesh stringQuads;
+	mutable vector<ofMesh> pageQuads;
 	bool useKerning;
+	mutable vector<short> kerningTable; // pairs of characters in the character set
+	mutable unordered_map<unsigned long long, int> kerningPairs; // any other pair
+
+	void clearTextLayouts() const;
+	mutable unordered_map<std::string, pair<shared_ptr<ofTextLayout>, list<const std::string*>::iterator>> textLayouts;
+	mutable list<const std::string*> textLayoutsLru;
+	size_t textLayoutCacheSize;
 
 	/// \endcond
 
@@ -317,6 +420,7 @@ private:
 	static void finishLibraries();
 
 	friend void ofExitCallback();
+	friend class ofTextLayout;
 };
 
 
@@ -0,0 +1,1098 @@
+#include "ofBatchMath.h"
+#include "ofPixels.h"
+#include "ofLog.h"
+#include "ofWorkerThreads.h"
+#include <atomic>
+#include <algorithm>
+
+#if !defined(TARGET_EMSCRIPTEN) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define OF_BATCH_SSE2
+	#define OF_BATCH_AVX
+	#include <emmintrin.h>
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define OF_TARGET_AVX
+	#else
+		#include <cpuid.h>
+		// the avx kernels are compiled for avx regardless of the compiler
+		// flags and only called if the cpu supports it
+		#define OF_TARGET_AVX __attribute__((target("avx")))
+	#endif
+#endif
+
+// ofNoise.h defines macros with common names so it goes after the rest
+#include "ofNoise.h"
+
+static_assert(sizeof(ofVec2f) == 2 * sizeof(float), "ofVec2f has to be 2 packed floats");
+static_assert(sizeof(ofVec3f) == 3 * sizeof(float), "ofVec3f has to be 3 packed floats");
+static_assert(sizeof(ofVec4f) == 4 * sizeof(float), "ofVec4f has to be 4 packed floats");
+
+namespace{
+	// what the 3d transforms do with the 4th row and column of the matrix
+	enum TransformMode{
+		Vectors,    // ignored, only rotation and scale
+		Affine,     // translation, w is always 1
+		Projective, // translation and divide by w
+	};
+
+	bool isAffine(const ofMatrix4x4 & m){
+		return m._mat[0][3] == 0 && m._mat[1][3] == 0 && m._mat[2][3] == 0 && m._mat[3][3] == 1;
+	}
+
+	const float * strided(const float * p, size_t stride, size_t i){
+		return reinterpret_cast<const float*>(reinterpret_cast<const char*>(p) + stride * i);
+	}
+
+	float * strided(float * p, size_t stride, size_t i){
+		return reinterpret_cast<float*>(reinterpret_cast<char*>(p) + stride * i);
+	}
+
+	struct NoiseSettings{
+		int octaves;
+		float lacunarity;
+		float gain;
+		bool isSigned;
+	};
+
+	struct Kernels{
+		void (*transformPoints)(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n, TransformMode mode);
+		void (*transformStrided)(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n, TransformMode mode);
+		void (*transformPoints4)(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n);
+		void (*normalize)(ofVec3f * v, size_t n);
+		void (*boundingBox)(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max);
+		size_t (*spheresInsidePlanes)(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n);
+		size_t (*boxesInsidePlanes)(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n);
+		void (*noisePoints)(int dims, const float * points, float * dst, size_t n, const NoiseSettings & settings);
+		void (*noiseRow)(int dims, float x, float stepX, float y, float z, float * dst, size_t n, const NoiseSettings & settings);
+	};
+}
+
+//----------------------------------------------------------
+// scalar kernels, the reference for the simd ones which do the same
+// operations in the same order so the results are identical for finite
+// values
+//----------------------------------------------------------
+static void transformStridedScalar(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n, TransformMode mode){
+	for(size_t i = 0; i < n; i++){
+		const float * s = strided(src, srcStride, i);
+		float * d = strided(dst, dstStride, i);
+		ofVec3f v(s[0], s[1], s[2]);
+		v = mode == Vectors ? ofMatrix4x4::transform3x3(v, m) : m.preMult(v);
+		d[0] = v.x;
+		d[1] = v.y;
+		d[2] = v.z;
+	}
+}
+
+//----------------------------------------------------------
+static void transformPointsScalar(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n, TransformMode mode){
+	transformStridedScalar(m, src->getPtr(), sizeof(ofVec3f), dst->getPtr(), sizeof(ofVec3f), n, mode);
+}
+
+//----------------------------------------------------------
+static void transformPoints4Scalar(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n){
+	for(size_t i = 0; i < n; i++){
+		dst[i] = m.preMult(src[i]);
+	}
+}
+
+//----------------------------------------------------------
+static void normalizeScalar(ofVec3f * v, size_t n){
+	for(size_t i = 0; i < n; i++){
+		v[i].normalize();
+	}
+}
+
+//----------------------------------------------------------
+static void boundingBoxScalar(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max){
+	for(size_t i = 0; i < n; i++){
+		min.x = std::min(min.x, v[i].x);
+		min.y = std::min(min.y, v[i].y);
+		min.z = std::min(min.z, v[i].z);
+		max.x = std::max(max.x, v[i].x);
+		max.y = std::max(max.y, v[i].y);
+		max.z = std::max(max.z, v[i].z);
+	}
+}
+
+//----------------------------------------------------------
+static size_t spheresInsidePlanesScalar(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n){
+	size_t count = 0;
+	for(size_t i = 0; i < n; i++){
+		const ofVec3f & c = centers[i];
+		float minDistance = radii ? -radii[i] : -0.f;
+		bool in = true;
+		for(size_t j = 0; j < numPlanes; j++){
+			const ofVec4f & p = planes[j];
+			in &= p.x * c.x + p.y * c.y + p.z * c.z + p.w >= minDistance;
+		}
+		inside[i] = in;
+		count += in;
+	}
+	return count;
+}
+
+//----------------------------------------------------------
+static size_t boxesInsidePlanesScalar(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n){
+	size_t count = 0;
+	for(size_t i = 0; i < n; i++){
+		bool in = true;
+		for(size_t j = 0; j < numPlanes; j++){
+			// the corner furthest along the normal of the plane
+			const ofVec4f & p = planes[j];
+			float x = p.x >= 0 ? max[i].x : min[i].x;
+			float y = p.y >= 0 ? max[i].y : min[i].y;
+			float z = p.z >= 0 ? max[i].z : min[i].z;
+			in &= p.x * x + p.y * y + p.z * z + p.w >= 0;
+		}
+		inside[i] = in;
+		count += in;
+	}
+	return count;
+}
+
+#ifdef OF_BATCH_SSE2
+//----------------------------------------------------------
+// sse2 kernels, arrays of ofVec3f are processed 4 at a time converted to
+// one register per coordinate, strided data one vector at a time
+//----------------------------------------------------------
+static inline void loadSoA(const float * p, __m128 & x, __m128 & y, __m128 & z){
+	// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+	__m128 a = _mm_loadu_ps(p);
+	__m128 b = _mm_loadu_ps(p + 4);
+	__m128 c = _mm_loadu_ps(p + 8);
+	__m128 x2x3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1,1,2,2));
+	__m128 y0y1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0,0,1,1));
+	__m128 y2y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2,2,3,3));
+	__m128 z0z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1,1,2,2));
+	__m128 z2z3 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3,3,0,0));
+	x = _mm_shuffle_ps(a, x2x3, _MM_SHUFFLE(2,0,3,0));
+	y = _mm_shuffle_ps(y0y1, y2y3, _MM_SHUFFLE(2,0,2,0));
+	z = _mm_shuffle_ps(z0z1, z2z3, _MM_SHUFFLE(2,0,2,0));
+}
+
+//----------------------------------------------------------
+static inline void storeSoA(float * p, __m128 x, __m128 y, __m128 z){
+	__m128 x0y0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0,0,0,0));
+	__m128 z0x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1,1,0,0));
+	__m128 y1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1,1,1,1));
+	__m128 x2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2,2,2,2));
+	__m128 z2x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3,3,2,2));
+	__m128 y3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3,3,3,3));
+	_mm_storeu_ps(p, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(p + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(p + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2,0,2,0)));
+}
+
+//----------------------------------------------------------
+static inline void store3(float * p, __m128 v){
+	_mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+	_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+//----------------------------------------------------------
+template<TransformMode mode>
+static void transformPointsSSE2(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n){
+	__m128 c[4][4];
+	for(int i = 0; i < 4; i++){
+		for(int j = 0; j < 4; j++){
+			c[i][j] = _mm_set1_ps(m._mat[i][j]);
+		}
+	}
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 x, y, z;
+		loadSoA(src[i].getPtr(), x, y, z);
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0][0], x), _mm_mul_ps(c[1][0], y)), _mm_mul_ps(c[2][0], z));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0][1], x), _mm_mul_ps(c[1][1], y)), _mm_mul_ps(c[2][1], z));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0][2], x), _mm_mul_ps(c[1][2], y)), _mm_mul_ps(c[2][2], z));
+		if(mode != Vectors){
+			rx = _mm_add_ps(rx, c[3][0]);
+			ry = _mm_add_ps(ry, c[3][1]);
+			rz = _mm_add_ps(rz, c[3][2]);
+		}
+		if(mode == Projective){
+			__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0][3], x), _mm_mul_ps(c[1][3], y)), _mm_mul_ps(c[2][3], z)), c[3][3]);
+			__m128 d = _mm_div_ps(_mm_set1_ps(1.f), w);
+			rx = _mm_mul_ps(rx, d);
+			ry = _mm_mul_ps(ry, d);
+			rz = _mm_mul_ps(rz, d);
+		}
+		storeSoA(dst[i].getPtr(), rx, ry, rz);
+	}
+	transformPointsScalar(m, src + i, dst + i, n - i, mode);
+}
+
+//----------------------------------------------------------
+static void transformPointsSSE2(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n, TransformMode mode){
+	switch(mode){
+	case Vectors: transformPointsSSE2<Vectors>(m, src, dst, n); break;
+	case Affine: transformPointsSSE2<Affine>(m, src, dst, n); break;
+	case Projective: transformPointsSSE2<Projective>(m, src, dst, n); break;
+	}
+}
+
+//----------------------------------------------------------
+template<TransformMode mode>
+static void transformStridedSSE2(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n){
+	__m128 r0 = _mm_loadu_ps(m._mat[0].getPtr());
+	__m128 r1 = _mm_loadu_ps(m._mat[1].getPtr());
+	__m128 r2 = _mm_loadu_ps(m._mat[2].getPtr());
+	__m128 r3 = _mm_loadu_ps(m._mat[3].getPtr());
+	for(size_t i = 0; i < n; i++){
+		const float * s = strided(src, srcStride, i);
+		__m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(s[0]), r0), _mm_mul_ps(_mm_set1_ps(s[1]), r1)), _mm_mul_ps(_mm_set1_ps(s[2]), r2));
+		if(mode != Vectors){
+			v = _mm_add_ps(v, r3);
+		}
+		if(mode == Projective){
+			v = _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.f), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3))));
+		}
+		store3(strided(dst, dstStride, i), v);
+	}
+}
+
+//----------------------------------------------------------
+static void transformStridedSSE2(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n, TransformMode mode){
+	switch(mode){
+	case Vectors: transformStridedSSE2<Vectors>(m, src, srcStride, dst, dstStride, n); break;
+	case Affine: transformStridedSSE2<Affine>(m, src, srcStride, dst, dstStride, n); break;
+	case Projective: transformStridedSSE2<Projective>(m, src, srcStride, dst, dstStride, n); break;
+	}
+}
+
+//----------------------------------------------------------
+static void transformPoints4SSE2(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n){
+	__m128 r0 = _mm_loadu_ps(m._mat[0].getPtr());
+	__m128 r1 = _mm_loadu_ps(m._mat[1].getPtr());
+	__m128 r2 = _mm_loadu_ps(m._mat[2].getPtr());
+	__m128 r3 = _mm_loadu_ps(m._mat[3].getPtr());
+	for(size_t i = 0; i < n; i++){
+		__m128 v = _mm_loadu_ps(src[i].getPtr());
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0,0,0,0)), r0),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)), r1)),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,2,2,2)), r2)),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)), r3));
+		_mm_storeu_ps(dst[i].getPtr(), r);
+	}
+}
+
+//----------------------------------------------------------
+static void normalizeSSE2(ofVec3f * v, size_t n){
+	__m128 zero = _mm_setzero_ps();
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 x, y, z;
+		loadSoA(v[i].getPtr(), x, y, z);
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		__m128 mask = _mm_cmpgt_ps(length, zero);
+		x = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(x, length)), _mm_andnot_ps(mask, x));
+		y = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(y, length)), _mm_andnot_ps(mask, y));
+		z = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(z, length)), _mm_andnot_ps(mask, z));
+		storeSoA(v[i].getPtr(), x, y, z);
+	}
+	normalizeScalar(v + i, n - i);
+}
+
+//----------------------------------------------------------
+static inline float horizontalMin(__m128 v){
+	v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_min_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)));
+	return _mm_cvtss_f32(v);
+}
+
+//----------------------------------------------------------
+static inline float horizontalMax(__m128 v){
+	v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_max_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)));
+	return _mm_cvtss_f32(v);
+}
+
+//----------------------------------------------------------
+static void boundingBoxSSE2(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max){
+	__m128 minX = _mm_set1_ps(min.x), minY = _mm_set1_ps(min.y), minZ = _mm_set1_ps(min.z);
+	__m128 maxX = _mm_set1_ps(max.x), maxY = _mm_set1_ps(max.y), maxZ = _mm_set1_ps(max.z);
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 x, y, z;
+		loadSoA(v[i].getPtr(), x, y, z);
+		minX = _mm_min_ps(minX, x);
+		minY = _mm_min_ps(minY, y);
+		minZ = _mm_min_ps(minZ, z);
+		maxX = _mm_max_ps(maxX, x);
+		maxY = _mm_max_ps(maxY, y);
+		maxZ = _mm_max_ps(maxZ, z);
+	}
+	min.set(horizontalMin(minX), horizontalMin(minY), horizontalMin(minZ));
+	max.set(horizontalMax(maxX), horizontalMax(maxY), horizontalMax(maxZ));
+	boundingBoxScalar(v + i, n - i, min, max);
+}
+
+//----------------------------------------------------------
+static inline size_t storeMask(int bits, uint8_t * inside, int n){
+	size_t count = 0;
+	for(int i = 0; i < n; i++){
+		inside[i] = (bits >> i) & 1;
+		count += inside[i];
+	}
+	return count;
+}
+
+//----------------------------------------------------------
+static inline __m128 planeDistance(const ofVec4f & p, __m128 x, __m128 y, __m128 z){
+	return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), x), _mm_mul_ps(_mm_set1_ps(p.y), y)), _mm_mul_ps(_mm_set1_ps(p.z), z)), _mm_set1_ps(p.w));
+}
+
+//----------------------------------------------------------
+static size_t spheresInsidePlanesSSE2(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n){
+	__m128 sign = _mm_set1_ps(-0.f);
+	size_t count = 0;
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 x, y, z;
+		loadSoA(centers[i].getPtr(), x, y, z);
+		__m128 minDistance = radii ? _mm_xor_ps(_mm_loadu_ps(radii + i), sign) : sign;
+		__m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for(size_t j = 0; j < numPlanes; j++){
+			in = _mm_and_ps(in, _mm_cmpge_ps(planeDistance(planes[j], x, y, z), minDistance));
+		}
+		count += storeMask(_mm_movemask_ps(in), inside + i, 4);
+	}
+	return count + spheresInsidePlanesScalar(planes, numPlanes, centers + i, radii ? radii + i : nullptr, inside + i, n - i);
+}
+
+//----------------------------------------------------------
+static size_t boxesInsidePlanesSSE2(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n){
+	__m128 zero = _mm_setzero_ps();
+	size_t count = 0;
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 minX, minY, minZ, maxX, maxY, maxZ;
+		loadSoA(min[i].getPtr(), minX, minY, minZ);
+		loadSoA(max[i].getPtr(), maxX, maxY, maxZ);
+		__m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for(size_t j = 0; j < numPlanes; j++){
+			const ofVec4f & p = planes[j];
+			__m128 distance = planeDistance(p, p.x >= 0 ? maxX : minX, p.y >= 0 ? maxY : minY, p.z >= 0 ? maxZ : minZ);
+			in = _mm_and_ps(in, _mm_cmpge_ps(distance, zero));
+		}
+		count += storeMask(_mm_movemask_ps(in), inside + i, 4);
+	}
+	return count + boxesInsidePlanesScalar(planes, numPlanes, min + i, max + i, inside + i, n - i);
+}
+#endif
+
+#ifdef OF_BATCH_AVX
+//----------------------------------------------------------
+// avx kernels, the same as the sse2 ones with 8 vectors at a time, each
+// 128 bit half of the registers holds 4 of them in the same layout
+//----------------------------------------------------------
+OF_TARGET_AVX static inline __m256 load2(const float * p0, const float * p1){
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p0)), _mm_loadu_ps(p1), 1);
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static inline void store2(float * p0, float * p1, __m256 v){
+	_mm_storeu_ps(p0, _mm256_castps256_ps128(v));
+	_mm_storeu_ps(p1, _mm256_extractf128_ps(v, 1));
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static inline void loadSoA(const float * p, __m256 & x, __m256 & y, __m256 & z){
+	__m256 a = load2(p, p + 12);
+	__m256 b = load2(p + 4, p + 16);
+	__m256 c = load2(p + 8, p + 20);
+	__m256 x2x3 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1,1,2,2));
+	__m256 y0y1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0,0,1,1));
+	__m256 y2y3 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2,2,3,3));
+	__m256 z0z1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1,1,2,2));
+	__m256 z2z3 = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3,3,0,0));
+	x = _mm256_shuffle_ps(a, x2x3, _MM_SHUFFLE(2,0,3,0));
+	y = _mm256_shuffle_ps(y0y1, y2y3, _MM_SHUFFLE(2,0,2,0));
+	z = _mm256_shuffle_ps(z0z1, z2z3, _MM_SHUFFLE(2,0,2,0));
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static inline void storeSoA(float * p, __m256 x, __m256 y, __m256 z){
+	__m256 x0y0 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0,0,0,0));
+	__m256 z0x1 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1,1,0,0));
+	__m256 y1z1 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(1,1,1,1));
+	__m256 x2y2 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2,2,2,2));
+	__m256 z2x3 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3,3,2,2));
+	__m256 y3z3 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3,3,3,3));
+	store2(p, p + 12, _mm256_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2,0,2,0)));
+	store2(p + 4, p + 16, _mm256_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2,0,2,0)));
+	store2(p + 8, p + 20, _mm256_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2,0,2,0)));
+}
+
+//----------------------------------------------------------
+template<TransformMode mode>
+OF_TARGET_AVX static void transformPointsAVX(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n){
+	__m256 c[4][4];
+	for(int i = 0; i < 4; i++){
+		for(int j = 0; j < 4; j++){
+			c[i][j] = _mm256_set1_ps(m._mat[i][j]);
+		}
+	}
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256 x, y, z;
+		loadSoA(src[i].getPtr(), x, y, z);
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[0][0], x), _mm256_mul_ps(c[1][0], y)), _mm256_mul_ps(c[2][0], z));
+		__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[0][1], x), _mm256_mul_ps(c[1][1], y)), _mm256_mul_ps(c[2][1], z));
+		__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[0][2], x), _mm256_mul_ps(c[1][2], y)), _mm256_mul_ps(c[2][2], z));
+		if(mode != Vectors){
+			rx = _mm256_add_ps(rx, c[3][0]);
+			ry = _mm256_add_ps(ry, c[3][1]);
+			rz = _mm256_add_ps(rz, c[3][2]);
+		}
+		if(mode == Projective){
+			__m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[0][3], x), _mm256_mul_ps(c[1][3], y)), _mm256_mul_ps(c[2][3], z)), c[3][3]);
+			__m256 d = _mm256_div_ps(_mm256_set1_ps(1.f), w);
+			rx = _mm256_mul_ps(rx, d);
+			ry = _mm256_mul_ps(ry, d);
+			rz = _mm256_mul_ps(rz, d);
+		}
+		storeSoA(dst[i].getPtr(), rx, ry, rz);
+	}
+	transformPointsSSE2<mode>(m, src + i, dst + i, n - i);
+}
+
+//----------------------------------------------------------
+static void transformPointsAVX(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n, TransformMode mode){
+	switch(mode){
+	case Vectors: transformPointsAVX<Vectors>(m, src, dst, n); break;
+	case Affine: transformPointsAVX<Affine>(m, src, dst, n); break;
+	case Projective: transformPointsAVX<Projective>(m, src, dst, n); break;
+	}
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static void transformPoints4AVX(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n){
+	__m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m._mat[0].getPtr()));
+	__m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m._mat[1].getPtr()));
+	__m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m._mat[2].getPtr()));
+	__m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m._mat[3].getPtr()));
+	size_t i = 0;
+	for(; i + 2 <= n; i += 2){
+		__m256 v = _mm256_loadu_ps(src[i].getPtr());
+		__m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0,0,0,0)), r0),
+			_mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1,1,1,1)), r1)),
+			_mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2,2,2,2)), r2)),
+			_mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(3,3,3,3)), r3));
+		_mm256_storeu_ps(dst[i].getPtr(), r);
+	}
+	transformPoints4SSE2(m, src + i, dst + i, n - i);
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static void normalizeAVX(ofVec3f * v, size_t n){
+	__m256 zero = _mm256_setzero_ps();
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256 x, y, z;
+		loadSoA(v[i].getPtr(), x, y, z);
+		__m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+		__m256 mask = _mm256_cmp_ps(length, zero, _CMP_GT_OQ);
+		x = _mm256_blendv_ps(x, _mm256_div_ps(x, length), mask);
+		y = _mm256_blendv_ps(y, _mm256_div_ps(y, length), mask);
+		z = _mm256_blendv_ps(z, _mm256_div_ps(z, length), mask);
+		storeSoA(v[i].getPtr(), x, y, z);
+	}
+	normalizeSSE2(v + i, n - i);
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static void boundingBoxAVX(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max){
+	__m256 minX = _mm256_set1_ps(min.x), minY = _mm256_set1_ps(min.y), minZ = _mm256_set1_ps(min.z);
+	__m256 maxX = _mm256_set1_ps(max.x), maxY = _mm256_set1_ps(max.y), maxZ = _mm256_set1_ps(max.z);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256 x, y, z;
+		loadSoA(v[i].getPtr(), x, y, z);
+		minX = _mm256_min_ps(minX, x);
+		minY = _mm256_min_ps(minY, y);
+		minZ = _mm256_min_ps(minZ, z);
+		maxX = _mm256_max_ps(maxX, x);
+		maxY = _mm256_max_ps(maxY, y);
+		maxZ = _mm256_max_ps(maxZ, z);
+	}
+	min.set(horizontalMin(_mm_min_ps(_mm256_castps256_ps128(minX), _mm256_extractf128_ps(minX, 1))),
+			horizontalMin(_mm_min_ps(_mm256_castps256_ps128(minY), _mm256_extractf128_ps(minY, 1))),
+			horizontalMin(_mm_min_ps(_mm256_castps256_ps128(minZ), _mm256_extractf128_ps(minZ, 1))));
+	max.set(horizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxX), _mm256_extractf128_ps(maxX, 1))),
+			horizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxY), _mm256_extractf128_ps(maxY, 1))),
+			horizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxZ), _mm256_extractf128_ps(maxZ, 1))));
+	boundingBoxSSE2(v + i, n - i, min, max);
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static inline __m256 planeDistance(const ofVec4f & p, __m256 x, __m256 y, __m256 z){
+	return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.x), x), _mm256_mul_ps(_mm256_set1_ps(p.y), y)), _mm256_mul_ps(_mm256_set1_ps(p.z), z)), _mm256_set1_ps(p.w));
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static size_t spheresInsidePlanesAVX(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n){
+	__m256 sign = _mm256_set1_ps(-0.f);
+	size_t count = 0;
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256 x, y, z;
+		loadSoA(centers[i].getPtr(), x, y, z);
+		__m256 minDistance = radii ? _mm256_xor_ps(_mm256_loadu_ps(radii + i), sign) : sign;
+		__m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for(size_t j = 0; j < numPlanes; j++){
+			in = _mm256_and_ps(in, _mm256_cmp_ps(planeDistance(planes[j], x, y, z), minDistance, _CMP_GE_OQ));
+		}
+		count += storeMask(_mm256_movemask_ps(in), inside + i, 8);
+	}
+	return count + spheresInsidePlanesSSE2(planes, numPlanes, centers + i, radii ? radii + i : nullptr, inside + i, n - i);
+}
+
+//----------------------------------------------------------
+OF_TARGET_AVX static size_t boxesInsidePlanesAVX(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n){
+	__m256 zero = _mm256_setzero_ps();
+	size_t count = 0;
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256 minX, minY, minZ, maxX, maxY, maxZ;
+		loadSoA(min[i].getPtr(), minX, minY, minZ);
+		loadSoA(max[i].getPtr(), maxX, maxY, maxZ);
+		__m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for(size_t j = 0; j < numPlanes; j++){
+			const ofVec4f & p = planes[j];
+			__m256 distance = planeDistance(p, p.x >= 0 ? maxX : minX, p.y >= 0 ? maxY : minY, p.z >= 0 ? maxZ : minZ);
+			in = _mm256_and_ps(in, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+		}
+		count += storeMask(_mm256_movemask_ps(in), inside + i, 8);
+	}
+	return count + boxesInsidePlanesSSE2(planes, numPlanes, min + i, max + i, inside + i, n - i);
+}
+#endif
+
+//----------------------------------------------------------
+// noise kernels, the scalar ones call the functions in ofNoise.h, the sse2
+// ones are a translation of them doing the same operations in the same
+// order for 4 points at a time. The hashing has no simd equivalent in
+// sse2 so it's done per lane
+//----------------------------------------------------------
+static float signedNoiseScalar(int dims, float x, float y, float z){
+	return dims == 2 ? _slang_library_noise2(x, y) : _slang_library_noise3(x, y, z);
+}
+
+//----------------------------------------------------------
+static float noiseScalar(int dims, float x, float y, float z, const NoiseSettings & settings){
+	float sum = 0;
+	float amplitude = 1;
+	float frequency = 1;
+	float norm = 0;
+	for(int i = 0; i < settings.octaves; i++){
+		sum += amplitude * signedNoiseScalar(dims, x * frequency, y * frequency, z * frequency);
+		norm += amplitude;
+		frequency *= settings.lacunarity;
+		amplitude *= settings.gain;
+	}
+	float noise = sum / norm;
+	return settings.isSigned ? noise : noise * 0.5f + 0.5f;
+}
+
+//----------------------------------------------------------
+static void noisePointsScalar(int dims, const float * points, float * dst, size_t n, const NoiseSettings & settings){
+	for(size_t i = 0; i < n; i++){
+		const float * p = points + i * dims;
+		dst[i] = noiseScalar(dims, p[0], p[1], dims == 3 ? p[2] : 0, settings);
+	}
+}
+
+//----------------------------------------------------------
+static void noiseRowScalar(int dims, float x, float stepX, float y, float z, float * dst, size_t n, const NoiseSettings & settings){
+	for(size_t i = 0; i < n; i++){
+		dst[i] = noiseScalar(dims, x + i * stepX, y, z, settings);
+	}
+}
+
+#ifdef OF_BATCH_SSE2
+//----------------------------------------------------------
+static inline __m128 blendNoise(__m128 mask, __m128 a, __m128 b){
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+//----------------------------------------------------------
+static inline __m128 negateIf(__m128i mask, __m128 v){
+	return _mm_xor_ps(v, _mm_and_ps(_mm_castsi128_ps(mask), _mm_set1_ps(-0.f)));
+}
+
+//----------------------------------------------------------
+// the same as FASTFLOOR, (int)v for positive values and (int)v - 1 for the
+// rest
+static inline __m128i fastFloor(__m128 v){
+	__m128i positive = _mm_castps_si128(_mm_cmpgt_ps(v, _mm_setzero_ps()));
+	return _mm_sub_epi32(_mm_sub_epi32(_mm_cvttps_epi32(v), _mm_set1_epi32(1)), positive);
+}
+
+//----------------------------------------------------------
+static inline __m128i load4(const int * v){
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(v));
+}
+
+//----------------------------------------------------------
+static inline void store4(int * v, __m128i x){
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(v), x);
+}
+
+//----------------------------------------------------------
+// t^4 * gradient if t is positive, 0 otherwise
+static inline __m128 contribution(__m128 t, __m128 gradient){
+	__m128 mask = _mm_cmpge_ps(t, _mm_setzero_ps());
+	t = _mm_mul_ps(t, t);
+	return _mm_and_ps(mask, _mm_mul_ps(_mm_mul_ps(t, t), gradient));
+}
+
+//----------------------------------------------------------
+static inline __m128 gradient2(__m128i hash, __m128 x, __m128 y){
+	__m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+	__m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+	__m128 u = blendNoise(lt4, x, y);
+	__m128 v = blendNoise(lt4, y, x);
+	__m128i bit1 = _mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), _mm_set1_epi32(1));
+	__m128i bit2 = _mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), _mm_set1_epi32(2));
+	return _mm_add_ps(negateIf(bit1, u), negateIf(bit2, _mm_mul_ps(_mm_set1_ps(2.0f), v)));
+}
+
+//----------------------------------------------------------
+static inline __m128 gradient3(__m128i hash, __m128 x, __m128 y, __m128 z){
+	__m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+	__m128 lt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+	__m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+	__m128 is12or14 = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+	__m128 u = blendNoise(lt8, x, y);
+	__m128 v = blendNoise(lt4, y, blendNoise(is12or14, x, z));
+	__m128i bit1 = _mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), _mm_set1_epi32(1));
+	__m128i bit2 = _mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), _mm_set1_epi32(2));
+	return _mm_add_ps(negateIf(bit1, u), negateIf(bit2, v));
+}
+
+//----------------------------------------------------------
+static __m128 signedNoise2SSE2(__m128 x, __m128 y){
+	__m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(F2));
+	__m128i i = fastFloor(_mm_add_ps(x, s));
+	__m128i j = fastFloor(_mm_add_ps(y, s));
+	__m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(G2));
+	__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+	__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+	__m128 lower = _mm_cmpgt_ps(x0, y0);
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 i1 = _mm_and_ps(lower, one);
+	__m128 j1 = _mm_andnot_ps(lower, one);
+	__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1), _mm_set1_ps(G2));
+	__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, j1), _mm_set1_ps(G2));
+	__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(2.0f * G2));
+	__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(2.0f * G2));
+
+	int ii[4], jj[4], i1s[4], j1s[4], h0[4], h1[4], h2[4];
+	store4(ii, _mm_and_si128(i, _mm_set1_epi32(0xff)));
+	store4(jj, _mm_and_si128(j, _mm_set1_epi32(0xff)));
+	store4(i1s, _mm_cvttps_epi32(i1));
+	store4(j1s, _mm_cvttps_epi32(j1));
+	for(int l = 0; l < 4; l++){
+		h0[l] = perm[ii[l] + perm[jj[l]]];
+		h1[l] = perm[ii[l] + i1s[l] + perm[jj[l] + j1s[l]]];
+		h2[l] = perm[ii[l] + 1 + perm[jj[l] + 1]];
+	}
+
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 n0 = contribution(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), gradient2(load4(h0), x0, y0));
+	__m128 n1 = contribution(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), gradient2(load4(h1), x1, y1));
+	__m128 n2 = contribution(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2)), gradient2(load4(h2), x2, y2));
+	return _mm_mul_ps(_mm_set1_ps(40.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+}
+
+//----------------------------------------------------------
+static __m128 signedNoise3SSE2(__m128 x, __m128 y, __m128 z){
+	__m128 s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(F3));
+	__m128i i = fastFloor(_mm_add_ps(x, s));
+	__m128i j = fastFloor(_mm_add_ps(y, s));
+	__m128i k = fastFloor(_mm_add_ps(z, s));
+	__m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), _mm_set1_ps(G3));
+	__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+	__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+	__m128 z0 = _mm_sub_ps(z, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+	// the 6 branches that find the simplex in _slang_library_noise3 as
+	// masks
+	__m128 xy = _mm_cmpge_ps(x0, y0);
+	__m128 yz = _mm_cmpge_ps(y0, z0);
+	__m128 xz = _mm_cmpge_ps(x0, z0);
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 i1 = _mm_and_ps(_mm_and_ps(xy, _mm_or_ps(yz, xz)), one);
+	__m128 j1 = _mm_and_ps(_mm_andnot_ps(xy, yz), one);
+	__m128 k1 = _mm_and_ps(_mm_andnot_ps(yz, _mm_andnot_ps(_mm_and_ps(xy, xz), one)), one);
+	__m128 i2 = _mm_and_ps(_mm_or_ps(xy, _mm_and_ps(yz, xz)), one);
+	__m128 j2 = _mm_and_ps(_mm_or_ps(_mm_and_ps(xy, yz), _mm_andnot_ps(xy, one)), one);
+	__m128 k2 = _mm_and_ps(_mm_or_ps(_mm_andnot_ps(yz, xy), _mm_andnot_ps(xy, _mm_andnot_ps(_mm_and_ps(yz, xz), one))), one);
+
+	__m128 g1 = _mm_set1_ps(G3), g2 = _mm_set1_ps(2.0f * G3), g3 = _mm_set1_ps(3.0f * G3);
+	__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1), g1);
+	__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, j1), g1);
+	__m128 z1 = _mm_add_ps(_mm_sub_ps(z0, k1), g1);
+	__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, i2), g2);
+	__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, j2), g2);
+	__m128 z2 = _mm_add_ps(_mm_sub_ps(z0, k2), g2);
+	__m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), g3);
+	__m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), g3);
+	__m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), g3);
+
+	int ii[4], jj[4], kk[4], o[6][4], h0[4], h1[4], h2[4], h3[4];
+	store4(ii, _mm_and_si128(i, _mm_set1_epi32(0xff)));
+	store4(jj, _mm_and_si128(j, _mm_set1_epi32(0xff)));
+	store4(kk, _mm_and_si128(k, _mm_set1_epi32(0xff)));
+	store4(o[0], _mm_cvttps_epi32(i1));
+	store4(o[1], _mm_cvttps_epi32(j1));
+	store4(o[2], _mm_cvttps_epi32(k1));
+	store4(o[3], _mm_cvttps_epi32(i2));
+	store4(o[4], _mm_cvttps_epi32(j2));
+	store4(o[5], _mm_cvttps_epi32(k2));
+	for(int l = 0; l < 4; l++){
+		h0[l] = perm[ii[l] + perm[jj[l] + perm[kk[l]]]];
+		h1[l] = perm[ii[l] + o[0][l] + perm[jj[l] + o[1][l] + perm[kk[l] + o[2][l]]]];
+		h2[l] = perm[ii[l] + o[3][l] + perm[jj[l] + o[4][l] + perm[kk[l] + o[5][l]]]];
+		h3[l] = perm[ii[l] + 1 + perm[jj[l] + 1 + perm[kk[l] + 1]]];
+	}
+
+	__m128 c = _mm_set1_ps(0.6f);
+	__m128 n0 = contribution(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(c, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), _mm_mul_ps(z0, z0)), gradient3(load4(h0), x0, y0, z0));
+	__m128 n1 = contribution(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(c, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), _mm_mul_ps(z1, z1)), gradient3(load4(h1), x1, y1, z1));
+	__m128 n2 = contribution(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(c, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2)), _mm_mul_ps(z2, z2)), gradient3(load4(h2), x2, y2, z2));
+	__m128 n3 = contribution(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(c, _mm_mul_ps(x3, x3)), _mm_mul_ps(y3, y3)), _mm_mul_ps(z3, z3)), gradient3(load4(h3), x3, y3, z3));
+	return _mm_mul_ps(_mm_set1_ps(32.0f), _mm_add_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), n3));
+}
+
+//----------------------------------------------------------
+static inline __m128 noiseSSE2(int dims, __m128 x, __m128 y, __m128 z, const NoiseSettings & settings){
+	__m128 sum = _mm_setzero_ps();
+	float amplitude = 1;
+	float frequency = 1;
+	float norm = 0;
+	for(int i = 0; i < settings.octaves; i++){
+		__m128 f = _mm_set1_ps(frequency);
+		__m128 noise = dims == 2 ?
+			signedNoise2SSE2(_mm_mul_ps(x, f), _mm_mul_ps(y, f)) :
+			signedNoise3SSE2(_mm_mul_ps(x, f), _mm_mul_ps(y, f), _mm_mul_ps(z, f));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(amplitude), noise));
+		norm += amplitude;
+		frequency *= settings.lacunarity;
+		amplitude *= settings.gain;
+	}
+	__m128 noise = _mm_div_ps(sum, _mm_set1_ps(norm));
+	return settings.isSigned ? noise : _mm_add_ps(_mm_mul_ps(noise, _mm_set1_ps(0.5f)), _mm_set1_ps(0.5f));
+}
+
+//----------------------------------------------------------
+static void noisePointsSSE2(int dims, const float * points, float * dst, size_t n, const NoiseSettings & settings){
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 x, y, z;
+		if(dims == 2){
+			// x0 y0 x1 y1 | x2 y2 x3 y3
+			__m128 a = _mm_loadu_ps(points + i * 2);
+			__m128 b = _mm_loadu_ps(points + i * 2 + 4);
+			x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+			y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+			z = _mm_setzero_ps();
+		}else{
+			loadSoA(points + i * 3, x, y, z);
+		}
+		_mm_storeu_ps(dst + i, noiseSSE2(dims, x, y, z, settings));
+	}
+	noisePointsScalar(dims, points + i * dims, dst + i, n - i, settings);
+}
+
+//----------------------------------------------------------
+static void noiseRowSSE2(int dims, float x, float stepX, float y, float z, float * dst, size_t n, const NoiseSettings & settings){
+	__m128 yV = _mm_set1_ps(y);
+	__m128 zV = _mm_set1_ps(z);
+	__m128 stepV = _mm_set1_ps(stepX);
+	__m128 xV = _mm_set1_ps(x);
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128 index = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(int(i)), _mm_set_epi32(3, 2, 1, 0)));
+		_mm_storeu_ps(dst + i, noiseSSE2(dims, _mm_add_ps(xV, _mm_mul_ps(index, stepV)), yV, zV, settings));
+	}
+	for(; i < n; i++){
+		dst[i] = noiseScalar(dims, x + i * stepX, y, z, settings);
+	}
+}
+#endif
+
+//----------------------------------------------------------
+static const Kernels scalarKernels = {
+	transformPointsScalar,
+	transformStridedScalar,
+	transformPoints4Scalar,
+	normalizeScalar,
+	boundingBoxScalar,
+	spheresInsidePlanesScalar,
+	boxesInsidePlanesScalar,
+	noisePointsScalar,
+	noiseRowScalar,
+};
+
+#ifdef OF_BATCH_SSE2
+static const Kernels sse2Kernels = {
+	transformPointsSSE2,
+	transformStridedSSE2,
+	transformPoints4SSE2,
+	normalizeSSE2,
+	boundingBoxSSE2,
+	spheresInsidePlanesSSE2,
+	boxesInsidePlanesSSE2,
+	noisePointsSSE2,
+	noiseRowSSE2,
+};
+#endif
+
+#ifdef OF_BATCH_AVX
+// strided data is loaded one vector at a time so there's nothing to gain
+// from the wider registers. Noise uses the sse2 kernels since most of its
+// work is integer math which avx can't do on 8 lanes
+static const Kernels avxKernels = {
+	transformPointsAVX,
+	transformStridedSSE2,
+	transformPoints4AVX,
+	normalizeAVX,
+	boundingBoxAVX,
+	spheresInsidePlanesAVX,
+	boxesInsidePlanesAVX,
+	noisePointsSSE2,
+	noiseRowSSE2,
+};
+#endif
+
+//----------------------------------------------------------
+static ofSimdLevel detectSimdLevel(){
+#ifdef OF_BATCH_AVX
+	// avx needs the cpu to support it and the os to save the ymm registers
+	unsigned int ecx;
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		ecx = info[2];
+	#else
+		unsigned int eax, ebx, edx;
+		if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)){
+			ecx = 0;
+		}
+	#endif
+	bool osxsave = (ecx & (1 << 27)) != 0;
+	bool avx = (ecx & (1 << 28)) != 0;
+	if(osxsave && avx){
+	#ifdef _MSC_VER
+		unsigned long long xcr0 = _xgetbv(0);
+	#else
+		unsigned int xcr0Low, xcr0High;
+		__asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+		unsigned long long xcr0 = xcr0Low;
+	#endif
+		if((xcr0 & 6) == 6){
+			return OF_SIMD_AVX;
+		}
+	}
+#endif
+#ifdef OF_BATCH_SSE2
+	return OF_SIMD_SSE2;
+#else
+	return OF_SIMD_NONE;
+#endif
+}
+
+//----------------------------------------------------------
+static std::atomic<int> & simdLevel(){
+	static std::atomic<int> level(detectSimdLevel());
+	return level;
+}
+
+//----------------------------------------------------------
+static const Kernels & kernels(){
+	switch(simdLevel().load(std::memory_order_relaxed)){
+#ifdef OF_BATCH_AVX
+	case OF_SIMD_AVX: return avxKernels;
+#endif
+#ifdef OF_BATCH_SSE2
+	case OF_SIMD_SSE2: return sse2Kernels;
+#endif
+	default: return scalarKernels;
+	}
+}
+
+//----------------------------------------------------------
+ofSimdLevel ofGetSimdLevel(){
+	return ofSimdLevel(simdLevel().load());
+}
+
+//----------------------------------------------------------
+ofSimdLevel ofGetSupportedSimdLevel(){
+	static ofSimdLevel supported = detectSimdLevel();
+	return supported;
+}
+
+//----------------------------------------------------------
+void ofSetSimdLevel(ofSimdLevel level){
+	simdLevel().store(std::min(level, ofGetSupportedSimdLevel()));
+}
+
+//----------------------------------------------------------
+void ofTransformPoints(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n){
+	kernels().transformPoints(m, src, dst, n, isAffine(m) ? Affine : Projective);
+}
+
+//----------------------------------------------------------
+void ofTransformPoints(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n){
+	if(srcStride == sizeof(ofVec3f) && dstStride == sizeof(ofVec3f)){
+		ofTransformPoints(m, reinterpret_cast<const ofVec3f*>(src), reinterpret_cast<ofVec3f*>(dst), n);
+	}else{
+		kernels().transformStrided(m, src, srcStride, dst, dstStride, n, isAffine(m) ? Affine : Projective);
+	}
+}
+
+//----------------------------------------------------------
+void ofTransformPoints(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n){
+	kernels().transformPoints4(m, src, dst, n);
+}
+
+//----------------------------------------------------------
+void ofTransformVectors(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n){
+	kernels().transformPoints(m, src, dst, n, Vectors);
+}
+
+//----------------------------------------------------------
+void ofTransformVectors(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n){
+	if(srcStride == sizeof(ofVec3f) && dstStride == sizeof(ofVec3f)){
+		ofTransformVectors(m, reinterpret_cast<const ofVec3f*>(src), reinterpret_cast<ofVec3f*>(dst), n);
+	}else{
+		kernels().transformStrided(m, src, srcStride, dst, dstStride, n, Vectors);
+	}
+}
+
+//----------------------------------------------------------
+void ofNormalizeVectors(ofVec3f * v, size_t n){
+	kernels().normalize(v, n);
+}
+
+//----------------------------------------------------------
+bool ofGetBoundingBox(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max){
+	if(n == 0){
+		return false;
+	}
+	min = max = v[0];
+	kernels().boundingBox(v + 1, n - 1, min, max);
+	return true;
+}
+
+//----------------------------------------------------------
+size_t ofPointsInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * points, uint8_t * inside, size_t n){
+	return kernels().spheresInsidePlanes(planes, numPlanes, points, nullptr, inside, n);
+}
+
+//----------------------------------------------------------
+size_t ofSpheresInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n){
+	return kernels().spheresInsidePlanes(planes, numPlanes, centers, radii, inside, n);
+}
+
+//----------------------------------------------------------
+size_t ofBoxesInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n){
+	return kernels().boxesInsidePlanes(planes, numPlanes, min, max, inside, n);
+}
+
+//----------------------------------------------------------
+static void noisePoints(int dims, const float * points, float * dst, size_t n, int octaves, float lacunarity, float gain, bool isSigned){
+	NoiseSettings settings = {std::max(octaves, 1), lacunarity, gain, isSigned};
+	kernels().noisePoints(dims, points, dst, n, settings);
+}
+
+//----------------------------------------------------------
+void ofNoisePoints(const ofVec2f * points, float * dst, size_t n, int octaves, float lacunarity, float gain){
+	noisePoints(2, reinterpret_cast<const float*>(points), dst, n, octaves, lacunarity, gain, false);
+}
+
+//----------------------------------------------------------
+void ofNoisePoints(const ofVec3f * points, float * dst, size_t n, int octaves, float lacunarity, float gain){
+	noisePoints(3, reinterpret_cast<const float*>(points), dst, n, octaves, lacunarity, gain, false);
+}
+
+//----------------------------------------------------------
+void ofSignedNoisePoints(const ofVec2f * points, float * dst, size_t n, int octaves, float lacunarity, float gain){
+	noisePoints(2, reinterpret_cast<const float*>(points), dst, n, octaves, lacunarity, gain, true);
+}
+
+//----------------------------------------------------------
+void ofSignedNoisePoints(const ofVec3f * points, float * dst, size_t n, int octaves, float lacunarity, float gain){
+	noisePoints(3, reinterpret_cast<const float*>(points), dst, n, octaves, lacunarity, gain, true);
+}
+
+//----------------------------------------------------------
+static void noiseGrid(int dims, float * dst, size_t width, size_t height, const ofVec3f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, bool isSigned, int numThreads){
+	// below this many samples per thread handing them to the threads costs
+	// more than what they save
+	const size_t minSamplesPerThread = 4096;
+	numThreads = of::priv::getNumWorkThreads(numThreads, std::min(height, width * height / minSamplesPerThread));
+
+	NoiseSettings settings = {std::max(octaves, 1), lacunarity, gain, isSigned};
+	const Kernels & k = kernels();
+	auto rows = [&](int thread){
+		size_t begin = height * thread / numThreads;
+		size_t end = height * (thread + 1) / numThreads;
+		for(size_t y = begin; y < end; y++){
+			k.noiseRow(dims, origin.x, step.x, origin.y + y * step.y, origin.z, dst + y * width, width, settings);
+		}
+	};
+	// grids are usually evaluated every frame, the threads of the worker
+	// pool are reused instead of started every time
+	of::priv::runInWorkerThreads(numThreads, rows);
+}
+
+//----------------------------------------------------------
+void ofNoiseGrid(float * dst, size_t width, size_t height, const ofVec2f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	noiseGrid(2, dst, width, height, ofVec3f(origin.x, origin.y, 0), step, octaves, lacunarity, gain, false, numThreads);
+}
+
+//----------------------------------------------------------
+void ofNoiseGrid(float * dst, size_t width, size_t height, const ofVec3f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	noiseGrid(3, dst, width, height, origin, step, octaves, lacunarity, gain, false, numThreads);
+}
+
+//----------------------------------------------------------
+void ofSignedNoiseGrid(float * dst, size_t width, size_t height, const ofVec2f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	noiseGrid(2, dst, width, height, ofVec3f(origin.x, origin.y, 0), step, octaves, lacunarity, gain, true, numThreads);
+}
+
+//----------------------------------------------------------
+void ofSignedNoiseGrid(float * dst, size_t width, size_t height, const ofVec3f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	noiseGrid(3, dst, width, height, origin, step, octaves, lacunarity, gain, true, numThreads);
+}
+
+//----------------------------------------------------------
+static bool checkNoisePixels(const ofFloatPixels & pixels){
+	if(pixels.getNumChannels() != 1){
+		ofLogError("ofBatchMath") << "ofNoiseGrid(): pixels need 1 channel, they have " << pixels.getNumChannels();
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+void ofNoiseGrid(ofFloatPixels & pixels, const ofVec2f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	if(checkNoisePixels(pixels)){
+		ofNoiseGrid(pixels.getData(), pixels.getWidth(), pixels.getHeight(), origin, step, octaves, lacunarity, gain, numThreads);
+	}
+}
+
+//----------------------------------------------------------
+void ofNoiseGrid(ofFloatPixels & pixels, const ofVec3f & origin, const ofVec2f & step, int octaves, float lacunarity, float gain, int numThreads){
+	if(checkNoisePixels(pixels)){
+		ofNoiseGrid(pixels.getData(), pixels.getWidth(), pixels.getHeight(), origin, step, octaves, lacunarity, gain, numThreads);
+	}
+}
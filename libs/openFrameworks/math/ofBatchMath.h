@@ -0,0 +1,183 @@
+#pragma once
+
+#include "ofVec2f.h"
+#include "ofVec3f.h"
+#include "ofVec4f.h"
+#include "ofMatrix4x4.h"
+#include <cstdint>
+
+template<typename T>
+class ofPixels_;
+typedef ofPixels_<float> ofFloatPixels;
+
+/// \file
+/// Functions that transform, normalize and measure arrays of vectors at
+/// once. They give the same results as applying the ofVec3f and ofMatrix4x4
+/// operators to every element but use SIMD instructions, AVX or SSE
+/// depending on what the CPU supports, falling back to plain C++ code on
+/// other platforms.
+///
+/// ~~~~{.cpp}
+/// vector<ofVec3f> & vertices = mesh.getVertices();
+/// // same as v = v * node.getGlobalTransformMatrix() for every vertex
+/// ofTransformPoints(node.getGlobalTransformMatrix(), vertices.data(), vertices.data(), vertices.size());
+/// ~~~~
+///
+/// The destination can be the same array as the source but they can't
+/// overlap otherwise.
+
+/// \brief SIMD instructions used by the batch math functions.
+enum ofSimdLevel{
+	OF_SIMD_NONE,
+	OF_SIMD_SSE2,
+	OF_SIMD_AVX,
+};
+
+/// \brief Returns the instructions the batch math functions use, by
+/// default the best ones supported by the CPU.
+ofSimdLevel ofGetSimdLevel();
+
+/// \brief Returns the best instructions supported by the CPU and the
+/// operating system that the batch math functions were compiled for.
+ofSimdLevel ofGetSupportedSimdLevel();
+
+/// \brief Limits the instructions the batch math functions use, mostly
+/// useful to compare them or to test the fallbacks.
+///
+/// Levels above ofGetSupportedSimdLevel() are ignored.
+void ofSetSimdLevel(ofSimdLevel level);
+
+/// \name Batch transforms
+/// \{
+
+/// \brief Transforms an array of points by a matrix, the same as
+/// `dst[i] = src[i] * m`.
+///
+/// The points are divided by w, for matrices without a projection that
+/// divide is skipped.
+void ofTransformPoints(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n);
+
+/// \brief Transforms points of 3 floats stored every srcStride bytes, like
+/// the positions in an interleaved vertex buffer, and writes them every
+/// dstStride bytes.
+void ofTransformPoints(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n);
+
+/// \brief Transforms an array of 4d vectors by a matrix, the same as
+/// `dst[i] = src[i] * m`.
+void ofTransformPoints(const ofMatrix4x4 & m, const ofVec4f * src, ofVec4f * dst, size_t n);
+
+/// \brief Transforms an array of directions by the rotation and scale of
+/// a matrix, ignoring its translation, the same as
+/// `dst[i] = ofMatrix4x4::transform3x3(src[i], m)`.
+void ofTransformVectors(const ofMatrix4x4 & m, const ofVec3f * src, ofVec3f * dst, size_t n);
+
+/// \brief Transforms directions of 3 floats stored every srcStride bytes.
+void ofTransformVectors(const ofMatrix4x4 & m, const float * src, size_t srcStride, float * dst, size_t dstStride, size_t n);
+
+/// \}
+/// \name Batch vector operations
+/// \{
+
+/// \brief Normalizes every vector in the array, the same as calling
+/// ofVec3f::normalize() on each, vectors of length 0 are left as they are.
+void ofNormalizeVectors(ofVec3f * v, size_t n);
+
+/// \brief Computes the axis aligned bounding box of an array of points.
+///
+/// \returns false if the array is empty, min and max aren't modified then.
+bool ofGetBoundingBox(const ofVec3f * v, size_t n, ofVec3f & min, ofVec3f & max);
+
+/// \}
+/// \name Batch visibility tests
+/// \{
+
+/// \brief Tests which points are in front of all the planes, like the
+/// planes of an ofFrustum.
+///
+/// Every plane is stored as (a, b, c, d) with its normal (a, b, c) pointing
+/// to the inside, a point p is in front of it if
+/// `a * p.x + b * p.y + c * p.z + d >= 0`.
+///
+/// \param inside Set to 1 for the points in front of every plane and to 0
+/// for the rest.
+/// \returns The number of points in front of every plane.
+size_t ofPointsInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * points, uint8_t * inside, size_t n);
+
+/// \brief Tests which spheres are at least partly in front of all the
+/// planes.
+///
+/// The plane normals have to be normalized for the distances to be
+/// comparable with the radii.
+size_t ofSpheresInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * centers, const float * radii, uint8_t * inside, size_t n);
+
+/// \brief Tests which axis aligned boxes are at least partly in front of
+/// all the planes.
+///
+/// The test is conservative, boxes close to the edges of a frustum can be
+/// reported as inside while being outside of it.
+size_t ofBoxesInsidePlanes(const ofVec4f * planes, size_t numPlanes, const ofVec3f * min, const ofVec3f * max, uint8_t * inside, size_t n);
+
+/// \}
+/// \name Batch noise
+/// \{
+
+/// \brief Calculates the noise at every point of an array, the same as
+/// `dst[i] = ofFractalNoise(points[i], octaves, lacunarity, gain)`, which
+/// with 1 octave is `dst[i] = ofNoise(points[i])`.
+///
+/// The results can differ from the scalar functions in the last bits
+/// depending on how the compiler optimized them.
+void ofNoisePoints(const ofVec2f * points, float * dst, size_t n, int octaves = 1, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates the three dimensional noise at every point of an
+/// array.
+void ofNoisePoints(const ofVec3f * points, float * dst, size_t n, int octaves = 1, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates the signed noise at every point of an array, the
+/// same as `dst[i] = ofSignedFractalNoise(points[i], octaves, lacunarity, gain)`.
+void ofSignedNoisePoints(const ofVec2f * points, float * dst, size_t n, int octaves = 1, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates the three dimensional signed noise at every point of
+/// an array.
+void ofSignedNoisePoints(const ofVec3f * points, float * dst, size_t n, int octaves = 1, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Fills a width x height array of floats with noise sampled on a
+/// grid.
+///
+/// The value at column x and row y is
+/// `ofFractalNoise(ofVec2f(origin.x + x * step.x, origin.y + y * step.y), octaves, lacunarity, gain)`
+///
+/// ~~~~{.cpp}
+/// ofFloatPixels heights;
+/// heights.allocate(512, 512, OF_PIXELS_GRAY);
+/// ofNoiseGrid(heights, ofVec2f(0, 0), ofVec2f(0.01, 0.01), 4);
+/// ~~~~
+///
+/// \param numThreads Number of threads the rows are split between, 0 uses
+/// as many threads as cores. Small grids always use only the calling
+/// thread. The threads are started the first time and reused afterwards.
+void ofNoiseGrid(float * dst, size_t width, size_t height, const ofVec2f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \brief Fills a width x height array of floats with three dimensional
+/// noise sampled on a grid at depth origin.z.
+///
+/// Moving origin.z every frame animates the noise.
+void ofNoiseGrid(float * dst, size_t width, size_t height, const ofVec3f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \brief Fills a width x height array of floats with signed noise
+/// sampled on a grid.
+void ofSignedNoiseGrid(float * dst, size_t width, size_t height, const ofVec2f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \brief Fills a width x height array of floats with three dimensional
+/// signed noise sampled on a grid at depth origin.z.
+void ofSignedNoiseGrid(float * dst, size_t width, size_t height, const ofVec3f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \brief Fills allocated single channel float pixels with noise sampled
+/// on a grid.
+void ofNoiseGrid(ofFloatPixels & pixels, const ofVec2f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \brief Fills allocated single channel float pixels with three
+/// dimensional noise sampled on a grid.
+void ofNoiseGrid(ofFloatPixels & pixels, const ofVec3f & origin, const ofVec2f & step, int octaves = 1, float lacunarity = 2, float gain = 0.5f, int numThreads = 1);
+
+/// \}
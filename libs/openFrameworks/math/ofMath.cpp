@@ -7,6 +7,7 @@
 #endif
 
 #include "ofNoise.h"
+#include "ofRandomEngine.h"
 #include "ofPolyline.h"
 
 //--------------------------------------------------
@@ -24,46 +25,64 @@ void ofSeedRandom() {
 	// http://stackoverflow.com/questions/322938/recommended-way-to-initialize-srand
 
 	#ifdef TARGET_WIN32
-		srand(GetTickCount());
+		unsigned long n = GetTickCount();
 	#elif !defined(TARGET_EMSCRIPTEN)
 		// use XOR'd second, microsecond precision AND pid as seed
 		struct timeval tv;
 		gettimeofday(&tv, 0);
 		long int n = (tv.tv_sec ^ tv.tv_usec) ^ getpid();
-		srand(n);
 	#else
 		struct timeval tv;
 		gettimeofday(&tv, 0);
 		long int n = (tv.tv_sec ^ tv.tv_usec);
-		srand(n);
 	#endif
+	srand(n);
+	of::priv::seedRandomEngines(n);
 }
 
 //--------------------------------------------------
 void ofSeedRandom(int val) {
 	srand((long) val);
+	of::priv::seedRandomEngines((uint32_t) val);
 }
 
 //--------------------------------------------------
 float ofRandom(float max) {
-	return (max * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return max * ofGetRandomEngine().uniform();
 }
 
 //--------------------------------------------------
 float ofRandom(float x, float y) {
 	float high = MAX(x, y);
 	float low = MIN(x, y);
-	return max(low, (low + ((high - low) * rand() / float(RAND_MAX))) * (1.0f - std::numeric_limits<float>::epsilon()));
+	float r = low + (high - low) * ofGetRandomEngine().uniform();
+	// rounding can reach high for some ranges
+	return r < high ? r : max(low, std::nextafter(high, low));
 }
 
 //--------------------------------------------------
 float ofRandomf() {
-	return -1.0f + (2.0f * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return -1.0f + 2.0f * ofGetRandomEngine().uniform();
 }
 
 //--------------------------------------------------
 float ofRandomuf() {
-	return (rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return ofGetRandomEngine().uniform();
+}
+
+//--------------------------------------------------
+float ofRandomGaussian(float mean, float deviation) {
+	return mean + ofGetRandomEngine().gaussian() * deviation;
+}
+
+//--------------------------------------------------
+void ofRandomFill(float * dst, size_t n, float min, float max) {
+	ofGetRandomEngine().fill(dst, n, min, max);
+}
+
+//--------------------------------------------------
+void ofRandomFillGaussian(float * dst, size_t n, float mean, float deviation) {
+	ofGetRandomEngine().fillGaussian(dst, n, mean, deviation);
 }
 
 //---- new to 006
@@ -250,6 +269,48 @@ float ofSignedNoise(const ofVec4f& p){
 	return ofSignedNoise( p.x, p.y, p.z, p.w );
 }
 
+//--------------------------------------------------
+// the batch versions in ofBatchMath.cpp do the same operations in the same
+// order so they give the same results
+template<typename Noise>
+static float fractalNoise(int octaves, float lacunarity, float gain, Noise noise){
+	float sum = 0;
+	float amplitude = 1;
+	float frequency = 1;
+	float norm = 0;
+	for(int i = 0; i < std::max(octaves, 1); i++){
+		sum += amplitude * noise(frequency);
+		norm += amplitude;
+		frequency *= lacunarity;
+		amplitude *= gain;
+	}
+	return sum / norm;
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(const ofVec2f& p, int octaves, float lacunarity, float gain){
+	return fractalNoise(octaves, lacunarity, gain, [&](float frequency){
+		return _slang_library_noise2(p.x * frequency, p.y * frequency);
+	});
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(const ofVec3f& p, int octaves, float lacunarity, float gain){
+	return fractalNoise(octaves, lacunarity, gain, [&](float frequency){
+		return _slang_library_noise3(p.x * frequency, p.y * frequency, p.z * frequency);
+	});
+}
+
+//--------------------------------------------------
+float ofFractalNoise(const ofVec2f& p, int octaves, float lacunarity, float gain){
+	return ofSignedFractalNoise(p, octaves, lacunarity, gain) * 0.5f + 0.5f;
+}
+
+//--------------------------------------------------
+float ofFractalNoise(const ofVec3f& p, int octaves, float lacunarity, float gain){
+	return ofSignedFractalNoise(p, octaves, lacunarity, gain) * 0.5f + 0.5f;
+}
+
 //--------------------------------------------------
 bool ofInsidePoly(float x, float y, const vector<ofPoint>& polygon){
     return ofPolyline::inside(x,y, ofPolyline(polygon));
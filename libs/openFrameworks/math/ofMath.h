@@ -16,11 +16,10 @@
 /// \file
 /// ofMath provides a collection of mathematical utilities and functions.
 ///
-/// \warning Many ofRandom-style functions wrap `rand()` which is not reentrant
-/// or thread safe.  To generate random numbers simultaneously in multiple
-/// threads, consider using c++11 uniform_real_distribution.
+/// The ofRandom-style functions use a fast random engine per thread, see
+/// ofRandomEngine, so they can be called from several threads at once.
 ///
-/// \sa http://en.cppreference.com/w/cpp/numeric/random/uniform_real_distribution
+/// \sa ofRandomEngine.h
 
 /// \name Random Numbers
 /// \{
@@ -35,8 +34,6 @@
 /// float randomNumber = ofRandom(20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps C++'s `rand()` which is not reentrant or thread safe.
-///
 /// \param max The maximum value of the random number.
 float ofRandom(float max); 
 
@@ -50,8 +47,6 @@ float ofRandom(float max);
 /// float randomNumber = ofRandom(-30, 20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \param val0 the minimum value of the random number.
 /// \param val1 The maximum value of the random number.
 /// \returns A random floating point number between val0 and val1.
@@ -59,15 +54,11 @@ float ofRandom(float val0, float val1);
 
 /// \brief Get a random floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between -1 and 1.
 float ofRandomf();
 
 /// \brief Get a random unsigned floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between 0 and 1.
 float ofRandomuf();
 
@@ -76,8 +67,6 @@ float ofRandomuf();
 ///
 /// A random number in the range [0, ofGetWidth()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetWidth().
 float ofRandomWidth();
 
@@ -85,15 +74,41 @@ float ofRandomWidth();
 ///
 /// A random number in the range [0, ofGetHeight()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetHeight().
 float ofRandomHeight();
 
+/// \brief Get a normally distributed random number.
+///
+/// About 68% of the numbers are within one deviation of the mean and 95%
+/// within two.
+///
+/// \param mean The center of the distribution.
+/// \param deviation The standard deviation of the distribution.
+float ofRandomGaussian(float mean = 0, float deviation = 1);
+
+/// \brief Fill an array with random floating point numbers between min and
+/// max.
+///
+/// Much faster than calling ofRandom for every element, the numbers are
+/// generated several at a time with SIMD instructions when available.
+///
+/// \param dst The array to fill.
+/// \param n The number of elements in the array.
+/// \param min The minimum value of the random numbers.
+/// \param max The maximum value of the random numbers.
+void ofRandomFill(float * dst, size_t n, float min, float max);
+
+/// \brief Fill an array with normally distributed random numbers.
+///
+/// \sa ofRandomGaussian()
+void ofRandomFillGaussian(float * dst, size_t n, float mean = 0, float deviation = 1);
+
 /// \brief Seed the seeds the random number generator with a unique value.
 ///
 /// This seeds the random number generator with an acceptably random value, 
 /// generated from clock time and the PID.
+///
+/// The random engines of every thread and `rand()` are seeded.
 void ofSeedRandom();
 
 /// \brief Seed the random number generator.
@@ -102,6 +117,10 @@ void ofSeedRandom();
 /// seed can be used to initialize the random number generator during app
 /// setup.  This can be useful for debugging and testing.
 ///
+/// The calling thread uses the sequence of the seed and every other thread
+/// a different one derived from it, see ofGetRandomEngine(). `rand()` is
+/// seeded too for code that still uses it.
+///
 /// \param val The value with which to seed the generator.
 void ofSeedRandom(int val);
 
@@ -425,6 +444,27 @@ float ofSignedNoise(float x, float y, float z, float w);
 /// \brief Calculates a four dimensional Perlin noise value between -1.0...1.0.
 float ofSignedNoise(const ofVec4f& p);
 
+/// \brief Calculates a sum of octaves of two dimensional noise between
+/// 0.0...1.0.
+///
+/// Every octave multiplies the frequency by lacunarity and the amplitude
+/// by gain, the sum is divided by the sum of the amplitudes. With 1 octave
+/// the result is the same as ofNoise(p). See ofNoisePoints() and
+/// ofNoiseGrid() to calculate many values at once.
+float ofFractalNoise(const ofVec2f& p, int octaves, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates a sum of octaves of three dimensional noise between
+/// 0.0...1.0.
+float ofFractalNoise(const ofVec3f& p, int octaves, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates a sum of octaves of two dimensional noise between
+/// -1.0...1.0.
+float ofSignedFractalNoise(const ofVec2f& p, int octaves, float lacunarity = 2, float gain = 0.5f);
+
+/// \brief Calculates a sum of octaves of three dimensional noise between
+/// -1.0...1.0.
+float ofSignedFractalNoise(const ofVec3f& p, int octaves, float lacunarity = 2, float gain = 0.5f);
+
 /// \}
 
 
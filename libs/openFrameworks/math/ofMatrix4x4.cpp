@@ -7,6 +7,11 @@
 #include <stdlib.h>
 #include "ofConstants.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OF_MATRIX_SSE2
+	#include <emmintrin.h>
+#endif
+
 #if (_MSC_VER)
 #undef min
 // see: http://stackoverflow.com/questions/1904635/warning-c4003-and-errors-c2589-and-c2059-on-x-stdnumericlimitsintmax
@@ -435,8 +440,38 @@ void ofMatrix4x4::makeRotationMatrix( float angle1, const ofVec3f& axis1,
     setRotate(quat);
 }
 
+#ifdef OF_MATRIX_SSE2
+// dst = lhs * rhs one row at a time, every row of the result is the rows of
+// rhs weighted by the elements in the same row of lhs which adds the same
+// products in the same order as INNER_PRODUCT. everything is loaded before
+// storing so dst can be lhs or rhs
+static inline void multiplySSE2( const ofMatrix4x4& lhs, const ofMatrix4x4& rhs, ofMatrix4x4& dst )
+{
+	__m128 r0 = _mm_loadu_ps(rhs._mat[0].getPtr());
+	__m128 r1 = _mm_loadu_ps(rhs._mat[1].getPtr());
+	__m128 r2 = _mm_loadu_ps(rhs._mat[2].getPtr());
+	__m128 r3 = _mm_loadu_ps(rhs._mat[3].getPtr());
+	__m128 l[4];
+	for(int row=0; row<4; ++row){
+		l[row] = _mm_loadu_ps(lhs._mat[row].getPtr());
+	}
+	for(int row=0; row<4; ++row){
+		__m128 v = l[row];
+		__m128 t = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0,0,0,0)), r0),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)), r1)),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,2,2,2)), r2)),
+			_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)), r3));
+		_mm_storeu_ps(dst._mat[row].getPtr(), t);
+	}
+}
+#endif
+
 void ofMatrix4x4::makeFromMultiplicationOf( const ofMatrix4x4& lhs, const ofMatrix4x4& rhs )
 {
+#ifdef OF_MATRIX_SSE2
+	multiplySSE2(lhs, rhs, *this);
+#else
     if (&lhs==this)
     {
         postMult(rhs);
@@ -466,10 +501,14 @@ void ofMatrix4x4::makeFromMultiplicationOf( const ofMatrix4x4& lhs, const ofMatr
     _mat[3][1] = INNER_PRODUCT(lhs, rhs, 3, 1);
     _mat[3][2] = INNER_PRODUCT(lhs, rhs, 3, 2);
     _mat[3][3] = INNER_PRODUCT(lhs, rhs, 3, 3);
+#endif
 }
 
 void ofMatrix4x4::preMult( const ofMatrix4x4& other )
 {
+#ifdef OF_MATRIX_SSE2
+	multiplySSE2(other, *this, *this);
+#else
     // brute force method requiring a copy
     //ofMatrix4x4 tmp(other* *this);
     // *this = tmp;
@@ -486,11 +525,14 @@ void ofMatrix4x4::preMult( const ofMatrix4x4& other )
         _mat[2][col] = t[2];
         _mat[3][col] = t[3];
     }
-
+#endif
 }
 
 void ofMatrix4x4::postMult( const ofMatrix4x4& other )
 {
+#ifdef OF_MATRIX_SSE2
+	multiplySSE2(*this, other, *this);
+#else
     // brute force method requiring a copy
     //ofMatrix4x4 tmp(*this * other);
     // *this = tmp;
@@ -505,6 +547,7 @@ void ofMatrix4x4::postMult( const ofMatrix4x4& other )
         t[3] = INNER_PRODUCT( *this, other, row, 3 );
         SET_ROW(row, t[0], t[1], t[2], t[3] )
     }
+#endif
 }
 
 #undef INNER_PRODUCT
@@ -576,9 +619,23 @@ bool invert_4x3( const ofMatrix4x4& src, ofMatrix4x4 & dst);
 /** full 4x4 matrix invert. */
 bool invert_4x4( const ofMatrix4x4& rhs, ofMatrix4x4 & dst);
 
+#ifdef OF_MATRIX_SSE2
+/** full 4x4 matrix invert using sse, fails without modifying dst if the
+ *  determinant is 0 or too small to be represented as a float. */
+static bool invert_4x4_sse2( const ofMatrix4x4& rhs, ofMatrix4x4 & dst);
+#endif
+
 bool ofMatrix4x4::makeInvertOf(const ofMatrix4x4 & rhs){
 	bool is_4x3 = (rhs._mat[0][3] == 0.0f && rhs._mat[1][3] == 0.0f &&  rhs._mat[2][3] == 0.0f && rhs._mat[3][3] == 1.0f);
-	return is_4x3 ? invert_4x3(rhs,*this) :  invert_4x4(rhs,*this);
+	if(is_4x3){
+		return invert_4x3(rhs,*this);
+	}
+#ifdef OF_MATRIX_SSE2
+	if(invert_4x4_sse2(rhs,*this)){
+		return true;
+	}
+#endif
+	return invert_4x4(rhs,*this);
 }
 
 ofMatrix4x4 ofMatrix4x4::getInverse() const
@@ -744,6 +801,94 @@ inline T SGL_ABS(T a)
 	return (a >= 0 ? a : -a);
 }
 
+#ifdef OF_MATRIX_SSE2
+template<int x, int y, int z, int w>
+static inline __m128 swizzle(__m128 v){
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w,z,y,x));
+}
+
+template<int x, int y, int z, int w>
+static inline __m128 combine(__m128 a, __m128 b){
+	return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w,z,y,x));
+}
+
+// 2x2 matrices stored as row major vectors
+// a * b
+static inline __m128 mat2Mul(__m128 a, __m128 b){
+	return _mm_add_ps(_mm_mul_ps(a, swizzle<0,3,0,3>(b)), _mm_mul_ps(swizzle<1,0,3,2>(a), swizzle<2,1,2,1>(b)));
+}
+
+// adjugate(a) * b
+static inline __m128 mat2AdjMul(__m128 a, __m128 b){
+	return _mm_sub_ps(_mm_mul_ps(swizzle<3,3,0,0>(a), b), _mm_mul_ps(swizzle<1,1,2,2>(a), swizzle<2,3,0,1>(b)));
+}
+
+// a * adjugate(b)
+static inline __m128 mat2MulAdj(__m128 a, __m128 b){
+	return _mm_sub_ps(_mm_mul_ps(a, swizzle<3,0,3,0>(b)), _mm_mul_ps(swizzle<1,0,3,2>(a), swizzle<2,1,2,1>(b)));
+}
+
+// inverts the matrix as 4 2x2 blocks
+//     | A B |                | X Y |
+// M = | C D |  inverse(M) =  | Z W | / det(M)
+// with the adjugates
+// X# = det(D) A - B (D# C)    Y# = det(B) C - D (A# B)#
+// Z# = det(C) B - A (D# C)#   W# = det(A) D - C (A# B)
+// det(M) = det(A) det(D) + det(B) det(C) - trace((A# B) (D# C))
+static bool invert_4x4_sse2( const ofMatrix4x4& src, ofMatrix4x4 & dst )
+{
+	__m128 r0 = _mm_loadu_ps(src._mat[0].getPtr());
+	__m128 r1 = _mm_loadu_ps(src._mat[1].getPtr());
+	__m128 r2 = _mm_loadu_ps(src._mat[2].getPtr());
+	__m128 r3 = _mm_loadu_ps(src._mat[3].getPtr());
+
+	__m128 A = _mm_movelh_ps(r0, r1);
+	__m128 B = _mm_movehl_ps(r1, r0);
+	__m128 C = _mm_movelh_ps(r2, r3);
+	__m128 D = _mm_movehl_ps(r3, r2);
+
+	// det(A) det(B) det(C) det(D)
+	__m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(combine<0,2,0,2>(r0, r2), combine<1,3,1,3>(r1, r3)),
+		_mm_mul_ps(combine<1,3,1,3>(r0, r2), combine<0,2,0,2>(r1, r3)));
+	__m128 detA = swizzle<0,0,0,0>(detSub);
+	__m128 detB = swizzle<1,1,1,1>(detSub);
+	__m128 detC = swizzle<2,2,2,2>(detSub);
+	__m128 detD = swizzle<3,3,3,3>(detSub);
+
+	__m128 D_C = mat2AdjMul(D, C);
+	__m128 A_B = mat2AdjMul(A, B);
+	__m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+	__m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+	__m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+	__m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+	__m128 tr = _mm_mul_ps(A_B, swizzle<0,2,1,3>(D_C));
+	tr = _mm_add_ps(tr, swizzle<1,0,3,2>(tr));
+	tr = _mm_add_ps(tr, swizzle<2,3,0,1>(tr));
+	__m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+	float det = _mm_cvtss_f32(detM);
+	if(det == 0 || !(std::abs(1.f / det) <= std::numeric_limits<float>::max())){
+		return false;
+	}
+
+	// the signs of the adjugate of every block
+	__m128 rDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+	X_ = _mm_mul_ps(X_, rDetM);
+	Y_ = _mm_mul_ps(Y_, rDetM);
+	Z_ = _mm_mul_ps(Z_, rDetM);
+	W_ = _mm_mul_ps(W_, rDetM);
+
+	// transposes the blocks of the adjugates while storing them
+	_mm_storeu_ps(dst._mat[0].getPtr(), combine<3,1,3,1>(X_, Y_));
+	_mm_storeu_ps(dst._mat[1].getPtr(), combine<2,0,2,0>(X_, Y_));
+	_mm_storeu_ps(dst._mat[2].getPtr(), combine<3,1,3,1>(Z_, W_));
+	_mm_storeu_ps(dst._mat[3].getPtr(), combine<2,0,2,0>(Z_, W_));
+	return true;
+}
+#endif
+
 #ifndef SGL_SWAP
 #define SGL_SWAP(a,b,temp) ((temp)=(a),(a)=(b),(b)=(temp))
 #endif
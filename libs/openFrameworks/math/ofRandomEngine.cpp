@@ -0,0 +1,238 @@
+#include "ofRandomEngine.h"
+#include "ofBatchMath.h"
+#include "ofConstants.h"
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+#if !defined(TARGET_EMSCRIPTEN) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define OF_RANDOM_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace{
+	struct ThreadEngine{
+		ofRandomEngine engine;
+		uint32_t generation = UINT32_MAX;
+	};
+
+	// the seed set by ofSeedRandom, the threads reseed their engine when
+	// the generation changes
+	std::mutex seedMutex;
+	std::atomic<uint32_t> seedGeneration(0);
+	uint64_t currentSeed = 0;
+	uint64_t nextStream = 0;
+
+	ThreadEngine & threadEngine(){
+#if defined(TARGET_EMSCRIPTEN) || !HAS_TLS
+		static ThreadEngine engine;
+#else
+		static thread_local ThreadEngine engine;
+#endif
+		return engine;
+	}
+
+	inline uint32_t rotl(uint32_t x, int k){
+		return (x << k) | (x >> (32 - k));
+	}
+
+	inline uint64_t splitMix64(uint64_t & x){
+		uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	// xoshiro128+ step
+	inline uint32_t next(uint32_t * s){
+		uint32_t result = s[0] + s[3];
+		uint32_t t = s[1] << 9;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 11);
+		return result;
+	}
+
+	// the 24 upper bits, which are the best ones, as a float in [0, 1)
+	inline float toUniform(uint32_t x){
+		return float(x >> 8) * (1.0f / 16777216.0f);
+	}
+
+	void seedState(uint32_t * state, uint64_t seed, uint64_t stream){
+		// the stream is mixed so consecutive streams don't start at
+		// consecutive points of the splitmix sequence
+		uint64_t x = seed ^ splitMix64(stream);
+		uint64_t a = splitMix64(x);
+		uint64_t b = splitMix64(x);
+		state[0] = uint32_t(a);
+		state[1] = uint32_t(a >> 32);
+		state[2] = uint32_t(b);
+		state[3] = uint32_t(b >> 32);
+		if(state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0){
+			state[0] = 1;
+		}
+	}
+
+	// 4 engines stored as one array per word of the state, so lanes[w][i]
+	// is word w of engine i, the layout of the sse2 registers
+	typedef uint32_t Lanes[4][4];
+
+	void fillScalar(Lanes & lanes, float * dst, size_t n, float min, float range){
+		for(size_t i = 0; i < n; i += 4){
+			float values[4];
+			for(int l = 0; l < 4; l++){
+				uint32_t s[4] = {lanes[0][l], lanes[1][l], lanes[2][l], lanes[3][l]};
+				values[l] = min + toUniform(next(s)) * range;
+				for(int w = 0; w < 4; w++){
+					lanes[w][l] = s[w];
+				}
+			}
+			std::copy(values, values + std::min<size_t>(4, n - i), dst + i);
+		}
+	}
+
+#ifdef OF_RANDOM_SSE2
+	inline __m128i rotl(__m128i x, int k){
+		return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+	}
+
+	// the same as fillScalar, 4 engines at a time
+	void fillSSE2(Lanes & lanes, float * dst, size_t n, float min, float range){
+		__m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[0]));
+		__m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[1]));
+		__m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[2]));
+		__m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[3]));
+		__m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+		__m128 minV = _mm_set1_ps(min);
+		__m128 rangeV = _mm_set1_ps(range);
+		for(size_t i = 0; i < n; i += 4){
+			__m128i result = _mm_add_epi32(s0, s3);
+			__m128i t = _mm_slli_epi32(s1, 9);
+			s2 = _mm_xor_si128(s2, s0);
+			s3 = _mm_xor_si128(s3, s1);
+			s1 = _mm_xor_si128(s1, s2);
+			s0 = _mm_xor_si128(s0, s3);
+			s2 = _mm_xor_si128(s2, t);
+			s3 = rotl(s3, 11);
+			__m128 uniform = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), scale);
+			__m128 values = _mm_add_ps(minV, _mm_mul_ps(uniform, rangeV));
+			if(i + 4 <= n){
+				_mm_storeu_ps(dst + i, values);
+			}else{
+				float last[4];
+				_mm_storeu_ps(last, values);
+				std::copy(last, last + (n - i), dst + i);
+			}
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[0]), s0);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[1]), s1);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[2]), s2);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[3]), s3);
+	}
+#endif
+}
+
+//----------------------------------------------------------
+ofRandomEngine::ofRandomEngine(uint64_t seed, uint64_t stream){
+	this->seed(seed, stream);
+}
+
+//----------------------------------------------------------
+void ofRandomEngine::seed(uint64_t seed, uint64_t stream){
+	seedState(state, seed, stream);
+	hasSpareGaussian = false;
+	spareGaussian = 0;
+}
+
+//----------------------------------------------------------
+uint32_t ofRandomEngine::operator()(){
+	return next(state);
+}
+
+//----------------------------------------------------------
+float ofRandomEngine::uniform(){
+	return toUniform(next(state));
+}
+
+//----------------------------------------------------------
+float ofRandomEngine::gaussian(){
+	// marsaglia's polar method, which generates 2 numbers at a time
+	if(hasSpareGaussian){
+		hasSpareGaussian = false;
+		return spareGaussian;
+	}
+	float u, v, s;
+	do{
+		u = uniform() * 2.0f - 1.0f;
+		v = uniform() * 2.0f - 1.0f;
+		s = u * u + v * v;
+	}while(s >= 1.0f || s == 0.0f);
+	float m = sqrt(-2.0f * log(s) / s);
+	spareGaussian = v * m;
+	hasSpareGaussian = true;
+	return u * m;
+}
+
+//----------------------------------------------------------
+void ofRandomEngine::fill(float * dst, size_t n, float min, float max){
+	if(n == 0){
+		return;
+	}
+	Lanes lanes;
+	for(int l = 0; l < 4; l++){
+		uint32_t s[4];
+		uint64_t laneSeed = (uint64_t(next(state)) << 32) | next(state);
+		seedState(s, laneSeed, l);
+		for(int w = 0; w < 4; w++){
+			lanes[w][l] = s[w];
+		}
+	}
+#ifdef OF_RANDOM_SSE2
+	if(ofGetSimdLevel() >= OF_SIMD_SSE2){
+		fillSSE2(lanes, dst, n, min, max - min);
+		return;
+	}
+#endif
+	fillScalar(lanes, dst, n, min, max - min);
+}
+
+//----------------------------------------------------------
+void ofRandomEngine::fillGaussian(float * dst, size_t n, float mean, float deviation){
+	// box-muller on pairs of uniform numbers, 1 - u is in (0, 1] so the
+	// log is always finite
+	fill(dst, n, 0, 1);
+	for(size_t i = 0; i + 1 < n; i += 2){
+		float r = sqrt(-2.0f * log(1.0f - dst[i])) * deviation;
+		float angle = float(TWO_PI) * dst[i + 1];
+		dst[i] = mean + r * cos(angle);
+		dst[i + 1] = mean + r * sin(angle);
+	}
+	if(n % 2 == 1){
+		dst[n - 1] = mean + gaussian() * deviation;
+	}
+}
+
+//----------------------------------------------------------
+ofRandomEngine & ofGetRandomEngine(){
+	ThreadEngine & thread = threadEngine();
+	if(thread.generation != seedGeneration.load(std::memory_order_acquire)){
+		std::unique_lock<std::mutex> lock(seedMutex);
+		thread.engine.seed(currentSeed, nextStream++);
+		thread.generation = seedGeneration.load(std::memory_order_relaxed);
+	}
+	return thread.engine;
+}
+
+//----------------------------------------------------------
+void of::priv::seedRandomEngines(uint64_t seed){
+	std::unique_lock<std::mutex> lock(seedMutex);
+	currentSeed = seed;
+	// the calling thread takes the first stream
+	ThreadEngine & thread = threadEngine();
+	thread.engine.seed(seed, 0);
+	thread.generation = ++seedGeneration;
+	nextStream = 1;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/// \brief Pseudo random number generator used by ofRandom and the rest of
+/// the random functions in ofMath.h.
+///
+/// It implements xoshiro128+ by Blackman and Vigna, which is much faster
+/// than `rand()`, has a period of 2^128 - 1 and passes the usual statistical
+/// tests for the upper bits that are used to make floats.
+///
+/// Every thread has its own engine, returned by ofGetRandomEngine(), so
+/// the random functions can be called from several threads without locks.
+/// The engine can also be used with the c++11 distributions:
+///
+/// ~~~~{.cpp}
+/// std::poisson_distribution<int> poisson(4);
+/// int n = poisson(ofGetRandomEngine());
+/// ~~~~
+class ofRandomEngine{
+public:
+	typedef uint32_t result_type;
+
+	/// \brief Construct an engine with a seed and a stream.
+	ofRandomEngine(uint64_t seed = 0, uint64_t stream = 0);
+
+	/// \brief Reset the state of the engine.
+	///
+	/// Engines with the same seed and stream return the same sequence,
+	/// different streams of the same seed return unrelated sequences.
+	void seed(uint64_t seed, uint64_t stream = 0);
+
+	/// \brief Get the next 32 random bits.
+	uint32_t operator()();
+
+	static constexpr uint32_t min(){ return 0; }
+	static constexpr uint32_t max(){ return UINT32_MAX; }
+
+	/// \brief Get a uniformly distributed number in [0, 1).
+	float uniform();
+
+	/// \brief Get a normally distributed number with mean 0 and standard
+	/// deviation 1.
+	float gaussian();
+
+	/// \brief Fills an array with uniformly distributed numbers in
+	/// [min, max).
+	///
+	/// The numbers are generated 4 at a time from 4 engines seeded from
+	/// this one with SIMD instructions when available, see ofBatchMath.h.
+	/// The results are the same with and without SIMD but aren't the same
+	/// as calling uniform() n times.
+	void fill(float * dst, size_t n, float min, float max);
+
+	/// \brief Fills an array with normally distributed numbers.
+	void fillGaussian(float * dst, size_t n, float mean, float deviation);
+
+private:
+	uint32_t state[4];
+	float spareGaussian;
+	bool hasSpareGaussian;
+};
+
+/// \brief Get the random engine of the calling thread.
+///
+/// After ofSeedRandom(), the thread that called it uses stream 0 of the
+/// new seed and every other thread gets the next stream the first time
+/// it uses its engine, so the results are repeatable as long as the
+/// threads start drawing numbers in the same order. Threads that need a
+/// fixed stream, like the workers of a pool, can seed their engine
+/// explicitly:
+///
+/// ~~~~{.cpp}
+/// ofGetRandomEngine().seed(seed, workerIndex);
+/// ~~~~
+///
+/// On platforms without thread local storage every thread shares one
+/// engine which is then not thread safe.
+ofRandomEngine & ofGetRandomEngine();
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+    // reseeds every thread's engine, used by ofSeedRandom
+    void seedRandomEngines(uint64_t seed);
+}
+}
+/*! \endcond */
@@ -6,3 +6,4 @@
 #include "ofMatrix3x3.h"
 #include "ofMatrix4x4.h"
 #include "ofQuaternion.h"
+#include "ofBatchMath.h"
@@ -13,6 +13,7 @@
 #include "ofThreadChannel.h"
 #endif
 #include "ofFpsCounter.h"
+#include "ofFrameProfiler.h"
 
 //--------------------------
 // types
@@ -23,13 +24,16 @@
 #include "ofRectangle.h"
 #if !defined(TARGET_EMSCRIPTEN)
 #include "ofXml.h"
+#include "ofXmlReader.h"
 #endif
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
+#include "ofParameterSnapshot.h"
 
 //--------------------------
 // math
 #include "ofMath.h"
+#include "ofRandomEngine.h"
 #include "ofVectorMath.h"
 
 //--------------------------
@@ -60,13 +64,17 @@
 #if !defined( TARGET_OF_IOS ) & !defined(TARGET_ANDROID) & !defined(TARGET_EMSCRIPTEN)
 	#include "ofCairoRenderer.h"
 #endif
+#include "ofDrawBatch.h"
+#include "ofGlyphAtlas.h"
 #include "ofGraphics.h"
 #include "ofImage.h"
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
+#include "ofRecordingRenderer.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
+#include "ofTextLayout.h"
 #include "ofTrueTypeFont.h"
 
 //--------------------------
@@ -105,6 +113,8 @@
 #include "of3dUtils.h"
 #include "ofCamera.h"
 #include "ofEasyCam.h"
+#include "ofFrustum.h"
 #include "ofMesh.h"
 #include "ofNode.h"
+#include "ofNodeHierarchy.h"
 
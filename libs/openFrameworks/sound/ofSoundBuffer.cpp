@@ -591,9 +591,7 @@ bool ofSoundBuffer::trimSilence(float threshold, bool trimStart, bool trimEnd) {
 }
 
 void ofSoundBuffer::fillWithNoise(float amplitude){
-	for (std::size_t i=0; i<size(); i++ ) {
-		buffer[i] = ofRandom(-amplitude, amplitude);
-	}
+	ofRandomFill(buffer.data(), size(), -amplitude, amplitude);
 }
 
 float ofSoundBuffer::fillWithTone( float pitchHz, float phase ){
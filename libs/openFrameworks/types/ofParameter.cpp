@@ -11,20 +11,17 @@ string ofAbstractParameter::escape(const string& _str) const{
 
 	std::string str(_str);
 
-	ofStringReplace(str, " ", "_");
-	ofStringReplace(str, "<", "_");
-	ofStringReplace(str, ">", "_");
-	ofStringReplace(str, "{", "_");
-	ofStringReplace(str, "}", "_");
-	ofStringReplace(str, "[", "_");
-	ofStringReplace(str, "]", "_");
-	ofStringReplace(str, ",", "_");
-	ofStringReplace(str, "(", "_");
-	ofStringReplace(str, ")", "_");
-	ofStringReplace(str, "/", "_");
-	ofStringReplace(str, "\\", "_");
-	ofStringReplace(str, ".", "_");
-	
+	for(auto & c: str){
+		switch(c){
+		case ' ': case '<': case '>': case '{': case '}': case '[': case ']':
+		case ',': case '(': case ')': case '/': case '\\': case '.':
+			c = '_';
+			break;
+		default:
+			break;
+		}
+	}
+
 	return str;
 }
 
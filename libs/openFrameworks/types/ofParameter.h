@@ -5,6 +5,7 @@
 #include "ofUtils.h"
 #include "ofConstants.h"
 #include <map>
+#include <unordered_map>
 
 template<typename ParameterType>
 class ofParameter;
@@ -56,6 +57,11 @@ protected:
 	virtual const ofParameterGroup getFirstParent() const = 0;
 	virtual void setSerializable(bool serializable)=0;
 	virtual string escape(const string& str) const;
+
+	/// notifies a change that a transaction of a group deferred
+	virtual void notifyDeferredChange(){}
+
+	friend class ofParameterGroup;
 };
 
 
@@ -169,6 +175,29 @@ public:
 	template<typename ParameterType>
 	ofParameter<ParameterType> & get(std::size_t pos);
 
+	/// \brief Finds a parameter by its path, the names of the groups that
+	/// contain it and its own separated by '/', like "light/color".
+	///
+	/// The returned reference stays valid until the parameter is removed
+	/// from the group, so it can be looked up once and used every frame
+	/// instead of looking up its name every time:
+	///
+	/// ~~~~{.cpp}
+	/// ofParameter<float> & speed = parameters.handle<float>("motion/speed");
+	/// ~~~~
+	///
+	/// \throws std::out_of_range if there's no parameter with that path.
+	ofAbstractParameter & handle(const string & path);
+	const ofAbstractParameter & handle(const string & path) const;
+
+	/// \throws std::out_of_range if there's no parameter with that path and
+	/// std::runtime_error if it's of a different type.
+	template<typename ParameterType>
+	ofParameter<ParameterType> & handle(const string & path);
+
+	template<typename ParameterType>
+	const ofParameter<ParameterType> & handle(const string & path) const;
+
 	std::size_t size() const;
 	string getName(std::size_t position) const;
 	string getType(std::size_t position) const;
@@ -201,6 +230,47 @@ public:
 
 	ofEvent<ofAbstractParameter> & parameterChangedE();
 
+	/// \brief Starts recording the changes of the parameters of the group,
+	/// including the ones in its subgroups, instead of notifying them.
+	///
+	/// Setting many parameters at once, like when loading a preset, calls
+	/// the listeners of every parameter and of every group containing it
+	/// for each change. Inside a transaction the values change right away
+	/// but the notifications wait until commitTransaction():
+	///
+	/// ~~~~{.cpp}
+	/// parameters.beginTransaction();
+	/// xml.deserialize(parameters);
+	/// parameters.commitTransaction();
+	/// ~~~~
+	///
+	/// Transactions can be nested, the changes are notified when the
+	/// outermost one is committed.
+	void beginTransaction();
+
+	/// \brief Ends a transaction started with beginTransaction(), each
+	/// parameter that changed is notified once with its last value and then
+	/// every group containing any of them notifies changesCommittedE once.
+	void commitTransaction();
+
+	/// \returns Whether the changes of the group are being recorded, by a
+	/// transaction or because its notifications are deferred.
+	bool isInTransaction() const;
+
+	/// \brief Keeps the group in a transaction that is committed once per
+	/// frame before the update of the app, so parameters set several times
+	/// during a frame, like from a gui, are notified only once.
+	///
+	/// Like the rest of ofParameter, transactions aren't thread safe, the
+	/// parameters of the group have to be set from the main thread. Values
+	/// received in other threads can be passed to it with an ofThreadChannel.
+	void setDeferredNotifications(bool deferred);
+	bool getDeferredNotifications() const;
+
+	/// \brief Notified once per committed transaction with all the
+	/// parameters of the group, or of its subgroups, that changed.
+	ofEvent<const vector<shared_ptr<ofAbstractParameter>>> & changesCommittedE();
+
 	vector<shared_ptr<ofAbstractParameter> >::iterator begin();
 	vector<shared_ptr<ofAbstractParameter> >::iterator end();
 	vector<shared_ptr<ofAbstractParameter> >::const_iterator begin() const;
@@ -214,16 +284,44 @@ private:
 	class Value{
 	public:
 		Value()
-		:serializable(true){}
+		:serializable(true)
+		,transactions(0)
+		,deferred(false){}
+		~Value();
 
 		void notifyParameterChanged(ofAbstractParameter & param);
 
-		map<string,std::size_t> parametersIndex;
+		// records the change of a parameter if any of its groups is in a
+		// transaction, the flag is shared by all the references to the
+		// parameter so it's only recorded once
+		static bool deferChange(ofAbstractParameter & param, bool & pending, const vector<weak_ptr<Value>> & parents){
+			return numTransactions != 0 && recordChange(param, pending, parents);
+		}
+		static bool recordChange(ofAbstractParameter & param, bool & pending, const vector<weak_ptr<Value>> & parents);
+		static Value * findTransaction(const vector<weak_ptr<Value>> & parents);
+		void commitChanges();
+		void update(ofEventArgs &);
+
+		struct Change{
+			shared_ptr<ofAbstractParameter> parameter;
+			bool * pending;
+			vector<weak_ptr<Value>> parents;
+		};
+
+		unordered_map<string,std::size_t> parametersIndex;
 		vector<shared_ptr<ofAbstractParameter> > parameters;
 		string name;
 		bool serializable;
 		vector<weak_ptr<Value>> parents;
 		ofEvent<ofAbstractParameter> parameterChangedE;
+		std::size_t transactions;
+		bool deferred;
+		vector<Change> changes;
+		ofEvent<const vector<shared_ptr<ofAbstractParameter>>> changesCommittedE;
+
+		// transactions open in any group, to skip looking for them when
+		// there are none, only used from the main thread
+		static std::size_t numTransactions;
 	};
 	shared_ptr<Value> obj;
 	ofParameterGroup(shared_ptr<Value> obj)
@@ -236,6 +334,10 @@ private:
 	friend class ofReadOnlyParameter;
 
 	const ofParameterGroup getFirstParent() const;
+	const ofAbstractParameter * find(const string & name) const;
+	const ofAbstractParameter & findPath(const string & path) const;
+	template<typename ParameterType>
+	const ofParameter<ParameterType> & checkType(const ofAbstractParameter & parameter, const string & path) const;
 };
 
 template<typename ParameterType>
@@ -258,6 +360,24 @@ ofParameter<ParameterType> & ofParameterGroup::get(std::size_t pos){
 	return static_cast<ofParameter<ParameterType>& >(get(pos));
 }
 
+template<typename ParameterType>
+const ofParameter<ParameterType> & ofParameterGroup::checkType(const ofAbstractParameter & parameter, const string & path) const{
+	if(parameter.type() != typeid(ofParameter<ParameterType>).name()){
+		throw std::runtime_error(("handle(): bad type for " + path).c_str());
+	}
+	return static_cast<const ofParameter<ParameterType>& >(parameter);
+}
+
+template<typename ParameterType>
+const ofParameter<ParameterType> & ofParameterGroup::handle(const string & path) const{
+	return checkType<ParameterType>(findPath(path), path);
+}
+
+template<typename ParameterType>
+ofParameter<ParameterType> & ofParameterGroup::handle(const string & path){
+	return const_cast<ofParameter<ParameterType>&>(checkType<ParameterType>(findPath(path), path));
+}
+
 
 
 
@@ -488,6 +608,7 @@ private:
 		:min(of::priv::TypeInfo<ParameterType>::min())
 		,max(of::priv::TypeInfo<ParameterType>::max())
 		,bInNotify(false)
+		,bPendingNotify(false)
 		,serializable(true){};
 
 		Value(ParameterType v)
@@ -495,6 +616,7 @@ private:
 		,min(of::priv::TypeInfo<ParameterType>::min())
 		,max(of::priv::TypeInfo<ParameterType>::max())
 		,bInNotify(false)
+		,bPendingNotify(false)
 		,serializable(true){};
 
 		Value(string name, ParameterType v)
@@ -503,6 +625,7 @@ private:
 		,min(of::priv::TypeInfo<ParameterType>::min())
 		,max(of::priv::TypeInfo<ParameterType>::max())
 		,bInNotify(false)
+		,bPendingNotify(false)
 		,serializable(true){};
 
 		Value(string name, ParameterType v, ParameterType min, ParameterType max)
@@ -511,6 +634,7 @@ private:
 		,min(min)
 		,max(max)
 		,bInNotify(false)
+		,bPendingNotify(false)
 		,serializable(true){};
 
 		string name;
@@ -518,6 +642,7 @@ private:
 		ParameterType min, max;
 		ofEvent<ParameterType> changedE;
 		bool bInNotify;
+		bool bPendingNotify;
 		bool serializable;
 		vector<weak_ptr<ofParameterGroup::Value>> parents;
 	};
@@ -526,6 +651,8 @@ private:
 
 	void eventsSetValue(const ParameterType & v);
 	void noEventsSetValue(const ParameterType & v);
+	void notifyChange();
+	void notifyDeferredChange();
 };
 
 
@@ -609,55 +736,72 @@ inline void ofParameter<ParameterType>::eventsSetValue(const ParameterType & v){
 
     // If the object is notifying its parents, just set the value without triggering an event.
     if(obj->bInNotify)
+    {
+		noEventsSetValue(v);
+	}
+    // If a group is in a transaction, the change is notified when it's committed.
+    else if(!obj->parents.empty() && ofParameterGroup::Value::deferChange(*this, obj->bPendingNotify, obj->parents))
     {
 		noEventsSetValue(v);
 	}
     else
     {
-        // Mark the object as in its notification loop.
-        obj->bInNotify = true;
-
         // Set the value.
         obj->value = v;
 
-        // Notify any local subscribers.
-        ofNotifyEvent(obj->changedE,obj->value,this);
-
-        // Notify all parents, if there are any.
-        if(!obj->parents.empty())
-        {
-
-            // This lambda will conditionally notify a parent if its child
-            // value has changed.
-            //
-            // If it was successful (i.e. the parent pointer is valid) the
-            // lambda will return false.  If it was unsuccessful (i.e. the
-            // parent pointer is invalid) the lambda will return true.
-            //
-            // This return value is used by the std::remove_if algorithm
-            // to erase invalid parents from this object's parent list.
-            auto notifyParents = [this](weak_ptr<ofParameterGroup::Value> p){
-                // Try to get a valid shared pointer ot the parent.
-                auto parent = p.lock();
-
-                // If the parent's shared pointer is not nullptr, notify it.
-                if(parent != nullptr) {
-                    parent->notifyParameterChanged(*this);
-                    return false;
-                } else {
-                    return true;
-                }
-            };
-
-            // Erase each invalid parent and notify all valid parents of this
-            // object's changed value.
-            obj->parents.erase(std::remove_if(obj->parents.begin(),
-                                              obj->parents.end(),
-                                              notifyParents),
-                               obj->parents.end());
-        }
-        obj->bInNotify = false;
+        notifyChange();
+    }
+}
+
+template<typename ParameterType>
+inline void ofParameter<ParameterType>::notifyChange(){
+    // Mark the object as in its notification loop.
+    obj->bInNotify = true;
+
+    // Notify any local subscribers.
+    ofNotifyEvent(obj->changedE,obj->value,this);
+
+    // Notify all parents, if there are any.
+    if(!obj->parents.empty())
+    {
+
+        // This lambda will conditionally notify a parent if its child
+        // value has changed.
+        //
+        // If it was successful (i.e. the parent pointer is valid) the
+        // lambda will return false.  If it was unsuccessful (i.e. the
+        // parent pointer is invalid) the lambda will return true.
+        //
+        // This return value is used by the std::remove_if algorithm
+        // to erase invalid parents from this object's parent list.
+        auto notifyParents = [this](weak_ptr<ofParameterGroup::Value> p){
+            // Try to get a valid shared pointer ot the parent.
+            auto parent = p.lock();
+
+            // If the parent's shared pointer is not nullptr, notify it.
+            if(parent != nullptr) {
+                parent->notifyParameterChanged(*this);
+                return false;
+            } else {
+                return true;
+            }
+        };
+
+        // Erase each invalid parent and notify all valid parents of this
+        // object's changed value.
+        obj->parents.erase(std::remove_if(obj->parents.begin(),
+                                          obj->parents.end(),
+                                          notifyParents),
+                           obj->parents.end());
     }
+    obj->bInNotify = false;
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::notifyDeferredChange(){
+	if(!obj->bInNotify){
+		notifyChange();
+	}
 }
 
 template<typename ParameterType>
@@ -265,9 +265,57 @@ string ofParameterGroup::getType(std::size_t position) const{
 
 
 int ofParameterGroup::getPosition(const string& name) const{
-	if(obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end())
-		return obj->parametersIndex.find(escape(name))->second;
-	return -1;
+	// most names don't need escaping so they are looked up as they are
+	// first, escaped names never match the name of another parameter
+	auto it = obj->parametersIndex.find(name);
+	if(it==obj->parametersIndex.end()){
+		it = obj->parametersIndex.find(escape(name));
+		if(it==obj->parametersIndex.end()){
+			return -1;
+		}
+	}
+	return it->second;
+}
+
+const ofAbstractParameter * ofParameterGroup::find(const string& name) const{
+	int position = getPosition(name);
+	if(position<0){
+		return nullptr;
+	}
+	return obj->parameters[position].get();
+}
+
+const ofAbstractParameter & ofParameterGroup::findPath(const string& path) const{
+	const ofParameterGroup * group = this;
+	std::size_t start = 0;
+	while(true){
+		std::size_t end = path.find('/', start);
+		const ofAbstractParameter * parameter;
+		if(start==0 && end==string::npos){
+			parameter = group->find(path);
+		}else{
+			parameter = group->find(path.substr(start, end==string::npos ? string::npos : end - start));
+		}
+		if(!parameter){
+			throw std::out_of_range(("handle(): " + path + " not found").c_str());
+		}
+		if(end==string::npos){
+			return *parameter;
+		}
+		if(parameter->type()!=typeid(ofParameterGroup).name()){
+			throw std::out_of_range(("handle(): " + path + " not found, " + parameter->getName() + " isn't a group").c_str());
+		}
+		group = static_cast<const ofParameterGroup*>(parameter);
+		start = end + 1;
+	}
+}
+
+ofAbstractParameter & ofParameterGroup::handle(const string& path){
+	return const_cast<ofAbstractParameter&>(findPath(path));
+}
+
+const ofAbstractParameter & ofParameterGroup::handle(const string& path) const{
+	return findPath(path);
 }
 
 string ofParameterGroup::getName() const{
@@ -298,9 +346,11 @@ void ofParameterGroup::fromString(const string & name){
 
 
 const ofAbstractParameter & ofParameterGroup::get(const string& name) const{
-	map<string,std::size_t>::const_iterator it = obj->parametersIndex.find(escape(name));
-	std::size_t index = it->second;
-	return get(index);
+	const ofAbstractParameter * parameter = find(name);
+	if(!parameter){
+		throw std::out_of_range(("get(): " + name + " not found").c_str());
+	}
+	return *parameter;
 }
 
 const ofAbstractParameter & ofParameterGroup::get(std::size_t pos) const{
@@ -317,9 +367,7 @@ const ofAbstractParameter & ofParameterGroup::operator[](std::size_t pos) const{
 }
 
 ofAbstractParameter & ofParameterGroup::get(const string& name){
-	map<string,std::size_t>::const_iterator it = obj->parametersIndex.find(escape(name));
-	std::size_t index = it->second;
-	return get(index);
+	return const_cast<ofAbstractParameter&>(static_cast<const ofParameterGroup&>(*this).get(name));
 }
 
 ofAbstractParameter & ofParameterGroup::get(std::size_t pos){
@@ -351,7 +399,7 @@ ostream& operator<<(ostream& os, const ofParameterGroup& group) {
 }
 
 bool ofParameterGroup::contains(const string& name){
-	return obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end();
+	return getPosition(name)!=-1;
 }
 
 void ofParameterGroup::Value::notifyParameterChanged(ofAbstractParameter & param){
@@ -363,6 +411,155 @@ void ofParameterGroup::Value::notifyParameterChanged(ofAbstractParameter & param
 	}),parents.end());
 }
 
+std::size_t ofParameterGroup::Value::numTransactions = 0;
+
+ofParameterGroup::Value::~Value(){
+	numTransactions -= transactions;
+	for(auto & change: changes){
+		*change.pending = false;
+	}
+	if(deferred){
+		ofRemoveListener(ofEvents().update, this, &Value::update, OF_EVENT_ORDER_BEFORE_APP);
+	}
+}
+
+ofParameterGroup::Value * ofParameterGroup::Value::findTransaction(const vector<weak_ptr<Value>> & parents){
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(parent){
+			if(parent->transactions > 0){
+				return parent.get();
+			}
+			Value * transaction = findTransaction(parent->parents);
+			if(transaction){
+				return transaction;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool ofParameterGroup::Value::recordChange(ofAbstractParameter & param, bool & pending, const vector<weak_ptr<Value>> & parents){
+	if(pending){
+		return true;
+	}
+	Value * transaction = findTransaction(parents);
+	if(!transaction){
+		return false;
+	}
+	pending = true;
+	transaction->changes.push_back({param.newReference(), &pending, parents});
+	return true;
+}
+
+void ofParameterGroup::Value::commitChanges(){
+	if(changes.empty()){
+		return;
+	}
+
+	// a group containing this one is still in a transaction, it'll notify
+	// the changes when it's committed
+	Value * transaction = findTransaction(parents);
+	if(transaction){
+		transaction->changes.insert(transaction->changes.end(), changes.begin(), changes.end());
+		changes.clear();
+		return;
+	}
+
+	// parameters set by the listeners are recorded again if the group is
+	// still deferring its notifications
+	vector<Change> committed;
+	committed.swap(changes);
+	for(auto & change: committed){
+		*change.pending = false;
+	}
+	for(auto & change: committed){
+		change.parameter->notifyDeferredChange();
+	}
+
+	// every group containing a changed parameter is notified once with all
+	// of them, lastChange avoids adding a parameter twice to a group that
+	// can be reached through several parents
+	struct GroupChanges{
+		shared_ptr<Value> group;
+		vector<shared_ptr<ofAbstractParameter>> parameters;
+		std::size_t lastChange;
+	};
+	vector<GroupChanges> groups;
+	map<Value*, std::size_t> groupsIndex;
+	std::function<void(const vector<weak_ptr<Value>> &, std::size_t)> addToParents = [&](const vector<weak_ptr<Value>> & parents, std::size_t i){
+		for(auto & p: parents){
+			auto parent = p.lock();
+			if(!parent){
+				continue;
+			}
+			auto it = groupsIndex.find(parent.get());
+			if(it == groupsIndex.end()){
+				it = groupsIndex.insert(std::make_pair(parent.get(), groups.size())).first;
+				groups.push_back({parent, {}, i});
+			}else if(groups[it->second].lastChange == i){
+				continue;
+			}
+			groups[it->second].lastChange = i;
+			groups[it->second].parameters.push_back(committed[i].parameter);
+			addToParents(parent->parents, i);
+		}
+	};
+	for(std::size_t i = 0; i < committed.size(); i++){
+		addToParents(committed[i].parents, i);
+	}
+	for(auto & group: groups){
+		ofNotifyEvent(group.group->changesCommittedE, group.parameters);
+	}
+}
+
+void ofParameterGroup::Value::update(ofEventArgs &){
+	commitChanges();
+}
+
+void ofParameterGroup::beginTransaction(){
+	obj->transactions++;
+	Value::numTransactions++;
+}
+
+void ofParameterGroup::commitTransaction(){
+	if(obj->transactions == 0 || (obj->deferred && obj->transactions == 1)){
+		ofLogWarning("ofParameterGroup") << "commitTransaction(): no transaction to commit in group " << getName();
+		return;
+	}
+	obj->transactions--;
+	Value::numTransactions--;
+	if(obj->transactions == 0){
+		obj->commitChanges();
+	}
+}
+
+bool ofParameterGroup::isInTransaction() const{
+	return obj->transactions > 0;
+}
+
+void ofParameterGroup::setDeferredNotifications(bool deferred){
+	if(deferred == obj->deferred){
+		return;
+	}
+	obj->deferred = deferred;
+	if(deferred){
+		beginTransaction();
+		ofAddListener(ofEvents().update, obj.get(), &Value::update, OF_EVENT_ORDER_BEFORE_APP);
+	}else{
+		ofRemoveListener(ofEvents().update, obj.get(), &Value::update, OF_EVENT_ORDER_BEFORE_APP);
+		commitTransaction();
+	}
+}
+
+bool ofParameterGroup::getDeferredNotifications() const{
+	return obj->deferred;
+}
+
+ofEvent<const vector<shared_ptr<ofAbstractParameter>>> & ofParameterGroup::changesCommittedE(){
+	return obj->changesCommittedE;
+}
+
 const ofParameterGroup ofParameterGroup::getFirstParent() const{
 	auto first = std::find_if(obj->parents.begin(),obj->parents.end(),[](weak_ptr<Value> p){return p.lock()!=nullptr;});
 	if(first!=obj->parents.end()){
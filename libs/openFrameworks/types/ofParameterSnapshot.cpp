@@ -0,0 +1,570 @@
+#include "ofParameterSnapshot.h"
+#include "ofBaseTypes.h"
+#include "ofLog.h"
+
+namespace{
+	// the order of the kinds is part of the schema hash, new kinds have to
+	// be added before StringValue
+	enum Kind: uint8_t{
+		BoolValue,
+		CharValue,
+		IntValue,
+		Int64Value,
+		FloatValue,
+		DoubleValue,
+		Vec2fValue,
+		Vec3fValue,
+		Vec4fValue,
+		ColorValue,
+		ShortColorValue,
+		FloatColorValue,
+		StringValue,
+		TextValue,
+		GroupBegin,
+		GroupEnd,
+	};
+
+	// typed copies of the values of the parameters with a fixed size
+	struct KindInfo{
+		string type;
+		size_t size;
+		void (*read)(const ofAbstractParameter & parameter, char * dst);
+		bool (*write)(ofAbstractParameter & parameter, const char * src, bool notify);
+		shared_ptr<ofAbstractParameter> (*makeParameter)(const string & name);
+	};
+
+	template<typename ParameterType>
+	void readValue(const ofAbstractParameter & parameter, char * dst){
+		memcpy(dst, &parameter.cast<ParameterType>().get(), sizeof(ParameterType));
+	}
+
+	template<typename ParameterType>
+	bool writeValue(ofAbstractParameter & parameter, const char * src, bool notify){
+		ofParameter<ParameterType> & typed = parameter.cast<ParameterType>();
+		if(memcmp(&typed.get(), src, sizeof(ParameterType)) == 0){
+			return false;
+		}
+		ParameterType value;
+		memcpy(&value, src, sizeof(ParameterType));
+		if(notify){
+			typed.set(value);
+		}else{
+			typed.setWithoutEventNotifications(value);
+		}
+		return true;
+	}
+
+	template<typename ParameterType>
+	shared_ptr<ofAbstractParameter> makeParameter(const string & name){
+		return std::make_shared<ofParameter<ParameterType>>(name, ParameterType());
+	}
+
+	template<typename ParameterType>
+	KindInfo kindInfo(){
+		return {typeid(ofParameter<ParameterType>).name(), sizeof(ParameterType), &readValue<ParameterType>, &writeValue<ParameterType>, &makeParameter<ParameterType>};
+	}
+
+	const vector<KindInfo> & getKinds(){
+		static const vector<KindInfo> kinds = {
+			kindInfo<bool>(),
+			kindInfo<char>(),
+			kindInfo<int>(),
+			kindInfo<int64_t>(),
+			kindInfo<float>(),
+			kindInfo<double>(),
+			kindInfo<ofVec2f>(),
+			kindInfo<ofVec3f>(),
+			kindInfo<ofVec4f>(),
+			kindInfo<ofColor>(),
+			kindInfo<ofShortColor>(),
+			kindInfo<ofFloatColor>(),
+		};
+		return kinds;
+	}
+
+	// fnv-1a
+	const uint64_t hashSeed = 14695981039346656037ull;
+
+	uint64_t hashBytes(uint64_t h, const void * data, size_t size){
+		const unsigned char * bytes = static_cast<const unsigned char*>(data);
+		for(size_t i = 0; i < size; i++){
+			h = (h ^ bytes[i]) * 1099511628211ull;
+		}
+		return h;
+	}
+
+	uint64_t hashName(uint64_t h, Kind kind, const string & name){
+		h = hashBytes(h, &kind, 1);
+		return hashBytes(h, name.c_str(), name.size() + 1);
+	}
+
+	// binary format:
+	// header: 'OFPS' version type 0 0 schemaHash
+	// full: valuesSize values numStrings (stringSize string)*
+	// delta: valuesHash numChanged (index delta from the previous one as
+	// a varint, value or stringSize string)*
+	const char magic[4] = {'O','F','P','S'};
+	const uint8_t version = 1;
+	const uint8_t fullData = 0;
+	const uint8_t deltaData = 1;
+
+	template<typename T>
+	void append(ofBuffer & buffer, const T & value){
+		buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void appendString(ofBuffer & buffer, const string & str){
+		append(buffer, uint32_t(str.size()));
+		buffer.append(str.c_str(), str.size());
+	}
+
+	void appendIndex(ofBuffer & buffer, uint32_t index){
+		while(index >= 0x80){
+			append(buffer, uint8_t(index | 0x80));
+			index >>= 7;
+		}
+		append(buffer, uint8_t(index));
+	}
+
+	void appendHeader(ofBuffer & buffer, uint8_t type, uint64_t schemaHash){
+		buffer.clear();
+		buffer.append(magic, 4);
+		append(buffer, version);
+		append(buffer, type);
+		append(buffer, uint16_t(0));
+		append(buffer, schemaHash);
+	}
+
+	// reads the data checking that it doesn't go past the end
+	struct Reader{
+		const char * pos;
+		const char * end;
+
+		bool read(void * dst, size_t size){
+			if(size_t(end - pos) < size){
+				return false;
+			}
+			memcpy(dst, pos, size);
+			pos += size;
+			return true;
+		}
+
+		template<typename T>
+		bool read(T & value){
+			return read(&value, sizeof(T));
+		}
+
+		bool skip(size_t size){
+			if(size_t(end - pos) < size){
+				return false;
+			}
+			pos += size;
+			return true;
+		}
+
+		bool readString(string * str){
+			uint32_t size;
+			if(!read(size) || size_t(end - pos) < size){
+				return false;
+			}
+			if(str){
+				str->assign(pos, size);
+			}
+			pos += size;
+			return true;
+		}
+
+		bool readIndex(uint32_t & index){
+			index = 0;
+			for(int shift = 0; shift < 35; shift += 7){
+				uint8_t byte;
+				if(!read(byte)){
+					return false;
+				}
+				index |= uint32_t(byte & 0x7f) << shift;
+				if(!(byte & 0x80)){
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+}
+
+//---------------------------------------------------------------------------
+class ofParameterSnapshot::Schema{
+public:
+	struct Field{
+		Kind kind;
+		const KindInfo * info;
+		size_t offset; // in the values or the strings
+		shared_ptr<ofAbstractParameter> parameter;
+		shared_ptr<ofAbstractParameter> copy;
+	};
+
+	Schema()
+	:copied(false)
+	,valuesSize(0)
+	,numStrings(0)
+	,hash(hashSeed){}
+
+	static bool isSnapshotted(const ofAbstractParameter & parameter){
+		return parameter.isSerializable() && !parameter.isReadOnly();
+	}
+
+	static bool isGroup(const ofAbstractParameter & parameter){
+		return parameter.type() == typeid(ofParameterGroup).name();
+	}
+
+	void add(const ofParameterGroup & group){
+		hash = hashName(hash, GroupBegin, group.getEscapedName());
+		for(auto & parameter: group){
+			if(!isSnapshotted(*parameter)){
+				continue;
+			}
+			if(isGroup(*parameter)){
+				add(static_cast<const ofParameterGroup&>(*parameter));
+				continue;
+			}
+			Field field;
+			field.parameter = parameter;
+			field.info = nullptr;
+			const auto & kinds = getKinds();
+			string type = parameter->type();
+			auto kind = std::find_if(kinds.begin(), kinds.end(), [&](const KindInfo & info){
+				return info.type == type;
+			});
+			if(kind != kinds.end()){
+				field.kind = Kind(kind - kinds.begin());
+				field.info = &*kind;
+				field.offset = valuesSize;
+				valuesSize += kind->size;
+			}else{
+				field.kind = type == typeid(ofParameter<string>).name() ? StringValue : TextValue;
+				field.offset = numStrings++;
+			}
+			fields.push_back(field);
+			hash = hashName(hash, field.kind, parameter->getEscapedName());
+		}
+		hash = hashName(hash, GroupEnd, "");
+	}
+
+	// builds a group with the same structure and names but new parameters
+	// to save and load the values with a serializer without touching the
+	// original ones, strings and text are kept in ofParameter<string>
+	void addCopies(const ofParameterGroup & group, ofParameterGroup & copyGroup, size_t & index){
+		copyGroup.setName(group.getName());
+		for(auto & parameter: group){
+			if(!isSnapshotted(*parameter)){
+				continue;
+			}
+			if(isGroup(*parameter)){
+				ofParameterGroup child;
+				copyGroup.add(child);
+				addCopies(static_cast<const ofParameterGroup&>(*parameter), child, index);
+				continue;
+			}
+			Field & field = fields[index++];
+			if(field.info){
+				field.copy = field.info->makeParameter(parameter->getName());
+			}else{
+				field.copy = makeParameter<string>(parameter->getName());
+			}
+			copyGroup.add(*field.copy);
+		}
+	}
+
+	ofParameterGroup & getCopy(){
+		if(!copied){
+			size_t index = 0;
+			addCopies(group, copy, index);
+			copied = true;
+		}
+		return copy;
+	}
+
+	ofParameterGroup group;
+	ofParameterGroup copy;
+	bool copied;
+	vector<Field> fields;
+	size_t valuesSize;
+	size_t numStrings;
+	uint64_t hash;
+};
+
+//---------------------------------------------------------------------------
+ofParameterSnapshot::ofParameterSnapshot()
+:schema(std::make_shared<Schema>()){}
+
+//---------------------------------------------------------------------------
+ofParameterSnapshot::ofParameterSnapshot(const ofParameterGroup & group){
+	setup(group);
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::setup(const ofParameterGroup & group){
+	schema = std::make_shared<Schema>();
+	schema->group = group;
+	schema->add(group);
+	values.assign(schema->valuesSize, 0);
+	strings.assign(schema->numStrings, "");
+	capture();
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::capture(){
+	for(auto & field: schema->fields){
+		switch(field.kind){
+		case StringValue:
+			strings[field.offset] = field.parameter->cast<string>().get();
+			break;
+		case TextValue:
+			strings[field.offset] = field.parameter->toString();
+			break;
+		default:
+			field.info->read(*field.parameter, values.data() + field.offset);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+size_t ofParameterSnapshot::restore(bool notify) const{
+	size_t changed = 0;
+	for(auto & field: schema->fields){
+		switch(field.kind){
+		case StringValue:{
+			ofParameter<string> & parameter = field.parameter->cast<string>();
+			if(parameter.get() != strings[field.offset]){
+				if(notify){
+					parameter.set(strings[field.offset]);
+				}else{
+					parameter.setWithoutEventNotifications(strings[field.offset]);
+				}
+				changed++;
+			}
+			break;
+		}
+		case TextValue:
+			if(field.parameter->toString() != strings[field.offset]){
+				field.parameter->fromString(strings[field.offset]);
+				changed++;
+			}
+			break;
+		default:
+			changed += field.info->write(*field.parameter, values.data() + field.offset, notify);
+		}
+	}
+	return changed;
+}
+
+//---------------------------------------------------------------------------
+uint64_t ofParameterSnapshot::getSchemaHash() const{
+	return schema->hash;
+}
+
+//---------------------------------------------------------------------------
+size_t ofParameterSnapshot::getNumParameters() const{
+	return schema->fields.size();
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::operator==(const ofParameterSnapshot & other) const{
+	return getSchemaHash() == other.getSchemaHash() && values == other.values && strings == other.strings;
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::operator!=(const ofParameterSnapshot & other) const{
+	return !(*this == other);
+}
+
+//---------------------------------------------------------------------------
+uint64_t ofParameterSnapshot::getValuesHash() const{
+	uint64_t h = hashBytes(hashSeed, values.data(), values.size());
+	for(auto & str: strings){
+		h = hashBytes(h, str.c_str(), str.size() + 1);
+	}
+	return h;
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::serialize(ofBuffer & buffer) const{
+	appendHeader(buffer, fullData, getSchemaHash());
+	append(buffer, uint32_t(values.size()));
+	buffer.append(values.data(), values.size());
+	append(buffer, uint32_t(strings.size()));
+	for(auto & str: strings){
+		appendString(buffer, str);
+	}
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::deserialize(const ofBuffer & buffer){
+	return deserialize(buffer.getData(), buffer.size());
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::deserialize(const char * data, size_t size){
+	return readData(data, size, false);
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::serializeDelta(const ofParameterSnapshot & previous, ofBuffer & delta) const{
+	if(previous.getSchemaHash() != getSchemaHash()){
+		ofLogError("ofParameterSnapshot") << "serializeDelta(): the previous snapshot has a different schema, serializing all the values";
+		serialize(delta);
+		return;
+	}
+	appendHeader(delta, deltaData, getSchemaHash());
+	append(delta, previous.getValuesHash());
+	size_t countPosition = delta.size();
+	append(delta, uint32_t(0));
+	uint32_t count = 0;
+	uint32_t last = 0;
+	auto & fields = schema->fields;
+	for(uint32_t i = 0; i < fields.size(); i++){
+		auto & field = fields[i];
+		if(field.info){
+			const char * value = values.data() + field.offset;
+			if(memcmp(value, previous.values.data() + field.offset, field.info->size) == 0){
+				continue;
+			}
+			appendIndex(delta, i - last);
+			delta.append(value, field.info->size);
+		}else{
+			if(strings[field.offset] == previous.strings[field.offset]){
+				continue;
+			}
+			appendIndex(delta, i - last);
+			appendString(delta, strings[field.offset]);
+		}
+		last = i;
+		count++;
+	}
+	memcpy(delta.getData() + countPosition, &count, sizeof(count));
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::deserializeDelta(const ofBuffer & delta){
+	return deserializeDelta(delta.getData(), delta.size());
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::deserializeDelta(const char * data, size_t size){
+	return readData(data, size, true);
+}
+
+//---------------------------------------------------------------------------
+bool ofParameterSnapshot::readData(const char * data, size_t size, bool allowDelta){
+	Reader header{data, data + size};
+	char dataMagic[4];
+	uint8_t dataVersion, type;
+	uint16_t reserved;
+	uint64_t schemaHash;
+	if(!header.read(dataMagic, 4) || memcmp(dataMagic, magic, 4) != 0
+			|| !header.read(dataVersion) || !header.read(type) || !header.read(reserved) || !header.read(schemaHash)){
+		ofLogError("ofParameterSnapshot") << "the data isn't a parameter snapshot";
+		return false;
+	}
+	if(dataVersion != version || (type != fullData && (type != deltaData || !allowDelta))){
+		ofLogError("ofParameterSnapshot") << "unsupported snapshot data, version " << int(dataVersion) << " type " << int(type);
+		return false;
+	}
+	if(schemaHash != getSchemaHash()){
+		ofLogError("ofParameterSnapshot") << "the snapshot data is from a group with different parameters";
+		return false;
+	}
+
+	auto & fields = schema->fields;
+	if(type == fullData){
+		// checks the whole data before changing anything so corrupt data
+		// doesn't leave the snapshot half written
+		Reader reader = header;
+		uint32_t valuesSize, numStrings;
+		bool valid = reader.read(valuesSize) && valuesSize == values.size() && reader.skip(valuesSize)
+				&& reader.read(numStrings) && numStrings == strings.size();
+		for(uint32_t i = 0; valid && i < numStrings; i++){
+			valid = reader.readString(nullptr);
+		}
+		if(!valid){
+			ofLogError("ofParameterSnapshot") << "corrupt snapshot data";
+			return false;
+		}
+		reader = header;
+		reader.skip(sizeof(valuesSize));
+		reader.read(values.data(), values.size());
+		reader.skip(sizeof(numStrings));
+		for(auto & str: strings){
+			reader.readString(&str);
+		}
+		return true;
+	}
+
+	uint64_t valuesHash;
+	uint32_t count;
+	if(!header.read(valuesHash) || !header.read(count)){
+		ofLogError("ofParameterSnapshot") << "corrupt snapshot data";
+		return false;
+	}
+	if(valuesHash != getValuesHash()){
+		ofLogError("ofParameterSnapshot") << "the delta was made against different values";
+		return false;
+	}
+	for(int apply = 0; apply < 2; apply++){
+		Reader reader = header;
+		size_t index = 0;
+		for(uint32_t i = 0; i < count; i++){
+			uint32_t step;
+			if(!reader.readIndex(step) || index + step >= fields.size() || (i > 0 && step == 0)){
+				ofLogError("ofParameterSnapshot") << "corrupt snapshot data";
+				return false;
+			}
+			index += step;
+			auto & field = fields[index];
+			bool valid;
+			if(field.info){
+				valid = apply ? reader.read(values.data() + field.offset, field.info->size) : reader.skip(field.info->size);
+			}else{
+				valid = reader.readString(apply ? &strings[field.offset] : nullptr);
+			}
+			if(!valid){
+				ofLogError("ofParameterSnapshot") << "corrupt snapshot data";
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::saveTo(ofBaseSerializer & serializer) const{
+	ofParameterGroup & copy = schema->getCopy();
+	for(auto & field: schema->fields){
+		if(field.info){
+			field.info->write(*field.copy, values.data() + field.offset, false);
+		}else{
+			field.copy->cast<string>().setWithoutEventNotifications(strings[field.offset]);
+		}
+	}
+	serializer.serialize(copy);
+}
+
+//---------------------------------------------------------------------------
+void ofParameterSnapshot::loadFrom(ofBaseSerializer & serializer){
+	ofParameterGroup & copy = schema->getCopy();
+	// values that aren't in the file keep the ones of the snapshot
+	for(auto & field: schema->fields){
+		if(field.info){
+			field.info->write(*field.copy, values.data() + field.offset, false);
+		}else{
+			field.copy->cast<string>().setWithoutEventNotifications(strings[field.offset]);
+		}
+	}
+	serializer.deserialize(copy);
+	for(auto & field: schema->fields){
+		if(field.info){
+			field.info->read(*field.copy, values.data() + field.offset);
+		}else{
+			strings[field.offset] = field.copy->cast<string>().get();
+		}
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ofParameter.h"
+#include "ofFileUtils.h"
+
+class ofBaseSerializer;
+
+/// \brief A copy of the values of an ofParameterGroup kept in a flat binary
+/// blob, to store presets, scrub through them or send them over the network.
+///
+/// Serializing a group with ofXml converts every value to a string and
+/// builds a DOM tree, which is too slow to do for thousands of parameters
+/// every frame. A snapshot instead reads the structure of the group once in
+/// setup() and then copies the values of numeric, vector and color
+/// parameters as they are in memory:
+///
+/// ~~~~{.cpp}
+/// ofParameterSnapshot current(parameters);
+/// ofParameterSnapshot previous = current;
+///
+/// // every frame in the sender
+/// current.capture();
+/// current.serializeDelta(previous, buffer);
+/// previous = current;
+///
+/// // every frame in the receiver
+/// if(received.deserializeDelta(buffer)){
+///     received.restore();
+/// }
+/// ~~~~
+///
+/// Parameters of other types, including strings, are kept as text. Only
+/// serializable parameters are part of the snapshot, as with ofXml, and
+/// read only parameters are left out since they can't be restored.
+///
+/// Snapshots of the same group share its structure so copying them only
+/// copies the values. Once the sizes of the strings have been reached,
+/// capturing, restoring and serializing the fixed size values don't
+/// allocate any memory.
+///
+/// The binary data is in the byte order of the machine, which is little
+/// endian in every platform openFrameworks supports, and can only be read
+/// by a snapshot of a group with the same names and types of parameters,
+/// something that is checked with the hash of its schema.
+class ofParameterSnapshot{
+public:
+	ofParameterSnapshot();
+	ofParameterSnapshot(const ofParameterGroup & group);
+
+	/// \brief Reads the structure of the group and captures its current
+	/// values.
+	///
+	/// Parameters added to the group later aren't part of the snapshot
+	/// until setup() is called again.
+	void setup(const ofParameterGroup & group);
+
+	/// \brief Copies the current values of the parameters to the snapshot.
+	void capture();
+
+	/// \brief Sets the parameters to the values of the snapshot.
+	///
+	/// Only parameters with a different value are set, so listeners aren't
+	/// notified of values that didn't change.
+	///
+	/// \param notify false to set the values without notifying the
+	/// listeners. Parameters stored as text, other than strings, always
+	/// notify since they can only be set through fromString().
+	/// \returns The number of parameters that changed.
+	size_t restore(bool notify = true) const;
+
+	/// \returns A hash of the names and types of the parameters, snapshots
+	/// with the same hash can read each other's data.
+	uint64_t getSchemaHash() const;
+
+	/// \returns The number of parameters in the snapshot, not counting the
+	/// groups.
+	size_t getNumParameters() const;
+
+	/// \returns Whether two snapshots of the same schema have the same
+	/// values.
+	bool operator==(const ofParameterSnapshot & other) const;
+	bool operator!=(const ofParameterSnapshot & other) const;
+
+	/// \brief Writes the schema hash and all the values to the buffer,
+	/// reusing its memory.
+	void serialize(ofBuffer & buffer) const;
+
+	/// \brief Reads the values written by serialize() without changing the
+	/// parameters, call restore() to set them.
+	/// \returns false if the data is corrupt or from a different schema.
+	bool deserialize(const ofBuffer & buffer);
+	bool deserialize(const char * data, size_t size);
+
+	/// \brief Writes only the values that changed since a previous snapshot
+	/// of the same schema.
+	void serializeDelta(const ofParameterSnapshot & previous, ofBuffer & delta) const;
+
+	/// \brief Applies a delta written by serializeDelta() to a snapshot with
+	/// the values of the previous snapshot, without changing the parameters.
+	///
+	/// Full snapshots written by serialize() are read too, so they can be
+	/// sent from time to time to recover from lost deltas.
+	/// \returns false if the data is corrupt, from a different schema or
+	/// this snapshot doesn't have the values the delta was made against.
+	bool deserializeDelta(const ofBuffer & delta);
+	bool deserializeDelta(const char * data, size_t size);
+
+	/// \brief Writes the values of the snapshot with any serializer, like
+	/// ofXml, in the same format it uses for the group so presets can
+	/// still be edited by hand.
+	void saveTo(ofBaseSerializer & serializer) const;
+
+	/// \brief Reads the values saved with a serializer, or written by it
+	/// for the group, without changing the parameters.
+	void loadFrom(ofBaseSerializer & serializer);
+
+private:
+	class Schema;
+	shared_ptr<Schema> schema;
+	vector<char> values;
+	vector<string> strings;
+
+	uint64_t getValuesHash() const;
+	bool readData(const char * data, size_t size, bool allowDelta);
+};
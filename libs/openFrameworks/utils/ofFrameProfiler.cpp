@@ -0,0 +1,427 @@
+#include "ofFrameProfiler.h"
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <thread>
+#include <map>
+#include <algorithm>
+#include <iomanip>
+
+#define NANOS_PER_SEC 1000000000
+#define NANOS_TO_SEC .000000001
+
+void ofGetMonotonicTime(uint64_t & seconds, uint64_t & nanoseconds);
+
+std::atomic<bool> of::priv::frameProfilerEnabled(false);
+
+//--------------------------------------------------------------
+// the scopes of one thread, which is the only one writing them.
+// readers copy them without locking and then discard the ones
+// that the thread might have overwritten while they were copied
+class ofFrameProfiler::ThreadBuffer{
+public:
+	struct Scope{
+		std::atomic<const char*> name;
+		std::atomic<const char*> category;
+		std::atomic<uint64_t> start;
+		std::atomic<uint64_t> end;
+	};
+
+	struct Copy{
+		const char * name;
+		const char * category;
+		uint64_t start;
+		uint64_t end;
+	};
+
+	ThreadBuffer(size_t size, size_t id)
+	:scopes(new Scope[size])
+	,mask(size - 1)
+	,claimed(0)
+	,written(0)
+	,id(id)
+	,threadId(std::this_thread::get_id())
+	,inUse(false)
+	,isMain(false){}
+
+	void push(const char * name, const char * category, uint64_t start, uint64_t end){
+		auto next = written.load(std::memory_order_relaxed);
+		claimed.store(next + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		auto & scope = scopes[next & mask];
+		scope.name.store(name, std::memory_order_relaxed);
+		scope.category.store(category, std::memory_order_relaxed);
+		scope.start.store(start, std::memory_order_relaxed);
+		scope.end.store(end, std::memory_order_relaxed);
+		written.store(next + 1, std::memory_order_release);
+	}
+
+	vector<Copy> read(uint64_t since) const{
+		uint64_t size = mask + 1;
+		auto end = written.load(std::memory_order_acquire);
+		auto begin = end > size ? end - size : 0;
+		vector<Copy> copies;
+		copies.reserve(end - begin);
+		for(auto i = begin; i < end; i++){
+			auto & scope = scopes[i & mask];
+			copies.push_back({
+				scope.name.load(std::memory_order_relaxed),
+				scope.category.load(std::memory_order_relaxed),
+				scope.start.load(std::memory_order_relaxed),
+				scope.end.load(std::memory_order_relaxed),
+			});
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// scopes the thread started writing again while copying
+		auto firstValid = claimed.load(std::memory_order_relaxed);
+		firstValid = firstValid > size ? firstValid - size : 0;
+		if(firstValid > begin){
+			copies.erase(copies.begin(), copies.begin() + std::min(firstValid - begin, end - begin));
+		}
+		copies.erase(std::remove_if(copies.begin(), copies.end(), [&](const Copy & copy){
+			return copy.end < since;
+		}), copies.end());
+		return copies;
+	}
+
+	unique_ptr<Scope[]> scopes;
+	uint64_t mask;
+	std::atomic<uint64_t> claimed;
+	std::atomic<uint64_t> written;
+	size_t id;
+	std::thread::id threadId;
+	std::atomic<bool> inUse;
+	std::atomic<bool> isMain;
+};
+
+//--------------------------------------------------------------
+ofFrameProfiler::ofFrameProfiler()
+:threadBufferSize(16384)
+,resetNanos(0)
+,hitchNanos(NANOS_PER_SEC / 30)
+,numFrames(0)
+,numHitches(0)
+,maxFrameNanos(0){
+	for(auto & bucket: histogram){
+		bucket.store(0);
+	}
+}
+
+//--------------------------------------------------------------
+ofFrameProfiler & ofGetFrameProfiler(){
+	static ofFrameProfiler * profiler = new ofFrameProfiler;
+	return *profiler;
+}
+
+//--------------------------------------------------------------
+uint64_t ofFrameProfiler::getTimeNanos(){
+	uint64_t seconds, nanos;
+	ofGetMonotonicTime(seconds, nanos);
+	return seconds * NANOS_PER_SEC + nanos;
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::enable(){
+	if(resetNanos.load() == 0){
+		resetNanos = getTimeNanos();
+	}
+	of::priv::frameProfilerEnabled = true;
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::disable(){
+	of::priv::frameProfilerEnabled = false;
+}
+
+//--------------------------------------------------------------
+bool ofFrameProfiler::isEnabled() const{
+	return of::priv::frameProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::reset(){
+	resetNanos = getTimeNanos();
+	numFrames = 0;
+	numHitches = 0;
+	maxFrameNanos = 0;
+	for(auto & bucket: histogram){
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::setHitchThreshold(double secs){
+	hitchNanos = secs * NANOS_PER_SEC;
+}
+
+//--------------------------------------------------------------
+double ofFrameProfiler::getHitchThreshold() const{
+	return hitchNanos.load() * NANOS_TO_SEC;
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::setThreadBufferSize(size_t scopes){
+	// rounded up to a power of 2 to wrap around with a mask
+	size_t size = 1;
+	while(size < scopes){
+		size *= 2;
+	}
+	std::unique_lock<std::mutex> lock(buffersMutex);
+	threadBufferSize = size;
+}
+
+//--------------------------------------------------------------
+uint64_t ofFrameProfiler::getNumFrames() const{
+	return numFrames.load();
+}
+
+//--------------------------------------------------------------
+uint64_t ofFrameProfiler::getNumHitches() const{
+	return numHitches.load();
+}
+
+//--------------------------------------------------------------
+double ofFrameProfiler::getMaxFrameTime() const{
+	return maxFrameNanos.load() * NANOS_TO_SEC;
+}
+
+//--------------------------------------------------------------
+double ofFrameProfiler::getFrameTimePercentile(double percent) const{
+	auto frames = getFrameTimeHistogram();
+	uint64_t total = 0;
+	for(auto count: frames){
+		total += count;
+	}
+	if(total == 0){
+		return 0;
+	}
+
+	uint64_t rank = std::max<uint64_t>(1, ceil(std::max(0., std::min(100., percent)) / 100. * total));
+	uint64_t accumulated = 0;
+	size_t i = 0;
+	for(; i < frames.size(); i++){
+		accumulated += frames[i];
+		if(accumulated >= rank){
+			break;
+		}
+	}
+	if(accumulated < rank || i == numBuckets - 1){
+		return getMaxFrameTime();
+	}
+	// the end of the bucket, never more than the longest frame
+	return std::min<uint64_t>((i + 1) * bucketNanos, maxFrameNanos.load()) * NANOS_TO_SEC;
+}
+
+//--------------------------------------------------------------
+vector<uint64_t> ofFrameProfiler::getFrameTimeHistogram() const{
+	vector<uint64_t> frames(numBuckets);
+	for(size_t i = 0; i < numBuckets; i++){
+		frames[i] = histogram[i].load(std::memory_order_relaxed);
+	}
+	return frames;
+}
+
+//--------------------------------------------------------------
+double ofFrameProfiler::getHistogramBucketWidth() const{
+	return bucketNanos * NANOS_TO_SEC;
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::newFrame(uint64_t frameNanos){
+	if(!isEnabled()){
+		return;
+	}
+
+	auto bucket = std::min<uint64_t>(frameNanos / bucketNanos, numBuckets - 1);
+	histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+	numFrames.fetch_add(1, std::memory_order_relaxed);
+	if(frameNanos > hitchNanos.load(std::memory_order_relaxed)){
+		numHitches.fetch_add(1, std::memory_order_relaxed);
+	}
+	auto max = maxFrameNanos.load(std::memory_order_relaxed);
+	while(frameNanos > max && !maxFrameNanos.compare_exchange_weak(max, frameNanos, std::memory_order_relaxed));
+
+	auto & buffer = getThreadBuffer();
+	buffer.isMain.store(true, std::memory_order_relaxed);
+	auto now = getTimeNanos();
+	buffer.push("frame", "frame", now - std::min(now, frameNanos), now);
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::record(const char * name, const char * category, uint64_t startNanos, uint64_t endNanos){
+	if(!isEnabled()){
+		return;
+	}
+	getThreadBuffer().push(name, category, startNanos, endNanos);
+}
+
+//--------------------------------------------------------------
+#if HAS_TLS && !defined(TARGET_EMSCRIPTEN)
+namespace{
+	// gives the buffer of a thread back to the profiler when it ends,
+	// so threads created later reuse it instead of allocating another
+	struct ThreadBufferOwner{
+		std::atomic<bool> * inUse = nullptr;
+		~ThreadBufferOwner(){
+			if(inUse){
+				inUse->store(false);
+			}
+		}
+	};
+}
+#endif
+
+//--------------------------------------------------------------
+ofFrameProfiler::ThreadBuffer & ofFrameProfiler::getThreadBuffer(){
+#if HAS_TLS && !defined(TARGET_EMSCRIPTEN)
+	// the buffer of every thread is only looked up the first time
+	static thread_local ThreadBuffer * threadBuffer = nullptr;
+	static thread_local ThreadBufferOwner owner;
+	if(threadBuffer){
+		return *threadBuffer;
+	}
+
+	std::unique_lock<std::mutex> lock(buffersMutex);
+	auto found = std::find_if(buffers.begin(), buffers.end(), [&](const shared_ptr<ThreadBuffer> & buffer){
+		return !buffer->inUse && buffer->mask + 1 == threadBufferSize;
+	});
+#else
+	// without thread local storage it's looked up every time
+	std::unique_lock<std::mutex> lock(buffersMutex);
+	auto id = std::this_thread::get_id();
+	auto found = std::find_if(buffers.begin(), buffers.end(), [&](const shared_ptr<ThreadBuffer> & buffer){
+		return buffer->threadId == id;
+	});
+#endif
+	if(found == buffers.end()){
+		buffers.push_back(make_shared<ThreadBuffer>(threadBufferSize, buffers.size()));
+		found = buffers.end() - 1;
+	}
+	auto & buffer = **found;
+	buffer.threadId = std::this_thread::get_id();
+	buffer.inUse = true;
+#if HAS_TLS && !defined(TARGET_EMSCRIPTEN)
+	buffer.isMain = false;
+	threadBuffer = &buffer;
+	owner.inUse = &buffer.inUse;
+#endif
+	return buffer;
+}
+
+//--------------------------------------------------------------
+vector<shared_ptr<ofFrameProfiler::ThreadBuffer>> ofFrameProfiler::getThreadBuffers() const{
+	std::unique_lock<std::mutex> lock(buffersMutex);
+	return buffers;
+}
+
+//--------------------------------------------------------------
+vector<ofFrameProfiler::ScopeStats> ofFrameProfiler::getScopeStats() const{
+	map<string, ScopeStats> statsByName;
+	auto since = resetNanos.load();
+	for(auto & buffer: getThreadBuffers()){
+		for(auto & scope: buffer->read(since)){
+			if(strcmp(scope.category, "frame") == 0){
+				continue;
+			}
+			auto & stats = statsByName[scope.name];
+			double secs = (scope.end - scope.start) * NANOS_TO_SEC;
+			stats.count++;
+			stats.totalSecs += secs;
+			stats.maxSecs = std::max(stats.maxSecs, secs);
+		}
+	}
+
+	vector<ScopeStats> allStats;
+	for(auto & named: statsByName){
+		auto stats = named.second;
+		stats.name = named.first;
+		stats.averageSecs = stats.totalSecs / stats.count;
+		allStats.push_back(stats);
+	}
+	std::sort(allStats.begin(), allStats.end(), [](const ScopeStats & a, const ScopeStats & b){
+		return a.totalSecs > b.totalSecs;
+	});
+	return allStats;
+}
+
+//--------------------------------------------------------------
+string ofFrameProfiler::getSummary() const{
+	auto millis = [](double secs){
+		return secs * 1000.;
+	};
+	ostringstream summary;
+	summary << std::fixed << std::setprecision(2);
+	summary << getNumFrames() << " frames, " << getNumHitches() << " hitches longer than " << millis(getHitchThreshold()) << "ms" << endl;
+	summary << "frame time p50 " << millis(getFrameTimePercentile(50)) << "ms";
+	summary << ", p95 " << millis(getFrameTimePercentile(95)) << "ms";
+	summary << ", p99 " << millis(getFrameTimePercentile(99)) << "ms";
+	summary << ", max " << millis(getMaxFrameTime()) << "ms";
+	for(auto & stats: getScopeStats()){
+		summary << endl << stats.name << ": " << millis(stats.averageSecs) << "ms average, ";
+		summary << millis(stats.maxSecs) << "ms max, " << stats.count << " times";
+	}
+	return summary.str();
+}
+
+//--------------------------------------------------------------
+static void writeJsonString(ostream & out, const char * str){
+	out << '"';
+	for(; *str; str++){
+		switch(*str){
+		case '"': out << "\\\""; break;
+		case '\\': out << "\\\\"; break;
+		case '\n': out << "\\n"; break;
+		case '\t': out << "\\t"; break;
+		default:
+			if((unsigned char)*str < 0x20){
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(*str) << std::dec << std::setfill(' ');
+			}else{
+				out << *str;
+			}
+		}
+	}
+	out << '"';
+}
+
+//--------------------------------------------------------------
+void ofFrameProfiler::writeChromeTrace(ostream & out) const{
+	auto since = resetNanos.load();
+	auto flags = out.flags();
+	auto precision = out.precision();
+	out << std::fixed << std::setprecision(3);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for(auto & buffer: getThreadBuffers()){
+		if(!first){
+			out << ",";
+		}
+		first = false;
+		out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->id;
+		out << ",\"args\":{\"name\":\"" << (buffer->isMain ? "main" : "thread " + ofToString(buffer->id)) << "\"}}";
+		for(auto & scope: buffer->read(since)){
+			// times in microseconds since the profiler was reset
+			out << ",\n{\"name\":";
+			writeJsonString(out, scope.name);
+			out << ",\"cat\":";
+			writeJsonString(out, scope.category);
+			out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id;
+			out << ",\"ts\":" << (scope.start - since) / 1000.;
+			out << ",\"dur\":" << (scope.end - scope.start) / 1000. << "}";
+		}
+	}
+	out << "\n]}\n";
+	out.flags(flags);
+	out.precision(precision);
+}
+
+//--------------------------------------------------------------
+bool ofFrameProfiler::saveChromeTrace(const string & path) const{
+	ofFile file(path, ofFile::WriteOnly);
+	if(!file.is_open()){
+		ofLogError("ofFrameProfiler") << "couldn't save the trace, \"" << file.getFileName() << "\" can't be opened";
+		return false;
+	}
+	writeChromeTrace(file);
+	return !file.bad();
+}
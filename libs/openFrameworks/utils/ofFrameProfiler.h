@@ -0,0 +1,170 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <atomic>
+#include <mutex>
+
+/// \brief Records how long frames take and where that time goes.
+///
+/// ofGetFrameRate() only reports a smoothed average, which hides the frames
+/// that take much longer than the rest. Once enabled, the profiler keeps a
+/// histogram of the time of every frame, measured by the ofFpsCounter of the
+/// core events, and the duration of the setup, update, draw, wait and events
+/// phases of the main loop, plus any scope marked with OF_PROFILE_SCOPE:
+///
+/// ~~~~{.cpp}
+/// void ofApp::setup(){
+///     ofGetFrameProfiler().enable();
+/// }
+///
+/// void ofApp::update(){
+///     OF_PROFILE_SCOPE("particles");
+///     particles.update();
+/// }
+///
+/// void ofApp::exit(){
+///     ofLogNotice() << ofGetFrameProfiler().getSummary();
+///     ofGetFrameProfiler().saveChromeTrace("trace.json");
+/// }
+/// ~~~~
+///
+/// Every thread records its scopes in its own ring buffer without locking,
+/// keeping the most recent ones, so scopes can be used from worker threads
+/// too. The trace can be opened in chrome://tracing or ui.perfetto.dev.
+///
+/// While disabled, which is the default, a scope only checks a flag, so
+/// they can be left in the code. Scope names aren't copied and have to
+/// outlive the profiler, usually they are string literals.
+///
+/// The setup phase is only recorded if the profiler is enabled before
+/// ofRunApp. With several windows every window's draw ends a frame.
+class ofFrameProfiler{
+public:
+	/// \brief The durations recorded for one scope name.
+	struct ScopeStats{
+		string name;
+		/// \brief Times the scope was recorded.
+		uint64_t count;
+		double totalSecs;
+		double averageSecs;
+		double maxSecs;
+	};
+
+	void enable();
+	void disable();
+	bool isEnabled() const;
+
+	/// \brief Forgets the frames and scopes recorded so far.
+	void reset();
+
+	/// \brief Frames longer than this are counted as hitches, 1/30s by
+	/// default, twice the time of a frame at 60fps.
+	void setHitchThreshold(double secs);
+	double getHitchThreshold() const;
+
+	/// \brief Number of scopes every thread keeps, the oldest are
+	/// overwritten. Only affects threads that haven't recorded anything yet.
+	void setThreadBufferSize(size_t scopes);
+
+	uint64_t getNumFrames() const;
+	uint64_t getNumHitches() const;
+	double getMaxFrameTime() const;
+
+	/// \returns The time in seconds that this percentage of the frames,
+	/// from 0 to 100, took at most, so 99 returns the p99 frame time.
+	/// The precision is that of the histogram buckets.
+	double getFrameTimePercentile(double percent) const;
+
+	/// \returns The number of frames in every bucket of the histogram, the
+	/// last bucket has all the frames longer than the rest.
+	vector<uint64_t> getFrameTimeHistogram() const;
+	double getHistogramBucketWidth() const;
+
+	/// \returns The stats of every scope name, core phases included, from
+	/// the scopes still in the ring buffers, sorted by total time.
+	vector<ScopeStats> getScopeStats() const;
+
+	/// \returns The frame time percentiles and the average time of every
+	/// scope in a few lines, to log them.
+	string getSummary() const;
+
+	/// \brief Writes the scopes in the ring buffers in the Chrome trace
+	/// event format.
+	void writeChromeTrace(ostream & out) const;
+	bool saveChromeTrace(const string & path) const;
+
+	/// \brief Ends a frame that took frameNanos, called by the core events
+	/// after every draw.
+	void newFrame(uint64_t frameNanos);
+
+	/// \brief Records a scope, usually through OF_PROFILE_SCOPE or
+	/// ofProfileScope. Times are in nanoseconds of the monotonic clock.
+	void record(const char * name, const char * category, uint64_t startNanos, uint64_t endNanos);
+
+	static uint64_t getTimeNanos();
+
+private:
+	ofFrameProfiler();
+	ofFrameProfiler(const ofFrameProfiler &) = delete;
+	ofFrameProfiler & operator=(const ofFrameProfiler &) = delete;
+	friend ofFrameProfiler & ofGetFrameProfiler();
+
+	class ThreadBuffer;
+	ThreadBuffer & getThreadBuffer();
+	vector<shared_ptr<ThreadBuffer>> getThreadBuffers() const;
+
+	static const size_t numBuckets = 2000;
+	static const uint64_t bucketNanos = 50000;
+
+	mutable std::mutex buffersMutex;
+	vector<shared_ptr<ThreadBuffer>> buffers;
+	size_t threadBufferSize;
+	std::atomic<uint64_t> resetNanos;
+	std::atomic<uint64_t> hitchNanos;
+	std::atomic<uint64_t> numFrames;
+	std::atomic<uint64_t> numHitches;
+	std::atomic<uint64_t> maxFrameNanos;
+	std::atomic<uint64_t> histogram[numBuckets];
+};
+
+/// \brief The profiler of the application.
+ofFrameProfiler & ofGetFrameProfiler();
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// checked by the scopes before doing anything else
+	extern std::atomic<bool> frameProfilerEnabled;
+}
+}
+/*! \endcond */
+
+/// \brief Records the time between its construction and destruction in the
+/// frame profiler, if it's enabled.
+class ofProfileScope{
+public:
+	ofProfileScope(const char * name, const char * category = "scope")
+	:name(name)
+	,category(category)
+	,start(of::priv::frameProfilerEnabled.load(std::memory_order_relaxed) ? ofFrameProfiler::getTimeNanos() : 0){}
+
+	~ofProfileScope(){
+		if(start){
+			ofGetFrameProfiler().record(name, category, start, ofFrameProfiler::getTimeNanos());
+		}
+	}
+
+private:
+	ofProfileScope(const ofProfileScope &) = delete;
+	ofProfileScope & operator=(const ofProfileScope &) = delete;
+	const char * name;
+	const char * category;
+	uint64_t start;
+};
+
+#define OF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OF_PROFILE_CONCAT(a, b) OF_PROFILE_CONCAT_IMPL(a, b)
+
+/// \brief Records the time until the end of the enclosing scope with a name,
+/// which has to be a string literal or outlive the profiler.
+#define OF_PROFILE_SCOPE(name) ofProfileScope OF_PROFILE_CONCAT(ofProfileScope_, __LINE__)(name)
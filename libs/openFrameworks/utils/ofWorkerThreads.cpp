@@ -0,0 +1,110 @@
+#include "ofWorkerThreads.h"
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace{
+	struct Job{
+		Job(int numTasks, const std::function<void(int)> & f)
+		:f(f)
+		,numTasks(numTasks)
+		,nextTask(0)
+		,pendingTasks(numTasks){}
+
+		const std::function<void(int)> & f;
+		int numTasks;
+		// both guarded by the pool mutex, a job is alive while it has
+		// pending tasks so it's only accessed while starting or finishing one
+		int nextTask;
+		int pendingTasks;
+	};
+
+	class WorkerPool{
+	public:
+		~WorkerPool(){
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			workAvailable.notify_all();
+			for(auto & thread: threads){
+				thread.join();
+			}
+		}
+
+		void run(int numTasks, const std::function<void(int)> & f){
+			Job job(numTasks, f);
+			std::unique_lock<std::mutex> lock(mutex);
+			while(int(threads.size()) < numTasks - 1){
+				threads.emplace_back(&WorkerPool::work, this);
+			}
+			jobs.push_back(&job);
+			workAvailable.notify_all();
+
+			// the calling thread runs tasks too, so the job finishes even if
+			// the workers are busy with other jobs or this is called from one
+			while(job.nextTask < job.numTasks){
+				runNextTask(lock, job);
+			}
+			jobDone.wait(lock, [&]{ return job.pendingTasks == 0; });
+		}
+
+	private:
+		// called with the mutex locked, returns with it locked
+		void runNextTask(std::unique_lock<std::mutex> & lock, Job & job){
+			int task = job.nextTask++;
+			if(job.nextTask == job.numTasks){
+				jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+			}
+			lock.unlock();
+			job.f(task);
+			lock.lock();
+			if(--job.pendingTasks == 0){
+				jobDone.notify_all();
+			}
+		}
+
+		void work(){
+			std::unique_lock<std::mutex> lock(mutex);
+			while(true){
+				workAvailable.wait(lock, [this]{ return stopping || !jobs.empty(); });
+				if(stopping){
+					return;
+				}
+				runNextTask(lock, *jobs.front());
+			}
+		}
+
+		std::mutex mutex;
+		std::condition_variable workAvailable;
+		std::condition_variable jobDone;
+		std::deque<Job*> jobs;
+		std::vector<std::thread> threads;
+		bool stopping = false;
+	};
+}
+
+//----------------------------------------------------------
+int of::priv::getNumWorkThreads(int numThreads, size_t maxThreads){
+#ifdef TARGET_EMSCRIPTEN
+	return 1;
+#else
+	if(numThreads <= 0){
+		numThreads = std::thread::hardware_concurrency();
+	}
+	return int(std::max<size_t>(std::min<size_t>(numThreads, maxThreads), 1));
+#endif
+}
+
+//----------------------------------------------------------
+void of::priv::runInWorkerThreads(int numTasks, const std::function<void(int)> & f){
+	if(numTasks <= 1){
+		if(numTasks == 1){
+			f(0);
+		}
+		return;
+	}
+	static WorkerPool pool;
+	pool.run(numTasks, f);
+}
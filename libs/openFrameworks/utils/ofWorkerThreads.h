@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <thread>
+#include <functional>
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// number of threads to split some work in, one per core if numThreads
+	// is 0 or less, at most maxThreads and at least 1. always 1 on emscripten
+	int getNumWorkThreads(int numThreads, size_t maxThreads);
+
+	// calls f(thread) for every thread in [0, numThreads) in new threads,
+	// the first one in the calling thread, and waits for all of them to
+	// finish. for work that is done once, like loading
+	template<typename Function>
+	void runInThreads(int numThreads, Function f){
+		std::vector<std::thread> threads;
+		for(int i = 1; i < numThreads; i++){
+			threads.emplace_back(f, i);
+		}
+		f(0);
+		for(auto & thread: threads){
+			thread.join();
+		}
+	}
+
+	// calls f(task) for every task in [0, numTasks) on worker threads that
+	// are started once and wait for more work afterwards, plus the calling
+	// thread, and waits for all of them to finish. for work done every frame
+	void runInWorkerThreads(int numTasks, const std::function<void(int)> & f);
+}
+}
+/*! \endcond */
@@ -1,24 +1,297 @@
 
 #include "ofXml.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/DOM/EventListener.h"
+#include "Poco/DOM/MutationEvent.h"
+#include <unordered_map>
+
+// paths like a/b[2]/c[@attr] are parsed once into steps and resolved by
+// walking the children, anything else is left to Poco. The nodes found
+// are remembered per path until a mutation event says the document
+// changed. If the document has its events suspended nothing is remembered
+// since there would be no way to know when it changes.
+class ofXml::PathCache: public Poco::XML::EventListener{
+public:
+	struct Step{
+		string name;
+		int index;
+	};
+
+	struct Path{
+		bool compiled = false;
+		vector<Step> steps;
+		string attribute;
+		vector<string> tokens;
+
+		// the last lookup
+		const Poco::XML::Node * from = nullptr;
+		Poco::XML::Node * node = nullptr;
+		uint64_t generation = 0;
+	};
+
+	~PathCache(){
+		detach();
+	}
+
+	void attach(Poco::XML::Document * document){
+		detach();
+		this->document = document;
+		if(document){
+			for(auto type: eventTypes()){
+				document->addEventListener(*type, this, true);
+			}
+		}
+		generation++;
+	}
+
+	void detach(){
+		if(document){
+			for(auto type: eventTypes()){
+				document->removeEventListener(*type, this, true);
+			}
+			document = nullptr;
+		}
+		generation++;
+	}
+
+	void handleEvent(Poco::XML::Event *){
+		generation++;
+	}
+
+	Path & get(const string & str){
+		auto it = paths.find(str);
+		if(it != paths.end()){
+			return it->second;
+		}
+		// paths built on the fly, like indices in a loop, would make the
+		// cache grow forever
+		if(paths.size() >= maxPaths){
+			paths.clear();
+		}
+		Path & path = paths[str];
+		path.compiled = compile(str, path);
+		path.tokens = ofXml::tokenize(str, "/");
+		return path;
+	}
+
+	Poco::XML::Node * find(const Poco::XML::Element * from, const string & str){
+		Path & path = get(str);
+		bool cacheable = document && document->events();
+		if(cacheable && path.from == from && path.generation == generation){
+			return path.node;
+		}
+		Poco::XML::Node * node;
+		if(path.compiled){
+			node = resolve(path, 0, const_cast<Poco::XML::Element*>(from));
+		}else{
+			node = from->getNodeByPath(str);
+		}
+		if(cacheable){
+			path.from = from;
+			path.node = node;
+			path.generation = generation;
+		}
+		return node;
+	}
+
+private:
+	static const vector<const Poco::XML::XMLString*> & eventTypes(){
+		// the only changes that can make a path lead to another node, text
+		// and attribute values are read from the nodes every time
+		static vector<const Poco::XML::XMLString*> types{
+			&Poco::XML::MutationEvent::DOMNodeInserted,
+			&Poco::XML::MutationEvent::DOMNodeRemoved,
+			&Poco::XML::MutationEvent::DOMAttrModified,
+		};
+		return types;
+	}
+
+	static bool isNameChar(char c){
+		return c != '/' && c != '[' && c != ']' && c != '@' && c != '=' && c != '*' && c != '\'' && c != '"' && c != '.';
+	}
+
+	// accepts name(/name)* where every name can have an [index] and the
+	// last one an [@attribute], or just [@attribute]
+	static bool compile(const string & str, Path & path){
+		size_t i = 0;
+		size_t n = str.size();
+		while(i < n){
+			if(str.compare(i, 2, "[@") == 0){
+				size_t close = str.find(']', i);
+				if(close != n - 1 || close == i + 2){
+					return false;
+				}
+				path.attribute = str.substr(i + 2, close - i - 2);
+				for(char c: path.attribute){
+					if(!isNameChar(c)){
+						return false;
+					}
+				}
+				return true;
+			}
+			size_t nameEnd = i;
+			while(nameEnd < n && isNameChar(str[nameEnd])){
+				nameEnd++;
+			}
+			if(nameEnd == i){
+				return false;
+			}
+			Step step{str.substr(i, nameEnd - i), 0};
+			i = nameEnd;
+			if(i < n && str[i] == '[' && i + 1 < n && str[i + 1] != '@'){
+				size_t close = str.find(']', i);
+				if(close == string::npos || close == i + 1){
+					return false;
+				}
+				for(size_t d = i + 1; d < close; d++){
+					if(!isdigit(str[d])){
+						return false;
+					}
+				}
+				step.index = ofToInt(str.substr(i + 1, close - i - 1));
+				i = close + 1;
+			}
+			path.steps.push_back(step);
+			if(i < n){
+				if(str[i] == '/'){
+					// a trailing / or // aren't simple paths
+					i++;
+					if(i == n || str[i] == '/'){
+						return false;
+					}
+				}else if(str[i] != '['){
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// the same search Poco does, when a name without an index matches
+	// several children the first one that contains the rest of the path
+	// is used
+	static Poco::XML::Node * resolve(const Path & path, size_t i, Poco::XML::Node * node){
+		if(i == path.steps.size()){
+			if(path.attribute.empty()){
+				return node;
+			}
+			if(node->nodeType() == Poco::XML::Node::ELEMENT_NODE){
+				return static_cast<Poco::XML::Element*>(node)->getAttributeNode(path.attribute);
+			}
+			return nullptr;
+		}
+		const Step & step = path.steps[i];
+		for(Poco::XML::Node * child = node->firstChild(); child; child = child->nextSibling()){
+			if(child->nodeType() != Poco::XML::Node::ELEMENT_NODE || child->nodeName() != step.name){
+				continue;
+			}
+			if(step.index > 0){
+				// the index counts from the first child with the name
+				int index = step.index;
+				for(Poco::XML::Node * sibling = child->nextSibling(); sibling; sibling = sibling->nextSibling()){
+					if(sibling->nodeType() == Poco::XML::Node::ELEMENT_NODE && sibling->nodeName() == step.name && --index == 0){
+						return resolve(path, i + 1, sibling);
+					}
+				}
+				return nullptr;
+			}
+			Poco::XML::Node * found = resolve(path, i + 1, child);
+			if(found){
+				return found;
+			}
+		}
+		return nullptr;
+	}
+
+	static const size_t maxPaths = 4096;
+	unordered_map<string, Path> paths;
+	Poco::XML::Document * document = nullptr;
+	uint64_t generation = 0;
+};
+
+namespace{
+	// removes the <#text> and </#text> tags the DOMWriter outputs for text
+	// nodes while passing everything else to another stream buffer
+	class TextTagFilter: public std::streambuf{
+	public:
+		TextTagFilter(std::streambuf * dst)
+		:dst(dst){}
+
+		~TextTagFilter(){
+			flushPending();
+		}
+
+		void flushPending(){
+			dst->sputn(pending.data(), pending.size());
+			pending.clear();
+		}
+
+	protected:
+		int overflow(int c){
+			if(c != EOF){
+				char ch = c;
+				xsputn(&ch, 1);
+			}
+			return c;
+		}
+
+		std::streamsize xsputn(const char * s, std::streamsize n){
+			const char * end = s + n;
+			while(s < end){
+				if(pending.empty()){
+					// copy everything up to the next tag that could match
+					const char * tag = std::find(s, end, '<');
+					dst->sputn(s, tag - s);
+					s = tag;
+					if(s == end){
+						break;
+					}
+				}
+				pending += *s++;
+				if(pending == open || pending == close){
+					pending.clear();
+				}else{
+					// not a tag, write up to where the next one could start
+					while(!pending.empty() && open.compare(0, pending.size(), pending) != 0 && close.compare(0, pending.size(), pending) != 0){
+						size_t next = std::min(pending.find('<', 1), pending.size());
+						dst->sputn(pending.data(), next);
+						pending.erase(0, next);
+					}
+				}
+			}
+			return n;
+		}
+
+	private:
+		std::streambuf * dst;
+		string pending;
+		const string open = "<#text>";
+		const string close = "</#text>";
+	};
+}
+
 
 ofXml::~ofXml() {
 	releaseAll();
 }
 
-ofXml::ofXml( const string & path ) {
+ofXml::ofXml( const string & path )
+:pathCache(new PathCache){
     document = new Poco::XML::Document(); // we create this so that they can be merged later
     element = document->documentElement();
+    pathCache->attach(document);
     load(path);
 }
 
-ofXml::ofXml( const ofXml& rhs ) {
+ofXml::ofXml( const ofXml& rhs )
+:pathCache(new PathCache){
 
     document = new Poco::XML::Document();
     Poco::XML::Node *n = document->importNode(rhs.getPocoDocument()->documentElement(), true);
     document->appendChild(n);
     
     element = document->documentElement();
+    pathCache->attach(document);
 }
 
 const ofXml& ofXml::operator =( const ofXml& rhs ) {
@@ -28,12 +301,15 @@ const ofXml& ofXml::operator =( const ofXml& rhs ) {
 
     document = (Poco::XML::Document*) rhs.document->cloneNode(true);
     element = document->documentElement();
+    pathCache->attach(document);
     return *this;
 }
 
-ofXml::ofXml() {
+ofXml::ofXml()
+:pathCache(new PathCache){
     document = new Poco::XML::Document(); // we create this so that they can be merged later
     element = document->documentElement();
+    pathCache->attach(document);
 }
 
 bool ofXml::load(const string & path){
@@ -47,9 +323,46 @@ bool ofXml::load(const string & path){
 }
 
 bool ofXml::save(const string & path){
-    ofBuffer buffer(toString());
     ofFile file(path, ofFile::WriteOnly);
-    return file.writeFromBuffer(buffer);
+    if(!file.is_open()) {
+        ofLogError("ofXml") << "couldn't save, \"" << file.getFileName() << "\" can't be opened";
+        return false;
+    }
+    return save(file);
+}
+
+bool ofXml::save(ostream & stream) const
+{
+    Poco::XML::DOMWriter writer;
+    writer.setOptions(Poco::XML::XMLWriter::PRETTY_PRINT);
+    TextTagFilter filter(stream.rdbuf());
+    ostream filtered(&filter);
+    if(document) {
+        try {
+            writer.writeNode( filtered, getPocoDocument() );
+        } catch( exception & e ) {
+            ofLogError("ofXml") << "save(): " << e.what();
+            return false;
+        }
+    } else if(element){
+        element->normalize();
+        writer.writeNode( filtered, element );
+    }
+    filter.flushPending();
+    return !stream.bad();
+}
+
+Poco::XML::Node * ofXml::findNode(const string & path) const
+{
+    if(!element) {
+        return nullptr;
+    }
+    return pathCache->find(element, path);
+}
+
+const vector<string> & ofXml::splitPath(const string & path) const
+{
+    return pathCache->get(path).tokens;
 }
 
 void ofXml::serialize(const ofAbstractParameter & parameter){
@@ -149,27 +462,8 @@ int ofXml::getNumChildren(const string& path) const
 string ofXml::toString() const
 {
     ostringstream stream;
-    
-    Poco::XML::DOMWriter writer;
-    writer.setOptions(Poco::XML::XMLWriter::PRETTY_PRINT);
-    if(document) {
-        try {
-            writer.writeNode( stream, getPocoDocument() );
-        } catch( exception & e ) {
-            ofLogError("ofXml") << "toString(): " << e.what();
-        }
-    } else if(element){
-        element->normalize();
-        writer.writeNode( stream, element );
-    }
-    
-    string tmp = stream.str();
-    
-    // don't know how else to get rid of the hidden <#text></#text> nodes :/
-    ofStringReplace(tmp, "<#text>", "");
-    ofStringReplace(tmp, "</#text>", "");
-    
-    return tmp;
+    save(stream);
+    return stream.str();
 }
 
 void ofXml::addXml( ofXml& xml, bool copyAll ) {
@@ -197,11 +491,7 @@ void ofXml::addXml( ofXml& xml, bool copyAll ) {
 
 bool ofXml::addChild( const string& path )
 {
-    vector<string> tokens;
-    
-    if(path.find('/') != string::npos) {
-        tokens = tokenize(path, "/");
-    }
+    const vector<string> & tokens = splitPath(path);
     
     // is this a tokenized tag?
     if(tokens.size() > 1) 
@@ -429,7 +719,7 @@ bool ofXml::setValue(const string& path, const string& value)
 {
     Poco::XML::Element *e;
     if(element) {
-        e = (Poco::XML::Element*) element->getNodeByPath(path);
+        e = (Poco::XML::Element*) findNode(path);
     } else {
         ofLogWarning("ofXml") << "setValue(): no element set yet";
         return false;
@@ -465,9 +755,9 @@ string ofXml::getAttribute(const string& path) const {
         if(path.find("[@") == string::npos) {
             // we need to create a proper path
             string attributePath = "[@" + path + "]";
-            e = element->getNodeByPath(attributePath);
+            e = findNode(attributePath);
         } else {
-            e = element->getNodeByPath(path);
+            e = findNode(path);
         }
     } else {
         ofLogWarning("ofXml") << "getAttribute(): no element set yet";
@@ -506,7 +796,7 @@ bool ofXml::removeAttribute(const string& path)
         }
         
         if(hasPath) {
-            e = (Poco::XML::Element*) element->getNodeByPath(pathToAttribute);
+            e = (Poco::XML::Element*) findNode(pathToAttribute);
         } else {
             e = element;
         }
@@ -538,9 +828,9 @@ bool ofXml::removeAttributes(const string& path)
         if(path.find("[@") == string::npos) {
             // we need to create a proper path
             string attributePath = "[@" + path + "]";
-            e = (Poco::XML::Element*) element->getNodeByPath(attributePath);
+            e = (Poco::XML::Element*) findNode(attributePath);
         } else {
-            e = (Poco::XML::Element*) element->getNodeByPath(path);
+            e = (Poco::XML::Element*) findNode(path);
         }
 
     } else {
@@ -601,7 +891,7 @@ bool ofXml::removeContents(const string& path) {
     
     Poco::XML::Element *e;
     if(element) {
-        e = (Poco::XML::Element*) element->getNodeByPath(path);
+        e = (Poco::XML::Element*) findNode(path);
     } else {
         ofLogWarning("ofXml") << "clearContents(): no element set yet";
         return false;
@@ -623,9 +913,11 @@ void ofXml::clear(){
 	releaseAll();
     document = new Poco::XML::Document(); // we create this so that they can be merged later
     element = document->documentElement();
+    pathCache->attach(document);
 }
 
 void ofXml::releaseAll(){
+    pathCache->detach();
     if(document) {
         document->release();
         document = 0;
@@ -638,7 +930,7 @@ bool ofXml::remove(const string& path) // works for both attributes and tags
 {
     Poco::XML::Node *node;
     if(element) {
-        node = element->getNodeByPath(path);
+        node = findNode(path);
     } else {
         ofLogWarning("ofXml") << "remove(): no element set yet";
         return false;
@@ -668,7 +960,7 @@ bool ofXml::exists(const string& path) const // works for both attributes and ta
 {
     Poco::XML::Node *node;
     if(element) {
-        node = element->getNodeByPath(path);
+        node = findNode(path);
     } else {
         return false;
     }
@@ -802,6 +1094,7 @@ bool ofXml::loadFromBuffer( const string& buffer )
     Poco::XML::DOMParser parser;
     
     // release and nullptr out if we already have a document
+    pathCache->detach();
     if(document) {
         document->release();
     }
@@ -810,17 +1103,20 @@ bool ofXml::loadFromBuffer( const string& buffer )
         document = parser.parseString(buffer);
     	element = (Poco::XML::Element*) document->firstChild();
     	document->normalize();
+    	pathCache->attach(document);
     	return true;
 	} catch( const Poco::XML::SAXException & e ) {
 		ofLogError("ofXml") << "parse error: " << e.message();
         document = new Poco::XML::Document;
         element = document->documentElement();
+        pathCache->attach(document);
         return false;
     } catch( const exception & e ) {
         short msg = atoi(e.what());
         ofLogError("ofXml") << "parse error: " << DOMErrorMessage(msg);
         document = new Poco::XML::Document;
         element = document->documentElement();
+        pathCache->attach(document);
         return false;
     }
 }
@@ -914,7 +1210,7 @@ bool ofXml::setTo(const string& path)
     } else {
         // another: we're actually looking down into the thing :)
         Poco::XML::Element* prev = element;
-        element = (Poco::XML::Element*) element->getNodeByPath(path);
+        element = (Poco::XML::Element*) findNode(path);
         if(!element) {
             element = prev;
             ofLogWarning("ofXml") << "setCurrentElement(): passed invalid path \"" << path << "\"";
@@ -944,7 +1240,7 @@ Poco::XML::Element* ofXml::getPocoElement(const string& path)
     }
     
     if(element) {
-        return (Poco::XML::Element*) element->getNodeByPath(copy);
+        return (Poco::XML::Element*) findNode(copy);
     } else {
         ofLogWarning("ofXml") << "getPocoElement(): no element to get yet ";
         return nullptr;
@@ -962,7 +1258,7 @@ const Poco::XML::Element* ofXml::getPocoElement(const string& path) const
     }
 
     if(element) {
-        return (Poco::XML::Element*) element->getNodeByPath(copy);
+        return (Poco::XML::Element*) findNode(copy);
     } else {
         ofLogWarning("ofXml") << "getPocoElement(): no element to get yet ";
         return nullptr;
@@ -42,6 +42,10 @@ public:
 	bool load(const string & path);
 	bool save(const string & path);
 
+	/// \brief Writes the document to a stream as it's serialized, without
+	/// building the whole text in memory first like toString() does.
+	bool save(ostream & stream) const;
+
     bool            addChild( const string& path );
     void            addXml( ofXml& xml, bool copyAll = false);
 
@@ -123,11 +127,7 @@ public:
     template <class T> bool addValue(const string& path, T data=T(), bool createEntirePath = false)
     {
         string value = ofToString(data);
-        vector<string> tokens;
-        
-        if(path.find('/') != string::npos) {
-            tokens = tokenize(path, "/");
-        }
+        const vector<string> & tokens = splitPath(path);
         
         // is this a tokenized tag?
         if(tokens.size() > 1)
@@ -216,7 +216,7 @@ public:
 					return returnVal; // hmm. this could be a problem
 				}
 			} else {
-				Poco::XML::Element *e = (Poco::XML::Element*) element->getNodeByPath(path);
+				Poco::XML::Element *e = (Poco::XML::Element*) findNode(path);
 				if(e) {
 					return ofFromString<T>(e->innerText());
 				}
@@ -241,7 +241,16 @@ protected:
     void releaseAll();
     string DOMErrorMessage(short msg);
 
+    // resolves a path from the current element, the paths are parsed once
+    // and the nodes they lead to are cached until the document changes
+    Poco::XML::Node * findNode(const string & path) const;
+    // the path split at '/', cached like the paths
+    const vector<string> & splitPath(const string & path) const;
+
     Poco::XML::Document *document;
     Poco::XML::Element *element;
+
+    class PathCache;
+    unique_ptr<PathCache> pathCache;
     
 };
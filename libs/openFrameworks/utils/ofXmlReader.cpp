@@ -0,0 +1,494 @@
+#include "ofXmlReader.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <Poco/SharedMemory.h>
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+#include <cstring>
+#include <algorithm>
+
+namespace{
+	inline bool isSpace(char c){
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	// the characters that end a name in a tag
+	inline bool isNameEnd(char c){
+		return isSpace(c) || c == '>' || c == '/' || c == '=';
+	}
+
+	inline bool startsWith(const char * p, const char * end, const char * prefix){
+		size_t length = strlen(prefix);
+		return size_t(end - p) >= length && memcmp(p, prefix, length) == 0;
+	}
+
+	void appendUtf8(string & str, uint32_t c){
+		if(c < 0x80){
+			str += char(c);
+		}else if(c < 0x800){
+			str += char(0xC0 | (c >> 6));
+			str += char(0x80 | (c & 0x3F));
+		}else if(c < 0x10000){
+			str += char(0xE0 | (c >> 12));
+			str += char(0x80 | ((c >> 6) & 0x3F));
+			str += char(0x80 | (c & 0x3F));
+		}else{
+			str += char(0xF0 | (c >> 18));
+			str += char(0x80 | ((c >> 12) & 0x3F));
+			str += char(0x80 | ((c >> 6) & 0x3F));
+			str += char(0x80 | (c & 0x3F));
+		}
+	}
+}
+
+//----------------------------------------------------------
+ofXmlReader::ofXmlReader(){
+	start(nullptr, 0);
+}
+
+//----------------------------------------------------------
+ofXmlReader::ofXmlReader(const ofBuffer & buffer){
+	setBuffer(buffer);
+}
+
+//----------------------------------------------------------
+ofXmlReader::~ofXmlReader(){
+}
+
+//----------------------------------------------------------
+bool ofXmlReader::load(const string & path){
+	mappedFile.reset();
+	ownedBuffer.clear();
+	string fullPath = ofToDataPath(path);
+	ofFile file(fullPath, ofFile::Reference);
+	if(!file.exists()){
+		ofLogError("ofXmlReader") << "couldn't load, \"" << file.getFileName() << "\" not found";
+		start(nullptr, 0);
+		return false;
+	}
+
+	// mapping fails for empty files and on platforms without it, the file
+	// is read in memory then
+	if(file.getSize() > 0){
+		try{
+			mappedFile = make_shared<Poco::SharedMemory>(Poco::File(fullPath), Poco::SharedMemory::AM_READ);
+			if(mappedFile->begin()){
+				start(mappedFile->begin(), mappedFile->end() - mappedFile->begin());
+				return true;
+			}
+		}catch(const Poco::Exception & e){
+			ofLogVerbose("ofXmlReader") << "couldn't map \"" << file.getFileName() << "\", reading it instead: " << e.displayText();
+		}
+		mappedFile.reset();
+	}
+	ownedBuffer = ofBufferFromFile(fullPath, true);
+	start(ownedBuffer.getData(), ownedBuffer.size());
+	return true;
+}
+
+//----------------------------------------------------------
+void ofXmlReader::setBuffer(const ofBuffer & buffer){
+	setData(buffer.getData(), buffer.size());
+}
+
+//----------------------------------------------------------
+void ofXmlReader::setData(const char * data, size_t size){
+	mappedFile.reset();
+	ownedBuffer.clear();
+	start(data, size);
+}
+
+//----------------------------------------------------------
+void ofXmlReader::start(const char * data, size_t size){
+	begin = data;
+	end = data + size;
+	reset();
+}
+
+//----------------------------------------------------------
+void ofXmlReader::reset(){
+	pos = begin;
+	event = StartElement;
+	name.clear();
+	text.begin = text.end = begin;
+	textIsRaw = false;
+	closePending = false;
+	popPending = false;
+	elements.clear();
+	attributes.clear();
+	error.clear();
+	// skip the utf-8 byte order mark
+	if(startsWith(pos, end, "\xEF\xBB\xBF")){
+		pos += 3;
+	}
+}
+
+//----------------------------------------------------------
+ofXmlReader::Event ofXmlReader::next(){
+	if(event == EndDocument || event == Error){
+		return event;
+	}
+	attributes.clear();
+	if(popPending){
+		elements.pop_back();
+		popPending = false;
+	}
+	if(closePending){
+		// the end of an empty element, <name/>
+		closePending = false;
+		popPending = true;
+		event = EndElement;
+		return event;
+	}
+
+	while(true){
+		if(pos >= end){
+			if(!elements.empty()){
+				return setError("unexpected end of the document, <" + string(elements.back().begin, elements.back().end) + "> isn't closed");
+			}
+			event = EndDocument;
+			return event;
+		}
+
+		if(*pos != '<'){
+			const char * textBegin = pos;
+			pos = static_cast<const char*>(memchr(pos, '<', end - pos));
+			if(!pos){
+				pos = end;
+			}
+			if(std::all_of(textBegin, pos, isSpace)){
+				continue;
+			}
+			if(elements.empty()){
+				return setError("text outside of the root element");
+			}
+			text.begin = textBegin;
+			text.end = pos;
+			textIsRaw = false;
+			event = Text;
+			return event;
+		}
+
+		if(startsWith(pos, end, "<?")){
+			if(!skipTo("?>")){
+				return setError("unclosed processing instruction");
+			}
+		}else if(startsWith(pos, end, "<!--")){
+			if(!skipTo("-->")){
+				return setError("unclosed comment");
+			}
+		}else if(startsWith(pos, end, "<![CDATA[")){
+			const char * textBegin = pos + 9;
+			if(!skipTo("]]>")){
+				return setError("unclosed CDATA section");
+			}
+			if(elements.empty()){
+				return setError("CDATA section outside of the root element");
+			}
+			text.begin = textBegin;
+			text.end = pos - 3;
+			textIsRaw = true;
+			event = Text;
+			return event;
+		}else if(startsWith(pos, end, "<!")){
+			// doctype, the internal subset between [] can contain >
+			int brackets = 0;
+			for(pos += 2; pos < end && (*pos != '>' || brackets > 0); pos++){
+				brackets += (*pos == '[') - (*pos == ']');
+			}
+			if(pos >= end){
+				return setError("unclosed declaration");
+			}
+			pos++;
+		}else if(startsWith(pos, end, "</")){
+			return endElement();
+		}else{
+			return startElement();
+		}
+	}
+}
+
+//----------------------------------------------------------
+ofXmlReader::Event ofXmlReader::startElement(){
+	const char * p = pos + 1;
+	Range element = {p, p};
+	while(p < end && !isNameEnd(*p)){
+		p++;
+	}
+	element.end = p;
+	if(element.begin == element.end){
+		return setError("expected an element name after <");
+	}
+
+	while(true){
+		while(p < end && isSpace(*p)){
+			p++;
+		}
+		if(p >= end){
+			return setError("unclosed element <" + string(element.begin, element.end) + ">");
+		}
+		if(*p == '>'){
+			p++;
+			break;
+		}
+		if(*p == '/'){
+			if(p + 1 < end && p[1] == '>'){
+				p += 2;
+				closePending = true;
+				break;
+			}
+			return setError("unexpected / in element <" + string(element.begin, element.end) + ">");
+		}
+
+		Attribute attribute;
+		attribute.name.begin = p;
+		while(p < end && !isNameEnd(*p)){
+			p++;
+		}
+		attribute.name.end = p;
+		if(attribute.name.begin == attribute.name.end){
+			return setError("expected an attribute name in element <" + string(element.begin, element.end) + ">");
+		}
+		while(p < end && isSpace(*p)){
+			p++;
+		}
+		if(p >= end || *p != '='){
+			return setError("expected = after attribute " + string(attribute.name.begin, attribute.name.end));
+		}
+		p++;
+		while(p < end && isSpace(*p)){
+			p++;
+		}
+		if(p >= end || (*p != '"' && *p != '\'')){
+			return setError("expected a quoted value for attribute " + string(attribute.name.begin, attribute.name.end));
+		}
+		const char * quote = static_cast<const char*>(memchr(p + 1, *p, end - p - 1));
+		if(!quote){
+			return setError("unclosed value of attribute " + string(attribute.name.begin, attribute.name.end));
+		}
+		attribute.value.begin = p + 1;
+		attribute.value.end = quote;
+		attributes.push_back(attribute);
+		p = quote + 1;
+	}
+
+	pos = p;
+	elements.push_back(element);
+	name.assign(element.begin, element.end);
+	event = StartElement;
+	return event;
+}
+
+//----------------------------------------------------------
+ofXmlReader::Event ofXmlReader::endElement(){
+	const char * p = pos + 2;
+	Range element = {p, p};
+	while(p < end && !isNameEnd(*p)){
+		p++;
+	}
+	element.end = p;
+	while(p < end && isSpace(*p)){
+		p++;
+	}
+	if(p >= end || *p != '>'){
+		return setError("unclosed end of element </" + string(element.begin, element.end) + ">");
+	}
+	string closed(element.begin, element.end);
+	if(elements.empty()){
+		return setError("unexpected </" + closed + ">");
+	}
+	const Range & open = elements.back();
+	if(!equals(open, closed)){
+		return setError("</" + closed + "> doesn't close <" + string(open.begin, open.end) + ">");
+	}
+	pos = p + 1;
+	name.swap(closed);
+	popPending = true;
+	event = EndElement;
+	return event;
+}
+
+//----------------------------------------------------------
+bool ofXmlReader::skipTo(const char * terminator){
+	size_t length = strlen(terminator);
+	const char * found = std::search(pos, end, terminator, terminator + length);
+	if(found == end){
+		return false;
+	}
+	pos = found + length;
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofXmlReader::skipElement(){
+	if(event != StartElement || elements.empty()){
+		ofLogWarning("ofXmlReader") << "skipElement(): not at the start of an element";
+		return false;
+	}
+	size_t depth = elements.size();
+	while(next() != EndDocument && event != Error){
+		if(event == EndElement && elements.size() == depth){
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+string ofXmlReader::readElementText(){
+	if(event != StartElement || elements.empty()){
+		ofLogWarning("ofXmlReader") << "readElementText(): not at the start of an element";
+		return "";
+	}
+	string contents;
+	size_t depth = elements.size();
+	while(next() != EndDocument && event != Error){
+		if(event == Text){
+			contents += getText();
+		}else if(event == EndElement && elements.size() == depth){
+			break;
+		}
+	}
+	return contents;
+}
+
+//----------------------------------------------------------
+ofXmlReader::Event ofXmlReader::getEvent() const{
+	return event;
+}
+
+//----------------------------------------------------------
+const string & ofXmlReader::getName() const{
+	return name;
+}
+
+//----------------------------------------------------------
+size_t ofXmlReader::getDepth() const{
+	return elements.size();
+}
+
+//----------------------------------------------------------
+string ofXmlReader::getPath() const{
+	string path;
+	for(auto & element: elements){
+		if(!path.empty()){
+			path += '/';
+		}
+		path.append(element.begin, element.end);
+	}
+	return path;
+}
+
+//----------------------------------------------------------
+string ofXmlReader::getText() const{
+	if(event != Text){
+		return "";
+	}
+	return textIsRaw ? string(text.begin, text.end) : decode(text);
+}
+
+//----------------------------------------------------------
+size_t ofXmlReader::getNumAttributes() const{
+	return attributes.size();
+}
+
+//----------------------------------------------------------
+string ofXmlReader::getAttributeName(size_t index) const{
+	if(index >= attributes.size()){
+		ofLogWarning("ofXmlReader") << "getAttributeName(): index " << index << " out of bounds";
+		return "";
+	}
+	return string(attributes[index].name.begin, attributes[index].name.end);
+}
+
+//----------------------------------------------------------
+string ofXmlReader::getAttributeValue(size_t index) const{
+	if(index >= attributes.size()){
+		ofLogWarning("ofXmlReader") << "getAttributeValue(): index " << index << " out of bounds";
+		return "";
+	}
+	return decode(attributes[index].value);
+}
+
+//----------------------------------------------------------
+bool ofXmlReader::hasAttribute(const string & name) const{
+	for(auto & attribute: attributes){
+		if(equals(attribute.name, name)){
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+string ofXmlReader::getAttribute(const string & name) const{
+	for(auto & attribute: attributes){
+		if(equals(attribute.name, name)){
+			return decode(attribute.value);
+		}
+	}
+	return "";
+}
+
+//----------------------------------------------------------
+const string & ofXmlReader::getError() const{
+	return error;
+}
+
+//----------------------------------------------------------
+size_t ofXmlReader::getLine() const{
+	return std::count(begin, pos, '\n') + 1;
+}
+
+//----------------------------------------------------------
+ofXmlReader::Event ofXmlReader::setError(const string & message){
+	error = message + " at line " + ofToString(getLine());
+	ofLogError("ofXmlReader") << "parse error: " << error;
+	event = Error;
+	return event;
+}
+
+//----------------------------------------------------------
+bool ofXmlReader::equals(const Range & range, const string & str){
+	return size_t(range.end - range.begin) == str.size() && memcmp(range.begin, str.data(), str.size()) == 0;
+}
+
+//----------------------------------------------------------
+string ofXmlReader::decode(const Range & range){
+	const char * amp = static_cast<const char*>(memchr(range.begin, '&', range.end - range.begin));
+	if(!amp){
+		return string(range.begin, range.end);
+	}
+	string decoded(range.begin, amp);
+	const char * p = amp;
+	while(p < range.end){
+		if(*p != '&'){
+			decoded += *p++;
+			continue;
+		}
+		const char * semicolon = std::find(p, std::min(p + 12, range.end), ';');
+		if(semicolon == range.end || *semicolon != ';'){
+			decoded += *p++;
+			continue;
+		}
+		string entity(p + 1, semicolon);
+		if(entity == "lt"){
+			decoded += '<';
+		}else if(entity == "gt"){
+			decoded += '>';
+		}else if(entity == "amp"){
+			decoded += '&';
+		}else if(entity == "quot"){
+			decoded += '"';
+		}else if(entity == "apos"){
+			decoded += '\'';
+		}else if(entity.size() > 1 && entity[0] == '#'){
+			bool hex = entity[1] == 'x' || entity[1] == 'X';
+			appendUtf8(decoded, strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10));
+		}else{
+			decoded.append(p, semicolon + 1);
+		}
+		p = semicolon + 1;
+	}
+	return decoded;
+}
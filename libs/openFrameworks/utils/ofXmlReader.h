@@ -0,0 +1,160 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+
+namespace Poco{
+	class SharedMemory;
+}
+
+/// \brief Reads an xml document one element at a time without loading it
+/// in memory.
+///
+/// ofXml builds the whole tree of the document, which for files of
+/// hundreds of megabytes takes a long time and several times their size
+/// in memory. ofXmlReader instead walks the document from the start
+/// returning every element, its attributes and its text as it finds them:
+///
+/// ~~~~{.cpp}
+/// ofXmlReader reader;
+/// if(reader.load("show.xml")){
+///     while(reader.next() != ofXmlReader::EndDocument){
+///         if(reader.getEvent() == ofXmlReader::StartElement && reader.getName() == "cue"){
+///             cues.push_back(ofToFloat(reader.getAttribute("time")));
+///         }else if(reader.getEvent() == ofXmlReader::Error){
+///             ofLogError() << reader.getError();
+///             break;
+///         }
+///     }
+/// }
+/// ~~~~
+///
+/// Files are memory mapped when the platform allows it so only the parts
+/// being read are in memory. Comments, processing instructions and the
+/// doctype are skipped, text that is only white space between elements
+/// isn't reported. The predefined and numeric entities are decoded, other
+/// entities are returned as they are.
+class ofXmlReader{
+public:
+	enum Event{
+		StartElement,
+		EndElement,
+		Text,
+		EndDocument,
+		Error,
+	};
+
+	ofXmlReader();
+
+	/// \brief Reads a document from a buffer that has to stay valid while
+	/// the reader is used, the data isn't copied.
+	ofXmlReader(const ofBuffer & buffer);
+	~ofXmlReader();
+
+	/// \brief Opens a file relative to the data folder, memory mapping it
+	/// if possible.
+	bool load(const string & path);
+
+	/// \brief Reads a document from a buffer that has to stay valid while
+	/// the reader is used.
+	void setBuffer(const ofBuffer & buffer);
+
+	/// \brief Reads a document from memory that has to stay valid while the
+	/// reader is used.
+	void setData(const char * data, size_t size);
+
+	/// \brief Goes back to the start of the document.
+	void reset();
+
+	/// \brief Reads the next element, end of element or text.
+	///
+	/// Empty elements like `<light/>` return a StartElement and then an
+	/// EndElement. Once the document ends or an error is found every call
+	/// returns EndDocument or Error.
+	Event next();
+
+	/// \brief Skips everything up to the end of the current element.
+	///
+	/// Has to be called right after next() returns StartElement, the next
+	/// event is then the EndElement that closes it.
+	bool skipElement();
+
+	/// \brief Reads all the text inside the current element, including the
+	/// text of its children, like ofXml::getValue().
+	///
+	/// Has to be called right after next() returns StartElement, the reader
+	/// is left at the EndElement that closes it.
+	string readElementText();
+
+	/// \returns The last event returned by next().
+	Event getEvent() const;
+
+	/// \returns The name of the element that starts or ends.
+	const string & getName() const;
+
+	/// \returns The number of elements that contain the current position,
+	/// 1 inside the root element, including the current element for a
+	/// StartElement or an EndElement.
+	size_t getDepth() const;
+
+	/// \returns The names of the elements that contain the current position
+	/// separated with '/', like the paths ofXml uses.
+	string getPath() const;
+
+	/// \returns The decoded text of a Text event.
+	string getText() const;
+
+	/// \returns The number of attributes of the element that starts.
+	size_t getNumAttributes() const;
+
+	string getAttributeName(size_t index) const;
+	string getAttributeValue(size_t index) const;
+	bool hasAttribute(const string & name) const;
+
+	/// \returns The decoded value of an attribute of the element that starts
+	/// or an empty string if it doesn't have it.
+	string getAttribute(const string & name) const;
+
+	/// \returns A description of the error and where it was found.
+	const string & getError() const;
+
+	/// \returns The line of the document where the reader is.
+	size_t getLine() const;
+
+private:
+	// the ranges point into the document, which may be owned by the reader
+	ofXmlReader(const ofXmlReader &) = delete;
+	ofXmlReader & operator=(const ofXmlReader &) = delete;
+
+	struct Range{
+		const char * begin;
+		const char * end;
+	};
+	struct Attribute{
+		Range name;
+		Range value;
+	};
+
+	void start(const char * data, size_t size);
+	Event setError(const string & message);
+	Event startElement();
+	Event endElement();
+	bool skipTo(const char * terminator);
+	static bool equals(const Range & range, const string & str);
+	static string decode(const Range & range);
+
+	const char * begin;
+	const char * end;
+	const char * pos;
+	Event event;
+	string name;
+	Range text;
+	bool textIsRaw;
+	bool closePending;
+	bool popPending;
+	vector<Range> elements;
+	vector<Attribute> attributes;
+	string error;
+	ofBuffer ownedBuffer;
+	shared_ptr<Poco::SharedMemory> mappedFile;
+};
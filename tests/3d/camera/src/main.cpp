@@ -0,0 +1,168 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool aprox_eq(const ofVec3f & v1, const ofVec3f & v2, float tolerance = 1e-3f){
+		return fabs(v1.x - v2.x) <= tolerance * max(1.f, fabs(v2.x)) &&
+			fabs(v1.y - v2.y) <= tolerance * max(1.f, fabs(v2.y)) &&
+			fabs(v1.z - v2.z) <= tolerance * max(1.f, fabs(v2.z));
+	}
+
+	bool aprox_eq(const vector<ofVec3f> & v1, const vector<ofVec3f> & v2, float tolerance = 1e-3f){
+		if(v1.size() != v2.size()){
+			return false;
+		}
+		for(size_t i = 0; i < v1.size(); i++){
+			if(!aprox_eq(v1[i], v2[i], tolerance)){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void run(){
+		// the viewport is always passed since there's no window
+		ofRectangle viewport(0, 0, 800, 600);
+		ofCamera camera;
+		camera.setFov(60);
+		camera.setNearClip(1);
+		camera.setFarClip(100);
+		camera.setPosition(0, 0, 10);
+
+		// at 10 units from the camera the frustum is 2 * 10 * tan(30)
+		// high and 4/3 of that wide
+		float halfHeight = 10 * tan(ofDegToRad(30));
+		float halfWidth = halfHeight * 4.f / 3.f;
+		ofFrustum frustum = camera.getFrustum(viewport);
+		test(frustum.isVisible(ofVec3f(0, 0, 0)), "the point the camera looks at is visible");
+		test(!frustum.isVisible(ofVec3f(0, 0, 20)), "points behind the camera aren't visible");
+		test(!frustum.isVisible(ofVec3f(0, 0, 9.5)), "points closer than the near clip aren't visible");
+		test(!frustum.isVisible(ofVec3f(0, 0, -95)), "points further than the far clip aren't visible");
+		test(frustum.isVisible(ofVec3f(halfWidth - 0.1, 0, 0)) && !frustum.isVisible(ofVec3f(halfWidth + 0.1, 0, 0)), "the right plane is at the edge of the field of view");
+		test(frustum.isVisible(ofVec3f(0, -halfHeight + 0.1, 0)) && !frustum.isVisible(ofVec3f(0, -halfHeight - 0.1, 0)), "the bottom plane is at the edge of the field of view");
+		test(fabs(frustum.getDistance(ofFrustum::Near, ofVec3f(0, 0, 0)) - 9) < 1e-4f, "planes are normalized");
+		test(!frustum.isSphereVisible(ofVec3f(halfWidth + 1.5, 0, 0), 0.5) && frustum.isSphereVisible(ofVec3f(halfWidth + 1.5, 0, 0), 2), "spheres are visible if they cross a plane");
+		test(frustum.isBoxVisible(ofVec3f(-1, -1, 5), ofVec3f(1, 1, 15)), "boxes through the camera are visible");
+		test(!frustum.isBoxVisible(ofVec3f(-1, -1, 11), ofVec3f(1, 1, 15)), "boxes behind the camera aren't visible");
+		test(!frustum.isBoxVisible(ofVec3f(halfWidth + 1, -1, -1), ofVec3f(halfWidth + 3, 1, 1)), "boxes outside a side plane aren't visible");
+
+		// batch tests give the same results as testing one by one
+		ofSeedRandom(7);
+		const size_t n = 1001;
+		vector<ofVec3f> points(n), boxMin(n), boxMax(n);
+		vector<float> radii(n);
+		for(size_t i = 0; i < n; i++){
+			points[i].set(ofRandom(-20, 20), ofRandom(-20, 20), ofRandom(-100, 20));
+			radii[i] = ofRandom(0, 3);
+			boxMin[i] = points[i] - ofVec3f(radii[i], radii[i], radii[i]);
+			boxMax[i] = points[i] + ofVec3f(radii[i], radii[i] * 2, radii[i] * 3);
+		}
+		vector<uint8_t> visible;
+		size_t count = frustum.getVisiblePoints(points, visible);
+		bool same = visible.size() == n;
+		size_t expected = 0;
+		for(size_t i = 0; i < n; i++){
+			same &= visible[i] == frustum.isVisible(points[i]);
+			expected += visible[i];
+		}
+		test(same && count == expected && count > 0 && count < n, "batch point tests are the same as single ones");
+		count = frustum.getVisibleSpheres(points, radii, visible);
+		same = true;
+		expected = 0;
+		for(size_t i = 0; i < n; i++){
+			same &= visible[i] == frustum.isSphereVisible(points[i], radii[i]);
+			expected += visible[i];
+		}
+		test(same && count == expected, "batch sphere tests are the same as single ones");
+		count = frustum.getVisibleBoxes(boxMin, boxMax, visible);
+		same = true;
+		expected = 0;
+		for(size_t i = 0; i < n; i++){
+			same &= visible[i] == frustum.isBoxVisible(boxMin[i], boxMax[i]);
+			expected += visible[i];
+		}
+		test(same && count == expected, "batch box tests are the same as single ones");
+		ofLogNotice() << "the next error is expected";
+		radii.pop_back();
+		test_eq(frustum.getVisibleSpheres(points, radii, visible), 0u, "arrays of different sizes are rejected");
+
+		// projection
+		test(aprox_eq(camera.worldToScreen(ofVec3f(0, 0, 0), viewport), ofVec3f(400, 300, camera.worldToScreen(ofVec3f(0, 0, 0), viewport).z)), "the center of the view is projected to the center of the viewport");
+		test(aprox_eq(camera.worldToScreen(ofVec3f(halfWidth, halfHeight, 0), viewport), ofVec3f(800, 0, camera.worldToScreen(ofVec3f(0, 0, 0), viewport).z)), "the corners of the view are projected to the corners of the viewport");
+		vector<ofVec3f> screen, single(n);
+		camera.worldToScreen(points, screen, viewport);
+		for(size_t i = 0; i < n; i++){
+			single[i] = camera.worldToScreen(points[i], viewport);
+		}
+		test(aprox_eq(screen, single), "batch projection is the same as worldToScreen");
+		vector<uint8_t> projectedVisible;
+		count = camera.worldToScreen(points, screen, projectedVisible, viewport);
+		frustum.getVisiblePoints(points, visible);
+		test(projectedVisible == visible && aprox_eq(screen, single), "batch projection returns which points are visible");
+		same = true;
+		for(size_t i = 0; i < n; i++){
+			if(projectedVisible[i]){
+				same &= viewport.inside(screen[i].x, screen[i].y) && screen[i].z >= -1 && screen[i].z <= 1;
+			}
+		}
+		test(same, "visible points are projected inside the viewport");
+
+		vector<ofVec3f> world;
+		camera.screenToWorld(single, world, viewport);
+		for(size_t i = 0; i < n; i++){
+			single[i] = camera.screenToWorld(single[i], viewport);
+		}
+		test(aprox_eq(world, single, 1e-2f), "batch unprojection is the same as screenToWorld");
+		test(aprox_eq(world, points, 1e-2f), "unprojecting the projected points gives the original points");
+		vector<ofVec3f> inPlace = points;
+		camera.worldToScreen(inPlace, inPlace, visible, viewport);
+		test(visible == projectedVisible && aprox_eq(inPlace, screen), "points can be projected in place");
+
+		// the cached matrices follow the camera
+		ofVec3f p(1, 2, -3);
+		ofVec3f before = camera.worldToScreen(p, viewport);
+		camera.move(1, 0, 0);
+		ofCamera fresh;
+		fresh.setFov(60);
+		fresh.setNearClip(1);
+		fresh.setFarClip(100);
+		fresh.setPosition(1, 0, 10);
+		test(!aprox_eq(camera.worldToScreen(p, viewport), before) && aprox_eq(camera.worldToScreen(p, viewport), fresh.worldToScreen(p, viewport)), "projecting after moving the camera uses the new position");
+		camera.setFov(30);
+		fresh.setFov(30);
+		test(aprox_eq(camera.worldToScreen(p, viewport), fresh.worldToScreen(p, viewport)), "projecting after changing the field of view uses the new one");
+		test(aprox_eq(camera.worldToScreen(p, ofRectangle(0, 0, 400, 400)), fresh.worldToScreen(p, ofRectangle(0, 0, 400, 400))), "projecting with another viewport uses it");
+		ofNode parent;
+		camera.setParent(parent);
+		fresh.setParent(parent);
+		before = camera.screenToWorld(ofVec3f(10, 20, 0.5), viewport);
+		parent.setOrientation(ofVec3f(0, 45, 0));
+		test(!aprox_eq(camera.screenToWorld(ofVec3f(10, 20, 0.5), viewport), before, 1e-2f) && aprox_eq(camera.screenToWorld(ofVec3f(10, 20, 0.5), viewport), fresh.screenToWorld(ofVec3f(10, 20, 0.5), viewport), 1e-2f), "unprojecting after moving the parent uses the new position");
+		camera.clearParent();
+
+		// orthographic cameras see a box the size of the viewport
+		ofCamera ortho;
+		ortho.enableOrtho();
+		ortho.setNearClip(1);
+		ortho.setFarClip(100);
+		ortho.setPosition(0, 0, 10);
+		frustum = ortho.getFrustum(viewport);
+		test(frustum.isVisible(ofVec3f(399, 299, 0)) && !frustum.isVisible(ofVec3f(401, 0, 0)) && !frustum.isVisible(ofVec3f(0, 301, 0)), "the frustum of an orthographic camera is the size of the viewport");
+		ortho.worldToScreen(points, screen, viewport);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ortho.worldToScreen(points[i], viewport);
+		}
+		test(aprox_eq(screen, single), "batch projection with an orthographic camera is the same as worldToScreen");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
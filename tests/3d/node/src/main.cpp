@@ -0,0 +1,158 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool aprox_eq(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2){
+		for(int i = 0; i < 4; i++){
+			for(int j = 0; j < 4; j++){
+				if(fabs(m1(i, j) - m2(i, j)) > 1e-4f * max(1.f, fabs(m2(i, j)))){
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// the global transform as it was computed before caching it
+	ofMatrix4x4 uncachedGlobalTransform(const ofNode & node){
+		ofMatrix4x4 m = node.getLocalTransformMatrix();
+		for(ofNode * parent = node.getParent(); parent; parent = parent->getParent()){
+			m = m * parent->getLocalTransformMatrix();
+		}
+		return m;
+	}
+
+	bool allUpToDate(const vector<ofNode> & nodes){
+		for(auto & node: nodes){
+			if(!aprox_eq(node.getGlobalTransformMatrix(), uncachedGlobalTransform(node))){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void run(){
+		// a chain 10 nodes deep
+		vector<ofNode> chain(10);
+		for(size_t i = 0; i < chain.size(); i++){
+			if(i > 0){
+				chain[i].setParent(chain[i - 1]);
+			}
+			chain[i].setPosition(1, 2, 3);
+			chain[i].setOrientation(ofVec3f(10, 20, 30));
+		}
+		test(allUpToDate(chain), "global transforms are the product of the local ones");
+		test_eq(chain[0].getChildren().size(), 1u, "parents know their children");
+		test(chain[0].getChildren()[0] == &chain[1], "the child is the node that set the parent");
+
+		chain[0].move(5, 0, 0);
+		test(allUpToDate(chain), "moving the root updates every global transform");
+		chain[4].setOrientation(ofVec3f(0, 90, 0));
+		test(allUpToDate(chain), "rotating a node in the middle updates its descendants");
+		chain[2].setScale(2);
+		test(allUpToDate(chain), "scaling a node updates its descendants");
+		chain[3].setTransformMatrix(ofMatrix4x4::newTranslationMatrix(1, 1, 1));
+		test(allUpToDate(chain), "setting the matrix updates the descendants");
+		test_eq(chain[9].getGlobalOrientation(), chain[9].getGlobalTransformMatrix().getRotate(), "the global orientation is the one of the global matrix");
+		chain[1].rotate(45, 0, 0, 1);
+		test(aprox_eq(ofMatrix4x4(chain[9].getGlobalOrientation()), ofMatrix4x4(uncachedGlobalTransform(chain[9]).getRotate())), "the global orientation is updated when a parent rotates");
+
+		// reparenting
+		ofNode other;
+		other.setPosition(100, 0, 0);
+		ofVec3f before = chain[5].getGlobalPosition();
+		chain[5].setParent(other, true);
+		test(chain[5].getGlobalPosition().distance(before) < 1e-3f, "setting the parent can keep the global transform");
+		test(chain[4].getChildren().empty(), "setting a new parent removes the node from the old one");
+		test(allUpToDate(chain), "setting the parent updates the descendants");
+		other.move(0, 10, 0);
+		test(allUpToDate(chain), "descendants follow the new parent");
+		chain[4].move(0, 10, 0);
+		test(aprox_eq(chain[9].getGlobalTransformMatrix(), uncachedGlobalTransform(chain[9])), "descendants don't follow the old parent");
+		chain[5].clearParent();
+		test(allUpToDate(chain), "clearing the parent updates the descendants");
+		test(other.getChildren().empty(), "clearing the parent removes the node from its children");
+		chain[5].setParent(chain[4]);
+
+		// flat update
+		vector<ofNode*> nodes;
+		nodes.push_back(&chain[0]);
+		chain[0].getDescendants(nodes);
+		test_eq(nodes.size(), chain.size(), "getDescendants returns every node below");
+		bool sorted = true;
+		for(size_t i = 1; i < nodes.size(); i++){
+			sorted &= std::find(nodes.begin(), nodes.begin() + i, nodes[i]->getParent()) != nodes.begin() + i;
+		}
+		test(sorted, "getDescendants returns every node after its parent");
+		chain[0].setPosition(-1, -2, -3);
+		ofNode::updateGlobalTransforms(nodes);
+		test(allUpToDate(chain), "updateGlobalTransforms updates every node");
+
+		// tree
+		ofNode root;
+		vector<ofNode> branches(4);
+		vector<ofNode> leaves(12);
+		for(size_t i = 0; i < branches.size(); i++){
+			branches[i].setParent(root);
+			branches[i].setPosition(i, 0, 0);
+		}
+		for(size_t i = 0; i < leaves.size(); i++){
+			leaves[i].setParent(branches[i % branches.size()]);
+			leaves[i].setPosition(0, i, 0);
+		}
+		nodes.clear();
+		root.getDescendants(nodes);
+		test_eq(nodes.size(), branches.size() + leaves.size(), "getDescendants returns every branch of a tree");
+		root.rotate(30, 0, 1, 0);
+		ofNode::updateGlobalTransforms(nodes);
+		test(allUpToDate(branches) && allUpToDate(leaves), "updateGlobalTransforms updates every branch of a tree");
+
+		// copies and destruction
+		ofNode copy = leaves[0];
+		test_eq(branches[0].getChildren().size(), 4u, "copies of a node are children of the same parent");
+		root.move(0, 0, 1);
+		test(aprox_eq(copy.getGlobalTransformMatrix(), leaves[0].getGlobalTransformMatrix()), "copies follow the parent");
+		{
+			ofNode parent;
+			parent.setPosition(0, 5, 0);
+			copy.setParent(parent);
+			test_eq(copy.getGlobalPosition(), leaves[0].getPosition() + ofVec3f(0, 5, 0), "the new parent is used");
+		}
+		test(copy.getParent() == nullptr, "destroying a parent clears the parent of its children");
+		test_eq(copy.getGlobalPosition(), leaves[0].getPosition(), "destroying a parent updates the global transform of its children");
+
+		// move assignment
+		ofNode moved;
+		ofNode oldChild;
+		oldChild.setParent(moved);
+		vector<ofNode> movedChildren(2);
+		{
+			ofNode source;
+			source.setPosition(3, 0, 0);
+			for(auto & child: movedChildren){
+				child.setParent(source);
+				child.setPosition(0, 1, 0);
+			}
+			moved = std::move(source);
+		}
+		test(oldChild.getParent() == nullptr, "move assignment clears the parent of the old children");
+		test(movedChildren[0].getParent() == &moved && movedChildren[1].getParent() == &moved, "move assignment takes the children of the moved node");
+		test_eq(moved.getChildren().size(), 2u, "a node moved to knows its new children");
+		moved.move(0, 0, 1);
+		test(allUpToDate(movedChildren), "the children follow the node they were moved to");
+		nodes.clear();
+		moved.getDescendants(nodes);
+		test_eq(nodes.size(), 2u, "getDescendants returns the children of a node moved to");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
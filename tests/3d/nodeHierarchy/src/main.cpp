@@ -0,0 +1,153 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool aprox_eq(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2){
+		for(int i = 0; i < 4; i++){
+			for(int j = 0; j < 4; j++){
+				if(fabs(m1(i, j) - m2(i, j)) > 1e-4f * max(1.f, fabs(m2(i, j)))){
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool equal(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2){
+		return memcmp(m1.getPtr(), m2.getPtr(), sizeof(float) * 16) == 0;
+	}
+
+	bool equal(const vector<ofMatrix4x4> & m1, const vector<ofMatrix4x4> & m2){
+		return m1.size() == m2.size() && memcmp(m1.data(), m2.data(), m1.size() * sizeof(ofMatrix4x4)) == 0;
+	}
+
+	// every proxy has the same global matrix as the ofNode at the same index
+	bool sameAsNodes(const vector<ofNodeHierarchy::Node> & proxies, const vector<ofNode> & nodes){
+		for(size_t i = 0; i < proxies.size(); i++){
+			if(proxies[i].isValid() && !aprox_eq(proxies[i].getGlobalTransformMatrix(), nodes[i].getGlobalTransformMatrix())){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void run(){
+		// the same tree as ofNodes and in a hierarchy, every node has the
+		// previous one with half its index as parent
+		const size_t n = 200;
+		vector<ofNode> nodes(n);
+		// room for one more node so they aren't moved once parented
+		nodes.reserve(n + 1);
+		ofNodeHierarchy hierarchy;
+		vector<ofNodeHierarchy::Node> proxies;
+		for(size_t i = 0; i < n; i++){
+			nodes[i].setPosition(i, i % 7, -float(i % 3));
+			nodes[i].setOrientation(ofVec3f(i % 30, i % 45, 0));
+			nodes[i].setScale(1 + (i % 4) * 0.1f);
+			if(i > 0){
+				nodes[i].setParent(nodes[(i - 1) / 2]);
+				proxies.push_back(hierarchy.add(nodes[i], proxies[(i - 1) / 2].getHandle()));
+			}else{
+				proxies.push_back(hierarchy.add(nodes[i]));
+			}
+		}
+		test_eq(hierarchy.size(), n, "every node is added");
+		hierarchy.update();
+		test(sameAsNodes(proxies, nodes), "global matrices are the same as ofNode's");
+		test(proxies[10].getParent().getHandle() == proxies[4].getHandle(), "nodes know their parent");
+
+		// changes
+		proxies[1].move(ofVec3f(0, 5, 0));
+		nodes[1].move(ofVec3f(0, 5, 0));
+		proxies[6].setOrientation(ofVec3f(0, 90, 0));
+		nodes[6].setOrientation(ofVec3f(0, 90, 0));
+		hierarchy.update();
+		test(sameAsNodes(proxies, nodes), "changes are propagated to the descendants");
+
+		// reparenting to a shallower level reorders the nodes
+		proxies[150].setParent(proxies[0]);
+		nodes[150].setParent(nodes[0]);
+		proxies[3].clearParent();
+		nodes[3].clearParent();
+		hierarchy.update();
+		test(sameAsNodes(proxies, nodes), "reparenting updates the global matrices");
+		auto & matrices = hierarchy.getGlobalTransformMatrices();
+		bool sorted = true;
+		for(auto & proxy: proxies){
+			auto parent = proxy.getParent();
+			sorted &= !parent.isValid() || hierarchy.getIndex(parent.getHandle()) < hierarchy.getIndex(proxy.getHandle());
+			sorted &= equal(matrices[hierarchy.getIndex(proxy.getHandle())], proxy.getGlobalTransformMatrix());
+		}
+		test(sorted, "nodes are stored after their parents");
+
+		ofLogNotice() << "the next error is expected";
+		proxies[1].setParent(proxies[9]);
+		test(proxies[1].getParent().getHandle() == proxies[0].getHandle(), "a node can't be the child of its descendants");
+
+		// removing
+		auto removed = proxies[2];
+		size_t subtree = 0;
+		for(size_t i = 0; i < n; i++){
+			for(auto p = proxies[i]; p.isValid(); p = p.getParent()){
+				if(p.getHandle() == removed.getHandle()){
+					subtree++;
+					break;
+				}
+			}
+		}
+		removed.remove();
+		test_eq(hierarchy.size(), n - subtree, "removing a node removes its descendants");
+		test(!removed.isValid() && !proxies[5].isValid() && !proxies[12].isValid(), "the handles of removed nodes are invalid");
+		test(proxies[1].isValid() && proxies[150].isValid(), "the handles of the other nodes are still valid");
+		auto added = hierarchy.add(proxies[1]);
+		test(!removed.isValid(), "reused slots don't validate old handles");
+		added.setPosition(1, 2, 3);
+		nodes.emplace_back();
+		nodes.back().setParent(nodes[1]);
+		nodes.back().setPosition(1, 2, 3);
+		proxies.push_back(added);
+		nodes[0].rotate(20, 0, 1, 0);
+		proxies[0].rotate(ofQuaternion(20, ofVec3f(0, 1, 0)));
+		hierarchy.update();
+		test(sameAsNodes(proxies, nodes), "global matrices are correct after removing and adding nodes");
+
+		// exporting
+		vector<ofNodeHierarchy::Handle> some{proxies[150].getHandle(), proxies[0].getHandle(), added.getHandle()};
+		vector<ofMatrix4x4> exported(some.size());
+		hierarchy.getGlobalTransformMatrices(some, exported.data());
+		test(equal(exported[0], proxies[150].getGlobalTransformMatrix()) && equal(exported[2], added.getGlobalTransformMatrix()), "matrices are exported in the order of the handles");
+
+		ofNode copy;
+		added.applyTransform(copy);
+		test_eq(copy.getPosition(), ofVec3f(1, 2, 3), "the transform can be copied to an ofNode");
+
+		// threads
+		ofNodeHierarchy wide;
+		auto root = wide.add();
+		vector<ofNodeHierarchy::Handle> handles;
+		for(int i = 0; i < 5000; i++){
+			auto child = wide.add(root);
+			child.setPosition(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+			auto grandChild = wide.add(child);
+			grandChild.setOrientation(ofVec3f(ofRandom(360), ofRandom(360), 0));
+			handles.push_back(grandChild.getHandle());
+		}
+		root.setScale(2);
+		ofNodeHierarchy serial = wide;
+		serial.update(1);
+		wide.update(4);
+		test(equal(serial.getGlobalTransformMatrices(), wide.getGlobalTransformMatrices()), "updating with several threads gives the same result");
+		test(wide.getIndex(handles.back()) > wide.getIndex(handles.front()), "sorting by depth keeps the order of the nodes in every level");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
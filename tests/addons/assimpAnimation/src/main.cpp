@@ -0,0 +1,319 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofxAssimpModelLoader.h"
+#include "ofAppNoWindow.h"
+
+// builds a scene with a chain of nodes and an animation with one channel per
+// node with random keys at random times
+shared_ptr<aiScene> createScene(unsigned int numNodes, unsigned int numKeys, unsigned int numAnimations){
+    auto scene = make_shared<aiScene>();
+    scene->mRootNode = new aiNode("root");
+    aiNode * parent = scene->mRootNode;
+    for(unsigned int i=0;i<numNodes;i++){
+        aiNode * node = new aiNode("node" + ofToString(i));
+        node->mParent = parent;
+        parent->mNumChildren = 1;
+        parent->mChildren = new aiNode*[1];
+        parent->mChildren[0] = node;
+        parent = node;
+    }
+
+    scene->mNumAnimations = numAnimations;
+    scene->mAnimations = new aiAnimation*[numAnimations];
+    for(unsigned int a=0;a<numAnimations;a++){
+        aiAnimation * animation = new aiAnimation;
+        animation->mDuration = 10;
+        animation->mTicksPerSecond = 25;
+        animation->mNumChannels = numNodes;
+        animation->mChannels = new aiNodeAnim*[numNodes];
+        for(unsigned int i=0;i<numNodes;i++){
+            aiNodeAnim * channel = new aiNodeAnim;
+            channel->mNodeName = aiString("node" + ofToString(i));
+            channel->mNumPositionKeys = numKeys;
+            channel->mNumRotationKeys = numKeys;
+            channel->mNumScalingKeys = numKeys;
+            channel->mPositionKeys = new aiVectorKey[numKeys];
+            channel->mRotationKeys = new aiQuatKey[numKeys];
+            channel->mScalingKeys = new aiVectorKey[numKeys];
+            double time = 0;
+            for(unsigned int k=0;k<numKeys;k++){
+                aiQuaternion rotation(aiVector3D(ofRandomf(), ofRandomf(), ofRandomf()).Normalize(), ofRandom(PI));
+                channel->mPositionKeys[k] = aiVectorKey(time, aiVector3D(ofRandomf(), ofRandomf(), ofRandomf()));
+                channel->mRotationKeys[k] = aiQuatKey(time, rotation);
+                channel->mScalingKeys[k] = aiVectorKey(time, aiVector3D(ofRandom(0.5,2), ofRandom(0.5,2), ofRandom(0.5,2)));
+                time += ofRandom(0.5, 1.5) * animation->mDuration / numKeys;
+            }
+            animation->mChannels[i] = channel;
+        }
+        scene->mAnimations[a] = animation;
+    }
+    return scene;
+}
+
+// the original implementation of ofxAssimpAnimation::updateAnimationNodes,
+// searching the keys from the start on every call
+aiMatrix4x4 referenceTransform(const aiNodeAnim * channel, float progressInSeconds, float durationInSeconds){
+    aiVector3D presentPosition(0, 0, 0);
+    if(channel->mNumPositionKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumPositionKeys - 1) {
+            if(progressInSeconds < channel->mPositionKeys[frame+1].mTime) {
+                break;
+            }
+            frame++;
+        }
+
+        unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
+        const aiVectorKey & key = channel->mPositionKeys[frame];
+        const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += durationInSeconds;
+        }
+        if(diffTime > 0) {
+            float factor = float((progressInSeconds - key.mTime) / diffTime);
+            presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
+        } else {
+            presentPosition = key.mValue;
+        }
+    }
+
+    aiQuaternion presentRotation(1, 0, 0, 0);
+    if(channel->mNumRotationKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumRotationKeys - 1) {
+            if(progressInSeconds < channel->mRotationKeys[frame+1].mTime) {
+                break;
+            }
+            frame++;
+        }
+
+        unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
+        const aiQuatKey& key = channel->mRotationKeys[frame];
+        const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += durationInSeconds;
+        }
+        if(diffTime > 0) {
+            float factor = float((progressInSeconds - key.mTime) / diffTime);
+            aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
+        } else {
+            presentRotation = key.mValue;
+        }
+    }
+
+    aiVector3D presentScaling(1, 1, 1);
+    if(channel->mNumScalingKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumScalingKeys - 1){
+            if(progressInSeconds < channel->mScalingKeys[frame+1].mTime) {
+                break;
+            }
+            frame++;
+        }
+
+        presentScaling = channel->mScalingKeys[frame].mValue;
+    }
+
+    aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
+    mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
+    mat.a2 *= presentScaling.y; mat.b2 *= presentScaling.y; mat.c2 *= presentScaling.y;
+    mat.a3 *= presentScaling.z; mat.b3 *= presentScaling.z; mat.c3 *= presentScaling.z;
+    mat.a4 = presentPosition.x; mat.b4 = presentPosition.y; mat.c4 = presentPosition.z;
+    return mat;
+}
+
+bool aprox_eq(const aiMatrix4x4 & m1, const aiMatrix4x4 & m2){
+    for(int i=0;i<4;i++){
+        for(int j=0;j<4;j++){
+            if(abs(m1[i][j] - m2[i][j]) > 0.0001){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+class ofApp: public ofxUnitTestsApp{
+public:
+    // compares every node against the reference implementation
+    bool matchesReference(const aiScene & scene, const aiAnimation & animation, const ofxAssimpAnimationClip & clip, const ofxAssimpAnimationPose & pose, float time){
+        for(unsigned int i=0;i<animation.mNumChannels;i++){
+            auto node = clip.getChannelNode(i);
+            if(node<0 || !aprox_eq(pose.getTransform(node), referenceTransform(animation.mChannels[i], time, animation.mDuration))){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void run(){
+        ofSeedRandom(0);
+        auto scene = createScene(10, 50, 2);
+        const aiAnimation & animation = *scene->mAnimations[0];
+        ofxAssimpAnimationClip clip(scene.get(), &animation);
+        test_eq(clip.getNumChannels(), 10u, "clip has one channel per animated node");
+        test_eq(clip.getNumNodes(), 11u, "clip collects every node in the scene");
+
+        // forward playback, including times before the first and after the last key
+        ofxAssimpAnimationCursor cursor;
+        ofxAssimpAnimationPose pose;
+        bool forward = true;
+        for(float t=-0.5;t<animation.mDuration+1;t+=0.01){
+            pose.clear();
+            clip.sample(t, cursor, pose);
+            forward &= matchesReference(*scene, animation, clip, pose, t);
+        }
+        test(forward, "forward sampling matches the original implementation");
+
+        bool backward = true;
+        for(float t=animation.mDuration+1;t>-0.5;t-=0.01){
+            pose.clear();
+            clip.sample(t, cursor, pose);
+            backward &= matchesReference(*scene, animation, clip, pose, t);
+        }
+        test(backward, "backward sampling matches the original implementation");
+
+        bool seek = true;
+        for(int i=0;i<1000;i++){
+            float t = ofRandom(animation.mDuration);
+            pose.clear();
+            clip.sample(t, cursor, pose);
+            seek &= matchesReference(*scene, animation, clip, pose, t);
+        }
+        test(seek, "random seeks match the original implementation");
+
+        // ofxAssimpAnimation writes the same transforms to the scene nodes
+        ofxAssimpAnimation assimpAnimation(scene, scene->mAnimations[0]);
+        assimpAnimation.setPosition(0.37);
+        bool nodes = true;
+        for(unsigned int i=0;i<animation.mNumChannels;i++){
+            auto node = scene->mRootNode->FindNode(animation.mChannels[i]->mNodeName);
+            nodes &= aprox_eq(node->mTransformation, referenceTransform(animation.mChannels[i], assimpAnimation.getPositionInSeconds(), animation.mDuration));
+        }
+        test(nodes, "ofxAssimpAnimation updates the scene nodes");
+
+        // batch evaluation of several instances of the same clip
+        const size_t numInstances = 100;
+        vector<double> times(numInstances);
+        vector<ofxAssimpAnimationCursor> cursors(numInstances);
+        vector<ofxAssimpAnimationPose> poses(numInstances);
+        for(auto & t: times){
+            t = ofRandom(animation.mDuration);
+        }
+        clip.sample(times.data(), numInstances, cursors.data(), poses.data());
+        bool batch = true;
+        for(size_t i=0;i<numInstances;i++){
+            batch &= matchesReference(*scene, animation, clip, poses[i], times[i]);
+        }
+        test(batch, "batch sampling matches the original implementation");
+
+        // blending
+        ofxAssimpAnimation animation0(scene, scene->mAnimations[0]);
+        ofxAssimpAnimation animation1(scene, scene->mAnimations[1]);
+        animation0.setApplyToScene(false);
+        animation1.setApplyToScene(false);
+        animation0.setPosition(0.25);
+        animation1.setPosition(0.75);
+        ofxAssimpAnimationMixer mixer;
+        mixer.setup(scene.get());
+
+        ofxAssimpAnimationPose pose0, pose1, blended;
+        animation0.sample(pose0);
+        animation1.sample(pose1);
+
+        mixer.begin();
+        mixer.crossfade(animation0, animation1, 0);
+        bool crossfade0 = true;
+        for(size_t i=0;i<pose0.size();i++){
+            crossfade0 &= pose0.getWeight(i) == 0 || aprox_eq(mixer.getPose().getTransform(i), pose0.getTransform(i));
+        }
+        test(crossfade0, "crossfade at 0 is the first animation");
+
+        mixer.begin();
+        mixer.crossfade(animation0, animation1, 1);
+        bool crossfade1 = true;
+        for(size_t i=0;i<pose1.size();i++){
+            crossfade1 &= pose1.getWeight(i) == 0 || aprox_eq(mixer.getPose().getTransform(i), pose1.getTransform(i));
+        }
+        test(crossfade1, "crossfade at 1 is the second animation");
+
+        mixer.begin();
+        mixer.crossfade(animation0, animation1, 0.5);
+        blended.blend(pose0, pose1, 0.5);
+        bool crossfadeHalf = true;
+        for(size_t i=0;i<blended.size();i++){
+            crossfadeHalf &= aprox_eq(mixer.getPose().getTransform(i), blended.getTransform(i));
+        }
+        test(crossfadeHalf, "mixer crossfade matches blending the sampled poses");
+
+        mixer.begin();
+        mixer.add(animation0, 0.5);
+        mixer.add(animation0, 0.5);
+        bool sameAnimation = true;
+        for(size_t i=0;i<pose0.size();i++){
+            sameAnimation &= aprox_eq(mixer.getPose().getTransform(i), pose0.getTransform(i));
+        }
+        test(sameAnimation, "blending an animation with itself doesn't change the pose");
+
+        mixer.end();
+        bool applied = true;
+        for(unsigned int i=0;i<animation.mNumChannels;i++){
+            auto node = clip.getChannelNode(i);
+            applied &= aprox_eq(clip.getNodes()[node]->mTransformation, pose0.getTransform(node));
+        }
+        test(applied, "mixer writes the blended pose to the scene nodes");
+
+        // forward playback of a long clip reusing the cursor, the timings
+        // against the original search are only logged
+        auto bigScene = createScene(50, 1000, 1);
+        const aiAnimation & bigAnimation = *bigScene->mAnimations[0];
+        ofxAssimpAnimationClip bigClip(bigScene.get(), &bigAnimation);
+        const int numFrames = 200;
+        const float frameTime = bigAnimation.mDuration / numFrames;
+
+        aiMatrix4x4 sum;
+        auto then = ofGetElapsedTimeMicros();
+        for(int frame=0;frame<numFrames;frame++){
+            for(unsigned int i=0;i<bigAnimation.mNumChannels;i++){
+                aiMatrix4x4 m = referenceTransform(bigAnimation.mChannels[i], frame * frameTime, bigAnimation.mDuration);
+                sum.a4 += m.a4;
+            }
+        }
+        auto referenceTime = ofGetElapsedTimeMicros() - then;
+
+        ofxAssimpAnimationCursor bigCursor;
+        ofxAssimpAnimationPose bigPose;
+        then = ofGetElapsedTimeMicros();
+        for(int frame=0;frame<numFrames;frame++){
+            bigPose.clear();
+            bigClip.sample(frame * frameTime, bigCursor, bigPose);
+            sum.a4 += bigPose.px[1];
+        }
+        auto clipTime = ofGetElapsedTimeMicros() - then;
+        ofLogNotice() << "original search " << referenceTime << "us, clip with cursors " << clipTime << "us (" << sum.a4 << ")";
+
+        bool bigForward = true;
+        ofxAssimpAnimationCursor reusedCursor;
+        for(int frame=0;frame<numFrames;frame++){
+            bigPose.clear();
+            bigClip.sample(frame * frameTime, reusedCursor, bigPose);
+            bigForward &= matchesReference(*bigScene, bigAnimation, bigClip, bigPose, frame * frameTime);
+        }
+        test(bigForward, "playing a long clip with a reused cursor matches the original implementation");
+    }
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+    auto window = make_shared<ofAppNoWindow>();
+    auto app = make_shared<ofApp>();
+    // this kicks off the running of my app
+    // can be OF_WINDOW or OF_FULLSCREEN
+    // pass in width and height too:
+    ofRunApp(window, app);
+    return ofRunMainLoop();
+
+}
@@ -0,0 +1,171 @@
+#include "ofMain.h"
+#include "ofxKinectDepthProcessor.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+public:
+    // same calculation as freenect_camera_to_world
+    ofVec3f cameraToWorld(int x, int y, float z, float refPixelSize, float refDistance){
+        double factor = 2 * refPixelSize * z / refDistance;
+        return ofVec3f((x - 640 / 2) * factor, (y - 480 / 2) * factor, z);
+    }
+
+    // a depth frame with a gradient, holes with no data and values out of range
+    ofShortPixels makeFrame(){
+        ofShortPixels frame;
+        frame.allocate(640, 480, 1);
+        for(int y = 0; y < 480; y++){
+            for(int x = 0; x < 640; x++){
+                unsigned short z = 400 + x * 5 + y * 3;
+                if((x / 16 + y / 16) % 7 == 0) z = 0;
+                if(x % 97 == 0) z = 10000;
+                frame[y * 640 + x] = z;
+            }
+        }
+        return frame;
+    }
+
+    void testRecordedFrame(ofShortPixels & frame){
+        // save the frame as raw values and read it back like a recording
+        ofBuffer buffer((const char*)frame.getData(), frame.size() * sizeof(unsigned short));
+        ofBufferToFile("depth.raw", buffer, true);
+        ofBuffer loaded = ofBufferFromFile("depth.raw", true);
+        test_eq(loaded.size(), long(frame.size() * sizeof(unsigned short)), "recorded frame loads");
+        ofShortPixels recorded;
+        recorded.setFromPixels((const unsigned short*)loaded.getData(), 640, 480, 1);
+        test(memcmp(recorded.getData(), frame.getData(), loaded.size()) == 0, "recorded frame matches");
+        frame = recorded;
+    }
+
+    void testDistance(const ofShortPixels & frame){
+        ofFloatPixels distance;
+        ofxKinectDepthProcessor::toDistance(frame, distance);
+        bool same = true;
+        for(int i = 0; i < frame.size(); i++){
+            same &= distance[i] == frame[i];
+        }
+        test(same, "toDistance matches the raw values");
+    }
+
+    void testGray(){
+        // every raw value, the count isn't a multiple of the vector size
+        vector<unsigned short> raw(10003);
+        for(size_t i = 0; i < raw.size(); i++){
+            raw[i] = i;
+        }
+        vector<unsigned char> gray(raw.size());
+        for(bool nearWhite: {true, false}){
+            for(auto clip: {ofVec2f(500, 4000), ofVec2f(800, 1200), ofVec2f(3000, 500)}){
+                ofxKinectDepthProcessor::toGray(&raw[0], &gray[0], raw.size(), clip.x, clip.y, nearWhite);
+                unsigned char nearColor = nearWhite ? 255 : 0;
+                unsigned char farColor = nearWhite ? 0 : 255;
+                bool same = gray[0] == 0;
+                for(size_t i = 1; i < raw.size(); i++){
+                    same &= gray[i] == (unsigned char)ofMap(raw[i], clip.x, clip.y, nearColor, farColor, true);
+                }
+                test(same, "toGray matches the lookup table, near " + ofToString(clip.x) + " far " + ofToString(clip.y) + (nearWhite ? " near white" : " near black"));
+            }
+        }
+    }
+
+    void testWorldCoordinates(const ofShortPixels & frame){
+        ofxKinectDepthProcessor processor;
+        const float refPixelSize = 0.1042;
+        const float refDistance = 120;
+        processor.setup(640, 480, refPixelSize, refDistance);
+
+        for(int step: {1, 2, 3, 7}){
+            vector<ofVec3f> points;
+            vector<unsigned char> valid;
+            size_t numValid = processor.getWorldCoordinates(frame, points, step, &valid);
+            test_eq(points.size(), processor.getNumPoints(step), "point count with step " + ofToString(step));
+
+            bool same = true;
+            bool validOk = true;
+            size_t expectedValid = 0;
+            size_t i = 0;
+            for(int y = 0; y < 480; y += step){
+                for(int x = 0; x < 640; x += step, i++){
+                    float z = frame[y * 640 + x];
+                    bool expected = z > 0;
+                    expectedValid += expected;
+                    validOk &= valid[i] == expected;
+                    ofVec3f reference = expected ? cameraToWorld(x, y, z, refPixelSize, refDistance) : ofVec3f(0, 0, 0);
+                    same &= points[i].distance(reference) < 0.01;
+                }
+            }
+            test(same, "world coordinates match freenect_camera_to_world with step " + ofToString(step));
+            test(validOk, "validity mask with step " + ofToString(step));
+            test_eq(numValid, expectedValid, "valid count with step " + ofToString(step));
+        }
+
+        processor.setDepthRange(1000, 3000);
+        vector<ofVec3f> points;
+        vector<unsigned char> valid;
+        processor.getWorldCoordinates(frame, points, 1, &valid);
+        bool rangeOk = true;
+        for(int i = 0; i < frame.size(); i++){
+            bool expected = frame[i] >= 1000 && frame[i] <= 3000;
+            rangeOk &= valid[i] == expected && (expected || points[i] == ofVec3f(0, 0, 0));
+        }
+        test(rangeOk, "points outside the depth range are invalid");
+
+        ofMesh mesh;
+        processor.getPointCloud(frame, mesh, 2, true);
+        size_t expected = 0;
+        bool meshOk = true;
+        for(int y = 0; y < 480; y += 2){
+            for(int x = 0; x < 640; x += 2){
+                float z = frame[y * 640 + x];
+                if(z >= 1000 && z <= 3000){
+                    meshOk &= expected < mesh.getNumVertices() &&
+                        mesh.getVertex(expected).distance(processor.getWorldCoordinateAt(x, y, z)) < 0.001 &&
+                        mesh.getTexCoord(expected) == ofVec2f(x, y);
+                    expected++;
+                }
+            }
+        }
+        test_eq(mesh.getNumVertices(), expected, "point cloud has only the valid points");
+        test(meshOk, "point cloud vertices and texture coordinates");
+
+        // time against calculating every point individually
+        processor.setDepthRange();
+        auto then = ofGetElapsedTimeMicros();
+        for(int n = 0; n < 20; n++){
+            for(int y = 0, i = 0; y < 480; y++){
+                for(int x = 0; x < 640; x++, i++){
+                    points[i] = cameraToWorld(x, y, frame[i], refPixelSize, refDistance);
+                }
+            }
+        }
+        auto perPointTime = ofGetElapsedTimeMicros() - then;
+        then = ofGetElapsedTimeMicros();
+        for(int n = 0; n < 20; n++){
+            processor.getWorldCoordinates(frame, points);
+        }
+        auto bulkTime = ofGetElapsedTimeMicros() - then;
+        ofLogNotice() << "per point " << perPointTime / 20 << "us, bulk " << bulkTime / 20 << "us";
+    }
+
+    void run(){
+        auto frame = makeFrame();
+        testRecordedFrame(frame);
+        testDistance(frame);
+        testGray();
+        testWorldCoordinates(frame);
+    }
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+    auto window = make_shared<ofAppNoWindow>();
+    auto app = make_shared<ofApp>();
+    // this kicks off the running of my app
+    // can be OF_WINDOW or OF_FULLSCREEN
+    // pass in width and height too:
+    ofRunApp(window, app);
+    return ofRunMainLoop();
+
+}
@@ -0,0 +1,169 @@
+#include "ofMain.h"
+#include "ofxKinectRecorder.h"
+#include "ofxKinectPlayer.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+public:
+    const int numFrames = 30;
+    vector<ofShortPixels> depthFrames;
+    vector<ofPixels> videoFrames;
+
+    // a moving gradient with noise, holes without data and a far wall
+    void makeFrames(){
+        for(int f = 0; f < numFrames; f++){
+            ofShortPixels depth;
+            depth.allocate(640, 480, 1);
+            ofPixels video;
+            video.allocate(640, 480, 3);
+            for(int y = 0; y < 480; y++){
+                for(int x = 0; x < 640; x++){
+                    unsigned short z = 800 + x + y / 2 + f * 10 + ofRandom(4);
+                    if(ofDist(x, y, 320 + f * 5, 240) < 60) z = 0;
+                    if(x > 560) z = 4000;
+                    depth[y * 640 + x] = z;
+                    video.setColor(x, y, ofColor(x / 3, y / 2, f * 8));
+                }
+            }
+            depthFrames.push_back(depth);
+            videoFrames.push_back(video);
+        }
+    }
+
+    bool sameFrame(ofxKinectPlayer & player, int f){
+        return memcmp(player.getRawDepthPixels().getData(), depthFrames[f].getData(), depthFrames[f].size() * 2) == 0 &&
+            memcmp(player.getPixels().getData(), videoFrames[f].getData(), videoFrames[f].size()) == 0;
+    }
+
+    void testCompression(){
+        vector<unsigned char> data;
+        vector<unsigned short> decoded(640 * 480);
+        size_t size = ofxKinectRecorder::compressDepth(depthFrames[0].getData(), 640, 480, data);
+        bool ok = ofxKinectRecorder::decompressDepth(&data[0], size, &decoded[0], 640, 480);
+        test(ok && memcmp(&decoded[0], depthFrames[0].getData(), decoded.size() * 2) == 0, "depth frame compresses losslessly");
+        ofLogNotice() << "depth frame compressed to " << size << " bytes, " << ofToString(depthFrames[0].size() * 2.0 / size, 1) << "x";
+
+        // random values are the worst case
+        vector<unsigned short> noise(641 * 3);
+        for(auto & z: noise) z = ofRandom(65536);
+        noise[0] = 65535;
+        noise[1] = 0;
+        size = ofxKinectRecorder::compressDepth(&noise[0], 641, 3, data);
+        ok = ofxKinectRecorder::decompressDepth(&data[0], size, &decoded[0], 641, 3);
+        test(ok && memcmp(&decoded[0], &noise[0], noise.size() * 2) == 0, "random values compress losslessly");
+
+        test(!ofxKinectRecorder::decompressDepth(&data[0], size - 1, &decoded[0], 641, 3), "truncated data is detected");
+    }
+
+    void testRecording(){
+        ofxKinectRecorder recorder;
+        recorder.setDepthCalibration(0.105, 121);
+        test(recorder.open("recording.ofxkinect"), "recording opens");
+        for(int f = 0; f < numFrames; f++){
+            recorder.addFrame(depthFrames[f], videoFrames[f], f * 33333);
+        }
+        ofShortPixels wrongSize;
+        wrongSize.allocate(320, 240, 1);
+        test(!recorder.addFrame(wrongSize, videoFrames[0], 0), "frames with a different size are rejected");
+        test_eq(recorder.getNumFrames(), numFrames, "frames recorded");
+        recorder.close();
+
+        ofxKinectPlayer player;
+        player.setUseTexture(false);
+        test(player.load("recording.ofxkinect"), "recording loads");
+        test_eq(player.getNumFrames(), numFrames, "player frame count");
+        test_eq(player.getPixelFormat(), OF_PIXELS_RGB, "player pixel format");
+        test_eq(player.getDepthProcessor().getReferenceDistance(), 121.f, "calibration is saved");
+        test_eq(player.getFrameTimestamp(10), 333330u, "timestamps are saved");
+        test(sameFrame(player, 0), "first frame is loaded");
+
+        // every frame in order
+        player.setRealtime(false);
+        player.setLoop(false);
+        player.play();
+        bool allNew = true;
+        bool allSame = true;
+        for(int f = 0; f < numFrames; f++){
+            player.update();
+            allNew &= player.isFrameNew() && player.getCurrentFrame() == f;
+            allSame &= sameFrame(player, f);
+        }
+        test(allNew, "every frame is new once when not playing in real time");
+        test(allSame, "every frame matches the recorded one");
+        player.update();
+        test(!player.isFrameNew() && !player.isPlaying(), "playback stops at the end without loop");
+
+        ofFloatPixels distance;
+        ofxKinectDepthProcessor::toDistance(depthFrames[numFrames - 1], distance);
+        test(memcmp(distance.getData(), player.getDistancePixels().getData(), distance.size() * sizeof(float)) == 0, "distance pixels");
+
+        // seeking
+        player.setFrame(7);
+        player.update();
+        test(player.isFrameNew() && player.getCurrentFrame() == 7 && sameFrame(player, 7), "seek to a frame");
+        player.setPosition(0.5);
+        player.update();
+        test(player.getCurrentFrame() == 14 && sameFrame(player, 14), "seek to a position");
+        player.previousFrame();
+        player.update();
+        test(sameFrame(player, 13), "previous frame");
+
+        // changing the clipping converts the same frame again
+        player.setDepthClipping(500, 2000);
+        player.update();
+        ofPixels gray;
+        ofxKinectDepthProcessor::toGray(depthFrames[13], gray, 500, 2000);
+        test(!player.isFrameNew() && memcmp(gray.getData(), player.getDepthPixels().getData(), gray.size()) == 0,
+             "depth clipping converts the current frame without a new frame");
+
+        // real time, the frames are 33ms apart
+        player.setRealtime(true);
+        player.setLoop(true);
+        player.firstFrame();
+        player.play();
+        player.update();
+        ofSleepMillis(100);
+        player.update();
+        test(player.getCurrentFrame() >= 2 && player.getCurrentFrame() < numFrames / 2 && sameFrame(player, player.getCurrentFrame()),
+             "real time playback follows the timestamps", "frame " + ofToString(player.getCurrentFrame()));
+
+        auto then = ofGetElapsedTimeMicros();
+        player.setRealtime(false);
+        for(int f = 0; f < numFrames; f++){
+            player.update();
+        }
+        ofLogNotice() << "decoding " << (ofGetElapsedTimeMicros() - then) / numFrames << "us per frame";
+        player.close();
+
+        // a recording that wasn't closed has no index
+        ofBuffer buffer = ofBufferFromFile("recording.ofxkinect", true);
+        size_t frameSize = buffer.size() / numFrames;
+        ofBuffer truncated(buffer.getData(), frameSize * 10);
+        ofBufferToFile("truncated.ofxkinect", truncated, true);
+        test(player.load("truncated.ofxkinect"), "recording without index loads");
+        test(player.getNumFrames() > 0 && player.getNumFrames() < 10, "complete frames of a recording without index", ofToString(player.getNumFrames()) + " frames");
+        player.setFrame(player.getNumFrames() - 1);
+        player.update();
+        test(sameFrame(player, player.getNumFrames() - 1), "last frame of a recording without index");
+    }
+
+    void run(){
+        makeFrames();
+        testCompression();
+        testRecording();
+    }
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+    auto window = make_shared<ofAppNoWindow>();
+    auto app = make_shared<ofApp>();
+    // this kicks off the running of my app
+    // can be OF_WINDOW or OF_FULLSCREEN
+    // pass in width and height too:
+    ofRunApp(window, app);
+    return ofRunMainLoop();
+
+}
@@ -0,0 +1,145 @@
+#include "ofMain.h"
+#include "ofxOpenCv.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+// largest difference between two images of the same type and size
+double maxDiff(IplImage * img1, IplImage * img2){
+    return cv::norm(cv::cvarrToMat(img1), cv::cvarrToMat(img2), cv::NORM_INF);
+}
+
+class ofApp: public ofxUnitTestsApp{
+public:
+    ofxCvGrayscaleImage source, banded, legacy, other;
+    IplImage * legacyResult;
+
+    void reset(){
+        banded = source;
+        legacy = source;
+    }
+
+    // runs op with bands and the original single call cv function on a copy
+    // of the source, checks the results match and logs the time for both
+    void compare(const string & name, std::function<void(ofxCvGrayscaleImage &)> op, std::function<void(IplImage *, IplImage *)> legacyOp, double tolerance = 0, int iterations = 20){
+        reset();
+        op(banded);
+        legacyOp(legacy.getCvImage(), legacyResult);
+        auto diff = maxDiff(banded.getCvImage(), legacyResult);
+        test(diff <= tolerance, name + " matches the legacy cv function", "max difference " + ofToString(diff));
+
+        auto then = ofGetElapsedTimeMicros();
+        for(int i=0;i<iterations;i++){
+            legacyOp(legacy.getCvImage(), legacyResult);
+        }
+        auto legacyTime = ofGetElapsedTimeMicros() - then;
+
+        then = ofGetElapsedTimeMicros();
+        for(int i=0;i<iterations;i++){
+            banded = source;
+            op(banded);
+        }
+        auto bandsTime = ofGetElapsedTimeMicros() - then;
+        ofLogNotice() << name << ": legacy " << legacyTime / iterations << "us, " << ofxCvImage::getNumBands() << " bands " << bandsTime / iterations << "us";
+    }
+
+    void run(){
+        const int w = 1920;
+        const int h = 1080;
+        ofPixels pixels;
+        pixels.allocate(w, h, OF_PIXELS_GRAY);
+        for(auto & p: pixels){
+            p = ofRandom(255);
+        }
+        source.setUseTexture(false);
+        banded.setUseTexture(false);
+        legacy.setUseTexture(false);
+        other.setUseTexture(false);
+        source.setFromPixels(pixels);
+        other.setFromPixels(pixels);
+        other.blur(5);
+        legacyResult = cvCreateImage(cvSize(w, h), IPL_DEPTH_8U, 1);
+
+        IplImage * mapX = cvCreateImage(cvSize(w, h), IPL_DEPTH_32F, 1);
+        IplImage * mapY = cvCreateImage(cvSize(w, h), IPL_DEPTH_32F, 1);
+        for(int y=0;y<h;y++){
+            for(int x=0;x<w;x++){
+                CV_IMAGE_ELEM(mapX, float, y, x) = x + 10 * sin(y * 0.05);
+                CV_IMAGE_ELEM(mapY, float, y, x) = y + 10 * cos(x * 0.05);
+            }
+        }
+
+        ofPoint A(100, 50), B(w - 20, 10), C(w - 100, h - 30), D(40, h - 80);
+        CvPoint2D32f cvsrc[4] = { {A.x, A.y}, {B.x, B.y}, {C.x, C.y}, {D.x, D.y} };
+        CvPoint2D32f cvdst[4] = { {0, 0}, {float(w), 0}, {float(w), float(h)}, {0, float(h)} };
+        CvMat * homography = cvCreateMat(3, 3, CV_32FC1);
+        cvGetPerspectiveTransform(cvsrc, cvdst, homography);
+
+        for(int numBands: {1, 0, 3, 8}){
+            ofxCvImage::setNumBands(numBands);
+            ofLogNotice() << "bands: " << numBands;
+            compare("erode", [](ofxCvGrayscaleImage & img){ img.erode(); },
+                    [](IplImage * src, IplImage * dst){ cvErode(src, dst, 0, 1); });
+            compare("dilate", [](ofxCvGrayscaleImage & img){ img.dilate(); },
+                    [](IplImage * src, IplImage * dst){ cvDilate(src, dst, 0, 1); });
+            compare("blur", [](ofxCvGrayscaleImage & img){ img.blur(9); },
+                    [](IplImage * src, IplImage * dst){ cvSmooth(src, dst, CV_BLUR, 9); });
+            compare("blurGaussian", [](ofxCvGrayscaleImage & img){ img.blurGaussian(9); },
+                    [](IplImage * src, IplImage * dst){ cvSmooth(src, dst, CV_GAUSSIAN, 9); });
+            compare("invert", [](ofxCvGrayscaleImage & img){ img.invert(); },
+                    [](IplImage * src, IplImage * dst){ cvNot(src, dst); });
+            compare("operator+=(float)", [](ofxCvGrayscaleImage & img){ img += 20; },
+                    [](IplImage * src, IplImage * dst){ cvAddS(src, cvScalar(20), dst); });
+            compare("operator-=(float)", [](ofxCvGrayscaleImage & img){ img -= 20; },
+                    [](IplImage * src, IplImage * dst){ cvSubS(src, cvScalar(20), dst); });
+            compare("operator+=(image)", [this](ofxCvGrayscaleImage & img){ img += other; },
+                    [this](IplImage * src, IplImage * dst){ cvAdd(src, other.getCvImage(), dst); });
+            compare("operator-=(image)", [this](ofxCvGrayscaleImage & img){ img -= other; },
+                    [this](IplImage * src, IplImage * dst){ cvSub(src, other.getCvImage(), dst); });
+            compare("operator*=(image)", [this](ofxCvGrayscaleImage & img){ img *= other; },
+                    [this](IplImage * src, IplImage * dst){ cvMul(src, other.getCvImage(), dst, 1.0f / 255.0f); });
+            compare("operator&=(image)", [this](ofxCvGrayscaleImage & img){ img &= other; },
+                    [this](IplImage * src, IplImage * dst){ cvAnd(src, other.getCvImage(), dst); });
+            compare("remap", [&](ofxCvGrayscaleImage & img){ img.remap(mapX, mapY); },
+                    [&](IplImage * src, IplImage * dst){ cvRemap(src, dst, mapX, mapY); });
+            // the inverse map is offset per band so interpolation can round differently
+            compare("warpPerspective", [&](ofxCvGrayscaleImage & img){ img.warpPerspective(A, B, C, D); },
+                    [&](IplImage * src, IplImage * dst){ cvWarpPerspective(src, dst, homography); }, 1);
+
+            // chained operations on a region of interest
+            reset();
+            banded.setROI(100, 100, 800, 600);
+            banded.blur(5);
+            banded.dilate();
+            banded += 10;
+            cvCopy(legacy.getCvImage(), legacyResult);
+            cvSetImageROI(legacyResult, cvRect(100, 100, 800, 600));
+            cvSetImageROI(legacy.getCvImage(), cvRect(100, 100, 800, 600));
+            cvSmooth(legacyResult, legacy.getCvImage(), CV_BLUR, 5);
+            cvDilate(legacy.getCvImage(), legacyResult, 0, 1);
+            cvAddS(legacyResult, cvScalar(10), legacyResult);
+            cvResetImageROI(legacyResult);
+            cvResetImageROI(legacy.getCvImage());
+            banded.resetROI();
+            test(maxDiff(banded.getCvImage(), legacyResult) == 0, "chained operations on a ROI match the legacy cv functions");
+        }
+
+        ofxCvImage::setNumBands(0);
+        cvReleaseMat(&homography);
+        cvReleaseImage(&mapX);
+        cvReleaseImage(&mapY);
+        cvReleaseImage(&legacyResult);
+    }
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+    auto window = make_shared<ofAppNoWindow>();
+    auto app = make_shared<ofApp>();
+    // this kicks off the running of my app
+    // can be OF_WINDOW or OF_FULLSCREEN
+    // pass in width and height too:
+    ofRunApp(window, app);
+    return ofRunMainLoop();
+
+}
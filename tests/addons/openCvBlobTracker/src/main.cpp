@@ -0,0 +1,217 @@
+#include "ofMain.h"
+#include "ofxOpenCv.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+public:
+    ofxCvGrayscaleImage frame;
+
+    void drawCircles(const vector<ofPoint> & centers, int radius){
+        cvSet(frame.getCvImage(), cvScalar(0));
+        for(auto & c: centers){
+            cvCircle(frame.getCvImage(), cvPoint(c.x, c.y), radius, cvScalar(255), CV_FILLED);
+        }
+        frame.flagImageChanged();
+    }
+
+    // blobs sorted by position so two searches can be compared regardless
+    // of the order of blobs with the same area
+    vector<ofxCvBlob> sorted(const vector<ofxCvBlob> & blobs){
+        auto result = blobs;
+        sort(result.begin(), result.end(), [](const ofxCvBlob & a, const ofxCvBlob & b){
+            return a.boundingRect.x < b.boundingRect.x || (a.boundingRect.x == b.boundingRect.x && a.boundingRect.y < b.boundingRect.y);
+        });
+        return result;
+    }
+
+    bool sameBlobs(const vector<ofxCvBlob> & blobs1, const vector<ofxCvBlob> & blobs2){
+        if(blobs1.size() != blobs2.size()) return false;
+        auto a = sorted(blobs1);
+        auto b = sorted(blobs2);
+        for(size_t i = 0; i < a.size(); i++){
+            if(a[i].area != b[i].area || a[i].boundingRect != b[i].boundingRect ||
+               a[i].centroid != b[i].centroid || a[i].hole != b[i].hole || a[i].pts != b[i].pts){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void testTracking(){
+        const int w = 320;
+        const int h = 240;
+        frame.setUseTexture(false);
+        frame.allocate(w, h);
+
+        ofxCvContourFinder finder;
+        ofxCvBlobTracker tracker;
+        vector<ofPoint> centers = { {40, 40}, {150, 120}, {260, 200} };
+        vector<ofPoint> speeds = { {3, 0}, {0, 2}, {-2, -2} };
+
+        drawCircles(centers, 10);
+        finder.findContours(frame, 20, w * h, 10, false);
+        tracker.track(finder);
+        test_eq(tracker.blobs.size(), 3u, "3 blobs tracked in the first frame");
+        test_eq(tracker.getNewIds().size(), 3u, "3 new ids in the first frame");
+
+        // ids by position in centers
+        vector<int> ids;
+        for(auto & c: centers){
+            int id = -1;
+            for(auto & blob: tracker.blobs){
+                if(blob.centroid.distance(c) < 1) id = blob.id;
+            }
+            ids.push_back(id);
+        }
+
+        bool idsKept = true;
+        bool velocitiesOk = true;
+        for(int f = 0; f < 10; f++){
+            for(size_t i = 0; i < centers.size(); i++){
+                centers[i] += speeds[i];
+            }
+            drawCircles(centers, 10);
+            finder.findContours(frame, 20, w * h, 10, false);
+            tracker.track(finder);
+            for(size_t i = 0; i < centers.size(); i++){
+                auto blob = tracker.getBlobById(ids[i]);
+                if(!blob || blob->centroid.distance(centers[i]) > 1){
+                    idsKept = false;
+                }else if(blob->velocity.distance(speeds[i]) > 0.5){
+                    velocitiesOk = false;
+                }
+            }
+        }
+        test(idsKept, "ids persist while blobs move");
+        test(velocitiesOk, "velocities match the displacement per frame");
+        test(tracker.getNewIds().empty(), "no new ids while blobs move");
+
+        // blob 1 disappears for 2 frames and comes back where it was heading
+        vector<ofPoint> hidden;
+        for(int f = 0; f < 2; f++){
+            for(size_t i = 0; i < centers.size(); i++){
+                centers[i] += speeds[i];
+            }
+            hidden = { centers[0], centers[2] };
+            drawCircles(hidden, 10);
+            finder.findContours(frame, 20, w * h, 10, false);
+            tracker.track(finder);
+        }
+        test_eq(tracker.blobs.size(), 2u, "hidden blob isn't reported");
+        test(tracker.getLostIds().empty(), "hidden blob is kept for maxLostFrames");
+        for(size_t i = 0; i < centers.size(); i++){
+            centers[i] += speeds[i];
+        }
+        drawCircles(centers, 10);
+        finder.findContours(frame, 20, w * h, 10, false);
+        tracker.track(finder);
+        auto blob = tracker.getBlobById(ids[1]);
+        test(blob && blob->centroid.distance(centers[1]) < 1, "blob reappearing gets its old id back");
+
+        // a blob jumping further than the max distance is a new one
+        centers[0] += ofPoint(100, 100);
+        drawCircles(centers, 10);
+        finder.findContours(frame, 20, w * h, 10, false);
+        tracker.track(finder);
+        test(tracker.getBlobById(ids[0]) == nullptr, "blob jumping further than the max distance loses its id");
+        test_eq(tracker.getNewIds().size(), 1u, "blob jumping further than the max distance gets a new id");
+
+        // blobs crossing: the assignment minimizes the total distance
+        tracker.reset();
+        centers = { {100, 100}, {120, 100} };
+        drawCircles(centers, 5);
+        finder.findContours(frame, 20, w * h, 10, false);
+        tracker.track(finder);
+        int left = tracker.blobs[0].centroid.x < tracker.blobs[1].centroid.x ? tracker.blobs[0].id : tracker.blobs[1].id;
+        centers = { {108, 100}, {128, 100} };
+        drawCircles(centers, 5);
+        finder.findContours(frame, 20, w * h, 10, false);
+        tracker.track(finder);
+        blob = tracker.getBlobById(left);
+        test(blob && blob->centroid.distance(centers[0]) < 1, "assignment minimizes the total distance");
+    }
+
+    void testDirtyRect(){
+        const int w = 640;
+        const int h = 480;
+        frame.setUseTexture(false);
+        frame.allocate(w, h);
+
+        vector<ofPoint> centers;
+        for(int y = 40; y < h; y += 80){
+            for(int x = 40; x < w; x += 80){
+                centers.emplace_back(x, y);
+            }
+        }
+
+        for(bool holes: {false, true}){
+            ofxCvContourFinder full, dirty;
+            auto current = centers;
+            drawCircles(current, 20);
+            if(holes){
+                for(auto & c: current){
+                    cvCircle(frame.getCvImage(), cvPoint(c.x, c.y), 8, cvScalar(0), CV_FILLED);
+                }
+            }
+            full.findContours(frame, 10, w * h, 1000, holes);
+            dirty.findContours(frame, ofRectangle(0, 0, w, h), 10, w * h, 1000, holes);
+            test(sameBlobs(full.blobs, dirty.blobs), string("first dirty search is a full search") + (holes ? " with holes" : ""));
+
+            bool same = true;
+            for(int f = 0; f < 20; f++){
+                // move one circle per frame, sometimes into a neighbour
+                int i = (f * 7) % current.size();
+                ofPoint before = current[i];
+                current[i] += ofPoint(f % 2 ? 45 : -12, f % 3 ? 9 : -40);
+                drawCircles(current, 20);
+                ofRectangle changed(before.x - 21, before.y - 21, 42, 42);
+                changed.growToInclude(ofRectangle(current[i].x - 21, current[i].y - 21, 42, 42));
+                full.findContours(frame, 10, w * h, 1000, holes);
+                dirty.findContours(frame, changed, 10, w * h, 1000, holes);
+                same &= sameBlobs(full.blobs, dirty.blobs);
+            }
+            test(same, string("dirty rect search matches the full search") + (holes ? " with holes" : ""));
+
+            // nothing changed
+            dirty.findContours(frame, ofRectangle(), 10, w * h, 1000, holes);
+            test(sameBlobs(full.blobs, dirty.blobs), string("empty dirty rect reuses the last blobs") + (holes ? " with holes" : ""));
+
+            // nConsidered only limits the output
+            dirty.findContours(frame, ofRectangle(), 10, w * h, 3, holes);
+            test_eq(dirty.blobs.size(), 3u, string("nConsidered limits the blobs of a dirty search") + (holes ? " with holes" : ""));
+            dirty.findContours(frame, ofRectangle(), 10, w * h, 1000, holes);
+            test_eq(dirty.blobs.size(), full.blobs.size(), string("blobs over nConsidered are still cached") + (holes ? " with holes" : ""));
+
+            auto then = ofGetElapsedTimeMicros();
+            for(int f = 0; f < 100; f++){
+                full.findContours(frame, 10, w * h, 1000, holes);
+            }
+            auto fullTime = ofGetElapsedTimeMicros() - then;
+            then = ofGetElapsedTimeMicros();
+            for(int f = 0; f < 100; f++){
+                dirty.findContours(frame, ofRectangle(300, 200, 20, 20), 10, w * h, 1000, holes);
+            }
+            auto dirtyTime = ofGetElapsedTimeMicros() - then;
+            ofLogNotice() << "full search " << fullTime / 100 << "us, dirty rect search " << dirtyTime / 100 << "us";
+        }
+    }
+
+    void run(){
+        testTracking();
+        testDirtyRect();
+    }
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+    auto window = make_shared<ofAppNoWindow>();
+    auto app = make_shared<ofApp>();
+    // this kicks off the running of my app
+    // can be OF_WINDOW or OF_FULLSCREEN
+    // pass in width and height too:
+    ofRunApp(window, app);
+    return ofRunMainLoop();
+
+}
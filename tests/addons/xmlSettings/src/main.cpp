@@ -0,0 +1,108 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+#include "ofxXmlSettings.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	const string document =
+		"<settings>"
+			"<name>show</name>"
+			"<cue id=\"0\"><time>1.5</time><light><channel>1</channel></light></cue>"
+			"<cue id=\"1\"><time>3</time><light><channel>2</channel></light></cue>"
+			"<cue id=\"2\"><time>4.25</time></cue>"
+		"</settings>";
+
+	void testRead(){
+		ofxXmlSettings xml;
+		test(xml.loadFromBuffer(document), "documents are loaded from a buffer");
+		test_eq(xml.getValue("settings:name", ""), "show", "values at a path");
+		test_eq(xml.getValue("settings::name", ""), "show", "empty tags in a path are skipped");
+		test(xml.tagExists("settings") && !xml.tagExists("cue") && !xml.tagExists(""), "tags that exist and don't");
+
+		test(xml.pushTag("settings"), "tags can be pushed");
+		test_eq(xml.getNumTags("cue"), 3, "the number of tags with a name");
+		test_eq(xml.getValue("cue:time", 0.0), 1.5, "the first tag with a name");
+		test_eq(xml.getValue("cue:time", 0.0, 2), 4.25, "the nth tag with a name");
+		test_eq(xml.getValue("cue:light:channel", 0, 1), 2, "paths below the nth tag");
+		test_eq(xml.getValue("cue:light:channel", 7, 2), 7, "missing values return the default");
+		test_eq(xml.getValue("cue:time", 0.0, -1), 1.5, "negative indices are the first tag");
+		test(xml.tagExists("cue", 2) && !xml.tagExists("cue", 3), "tags exist up to their number");
+		test_eq(xml.getAttribute("cue", "id", -1, 1), 1, "attributes of the nth tag");
+		test_eq(xml.getNumAttributes("cue", 2), 1, "the number of attributes");
+		test(xml.pushTag("cue", 1) && xml.getValue("time", 0.0) == 3.0 && xml.popTag() == 1, "the nth tag can be pushed");
+		xml.popTag();
+	}
+
+	void testWrite(){
+		ofxXmlSettings xml;
+		xml.loadFromBuffer(document);
+		xml.pushTag("settings");
+
+		// the index follows the changes of the document
+		xml.setValue("cue:time", 5.5, 2);
+		test_eq(xml.getValue("cue:time", 0.0, 2), 5.5, "values are read after changing them");
+		test_eq(xml.addValue("cue", "new"), 3, "added tags return their index");
+		test_eq(xml.getNumTags("cue"), 4, "added tags are counted");
+		test_eq(xml.getValue("cue", "", 3), "new", "added tags are found");
+		xml.setValue("cue:light:channel", 9, 2);
+		test_eq(xml.getValue("cue:light:channel", 0, 2), 9, "tags added inside other tags are found");
+		xml.removeTag("cue", 0);
+		test_eq(xml.getNumTags("cue"), 3, "removed tags aren't counted");
+		test_eq(xml.getValue("cue:time", 0.0), 3.0, "tags are found after removing another one");
+		test_eq(xml.getValue("cue:light:channel", 0, 1), 9, "indices are found after removing a tag");
+		xml.setValue("cue", "replaced", 1);
+		test(!xml.tagExists("cue:light", 1) && xml.getValue("cue", "", 1) == "replaced", "setting a value removes the tags inside");
+		test_eq(xml.getValue("cue:time", 0.0), 3.0, "other tags are found after replacing one");
+		xml.setAttribute("cue", "id", 10, 2);
+		test_eq(xml.getAttribute("cue", "id", -1, 2), 10, "attributes are read after changing them");
+		xml.clear();
+		test(!xml.tagExists("cue") && xml.getNumTags("cue") == 0, "nothing is found after clearing");
+		xml.popTag();
+
+		xml.loadFromBuffer("<other><cue>a</cue></other>");
+		test(!xml.tagExists("settings") && xml.getValue("other:cue", "") == "a", "loading another document resets the index");
+
+		// changing the document directly needs the index to be built again
+		xml.pushTag("other");
+		xml.doc.RootElement()->Clear();
+		xml.invalidateIndex();
+		test_eq(xml.getNumTags("cue"), 0, "the index is built again after changing the document");
+	}
+
+	void testParameters(){
+		ofParameterGroup group, light;
+		ofParameter<float> intensity;
+		ofParameter<int> channel;
+		light.setName("light");
+		light.add(intensity.set("intensity", 0.5), channel.set("channel", 3));
+		group.setName("show");
+		group.add(light);
+
+		ofxXmlSettings xml;
+		xml.serialize(group);
+		intensity = 0;
+		channel = 0;
+		xml.deserialize(group);
+		test(intensity.get() == 0.5f && channel.get() == 3, "groups are saved and loaded");
+		intensity = 0.75;
+		xml.serialize(group);
+		test_eq(xml.getValue("show:light:intensity", 0.0), 0.75, "saving a group again replaces its values");
+		test_eq(xml.getNumTags("show"), 1, "saving a group again doesn't add tags");
+	}
+
+	void run(){
+		testRead();
+		testWrite();
+		testParameters();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
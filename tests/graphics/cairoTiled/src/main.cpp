@@ -0,0 +1,111 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	// largest difference between two images of the same size
+	int maxDiff(const ofPixels & p1, const ofPixels & p2){
+		int diff = 0;
+		for(int i=0;i<p1.size();i++){
+			diff = std::max(diff, abs(int(p1[i]) - int(p2[i])));
+		}
+		return diff;
+	}
+
+	ofPixels drawSingle(const ofRecordingRenderer & recording, int w, int h){
+		ofCairoRenderer renderer;
+		renderer.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, w, h));
+		renderer.startRender();
+		recording.replay(renderer);
+		renderer.finishRender();
+		return renderer.getImageSurfacePixels();
+	}
+
+	ofPixels drawTiled(const ofRecordingRenderer & recording, int w, int h, int tileW, int tileH, int numThreads){
+		ofCairoRenderer renderer;
+		renderer.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, w, h));
+		renderer.startRender();
+		renderer.drawTiled(recording, tileW, tileH, numThreads);
+		renderer.finishRender();
+		return renderer.getImageSurfacePixels();
+	}
+
+	void run(){
+		const int w = 500;
+		const int h = 300;
+
+		ofRecordingRenderer recording;
+		recording.setup(w, h);
+		recording.background(ofColor(30, 40, 50));
+		ofSeedRandom(0);
+		for(int i=0;i<200;i++){
+			recording.setColor(ofColor(ofRandom(255), ofRandom(255), ofRandom(255), ofRandom(100, 255)));
+			recording.setFillMode(i % 3 ? OF_FILLED : OF_OUTLINE);
+			recording.setLineWidth(ofRandom(1, 5));
+			recording.drawCircle(ofRandom(w), ofRandom(h), 0, ofRandom(5, 60));
+		}
+		recording.pushMatrix();
+		recording.translate(w / 2, h / 2);
+		recording.rotate(30, 0, 0, 1);
+		recording.setFillMode(OF_FILLED);
+		recording.setColor(255, 255, 255, 128);
+		recording.drawRectangle(-150, -40, 0, 300, 80);
+		recording.popMatrix();
+
+		ofPath path;
+		path.moveTo(20, 280);
+		path.bezierTo(150, 0, 350, 300, 480, 20);
+		path.lineTo(480, 280);
+		path.close();
+		path.setFillColor(ofColor(200, 100, 0, 180));
+		path.setStrokeColor(ofColor::white);
+		path.setStrokeWidth(2);
+		recording.draw(path);
+
+		for(int i=0;i<20;i++){
+			recording.drawLine(0, i * 15, 0, w, h - i * 15, 0);
+		}
+
+		auto single = drawSingle(recording, w, h);
+		test_eq(single.getWidth(), w, "single threaded output has the surface width");
+
+		for(int numThreads: {1, 4, 0}){
+			auto tiled = drawTiled(recording, w, h, 64, 64, numThreads);
+			test_eq(tiled.getWidth(), single.getWidth(), "tiled output has the surface width");
+			test_eq(tiled.getHeight(), single.getHeight(), "tiled output has the surface height");
+			auto diff = maxDiff(tiled, single);
+			test(diff <= 1, "tiled output with " + ofToString(numThreads) + " threads matches the single threaded output", "max difference " + ofToString(diff));
+		}
+
+		// tiles that don't divide the surface and tiles bigger than it
+		auto uneven = drawTiled(recording, w, h, 77, 41, 3);
+		auto diff = maxDiff(uneven, single);
+		test(diff <= 1, "tiles not dividing the surface match the single threaded output", "max difference " + ofToString(diff));
+		auto whole = drawTiled(recording, w, h, 1024, 1024, 4);
+		diff = maxDiff(whole, single);
+		test(diff <= 1, "one tile bigger than the surface matches the single threaded output", "max difference " + ofToString(diff));
+
+		// the recording starts from the renderer's style
+		ofRecordingRenderer rectangle;
+		rectangle.drawRectangle(10, 10, 0, 20, 20);
+		ofCairoRenderer renderer;
+		renderer.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, 64, 64));
+		renderer.setColor(ofColor::red);
+		renderer.startRender();
+		renderer.drawTiled(rectangle, 16, 16, 2);
+		renderer.finishRender();
+		auto & pixels = renderer.getImageSurfacePixels();
+		test_eq(pixels.getColor(15, 15), ofColor::red, "tiles are drawn with the renderer's current color");
+		test_eq(int(pixels.getColor(40, 40).a), 0, "pixels outside the recording are untouched");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
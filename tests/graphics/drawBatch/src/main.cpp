@@ -0,0 +1,173 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+// stands in for a renderer, records the meshes the batch draws and the
+// model view matrix they are drawn with
+class RecordingRenderer: public ofRendererCollection{
+public:
+	struct DrawCall{
+		ofMesh mesh;
+		ofMatrix4x4 modelView;
+	};
+
+	RecordingRenderer(ofDrawBatch & batch)
+	:batch(batch){}
+
+	void draw(const ofMesh & mesh, ofPolyRenderMode mode, bool useColors, bool useTextures, bool useNormals) const{
+		// a real renderer flushes before drawing anything else
+		batch.flush(const_cast<RecordingRenderer&>(*this));
+		drawCalls.push_back({mesh, modelViews.back()});
+	}
+	void pushMatrix(){
+		modelViews.push_back(modelViews.back());
+	}
+	void popMatrix(){
+		modelViews.pop_back();
+	}
+	void loadIdentityMatrix(){
+		modelViews.back().makeIdentityMatrix();
+	}
+	void translate(float x, float y, float z){
+		modelViews.back().glTranslate(x, y, z);
+	}
+
+	ofDrawBatch & batch;
+	mutable vector<DrawCall> drawCalls;
+	vector<ofMatrix4x4> modelViews{ofMatrix4x4()};
+};
+
+class ofApp: public ofxUnitTestsApp{
+
+	ofMesh primitive(ofPrimitiveMode mode, int numVertices){
+		ofMesh mesh;
+		mesh.setMode(mode);
+		for(int i=0;i<numVertices;i++){
+			mesh.addVertex(ofVec3f(i, i * i, 0));
+		}
+		return mesh;
+	}
+
+	ofMesh rectangle(float x, float y, float w, float h, bool fill){
+		ofMesh mesh;
+		mesh.setMode(fill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP);
+		mesh.addVertex(ofVec3f(x, y, 0));
+		mesh.addVertex(ofVec3f(x + w, y, 0));
+		mesh.addVertex(ofVec3f(x + w, y + h, 0));
+		mesh.addVertex(ofVec3f(x, y + h, 0));
+		return mesh;
+	}
+
+	void run(){
+		ofDrawBatch batch;
+		RecordingRenderer renderer(batch);
+		ofMatrix4x4 identity;
+		ofColor white(255), red(255, 0, 0);
+
+		// same state, nothing is drawn until the batch is flushed
+		for(int i=0;i<100;i++){
+			batch.add(renderer, rectangle(i, i, 10, 10, true), identity, white, 1, OF_BLENDMODE_ALPHA);
+		}
+		test_eq(renderer.drawCalls.size(), 0u, "primitives with the same state are not drawn while batching");
+		test_eq(batch.getNumPrimitives(), 100u, "batch has every primitive");
+		test_eq(batch.getNumVertices(), 400u, "batch has every vertex");
+		batch.flush(renderer);
+		test_eq(renderer.drawCalls.size(), 1u, "flushing draws the batch in one call");
+		test(batch.isEmpty(), "flushing empties the batch");
+		test_eq(renderer.drawCalls[0].mesh.getMode(), OF_PRIMITIVE_TRIANGLES, "filled primitives are drawn as triangles");
+		test_eq(renderer.drawCalls[0].mesh.getNumIndices(), 600u, "a fan of 4 vertices is 2 triangles");
+		test(renderer.drawCalls[0].modelView.isIdentity(), "the batch is drawn with the model view set to identity");
+		test_eq(renderer.modelViews.size(), 1u, "flushing leaves the matrix stack balanced");
+		batch.flush(renderer);
+		test_eq(renderer.drawCalls.size(), 1u, "flushing an empty batch draws nothing");
+
+		// state changes
+		renderer.drawCalls.clear();
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), identity, white, 1, OF_BLENDMODE_ALPHA);
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), identity, red, 1, OF_BLENDMODE_ALPHA);
+		test_eq(renderer.drawCalls.size(), 1u, "a color change flushes the batch");
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), identity, red, 1, OF_BLENDMODE_ADD);
+		test_eq(renderer.drawCalls.size(), 2u, "a blend mode change flushes the batch");
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), identity, red, 3, OF_BLENDMODE_ADD);
+		test_eq(renderer.drawCalls.size(), 2u, "the line width doesn't matter for triangles");
+		batch.add(renderer, rectangle(0, 0, 10, 10, false), identity, red, 3, OF_BLENDMODE_ADD);
+		test_eq(renderer.drawCalls.size(), 3u, "changing from triangles to lines flushes the batch");
+		batch.add(renderer, primitive(OF_PRIMITIVE_LINES, 2), identity, red, 3, OF_BLENDMODE_ADD);
+		test_eq(renderer.drawCalls.size(), 3u, "lines and line loops share a batch");
+		batch.add(renderer, primitive(OF_PRIMITIVE_LINES, 2), identity, red, 1, OF_BLENDMODE_ADD);
+		test_eq(renderer.drawCalls.size(), 4u, "a line width change flushes a batch of lines");
+		test_eq(renderer.drawCalls[3].mesh.getMode(), OF_PRIMITIVE_LINES, "outlines are drawn as lines");
+		test_eq(renderer.drawCalls[3].mesh.getNumIndices(), 10u, "a loop of 4 vertices and a line are 5 segments");
+		batch.flush(renderer);
+
+		// maximum size
+		renderer.drawCalls.clear();
+		batch.setMaxVertices(40);
+		for(int i=0;i<25;i++){
+			batch.add(renderer, rectangle(i, i, 10, 10, true), identity, white, 1, OF_BLENDMODE_ALPHA);
+		}
+		batch.flush(renderer);
+		test_eq(renderer.drawCalls.size(), 3u, "the batch is drawn when it reaches the maximum number of vertices");
+		bool underMax = true;
+		for(auto & call: renderer.drawCalls){
+			underMax &= call.mesh.getNumVertices() <= 40;
+		}
+		test(underMax, "batches don't exceed the maximum number of vertices");
+		batch.setMaxVertices(65535);
+
+		// transformations
+		renderer.drawCalls.clear();
+		ofMatrix4x4 transform;
+		transform.glTranslate(100, 50, 0);
+		transform.glScale(2, 2, 1);
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), identity, white, 1, OF_BLENDMODE_ALPHA);
+		batch.add(renderer, rectangle(0, 0, 10, 10, true), transform, white, 1, OF_BLENDMODE_ALPHA);
+		test_eq(renderer.drawCalls.size(), 0u, "a transformation doesn't flush the batch");
+		batch.flush(renderer);
+		auto & vertices = renderer.drawCalls[0].mesh.getVertices();
+		test_eq(vertices[0], ofVec3f(0, 0, 0), "untransformed vertex");
+		test_eq(vertices[4], ofVec3f(100, 50, 0), "transformed vertex");
+		test_eq(vertices[6], ofVec3f(120, 70, 0), "transformed and scaled vertex");
+
+		// primitive modes
+		struct ModeTest{
+			ofPrimitiveMode mode;
+			vector<ofIndexType> indices;
+			string name;
+		};
+		vector<ModeTest> modes = {
+			{OF_PRIMITIVE_TRIANGLES, {0,1,2, 3,4,5}, "triangles"},
+			{OF_PRIMITIVE_TRIANGLE_STRIP, {0,1,2, 2,1,3, 2,3,4, 4,3,5}, "triangle strip"},
+			{OF_PRIMITIVE_TRIANGLE_FAN, {0,1,2, 0,2,3, 0,3,4, 0,4,5}, "triangle fan"},
+			{OF_PRIMITIVE_LINES, {0,1, 2,3, 4,5}, "lines"},
+			{OF_PRIMITIVE_LINE_STRIP, {0,1, 1,2, 2,3, 3,4, 4,5}, "line strip"},
+			{OF_PRIMITIVE_LINE_LOOP, {0,1, 1,2, 2,3, 3,4, 4,5, 5,0}, "line loop"},
+		};
+		for(auto & modeTest: modes){
+			renderer.drawCalls.clear();
+			// an offset primitive checks the indices are shifted
+			batch.add(renderer, primitive(OF_PRIMITIVE_LINES, 2), identity, white, 1, OF_BLENDMODE_ALPHA);
+			batch.flush(renderer);
+			renderer.drawCalls.clear();
+			batch.add(renderer, primitive(modeTest.mode, 6), identity, white, 1, OF_BLENDMODE_ALPHA);
+			batch.add(renderer, primitive(modeTest.mode, 6), identity, white, 1, OF_BLENDMODE_ALPHA);
+			batch.flush(renderer);
+			auto expected = modeTest.indices;
+			for(auto index: modeTest.indices){
+				expected.push_back(index + 6);
+			}
+			test(renderer.drawCalls[0].mesh.getIndices() == expected, modeTest.name + " converted to indexed primitives");
+		}
+		test(!ofDrawBatch::isBatchable(OF_PRIMITIVE_POINTS), "points can't be batched");
+		test_eq(batch.getNumFlushes(), 22u, "every flush is counted");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
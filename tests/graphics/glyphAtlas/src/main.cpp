@@ -0,0 +1,140 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	ofPixels glyph(int width, int height, unsigned char value){
+		ofPixels pixels;
+		pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+		pixels.set(0, 255);
+		pixels.set(1, value);
+		return pixels;
+	}
+
+	bool overlap(const ofGlyphAtlas::Region & r1, const ofGlyphAtlas::Region & r2, int padding){
+		return r1.page == r2.page &&
+			r1.x - padding < r2.x + r2.width + padding && r2.x - padding < r1.x + r1.width + padding &&
+			r1.y - padding < r2.y + r2.height + padding && r2.y - padding < r1.y + r1.height + padding;
+	}
+
+	void run(){
+		ofGlyphAtlas atlas;
+		atlas.setup(64, 64, 2);
+
+		// packing
+		vector<ofGlyphAtlas::Region> regions;
+		bool allAdded = true;
+		for(uint32_t i = 0; i < 36; i++){
+			auto region = atlas.add(i, glyph(8, 8, i + 1));
+			allAdded &= region != nullptr;
+			if(region) regions.push_back(*region);
+		}
+		test(allAdded, "36 glyphs of 10x10 pixels with padding fit in a 64x64 page");
+		test_eq(atlas.getNumPages(), 1u, "glyphs that fit in one page only use one page");
+		test_eq(atlas.getNumGlyphs(), 36u, "every glyph is in the atlas");
+		bool overlaps = false;
+		bool inside = true;
+		for(size_t i = 0; i < regions.size(); i++){
+			inside &= regions[i].x >= 1 && regions[i].y >= 1 && regions[i].x + regions[i].width <= 63 && regions[i].y + regions[i].height <= 63;
+			for(size_t j = i + 1; j < regions.size(); j++){
+				overlaps |= overlap(regions[i], regions[j], atlas.getPadding());
+			}
+		}
+		test(!overlaps, "glyphs and their padding don't overlap");
+		test(inside, "glyphs are inside the page");
+
+		const ofPixels & page = atlas.getPage(0);
+		auto r = *atlas.find(7);
+		test_eq(int(page.getColor(r.x, r.y).a), 8, "glyph pixels are copied to the page");
+		test_eq(int(page.getColor(r.x - 1, r.y).a), 0, "padding is transparent");
+		test(atlas.isPageDirty(0), "adding glyphs marks the page dirty");
+		atlas.markPageClean(0);
+		test(!atlas.isPageDirty(0), "markPageClean clears the dirty flag");
+
+		ofGlyphAtlas shelves;
+		shelves.setup(64, 64, 1);
+		auto tall = *shelves.add(1, glyph(8, 20, 1));
+		auto small = *shelves.add(2, glyph(8, 8, 1));
+		auto medium = *shelves.add(3, glyph(8, 16, 1));
+		test(small.y > tall.y + tall.height, "small glyphs don't go in much taller shelves");
+		test_eq(medium.y, tall.y, "glyphs go in shelves a bit taller than them");
+
+		// new pages
+		atlas.beginBatch();
+		for(uint32_t i = 36; i < 72; i++){
+			atlas.add(i, glyph(8, 8, i + 1));
+		}
+		test_eq(atlas.getNumPages(), 2u, "a second page is added when the first is full");
+		test_eq(atlas.getNumEvictions(), 0u, "nothing is evicted while there are pages left");
+		test(atlas.isPageDirty(1), "the new page is dirty");
+		test(!atlas.isPageDirty(0), "pages that didn't change stay clean");
+
+		// lru eviction
+		atlas.beginBatch();
+		for(uint32_t i = 1; i < 72; i++){
+			atlas.find(i);
+		}
+		atlas.beginBatch();
+		auto evicting = atlas.add(1000, glyph(8, 8, 200));
+		test(evicting != nullptr, "glyphs are added when the atlas is full");
+		test(!atlas.contains(0), "the least recently used glyph is evicted");
+		test(atlas.contains(1), "recently used glyphs are kept");
+		test_eq(atlas.getNumEvictions(), 1u, "only one glyph is evicted to make room for one of the same size");
+		test_eq(int(atlas.getPage(evicting->page).getColor(evicting->x, evicting->y).a), 200, "the new glyph replaces the evicted one");
+
+		auto big = atlas.add(1001, glyph(20, 11, 100));
+		test(big != nullptr, "a bigger glyph evicts several neighbours");
+		test(atlas.getNumEvictions() > 1u, "several glyphs were evicted for a bigger glyph");
+
+		// glyphs used in the current batch are protected
+		ofGlyphAtlas inUse;
+		inUse.setup(16, 16, 1, OF_PIXELS_GRAY_ALPHA, 0);
+		inUse.beginBatch();
+		inUse.add(1, glyph(16, 8, 1));
+		inUse.add(2, glyph(16, 8, 2));
+		test(inUse.add(3, glyph(16, 8, 3)) == nullptr, "glyphs used in the current batch aren't evicted");
+		test(inUse.contains(1) && inUse.contains(2), "a failed add doesn't evict glyphs in use");
+		inUse.beginBatch();
+		test(inUse.add(3, glyph(16, 8, 3)) != nullptr, "glyphs from previous batches are evicted");
+		test(!inUse.contains(1), "the oldest glyph was evicted");
+
+		// pinned glyphs are never evicted
+		ofGlyphAtlas pinned;
+		pinned.setup(16, 16, 1, OF_PIXELS_GRAY_ALPHA, 0);
+		pinned.add(1, glyph(16, 8, 1), true);
+		pinned.add(2, glyph(16, 8, 2));
+		pinned.beginBatch();
+		test(pinned.add(3, glyph(16, 8, 3)) != nullptr, "unpinned glyphs are evicted");
+		test(pinned.contains(1) && !pinned.contains(2), "the pinned glyph is kept");
+		pinned.beginBatch();
+		test(pinned.add(4, glyph(16, 16, 4)) == nullptr, "pinned glyphs leave no space for a glyph that needs the whole page");
+
+		// errors
+		test(atlas.add(2000, glyph(100, 10, 1)) == nullptr, "glyphs bigger than a page are rejected");
+		ofPixels rgb;
+		rgb.allocate(4, 4, OF_PIXELS_RGB);
+		test(atlas.add(2001, rgb) == nullptr, "glyphs in a different format are rejected");
+		auto empty = atlas.add(' ', ofPixels());
+		test(empty != nullptr && empty->width == 0, "empty glyphs are added without taking space");
+
+		// copies are independent and keep working
+		ofGlyphAtlas copy = atlas;
+		bool allAddedToCopy = true;
+		for(uint32_t i = 3000; i < 3100; i++){
+			copy.beginBatch();
+			allAddedToCopy &= copy.add(i, glyph(8, 8, 1)) != nullptr;
+		}
+		test(allAddedToCopy, "glyphs are evicted from a copy of a full atlas");
+		test(atlas.contains(1000) && !copy.contains(1000), "evicting from a copy doesn't change the original");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,213 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	// star shaped polygon with noisy radius so it's concave in many places
+	ofPolyline star(int numVertices, float z = 0){
+		ofPolyline polyline;
+		for(int i=0;i<numVertices;i++){
+			float angle = TWO_PI * i / numVertices;
+			float radius = 200 + 100 * sin(angle * 7) + ofRandom(-20, 20);
+			polyline.addVertex(300 + radius * cos(angle), 300 + radius * sin(angle), z * ofRandom(-1, 1));
+		}
+		polyline.close();
+		return polyline;
+	}
+
+	vector<ofPoint> randomPoints(int numPoints, float z = 0){
+		vector<ofPoint> points;
+		for(int i=0;i<numPoints;i++){
+			points.emplace_back(ofRandom(-50, 650), ofRandom(-50, 650), ofRandom(-z, z));
+		}
+		return points;
+	}
+
+	// a polyline that hasn't been queried yet tests every segment
+	ofPolyline fresh(const ofPolyline & polyline){
+		ofPolyline copy(polyline.getVertices());
+		copy.setClosed(polyline.isClosed());
+		return copy;
+	}
+
+	// compares every cached value against a copy that computes them from
+	// scratch
+	bool sameCache(const ofPolyline & polyline){
+		auto expected = fresh(polyline);
+		expected.setRightVector(polyline.getRightVector());
+		if(polyline.getPerimeter() != expected.getPerimeter() ||
+		   polyline.getArea() != expected.getArea() ||
+		   polyline.getCentroid2D() != expected.getCentroid2D()){
+			return false;
+		}
+		for(int i=0;i<(int)polyline.size();i++){
+			if(polyline.getLengthAtIndex(i) != expected.getLengthAtIndex(i) ||
+			   polyline.getTangentAtIndex(i) != expected.getTangentAtIndex(i) ||
+			   polyline.getNormalAtIndex(i) != expected.getNormalAtIndex(i) ||
+			   polyline.getRotationAtIndex(i) != expected.getRotationAtIndex(i) ||
+			   polyline.getAngleAtIndex(i) != expected.getAngleAtIndex(i)){
+				return false;
+			}
+		}
+		return polyline.getPointAtPercent(0.3) == expected.getPointAtPercent(0.3);
+	}
+
+	void testCache(bool closed){
+		string name = closed ? "closed polyline: " : "open polyline: ";
+		ofPolyline polyline;
+		polyline.setClosed(closed);
+		bool same = true;
+		for(int i=0;i<200;i++){
+			polyline.addVertex(ofRandom(100), ofRandom(100), ofRandom(10));
+			// only some of the values are queried so the others fall behind
+			if(i % 3 == 0){
+				polyline.getPerimeter();
+			}
+			if(i % 5 == 0){
+				polyline.getArea();
+			}
+			if(i % 7 == 0){
+				polyline.getNormalAtIndex(0);
+			}
+			if(i % 11 == 0){
+				same &= sameCache(polyline);
+			}
+		}
+		test(same, name + "values extended after addVertex match computing them from scratch");
+
+		polyline.addVertices(randomPoints(50));
+		polyline.lineTo(10, 20);
+		polyline.bezierTo(20, 30, 40, 50, 60, 70);
+		polyline.curveTo(80, 90);
+		polyline.curveTo(100, 90);
+		polyline.arc(50, 50, 20, 20, 0, 90);
+		test(sameCache(polyline), name + "values after adding curves match computing them from scratch");
+
+		polyline[0].x += 5;
+		test(sameCache(polyline), name + "values after changing the first vertex match computing them from scratch");
+		polyline[polyline.size() / 2].y += 5;
+		test(sameCache(polyline), name + "values after changing a vertex match computing them from scratch");
+		polyline[polyline.size() - 1].y += 5;
+		test(sameCache(polyline), name + "values after changing the last vertex match computing them from scratch");
+		polyline.insertVertex(ofPoint(1, 2), 10);
+		test(sameCache(polyline), name + "values after inserting a vertex match computing them from scratch");
+		polyline.resize(polyline.size() - 20);
+		test(sameCache(polyline), name + "values after removing vertices match computing them from scratch");
+		polyline.setRightVector(ofVec3f(0, 1, 0));
+		test(sameCache(polyline), name + "values after changing the right vector match computing them from scratch");
+		polyline.setClosed(!closed);
+		test(sameCache(polyline), name + "values after changing closed match computing them from scratch");
+		polyline.simplify(5);
+		test(sameCache(polyline), name + "values after simplify match computing them from scratch");
+	}
+
+	void testClosestPoints(const ofPolyline & polyline, const vector<ofPoint> & targets, const string & name){
+		vector<ofPoint> closest;
+		vector<unsigned int> indices;
+		polyline.getClosestPoints(targets, closest, &indices);
+		bool same = true;
+		bool sameSingle = true;
+		for(size_t i=0;i<targets.size();i++){
+			unsigned int expectedIndex;
+			auto expected = fresh(polyline).getClosestPoint(targets[i], &expectedIndex);
+			same &= expected == closest[i] && expectedIndex == indices[i];
+			unsigned int index;
+			auto single = polyline.getClosestPoint(targets[i], &index);
+			sameSingle &= expected == single && expectedIndex == index;
+		}
+		test(same, name + ": getClosestPoints matches testing every segment");
+		test(sameSingle, name + ": repeated getClosestPoint matches testing every segment");
+	}
+
+	void testInside(const ofPolyline & polyline, const vector<ofPoint> & points, const string & name){
+		vector<bool> result;
+		polyline.inside(points, result);
+		bool same = true;
+		bool sameSingle = true;
+		int numInside = 0;
+		for(size_t i=0;i<points.size();i++){
+			bool expected = ofInsidePoly(points[i], polyline.getVertices());
+			same &= result[i] == expected;
+			sameSingle &= polyline.inside(points[i]) == expected;
+			numInside += expected;
+		}
+		test(numInside > 0 && numInside < int(points.size()), name + ": some points are inside and some outside");
+		test(same, name + ": batch inside matches testing every edge");
+		test(sameSingle, name + ": repeated inside matches testing every edge");
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testCache(false);
+		testCache(true);
+
+		auto polygon = star(5000);
+		auto targets = randomPoints(2000);
+		testClosestPoints(polygon, targets, "closed polyline");
+		testInside(polygon, targets, "closed polyline");
+
+		auto open = polygon;
+		open.setClosed(false);
+		testClosestPoints(open, targets, "open polyline");
+
+		auto polygon3d = star(3000, 100);
+		testClosestPoints(polygon3d, randomPoints(1000, 200), "3d polyline");
+
+		// targets on the vertices have to be found exactly
+		vector<ofPoint> onVertices(polygon.begin(), polygon.begin() + 100);
+		testClosestPoints(polygon, onVertices, "targets on the vertices");
+
+		// horizontal and vertical edges and points on them
+		ofPolyline grid;
+		for(int i=0;i<100;i++){
+			grid.addVertex(i * 10, (i % 2) * 10);
+			grid.addVertex(i * 10 + 5, (i % 2) * 10);
+		}
+		grid.addVertex(1000, 100);
+		grid.addVertex(0, 100);
+		grid.close();
+		vector<ofPoint> gridPoints;
+		for(int y=-5;y<=105;y+=5){
+			for(int x=-5;x<=1005;x+=5){
+				gridPoints.emplace_back(x, y);
+			}
+		}
+		testClosestPoints(grid, gridPoints, "axis aligned edges");
+		testInside(grid, gridPoints, "axis aligned edges");
+
+		// a line with no height
+		ofPolyline flat;
+		for(int i=0;i<200;i++){
+			flat.addVertex(i, 50);
+		}
+		testClosestPoints(flat, randomPoints(200), "horizontal line");
+
+		// changing the polyline discards the index
+		auto moved = polygon;
+		moved.inside(targets[0]);
+		moved.inside(targets[0]);
+		for(auto & p: moved.getVertices()){
+			p.x += 100;
+		}
+		bool same = true;
+		for(auto & p: targets){
+			same &= moved.inside(p) == ofInsidePoly(p, moved.getVertices());
+		}
+		test(same, "modifying the vertices rebuilds the index");
+
+		vector<bool> result;
+		ofPolyline().inside(targets, result);
+		test_eq(result.size(), targets.size(), "empty polyline returns one result per point");
+		test(std::find(result.begin(), result.end(), true) == result.end(), "no point is inside an empty polyline");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
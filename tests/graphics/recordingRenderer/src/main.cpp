@@ -0,0 +1,166 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool equal(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2){
+		for(int i=0;i<16;i++){
+			if(abs(m1.getPtr()[i] - m2.getPtr()[i]) > 0.0001){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	string bytes(const ofRecordingRenderer & recording){
+		ofBuffer buffer;
+		recording.save(buffer);
+		return string(buffer.getData(), buffer.size());
+	}
+
+	void drawScene(ofRecordingRenderer & renderer){
+		ofMesh quad;
+		quad.setMode(OF_PRIMITIVE_TRIANGLE_STRIP);
+		quad.addVertex(ofVec3f(0, 0, 0));
+		quad.addVertex(ofVec3f(10, 0, 0));
+		quad.addVertex(ofVec3f(0, 10, 0));
+		quad.addVertex(ofVec3f(10, 10, 0));
+		quad.addColor(ofFloatColor::red);
+		quad.addColor(ofFloatColor::green);
+		quad.addColor(ofFloatColor::blue);
+		quad.addColor(ofFloatColor::white);
+
+		ofPolyline line;
+		line.addVertex(0, 0);
+		line.addVertex(100, 20);
+		line.addVertex(50, 80);
+		line.close();
+
+		ofPath path;
+		path.moveTo(10, 10);
+		path.lineTo(60, 10);
+		path.bezierTo(70, 20, 70, 40, 60, 50);
+		path.arc(30, 30, 20, 20, 0, 180);
+		path.close();
+		path.setFillColor(ofColor::orange);
+
+		renderer.setupGraphicDefaults();
+		renderer.background(ofColor(20));
+		renderer.setColor(255, 0, 0);
+		renderer.drawRectangle(10, 10, 0, 100, 50);
+		renderer.pushMatrix();
+		renderer.translate(200, 100);
+		renderer.rotate(45, 0, 0, 1);
+		renderer.scale(2, 2);
+		for(int i=0;i<100;i++){
+			renderer.draw(quad, OF_MESH_FILL, true, false, false);
+		}
+		renderer.popMatrix();
+		renderer.pushStyle();
+		renderer.setFillMode(OF_OUTLINE);
+		renderer.setLineWidth(3);
+		renderer.draw(line);
+		renderer.draw(line);
+		renderer.popStyle();
+		renderer.draw(path);
+		renderer.drawCircle(300, 300, 0, 40);
+		renderer.drawString("hello", 20, 20, 0);
+		renderer.drawString("hello", 20, 40, 0);
+		renderer.drawString("world", 20, 60, 0);
+		renderer.pushView();
+		renderer.viewport(0, 0, 100, 100);
+		renderer.drawLine(0, 0, 0, 100, 100, 0);
+		renderer.popView();
+	}
+
+	void run(){
+		ofRecordingRenderer recording;
+		recording.setup(640, 480);
+		drawScene(recording);
+
+		test_eq(recording.getNumMeshes(), 1u, "a mesh drawn 100 times is stored once");
+		test_eq(recording.getNumPolylines(), 1u, "a polyline drawn twice is stored once");
+		test_eq(recording.getNumPaths(), 1u, "paths are stored");
+		test_eq(recording.getNumStrings(), 2u, "repeated strings are stored once");
+		test(!recording.hasReferences(), "recording without images has no references");
+		test_eq(recording.getStyle().color, ofColor(255, 0, 0), "color is tracked");
+		test_eq(recording.getFillMode(), OF_FILLED, "popStyle restores the fill mode");
+		test_eq(recording.getCurrentViewport(), ofRectangle(0, 0, 640, 480), "popView restores the viewport");
+		test(equal(recording.getCurrentMatrix(OF_MATRIX_MODELVIEW), ofMatrix4x4()), "popMatrix restores the model view matrix");
+
+		recording.pushMatrix();
+		recording.translate(10, 20, 30);
+		recording.scale(2, 2, 2);
+		ofMatrix4x4 expected;
+		expected.glTranslate(10, 20, 30);
+		expected.glScale(2, 2, 2);
+		test(equal(recording.getCurrentMatrix(OF_MATRIX_MODELVIEW), expected), "transformations are tracked like the matrix stack");
+		recording.popMatrix();
+
+		// replaying into another recording produces the same recording
+		ofRecordingRenderer replayed;
+		replayed.setup(640, 480);
+		recording.replay(replayed);
+		test_eq(replayed.getNumCommands(), recording.getNumCommands(), "replay issues every command");
+		test_eq(replayed.getCommandsSize(), recording.getCommandsSize(), "replay issues the same commands");
+		test_eq(replayed.getNumMeshes(), recording.getNumMeshes(), "replay draws the same meshes");
+		test(bytes(replayed) == bytes(recording), "replayed recording is identical to the original");
+
+		// serialization round trip
+		ofBuffer buffer;
+		test(recording.save(buffer), "recording without references can be saved");
+		ofRecordingRenderer loaded;
+		test(loaded.load(buffer), "saved recording can be loaded");
+		test_eq(loaded.getNumCommands(), recording.getNumCommands(), "loaded recording has the same commands");
+		test_eq(loaded.getNumMeshes(), recording.getNumMeshes(), "loaded recording has the same meshes");
+		test_eq(loaded.getNumPaths(), recording.getNumPaths(), "loaded recording has the same paths");
+		test(bytes(loaded) == bytes(recording), "loaded recording is identical to the original");
+
+		ofRecordingRenderer reloadedReplay;
+		loaded.replay(reloadedReplay);
+		test(bytes(reloadedReplay) == bytes(recording), "replaying a loaded recording gives the original recording");
+
+		// drawing the same geometry after loading reuses the loaded meshes
+		drawScene(loaded);
+		test_eq(loaded.getNumMeshes(), 1u, "loaded meshes are interned");
+
+		ofBuffer truncated;
+		truncated.set(buffer.getData(), buffer.size() / 2);
+		test(!loaded.load(truncated), "truncated recording fails to load");
+		test_eq(loaded.getNumCommands(), 0u, "failed load leaves an empty recording");
+
+		// a recording with a single polyline ends with the command and its index
+		ofRecordingRenderer single;
+		single.draw(ofPolyline::fromRectangle(ofRectangle(0, 0, 10, 10)));
+		single.save(buffer);
+		test(loaded.load(buffer), "single command recording can be loaded");
+		unsigned int index = 1;
+		memcpy(buffer.getData() + buffer.size() - sizeof(index), &index, sizeof(index));
+		test(!loaded.load(buffer), "recording with an index out of range fails to load");
+		buffer.getData()[buffer.size() - sizeof(index) - 1] = char(200);
+		test(!loaded.load(buffer), "recording with an unknown command fails to load");
+
+		// images are recorded by reference
+		ofImage image;
+		image.allocate(4, 4, OF_IMAGE_COLOR);
+		recording.draw(image, 0, 0, 0, 4, 4, 0, 0, 4, 4);
+		test(recording.hasReferences(), "drawing an image adds a reference");
+		test(!recording.save(buffer), "recording with references can't be saved");
+
+		recording.clearRecording();
+		test_eq(recording.getNumCommands(), 0u, "clearRecording removes the commands");
+		test_eq(recording.getCommandsSize(), 0u, "clearRecording removes the command buffer");
+		test_eq(recording.getNumMeshes(), 0u, "clearRecording removes the meshes");
+		test(!recording.hasReferences(), "clearRecording removes the references");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,104 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	// tessellation of every filled path appended one after another,
+	// what the batch tessellation should return
+	ofMesh appendTessellations(const vector<ofPath> & paths){
+		ofMesh mesh;
+		mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+		for(auto & path: paths){
+			if(!path.isFilled()) continue;
+			auto & tessellation = path.getTessellation();
+			auto offset = mesh.getNumVertices();
+			mesh.addVertices(tessellation.getVertices());
+			for(auto index: tessellation.getIndices()){
+				mesh.addIndex(index + offset);
+			}
+		}
+		return mesh;
+	}
+
+	bool equal(const ofMesh & mesh1, const ofMesh & mesh2){
+		return mesh1.getVertices() == mesh2.getVertices() && mesh1.getIndices() == mesh2.getIndices();
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		vector<ofPath> paths(500);
+		ofPolyWindingMode windingModes[] = {OF_POLY_WINDING_ODD, OF_POLY_WINDING_NONZERO, OF_POLY_WINDING_POSITIVE, OF_POLY_WINDING_ABS_GEQ_TWO};
+		for(size_t i=0;i<paths.size();i++){
+			auto & path = paths[i];
+			ofPoint center(ofRandom(1000), ofRandom(1000));
+			switch(i%4){
+			case 0:
+				path.circle(center, ofRandom(5, 50));
+				break;
+			case 1:
+				path.rectangle(center, ofRandom(5, 50), ofRandom(5, 50));
+				path.circle(center, 3);
+				break;
+			case 2:{
+				// self intersecting star
+				int numPoints = int(ofRandom(5, 12)) | 1;
+				for(int j=0;j<numPoints;j++){
+					float angle = TWO_PI * j * (numPoints / 2) / numPoints;
+					path.lineTo(center + ofPoint(cos(angle), sin(angle)) * 40);
+				}
+				path.close();
+				break;
+			}
+			case 3:
+				path.moveTo(center);
+				path.bezierTo(center + ofPoint(50, -30), center + ofPoint(60, 40), center + ofPoint(0, 30));
+				path.close();
+				break;
+			}
+			path.setPolyWindingMode(windingModes[(i/4)%4]);
+			path.setFilled(i%7!=0);
+		}
+
+		// the batch reads the paths, tessellate them before reading
+		// the expected result so both start from the same state
+		ofMesh expected = appendTessellations(paths);
+		test(expected.getNumIndices() > 0, "paths tessellate to triangles");
+
+		for(int numThreads: {1, 4, 0}){
+			ofMesh batch;
+			ofTessellator::tessellateToMesh(paths, batch, numThreads);
+			test(batch.getMode() == OF_PRIMITIVE_TRIANGLES, ofToString(numThreads) + " threads: batch tessellation mode is triangles");
+			test(equal(batch, expected), ofToString(numThreads) + " threads: batch tessellation equals the tessellation of every path appended",
+				 ofToString(batch.getNumVertices()) + " vertices, " + ofToString(batch.getNumIndices()) + " indices, expected " +
+				 ofToString(expected.getNumVertices()) + " vertices, " + ofToString(expected.getNumIndices()) + " indices");
+		}
+
+		// reusing a tessellator resets its arena every time, the results
+		// have to be the same as with a new tessellator
+		ofTessellator reused;
+		bool sameAsNew = true;
+		for(int i=0;i<3;i++){
+			for(auto & path: paths){
+				ofMesh mesh1, mesh2;
+				reused.tessellateToMesh(path.getOutline(), OF_POLY_WINDING_NONZERO, mesh1);
+				ofTessellator().tessellateToMesh(path.getOutline(), OF_POLY_WINDING_NONZERO, mesh2);
+				sameAsNew &= equal(mesh1, mesh2);
+			}
+		}
+		test(sameAsNew, "a reused tessellator returns the same meshes as a new one");
+
+		ofMesh empty;
+		ofTessellator::tessellateToMesh(vector<ofPath>(), empty);
+		test_eq(empty.getNumVertices(), 0u, "batch tessellation of no paths is empty");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
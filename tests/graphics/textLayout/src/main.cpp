@@ -0,0 +1,83 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool sameVertices(const ofMesh & m1, const ofMesh & m2){
+		return m1.getVertices() == m2.getVertices() && m1.getTexCoords() == m2.getTexCoords() && m1.getIndices() == m2.getIndices();
+	}
+
+	void run(){
+		ofTrueTypeFont font;
+		test(font.load("verdana.ttf", 14), "font loads");
+
+		ofTextLayout layout(font, "Hello\nWorld!");
+		test_eq(layout.getLines().size(), 2u, "lines are split at new lines");
+		test_eq(layout.getGlyphs().size(), 11u, "every character gets a glyph");
+		test_eq(layout.getLines()[1].firstGlyph, 5u, "the second line starts after the first one");
+		test_eq(layout.getLines()[1].numGlyphs, 6u, "the second line has its glyphs");
+		test_eq(layout.getLines()[1].y, font.getLineHeight(), "lines are one line height apart");
+		test_eq(layout.getGlyphs()[5].x, 0.f, "new lines start at the origin");
+		test(layout.getLines()[0].width > 0, "lines have a width");
+
+		ofRectangle bb = font.getStringBoundingBox("Hello\nWorld!", 10.5, 20.25);
+		test_eq(layout.getBoundingBox(10.5, 20.25), bb, "the bounding box is the same as the font's");
+		test_eq(layout.getBoundingBox(10.5, 20.25, false), font.getStringBoundingBox("Hello\nWorld!", 10.5, 20.25, false), "the bounding box is the same as the font's without vflip");
+		test_eq(layout.getWidth(), font.stringWidth("Hello\nWorld!"), "the width is the same as stringWidth");
+		test_eq(layout.getHeight(), font.stringHeight("Hello\nWorld!"), "the height is the same as stringHeight");
+
+		vector<ofMesh> meshes;
+		layout.getMeshes(meshes, 10.5, 20.25);
+		test_eq(meshes.size(), 1u, "ascii text uses one page");
+		test(sameVertices(meshes[0], font.getStringMesh("Hello\nWorld!", 10.5, 20.25)), "the layout's mesh is the same as the font's string mesh");
+		test_eq(layout.getMeshes()[0].getNumVertices(), 44u, "the mesh has one quad per glyph");
+
+		// characters outside of the character set
+		ofTextLayout cyrillic(font, "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82");
+		test_eq(cyrillic.getGlyphs().size(), 6u, "characters outside of the character set are laid out");
+		test(cyrillic.getWidth() > 0, "characters outside of the character set have a size");
+
+		// cache
+		auto cached = font.getTextLayout("cached");
+		test(font.getTextLayout("cached") == cached, "the font caches layouts");
+		font.setLetterSpacing(1.5);
+		auto spaced = font.getTextLayout("cached");
+		test(spaced != cached, "changing the letter spacing clears the cache");
+		test(spaced->getWidth() > cached->getWidth(), "layouts use the new letter spacing");
+		font.setLetterSpacing(1);
+		font.setTextLayoutCacheSize(1);
+		auto first = font.getTextLayout("first");
+		font.getTextLayout("second");
+		test(font.getTextLayout("first") != first, "the least recently used layout is removed when the cache is full");
+		font.setTextLayoutCacheSize(0);
+		test(font.getTextLayout("first") != font.getTextLayout("first"), "a cache size of 0 disables the cache");
+
+		ofTrueTypeFont copy = font;
+		test(copy.getTextLayout("copy")->getFont() == &copy, "copies of a font lay out with themselves");
+
+		// eviction
+		ofTrueTypeFont small;
+		small.setPreloadCharacterSet(false);
+		small.setGlyphCacheSize(64, 1);
+		small.load("verdana.ttf", 14);
+		ofTextLayout evicted(small, "abc");
+		test(evicted.isUpToDate(), "a new layout is up to date");
+		for(char c = 'd'; c <= 'z'; c++){
+			small.getTextLayout(string(1, c));
+		}
+		test(small.getGlyphAtlas().getNumEvictions() > 0, "laying out many characters in a small atlas evicts glyphs");
+		test(!evicted.isUpToDate(), "evicting its glyphs invalidates a layout");
+		test_eq(evicted.getGlyphs().size(), 3u, "an invalidated layout is laid out again when used");
+		test(evicted.isUpToDate(), "laying it out again makes it up to date");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
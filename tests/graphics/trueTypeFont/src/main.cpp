@@ -0,0 +1,165 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool sameAtlas(const ofTrueTypeFont & f1, const ofTrueTypeFont & f2){
+		const ofGlyphAtlas & a1 = f1.getGlyphAtlas();
+		const ofGlyphAtlas & a2 = f2.getGlyphAtlas();
+		if(a1.getNumPages() != a2.getNumPages() || a1.getNumGlyphs() != a2.getNumGlyphs()){
+			return false;
+		}
+		for(size_t i = 0; i < a1.getNumPages(); i++){
+			const ofPixels & p1 = a1.getPage(i);
+			const ofPixels & p2 = a2.getPage(i);
+			if(p1.size() != p2.size() || memcmp(p1.getData(), p2.getData(), p1.size()) != 0){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool sameOutlines(const ofTrueTypeFont & f1, const ofTrueTypeFont & f2){
+		for(int c = NUM_CHARACTER_TO_START; c < NUM_CHARACTER_TO_START + f1.getNumCharacters(); c++){
+			for(int vflip = 0; vflip < 2; vflip++){
+				for(int filled = 0; filled < 2; filled++){
+					ofTTFCharacter c1 = f1.getCharacterAsPoints(c, vflip, filled);
+					ofTTFCharacter c2 = f2.getCharacterAsPoints(c, vflip, filled);
+					if(c1.isFilled() != c2.isFilled() || c1.getCommands().size() != c2.getCommands().size()){
+						return false;
+					}
+					const vector<ofPolyline> & o1 = c1.getOutline();
+					const vector<ofPolyline> & o2 = c2.getOutline();
+					if(o1.size() != o2.size()){
+						return false;
+					}
+					for(size_t i = 0; i < o1.size(); i++){
+						if(o1[i].getVertices() != o2[i].getVertices()){
+							return false;
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	vector<ofPixels> pages(const ofTrueTypeFont & font){
+		vector<ofPixels> pages;
+		for(size_t i = 0; i < font.getNumAtlasPages(); i++){
+			pages.push_back(font.getGlyphAtlas().getPage(i));
+		}
+		return pages;
+	}
+
+	bool samePixels(const ofPixels & p1, const ofPixels & p2){
+		return p1.size() == p2.size() && memcmp(p1.getData(), p2.getData(), p1.size()) == 0;
+	}
+
+	void testCopies(){
+		ofTrueTypeFont original;
+		original.load("verdana.ttf", 20);
+		bool withTextures = ofGetGLRenderer() != nullptr;
+		if(withTextures){
+			original.getFontTexture(0);
+		}
+		auto originalPages = pages(original);
+		size_t originalGlyphs = original.getGlyphAtlas().getNumGlyphs();
+
+		// glyphs outside of the character set are rasterized by the copy
+		ofTrueTypeFont copy = original;
+		bool allDirty = true;
+		for(size_t i = 0; i < copy.getNumAtlasPages(); i++){
+			allDirty &= copy.getGlyphAtlas().isPageDirty(i);
+		}
+		test(allDirty, "a copy uploads every page of its atlas to its own textures");
+		copy.getStringMesh("\xCE\xB1\xCE\xB2\xCE\xB3 \xC4\x80\xC4\x82\xC4\x84", 0, 0);
+		test_gt(copy.getGlyphAtlas().getNumGlyphs(), originalGlyphs, "the copy adds new glyphs to its atlas");
+		test_eq(original.getGlyphAtlas().getNumGlyphs(), originalGlyphs, "new glyphs of a copy aren't added to the original");
+		auto afterPages = pages(original);
+		bool sameOriginal = afterPages.size() == originalPages.size();
+		for(size_t i = 0; sameOriginal && i < afterPages.size(); i++){
+			sameOriginal = samePixels(afterPages[i], originalPages[i]);
+		}
+		test(sameOriginal, "new glyphs of a copy don't change the pages of the original");
+
+		if(withTextures){
+			const ofTexture & copyTexture = copy.getFontTexture(0);
+			const ofTexture & originalTexture = original.getFontTexture(0);
+			test(copyTexture.getTextureData().textureID != originalTexture.getTextureData().textureID, "a copy draws with its own textures");
+			ofPixels uploaded;
+			originalTexture.readToPixels(uploaded);
+			test(samePixels(uploaded, originalPages[0]), "new glyphs of a copy don't change the texture of the original");
+		}
+
+		// moving takes the textures
+		ofTrueTypeFont moved = std::move(copy);
+		test_gt(moved.getGlyphAtlas().getNumGlyphs(), originalGlyphs, "a moved font keeps the new glyphs");
+	}
+
+	void run(){
+		testCopies();
+
+		// parallel loading
+		ofTrueTypeFont serial;
+		serial.setNumLoadThreads(1);
+		test(serial.load("verdana.ttf", 20, true, true, true), "font loads with one thread");
+
+		ofTrueTypeFont parallel;
+		parallel.setNumLoadThreads(4);
+		test(parallel.load("verdana.ttf", 20, true, true, true), "font loads with several threads");
+		test(sameAtlas(serial, parallel), "the atlas is the same with any number of threads");
+		test(sameOutlines(serial, parallel), "the contours are the same with any number of threads");
+		test_eq(parallel.stringWidth("Hello world"), serial.stringWidth("Hello world"), "the metrics are the same with any number of threads");
+
+		ofTrueTypeFont again;
+		again.setNumLoadThreads(3);
+		again.load("verdana.ttf", 20, true, true, true);
+		test(sameAtlas(parallel, again), "loading the same font twice packs the atlas the same way");
+
+		// disk cache
+		ofDirectory::removeDirectory("fontCache", true);
+		ofTrueTypeFont::setCacheDirectory("fontCache");
+		ofTrueTypeFont saved;
+		test(saved.load("verdana.ttf", 20, true, true, true), "font loads when the cache is empty");
+		ofDirectory cache("fontCache");
+		test_eq(cache.listDir(), 1u, "loading a font saves it to the cache");
+
+		ofTrueTypeFont cached;
+		test(cached.load("verdana.ttf", 20, true, true, true), "font loads from the cache");
+		test(sameAtlas(serial, cached), "the atlas read from the cache is the same");
+		test(sameOutlines(serial, cached), "the contours read from the cache are the same");
+		test_eq(cached.stringWidth("Hello world"), serial.stringWidth("Hello world"), "the metrics read from the cache are the same");
+
+		ofTrueTypeFont otherSize;
+		otherSize.load("verdana.ttf", 12, true, true, true);
+		test_eq(cache.listDir(), 2u, "other sizes are saved to another file");
+
+		// truncated files are ignored and the font is rasterized again
+		for(size_t i = 0; i < cache.size(); i++){
+			ofBuffer buffer = ofBufferFromFile(cache.getPath(i), true);
+			ofBuffer truncated;
+			truncated.set(buffer.getData(), buffer.size() / 2);
+			ofBufferToFile(cache.getPath(i), truncated, true);
+		}
+		ofTrueTypeFont fromTruncated;
+		test(fromTruncated.load("verdana.ttf", 20, true, true, true), "font loads when the cache file is truncated");
+		test(sameAtlas(serial, fromTruncated), "a truncated cache file is ignored");
+		ofTrueTypeFont rewritten;
+		rewritten.load("verdana.ttf", 20, true, true, true);
+		test(sameOutlines(serial, rewritten), "a truncated cache file is saved again");
+
+		ofTrueTypeFont::setCacheDirectory("");
+		ofDirectory::removeDirectory("fontCache", true);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,254 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool aprox_eq(const ofVec3f & v1, const ofVec3f & v2, float tolerance = 1e-5f){
+		return fabs(v1.x - v2.x) <= tolerance * max(1.f, fabs(v2.x)) &&
+			fabs(v1.y - v2.y) <= tolerance * max(1.f, fabs(v2.y)) &&
+			fabs(v1.z - v2.z) <= tolerance * max(1.f, fabs(v2.z));
+	}
+
+	bool aprox_eq(const ofVec4f & v1, const ofVec4f & v2, float tolerance = 1e-5f){
+		return aprox_eq(ofVec3f(v1), ofVec3f(v2), tolerance) && fabs(v1.w - v2.w) <= tolerance * max(1.f, fabs(v2.w));
+	}
+
+	bool aprox_eq(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2, float tolerance = 1e-5f){
+		for(int i = 0; i < 4; i++){
+			if(!aprox_eq(m1._mat[i], m2._mat[i], tolerance)){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool equal(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2){
+		return memcmp(m1.getPtr(), m2.getPtr(), sizeof(float) * 16) == 0;
+	}
+
+	ofMatrix4x4 naiveMultiply(const ofMatrix4x4 & a, const ofMatrix4x4 & b){
+		ofMatrix4x4 r;
+		for(int i = 0; i < 4; i++){
+			for(int j = 0; j < 4; j++){
+				r(i, j) = a(i, 0) * b(0, j) + a(i, 1) * b(1, j) + a(i, 2) * b(2, j) + a(i, 3) * b(3, j);
+			}
+		}
+		return r;
+	}
+
+	void testLevel(ofSimdLevel level, const string & name){
+		ofSetSimdLevel(level);
+		test_eq(ofGetSimdLevel(), level, name + " is used after setting it");
+
+		// odd sizes so the simd loops and the remainders are both used
+		const size_t n = 37;
+		vector<ofVec3f> points(n);
+		vector<ofVec4f> points4(n);
+		for(size_t i = 0; i < n; i++){
+			points[i].set(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+			points4[i].set(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-2, 2));
+		}
+		points[5].set(0, 0, 0);
+
+		ofMatrix4x4 affine;
+		affine.makeRotationMatrix(37, ofVec3f(1, 2, 3).getNormalized());
+		affine.postMultScale(2, 3, 0.5);
+		affine.postMultTranslate(10, -20, 30);
+		ofMatrix4x4 projection;
+		projection.makePerspectiveMatrix(60, 1.5, 0.1, 1000);
+		projection.preMult(affine);
+
+		for(auto & m: {affine, projection}){
+			vector<ofVec3f> transformed(n);
+			ofTransformPoints(m, points.data(), transformed.data(), n);
+			bool same = true;
+			for(size_t i = 0; i < n; i++){
+				same &= aprox_eq(transformed[i], points[i] * m);
+			}
+			test(same, name + " transforms points like operator *");
+
+			vector<ofVec3f> inPlace = points;
+			ofTransformPoints(m, inPlace.data(), inPlace.data(), n);
+			test(inPlace == transformed, name + " transforms points in place");
+
+			vector<ofVec3f> vectors(n);
+			ofTransformVectors(m, points.data(), vectors.data(), n);
+			same = true;
+			for(size_t i = 0; i < n; i++){
+				same &= aprox_eq(vectors[i], ofMatrix4x4::transform3x3(points[i], m));
+			}
+			test(same, name + " transforms vectors like transform3x3");
+
+			// positions interleaved with normals, written to a packed array
+			vector<ofVec3f> interleaved(n * 2);
+			for(size_t i = 0; i < n; i++){
+				interleaved[i * 2] = points[i];
+				interleaved[i * 2 + 1].set(1, 2, 3);
+			}
+			vector<ofVec3f> fromStrided(n);
+			ofTransformPoints(m, interleaved[0].getPtr(), sizeof(ofVec3f) * 2, fromStrided[0].getPtr(), sizeof(ofVec3f), n);
+			same = true;
+			for(size_t i = 0; i < n; i++){
+				same &= aprox_eq(fromStrided[i], transformed[i]);
+			}
+			test(same, name + " transforms strided points");
+			ofTransformVectors(m, interleaved[0].getPtr(), sizeof(ofVec3f) * 2, interleaved[0].getPtr(), sizeof(ofVec3f) * 2, n);
+			same = true;
+			for(size_t i = 0; i < n; i++){
+				same &= aprox_eq(interleaved[i * 2], vectors[i]) && interleaved[i * 2 + 1] == ofVec3f(1, 2, 3);
+			}
+			test(same, name + " transforms strided vectors in place without touching the rest");
+
+			vector<ofVec4f> transformed4(n);
+			ofTransformPoints(m, points4.data(), transformed4.data(), n);
+			same = true;
+			for(size_t i = 0; i < n; i++){
+				same &= aprox_eq(transformed4[i], points4[i] * m);
+			}
+			test(same, name + " transforms 4d vectors like operator *");
+		}
+
+		vector<ofVec3f> normalized = points;
+		ofNormalizeVectors(normalized.data(), n);
+		bool same = true;
+		for(size_t i = 0; i < n; i++){
+			same &= aprox_eq(normalized[i], points[i].getNormalized());
+		}
+		test(same, name + " normalizes vectors like getNormalized");
+		test_eq(normalized[5], ofVec3f(0, 0, 0), name + " leaves vectors of length 0 as they are");
+
+		ofVec3f min, max;
+		test(ofGetBoundingBox(points.data(), n, min, max), name + " computes the bounding box");
+		ofVec3f expectedMin = points[0], expectedMax = points[0];
+		for(auto & p: points){
+			expectedMin.set(std::min(expectedMin.x, p.x), std::min(expectedMin.y, p.y), std::min(expectedMin.z, p.z));
+			expectedMax.set(std::max(expectedMax.x, p.x), std::max(expectedMax.y, p.y), std::max(expectedMax.z, p.z));
+		}
+		test(min == expectedMin && max == expectedMax, name + " bounding box contains every point");
+		test(!ofGetBoundingBox(points.data(), 0, min, max), name + " bounding box of an empty array fails");
+
+		// half spaces that leave some of the points on each side
+		vector<ofVec4f> planes;
+		planes.emplace_back(1, 0, 0, 50);
+		planes.emplace_back(ofVec3f(-1, 1, 1).getNormalized());
+		planes.back().w = 20;
+		planes.emplace_back(0, 0, -1, 60);
+		vector<float> radii(n);
+		vector<ofVec3f> boxMax(n);
+		for(size_t i = 0; i < n; i++){
+			radii[i] = ofRandom(0, 30);
+			boxMax[i] = points[i] + ofVec3f(ofRandom(0, 30), ofRandom(0, 30), ofRandom(0, 30));
+		}
+		vector<uint8_t> inside(n);
+		size_t count = ofSpheresInsidePlanes(planes.data(), planes.size(), points.data(), radii.data(), inside.data(), n);
+		size_t expectedCount = 0, expectedPoints = 0;
+		bool sameSpheres = true;
+		for(size_t i = 0; i < n; i++){
+			bool sphereInside = true, pointInside = true;
+			for(auto & p: planes){
+				float distance = ofVec3f(p).dot(points[i]) + p.w;
+				sphereInside &= distance >= -radii[i];
+				pointInside &= distance >= 0;
+			}
+			sameSpheres &= inside[i] == sphereInside;
+			expectedCount += sphereInside;
+			expectedPoints += pointInside;
+		}
+		test(sameSpheres && count == expectedCount && count > 0 && count < n, name + " tests spheres against planes");
+		size_t pointCount = ofPointsInsidePlanes(planes.data(), planes.size(), points.data(), inside.data(), n);
+		test_eq(pointCount, expectedPoints, name + " tests points against planes");
+
+		count = ofBoxesInsidePlanes(planes.data(), planes.size(), points.data(), boxMax.data(), inside.data(), n);
+		bool sameBoxes = true;
+		expectedCount = 0;
+		for(size_t i = 0; i < n; i++){
+			bool boxInside = true;
+			for(auto & p: planes){
+				// a box is outside if its 8 corners are behind a plane
+				bool anyCornerInside = false;
+				for(int corner = 0; corner < 8; corner++){
+					ofVec3f c(corner & 1 ? boxMax[i].x : points[i].x, corner & 2 ? boxMax[i].y : points[i].y, corner & 4 ? boxMax[i].z : points[i].z);
+					anyCornerInside |= ofVec3f(p).dot(c) + p.w >= 0;
+				}
+				boxInside &= anyCornerInside;
+			}
+			sameBoxes &= inside[i] == boxInside;
+			expectedCount += boxInside;
+		}
+		test(sameBoxes && count == expectedCount, name + " tests boxes against planes");
+	}
+
+	void run(){
+		ofSeedRandom(42);
+		ofLogNotice() << "supported simd level " << ofGetSupportedSimdLevel();
+
+		testLevel(OF_SIMD_NONE, "scalar code");
+		if(ofGetSupportedSimdLevel() >= OF_SIMD_SSE2){
+			testLevel(OF_SIMD_SSE2, "sse2");
+		}
+		if(ofGetSupportedSimdLevel() >= OF_SIMD_AVX){
+			testLevel(OF_SIMD_AVX, "avx");
+		}
+		ofSetSimdLevel(OF_SIMD_AVX);
+		test_eq(ofGetSimdLevel(), ofGetSupportedSimdLevel(), "levels are limited to the supported ones");
+
+		// matrices
+		ofMatrix4x4 a;
+		a.makeRotationMatrix(30, ofVec3f(0, 1, 1).getNormalized());
+		a.postMultTranslate(1, 2, 3);
+		ofMatrix4x4 b;
+		b.makePerspectiveMatrix(45, 1.3, 1, 100);
+		test(equal(a * b, naiveMultiply(a, b)), "multiplying matrices gives the same result as the inner products");
+		ofMatrix4x4 c = a;
+		c.postMult(b);
+		test(equal(c, a * b), "postMult is the same as operator *");
+		c = b;
+		c.preMult(a);
+		test(equal(c, a * b), "preMult is the same as operator *");
+		c = a;
+		c.postMult(c);
+		test(equal(c, naiveMultiply(a, a)), "a matrix can be multiplied by itself");
+
+		ofMatrix4x4 projective(2, 0.5, 0, 1,
+							   0.25, 3, 1, 0,
+							   1, 0, 4, 0.5,
+							   3, 2, 1, 2);
+		ofMatrix4x4 inverse = projective.getInverse();
+		test(aprox_eq(inverse * projective, ofMatrix4x4()), "the inverse times the matrix is the identity");
+		test(aprox_eq(projective * inverse, ofMatrix4x4()), "the matrix times the inverse is the identity");
+		ofMatrix4x4 perspective = b.getInverse();
+		test(aprox_eq(perspective * b, ofMatrix4x4(), 1e-4f), "projection matrices can be inverted");
+		ofMatrix4x4 self = projective;
+		self.makeInvertOf(self);
+		test(equal(self, inverse), "a matrix can be inverted in place");
+
+		ofMatrix4x4 singular(0, 2, 3, 4,
+							 0, 4, 1, 8,
+							 0, 0, 1, 0,
+							 0, 1, 0, 1);
+		ofMatrix4x4 untouched;
+		test(!untouched.makeInvertOf(singular), "singular matrices can't be inverted");
+
+		// the determinant is too small for a float
+		ofMatrix4x4 tiny = projective;
+		for(int i = 0; i < 4; i++){
+			tiny._mat[i] *= 1e-12f;
+		}
+		ofMatrix4x4 tinyInverse;
+		test(tinyInverse.makeInvertOf(tiny), "matrices with a very small determinant can be inverted");
+		for(int i = 0; i < 4; i++){
+			tinyInverse._mat[i] *= 1e-12f;
+		}
+		test(aprox_eq(tinyInverse, inverse, 1e-4f), "the inverse of a matrix with a very small determinant is correct");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
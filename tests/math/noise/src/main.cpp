@@ -0,0 +1,136 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	bool aprox_eq(const vector<float> & v1, const vector<float> & v2, float tolerance = 1e-5f){
+		if(v1.size() != v2.size()){
+			return false;
+		}
+		for(size_t i = 0; i < v1.size(); i++){
+			if(fabs(v1[i] - v2[i]) > tolerance){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void testLevel(ofSimdLevel level, const string & name){
+		ofSetSimdLevel(level);
+
+		// odd sizes so the simd loops and the remainders are both used,
+		// negative coordinates and exact lattice points included
+		const size_t n = 1003;
+		vector<ofVec2f> points2(n);
+		vector<ofVec3f> points3(n);
+		for(size_t i = 0; i < n; i++){
+			points2[i].set(ofRandom(-300, 300), ofRandom(-300, 300));
+			points3[i].set(ofRandom(-300, 300), ofRandom(-300, 300), ofRandom(-300, 300));
+		}
+		points2[0].set(0, 0);
+		points2[1].set(-1, -2);
+		points3[0].set(0, 0, 0);
+		points3[1].set(-3, 2, -1);
+
+		vector<float> batch(n), single(n);
+		ofNoisePoints(points2.data(), batch.data(), n);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofNoise(points2[i]);
+		}
+		test(aprox_eq(batch, single), name + " 2d noise of points is the same as ofNoise");
+		ofSignedNoisePoints(points2.data(), batch.data(), n);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofSignedNoise(points2[i]);
+		}
+		test(aprox_eq(batch, single), name + " 2d signed noise of points is the same as ofSignedNoise");
+		ofNoisePoints(points3.data(), batch.data(), n);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofNoise(points3[i]);
+		}
+		test(aprox_eq(batch, single), name + " 3d noise of points is the same as ofNoise");
+		ofSignedNoisePoints(points3.data(), batch.data(), n);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofSignedNoise(points3[i]);
+		}
+		test(aprox_eq(batch, single), name + " 3d signed noise of points is the same as ofSignedNoise");
+
+		ofNoisePoints(points2.data(), batch.data(), n, 5, 1.9, 0.6);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofFractalNoise(points2[i], 5, 1.9, 0.6);
+		}
+		test(aprox_eq(batch, single), name + " 2d fractal noise of points is the same as ofFractalNoise");
+		ofSignedNoisePoints(points3.data(), batch.data(), n, 4);
+		for(size_t i = 0; i < n; i++){
+			single[i] = ofSignedFractalNoise(points3[i], 4);
+		}
+		test(aprox_eq(batch, single), name + " 3d fractal noise of points is the same as ofSignedFractalNoise");
+
+		// grids
+		const size_t width = 37, height = 11;
+		ofVec3f origin(-5.3, 2.1, -0.7);
+		ofVec2f step(0.13, -0.21);
+		vector<float> grid(width * height), expected(width * height);
+		ofNoiseGrid(grid.data(), width, height, ofVec2f(origin), step);
+		for(size_t y = 0; y < height; y++){
+			for(size_t x = 0; x < width; x++){
+				expected[y * width + x] = ofNoise(origin.x + x * step.x, origin.y + y * step.y);
+			}
+		}
+		test(aprox_eq(grid, expected), name + " 2d noise grid is the same as ofNoise");
+		ofSignedNoiseGrid(grid.data(), width, height, origin, step, 3);
+		for(size_t y = 0; y < height; y++){
+			for(size_t x = 0; x < width; x++){
+				expected[y * width + x] = ofSignedFractalNoise(ofVec3f(origin.x + x * step.x, origin.y + y * step.y, origin.z), 3);
+			}
+		}
+		test(aprox_eq(grid, expected), name + " 3d fractal noise grid is the same as ofSignedFractalNoise");
+	}
+
+	void run(){
+		ofSeedRandom(45);
+		test_eq(ofFractalNoise(ofVec3f(1.3, -2.2, 0.4), 1), ofNoise(ofVec3f(1.3, -2.2, 0.4)), "fractal noise with 1 octave is ofNoise");
+		test_eq(ofSignedFractalNoise(ofVec2f(1.3, -2.2), 0), ofSignedNoise(ofVec2f(1.3, -2.2)), "fractal noise uses at least 1 octave");
+		bool inRange = true;
+		for(int i = 0; i < 10000; i++){
+			float f = ofFractalNoise(ofVec3f(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100)), 6);
+			inRange &= f >= 0 && f <= 1;
+		}
+		test(inRange, "fractal noise is between 0 and 1");
+		test(ofNoise(-1000.5, -2000.25, -3000.75) >= 0 && ofNoise(-1000.5, -2000.25, -3000.75) <= 1, "noise works with negative coordinates");
+
+		testLevel(OF_SIMD_NONE, "scalar code");
+		if(ofGetSupportedSimdLevel() >= OF_SIMD_SSE2){
+			testLevel(OF_SIMD_SSE2, "sse2");
+		}
+		if(ofGetSupportedSimdLevel() >= OF_SIMD_AVX){
+			testLevel(OF_SIMD_AVX, "avx");
+		}
+		ofSetSimdLevel(ofGetSupportedSimdLevel());
+
+		// threads split the rows without changing the results
+		ofFloatPixels serial, threaded;
+		serial.allocate(301, 257, OF_PIXELS_GRAY);
+		threaded.allocate(301, 257, OF_PIXELS_GRAY);
+		ofNoiseGrid(serial, ofVec3f(10, 20, 0.5), ofVec2f(0.01, 0.02), 4);
+		ofNoiseGrid(threaded, ofVec3f(10, 20, 0.5), ofVec2f(0.01, 0.02), 4, 2, 0.5, 4);
+		test(memcmp(serial.getData(), threaded.getData(), serial.size() * sizeof(float)) == 0, "noise grids are the same with several threads");
+		test(fabs(serial[300 + 256 * 301] - ofFractalNoise(ofVec3f(10 + 300 * 0.01f, 20 + 256 * 0.02f, 0.5), 4)) < 1e-5f, "the last pixel of the grid is the noise at the corner");
+
+		ofFloatPixels rgb;
+		rgb.allocate(4, 4, OF_PIXELS_RGB);
+		rgb.set(0.25);
+		ofLogNotice() << "the next error is expected";
+		ofNoiseGrid(rgb, ofVec2f(0, 0), ofVec2f(1, 1));
+		test_eq(rgb[0], 0.25f, "pixels with more than 1 channel aren't filled");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,137 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	vector<float> draw(size_t n){
+		vector<float> values(n);
+		for(auto & v: values){
+			v = ofRandom(-10, 10);
+		}
+		return values;
+	}
+
+	// the numbers the first draws of a thread returns
+	vector<float> drawInThread(){
+		vector<float> values;
+		std::thread thread([&]{
+			values = draw(10);
+		});
+		thread.join();
+		return values;
+	}
+
+	void meanAndDeviation(const vector<float> & values, float & mean, float & deviation){
+		double sum = 0, sum2 = 0;
+		for(auto v: values){
+			sum += v;
+			sum2 += v * v;
+		}
+		mean = sum / values.size();
+		deviation = sqrt(sum2 / values.size() - mean * mean);
+	}
+
+	void run(){
+		// seeding
+		ofSeedRandom(10);
+		auto first = draw(100);
+		ofSeedRandom(10);
+		test(draw(100) == first, "the same seed gives the same numbers");
+		ofSeedRandom(11);
+		test(draw(100) != first, "different seeds give different numbers");
+
+		// threads
+		ofSeedRandom(10);
+		auto thread1 = drawInThread();
+		auto thread2 = drawInThread();
+		ofSeedRandom(10);
+		test(drawInThread() == thread1 && drawInThread() == thread2, "threads get the same numbers after seeding again");
+		test(thread1 != thread2 && thread1 != vector<float>(first.begin(), first.begin() + 10), "every thread gets different numbers");
+		vector<float> worker1, worker2;
+		std::thread a([&]{
+			ofGetRandomEngine().seed(5, 1);
+			worker1 = draw(10);
+		});
+		std::thread b([&]{
+			ofGetRandomEngine().seed(5, 1);
+			worker2 = draw(10);
+		});
+		a.join();
+		b.join();
+		test(worker1 == worker2, "threads can use a fixed stream");
+
+		// ranges
+		bool inRange = true;
+		float minValue = 1, maxValue = 0;
+		for(int i = 0; i < 100000; i++){
+			float r = ofRandomuf();
+			inRange &= r >= 0 && r < 1;
+			minValue = min(minValue, r);
+			maxValue = max(maxValue, r);
+			float f = ofRandomf();
+			inRange &= f >= -1 && f < 1;
+			float m = ofRandom(5);
+			inRange &= m >= 0 && m < 5;
+			float range = ofRandom(3, -2);
+			inRange &= range >= -2 && range < 3;
+		}
+		test(inRange, "random numbers are in range");
+		test(minValue < 0.001 && maxValue > 0.999, "random numbers cover the whole range");
+		test_eq(ofRandom(4, 4), 4.f, "empty ranges return the minimum");
+
+		// distributions
+		ofRandomEngine engine(1);
+		vector<float> uniform(100000);
+		for(auto & u: uniform){
+			u = engine.uniform();
+		}
+		float mean, deviation;
+		meanAndDeviation(uniform, mean, deviation);
+		test(fabs(mean - 0.5) < 0.01 && fabs(deviation - sqrt(1 / 12.)) < 0.01, "uniform numbers have the right mean and deviation");
+		vector<float> gaussian(100000);
+		for(auto & g: gaussian){
+			g = ofRandomGaussian(3, 2);
+		}
+		meanAndDeviation(gaussian, mean, deviation);
+		test(fabs(mean - 3) < 0.05 && fabs(deviation - 2) < 0.05, "gaussian numbers have the right mean and deviation");
+		std::uniform_int_distribution<int> dice(1, 6);
+		vector<int> histogram(7);
+		for(int i = 0; i < 60000; i++){
+			histogram[dice(engine)]++;
+		}
+		test(histogram[0] == 0 && *min_element(histogram.begin() + 1, histogram.end()) > 9000, "the engine works with the standard distributions");
+
+		// bulk generation, odd sizes so the simd loops and the
+		// remainders are both used
+		vector<float> filled(100003);
+		ofSeedRandom(3);
+		ofRandomFill(filled.data(), filled.size(), -5, 5);
+		inRange = true;
+		for(auto f: filled){
+			inRange &= f >= -5 && f <= 5;
+		}
+		meanAndDeviation(filled, mean, deviation);
+		test(inRange && fabs(mean) < 0.05 && fabs(deviation - 10 / sqrt(12.)) < 0.05, "filled numbers are uniformly distributed");
+		test(filled[0] != filled[4] && filled[1] != filled[2], "the values of the simd lanes are different");
+		ofSimdLevel level = ofGetSimdLevel();
+		ofSetSimdLevel(OF_SIMD_NONE);
+		vector<float> scalar(filled.size());
+		ofSeedRandom(3);
+		ofRandomFill(scalar.data(), scalar.size(), -5, 5);
+		ofSetSimdLevel(level);
+		test(scalar == filled, "filling gives the same numbers with and without simd");
+		ofRandomFillGaussian(filled.data(), filled.size(), -1, 0.5);
+		meanAndDeviation(filled, mean, deviation);
+		test(fabs(mean + 1) < 0.01 && fabs(deviation - 0.5) < 0.01, "filled gaussian numbers have the right mean and deviation");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
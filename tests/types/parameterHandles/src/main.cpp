@@ -0,0 +1,78 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	ofParameterGroup root, light, position;
+	ofParameter<float> intensity, x;
+	ofParameter<int> channel;
+	ofParameter<string> label;
+
+	void testNames(){
+		ofParameter<int> special("a name/with (all) {the} [chars], <escaped> by.escape\\", 0);
+		test_eq(special.getEscapedName(), "a_name_with__all___the___chars____escaped__by_escape_", "escaping replaces every special character");
+		test(root.contains("light") && !root.contains("dark"), "contains finds the names of the parameters");
+		test(light.contains("main label") && light.contains("main_label"), "names are found escaped or not");
+		test_eq(light.getPosition("main label"), 2, "the position of a name");
+		test_eq(light.getPosition("missing"), -1, "the position of a missing name");
+		test_eq(&light.get("channel").cast<int>().get(), &channel.get(), "get finds the parameter by name");
+
+		bool thrown = false;
+		try{
+			light.get("missing");
+		}catch(std::out_of_range &){
+			thrown = true;
+		}
+		test(thrown, "getting a missing name throws");
+	}
+
+	void testHandles(){
+		ofParameter<float> & handle = root.handle<float>("light/intensity");
+		test_eq(&handle.get(), &intensity.get(), "handles find parameters in subgroups");
+		handle = 0.25;
+		test_eq(intensity.get(), 0.25f, "handles set the parameter");
+		test_eq(root.handle<float>("light/position/x").get(), 3.f, "paths through several subgroups");
+		test_eq(root.handle("light/main label").toString(), "front", "paths with names that need escaping");
+		test_eq(light.handle<int>("channel").get(), 2, "paths with a single name");
+
+		const ofParameterGroup & constRoot = root;
+		test_eq(constRoot.handle<float>("light/position/x").get(), 3.f, "handles of a const group");
+
+		auto throws = [&](const string & path, bool outOfRange){
+			try{
+				root.handle<float>(path);
+			}catch(std::out_of_range &){
+				return outOfRange;
+			}catch(std::runtime_error &){
+				return !outOfRange;
+			}
+			return false;
+		};
+		test(throws("light/missing", true), "missing parameters throw");
+		test(throws("light/intensity/x", true), "paths through a parameter that isn't a group throw");
+		test(throws("light/channel", false), "parameters of a different type throw");
+		test(throws("", true), "empty paths throw");
+	}
+
+	void run(){
+		position.setName("position");
+		position.add(x.set("x", 3));
+		light.setName("light");
+		light.add(intensity.set("intensity", 0.5), channel.set("channel", 2), label.set("main label", "front"), position);
+		root.setName("root");
+		root.add(light);
+
+		testNames();
+		testHandles();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
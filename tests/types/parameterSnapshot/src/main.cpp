@@ -0,0 +1,186 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	struct Parameters{
+		ofParameterGroup group;
+		ofParameterGroup light;
+		ofParameter<float> intensity;
+		ofParameter<int> channel;
+		ofParameter<bool> enabled;
+		ofParameter<ofVec3f> position;
+		ofParameter<ofFloatColor> color;
+		ofParameter<ofColor> tint;
+		ofParameter<double> time;
+		ofParameter<string> label;
+		ofParameter<unsigned int> frames;
+		ofParameter<float> internal;
+		ofReadOnlyParameter<float, ofApp> fps;
+
+		Parameters(){
+			internal.setSerializable(false);
+			light.setName("light");
+			light.add(intensity.set("intensity", 0.5), channel.set("channel", 1), enabled.set("enabled", true));
+			light.add(position.set("position", ofVec3f(1, 2, 3)), color.set("color", ofFloatColor(1, 0.5, 0.25)));
+			group.setName("show");
+			group.add(light, tint.set("tint", ofColor(10, 20, 30)), time.set("time", 1.5), label.set("label", "intro"));
+			group.add(frames.set("frames", 25), internal.set("internal", 2), fps);
+		}
+
+		void change(){
+			intensity = 0.75;
+			position = ofVec3f(-1, 0, 4);
+			label = "second scene";
+			frames = 50;
+		}
+	};
+
+	size_t notifications = 0;
+
+	void changed(ofAbstractParameter &){
+		notifications++;
+	}
+
+	void testCaptureAndRestore(){
+		Parameters parameters;
+		ofParameterSnapshot snapshot(parameters.group);
+		test_eq(snapshot.getNumParameters(), 9u, "the snapshot has the serializable parameters that aren't read only");
+
+		parameters.change();
+		parameters.channel = 7;
+		test_eq(snapshot.restore(), 5u, "restoring sets the parameters that changed");
+		test_eq(parameters.intensity.get(), 0.5f, "floats are restored");
+		test_eq(parameters.channel.get(), 1, "ints are restored");
+		test_eq(parameters.position.get(), ofVec3f(1, 2, 3), "vectors are restored");
+		test_eq(parameters.label.get(), "intro", "strings are restored");
+		test_eq(parameters.frames.get(), 25u, "parameters of other types are restored");
+
+		ofAddListener(parameters.group.parameterChangedE(), this, &ofApp::changed);
+		parameters.change();
+		notifications = 0;
+		snapshot.restore();
+		test_eq(notifications, 4u, "every parameter that changed notifies once");
+		test_eq(snapshot.restore(), 0u, "restoring the same values doesn't set anything");
+		parameters.change();
+		notifications = 0;
+		snapshot.restore(false);
+		test_eq(notifications, 1u, "only the parameters stored as text notify when restoring without events");
+		test_eq(parameters.position.get(), ofVec3f(1, 2, 3), "the values are restored without events");
+		ofRemoveListener(parameters.group.parameterChangedE(), this, &ofApp::changed);
+
+		parameters.change();
+		ofParameterSnapshot captured = snapshot;
+		test(captured == snapshot, "copies of a snapshot have the same values");
+		captured.capture();
+		test(captured != snapshot && captured.getSchemaHash() == snapshot.getSchemaHash(), "capturing copies the current values");
+	}
+
+	void testBinary(){
+		Parameters sender, receiver;
+		ofParameterSnapshot sent(sender.group), received(receiver.group);
+		test_eq(sent.getSchemaHash(), received.getSchemaHash(), "groups with the same parameters have the same schema");
+
+		sender.change();
+		sender.tint = ofColor(255, 0, 0);
+		sent.capture();
+		ofBuffer data;
+		sent.serialize(data);
+		test(received.deserialize(data), "snapshots can be deserialized");
+		test(received == sent, "deserialized snapshots have the same values");
+		test(receiver.position.get() == ofVec3f(1, 2, 3), "deserializing doesn't change the parameters");
+		received.restore();
+		test(receiver.position.get() == sender.position.get() && receiver.tint.get() == sender.tint.get() && receiver.label.get() == sender.label.get(),
+			"restoring a deserialized snapshot sets the parameters");
+
+		// deltas only have the values that changed
+		ofParameterSnapshot previous = sent;
+		sender.intensity = 0.1;
+		sender.label = "third scene";
+		sent.capture();
+		ofBuffer delta;
+		sent.serializeDelta(previous, delta);
+		test(delta.size() < data.size(), "deltas are smaller than the whole snapshot");
+		test(received.deserializeDelta(delta) && received == sent, "deltas are applied to the previous values");
+		received.restore();
+		test(receiver.intensity.get() == 0.1f && receiver.label.get() == "third scene", "restoring a delta sets the parameters");
+		sent.serializeDelta(sent, delta);
+		test(received.deserializeDelta(delta) && received == sent, "deltas without changes");
+
+		ofLogNotice() << "the next errors are expected";
+		sent.serializeDelta(previous, delta);
+		test(!received.deserializeDelta(delta), "deltas can't be applied to different values");
+		test(!received.deserialize(delta), "deltas aren't read as whole snapshots");
+		test(received.deserializeDelta(data), "whole snapshots are read as deltas");
+		test(received.deserializeDelta(delta) && received == sent, "deltas can be applied after a whole snapshot");
+
+		sent.serialize(data);
+		ofParameterSnapshot corrupt = received;
+		test(!corrupt.deserialize(data.getData(), data.size() - 3), "truncated data isn't read");
+		test(corrupt == received, "truncated data doesn't change the values");
+		data.getData()[0] = 'X';
+		test(!corrupt.deserialize(data), "data that isn't a snapshot isn't read");
+
+		ofParameter<float> intensity("intensity", 0.5);
+		ofParameterGroup other("other", intensity);
+		ofParameterSnapshot otherSnapshot(other);
+		sent.serialize(data);
+		test(otherSnapshot.getSchemaHash() != sent.getSchemaHash() && !otherSnapshot.deserialize(data), "groups with different parameters can't read each other's data");
+	}
+
+	void testSerializers(){
+		Parameters parameters;
+		ofParameterSnapshot snapshot(parameters.group);
+		parameters.change();
+		ofParameterSnapshot captured(parameters.group);
+
+		// the snapshot is saved like the group so they can read each other
+		ofXml xml;
+		captured.saveTo(xml);
+		Parameters loaded;
+		xml.deserialize(loaded.group);
+		test(loaded.position.get() == ofVec3f(-1, 0, 4) && loaded.label.get() == "second scene" && loaded.frames.get() == 50u,
+			"groups load the values saved by a snapshot");
+
+		ofXml edited;
+		edited.loadFromBuffer(xml.toString());
+		edited.setValue("light/intensity", "0.25");
+		edited.setValue("label", "edited");
+		snapshot.loadFrom(edited);
+		test(parameters.intensity.get() == 0.75f, "loading doesn't change the parameters");
+		snapshot.restore();
+		test(parameters.intensity.get() == 0.25f && parameters.label.get() == "edited", "snapshots load values edited by hand");
+		test(parameters.position.get() == ofVec3f(-1, 0, 4) && parameters.frames.get() == 50u, "the rest of the values are loaded");
+
+		ofXml groupXml;
+		parameters.time = 3.5;
+		groupXml.serialize(parameters.group);
+		parameters.time = 0;
+		snapshot.loadFrom(groupXml);
+		snapshot.restore();
+		test_eq(parameters.time.get(), 3.5, "snapshots load the values saved by a group");
+
+		ofXml partial;
+		partial.addChild("show");
+		partial.addValue("time", 4.5);
+		snapshot.loadFrom(partial);
+		snapshot.restore();
+		test(parameters.time.get() == 4.5 && parameters.label.get() == "edited", "values that aren't in the file are kept");
+	}
+
+	void run(){
+		testCaptureAndRestore();
+		testBinary();
+		testSerializers();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,180 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	ofParameterGroup root, sub;
+	ofParameter<float> a, b;
+	ofParameter<int> c;
+
+	vector<float> aValues;
+	size_t rootNotifications = 0;
+	size_t subNotifications = 0;
+	vector<size_t> rootCommits;
+	vector<size_t> subCommits;
+
+	void aChanged(float & value){
+		aValues.push_back(value);
+	}
+
+	void rootChanged(ofAbstractParameter &){
+		rootNotifications++;
+	}
+
+	void subChanged(ofAbstractParameter &){
+		subNotifications++;
+	}
+
+	void rootCommitted(const vector<shared_ptr<ofAbstractParameter>> & changes){
+		rootCommits.push_back(changes.size());
+	}
+
+	void subCommitted(const vector<shared_ptr<ofAbstractParameter>> & changes){
+		subCommits.push_back(changes.size());
+	}
+
+	void reset(){
+		aValues.clear();
+		rootNotifications = 0;
+		subNotifications = 0;
+		rootCommits.clear();
+		subCommits.clear();
+	}
+
+	void setAll(){
+		a = 1;
+		a = 2;
+		a = 3;
+		b = 4;
+		c = 5;
+		c = 6;
+	}
+
+	void testTransactions(){
+		reset();
+		root.beginTransaction();
+		test(root.isInTransaction() && !sub.isInTransaction(), "groups are in a transaction until it's committed");
+		setAll();
+		test(a == 3 && b == 4 && c == 6, "values change inside a transaction");
+		test(aValues.empty() && rootNotifications == 0 && subNotifications == 0, "changes aren't notified inside a transaction");
+		root.commitTransaction();
+		test(aValues == vector<float>{3}, "each parameter notifies once with its last value");
+		test_eq(rootNotifications, 3u, "groups are notified once per changed parameter");
+		test_eq(subNotifications, 1u, "subgroups are notified of their changed parameters");
+		test(rootCommits == vector<size_t>{3} && subCommits == vector<size_t>{1}, "each group notifies all its changes once");
+		test(!root.isInTransaction(), "the transaction ends when it's committed");
+
+		reset();
+		setAll();
+		test_eq(aValues.size(), 3u, "outside of a transaction every change is notified");
+		test(rootCommits.empty(), "changes outside of a transaction aren't committed");
+
+		reset();
+		root.beginTransaction();
+		root.beginTransaction();
+		a = 10;
+		root.commitTransaction();
+		test(aValues.empty(), "nested transactions don't notify");
+		root.commitTransaction();
+		test(aValues == vector<float>{10}, "the outermost transaction notifies");
+
+		// a subgroup's transaction inside its parent's waits for it
+		reset();
+		root.beginTransaction();
+		sub.beginTransaction();
+		c = 20;
+		b = 21;
+		sub.commitTransaction();
+		test(subNotifications == 0 && rootNotifications == 0, "subgroups wait for the transactions of their parents");
+		root.commitTransaction();
+		test(subNotifications == 1 && rootNotifications == 2 && rootCommits == vector<size_t>{2}, "the changes of the subgroup are notified with the parent's");
+
+		reset();
+		root.beginTransaction();
+		a = 30;
+		a = 40;
+		a = 30;
+		root.commitTransaction();
+		test(aValues == vector<float>{30}, "parameters set back to their value still notify once");
+
+		ofLogNotice() << "the next warning is expected";
+		root.commitTransaction();
+		test(!root.isInTransaction(), "committing without a transaction does nothing");
+	}
+
+	void setB(float & value){
+		b = value * 2;
+	}
+
+	void testListeners(){
+		reset();
+		a.addListener(this, &ofApp::setB);
+		root.beginTransaction();
+		a = 7;
+		root.commitTransaction();
+		a.removeListener(this, &ofApp::setB);
+		test_eq(b.get(), 14.f, "listeners can set parameters while committing");
+		test_eq(rootNotifications, 2u, "parameters set while committing are notified right away");
+
+		// a parameter in two groups is recorded once
+		reset();
+		ofParameterGroup other;
+		other.add(a);
+		root.beginTransaction();
+		other.beginTransaction();
+		a = 8;
+		other.commitTransaction();
+		root.commitTransaction();
+		test(aValues == vector<float>{8}, "parameters in several groups notify once");
+		test_eq(rootCommits.size(), 1u, "groups containing the parameter are notified");
+	}
+
+	void testDeferred(){
+		reset();
+		root.setDeferredNotifications(true);
+		test(root.getDeferredNotifications() && root.isInTransaction(), "deferred groups are always in a transaction");
+		setAll();
+		test(aValues.empty(), "deferred changes aren't notified");
+		ofEvents().notifyUpdate();
+		test(aValues == vector<float>{3} && rootCommits == vector<size_t>{3}, "deferred changes are notified on update");
+		reset();
+		ofEvents().notifyUpdate();
+		test(rootCommits.empty(), "frames without changes don't notify");
+		a = 50;
+		root.beginTransaction();
+		b = 51;
+		root.commitTransaction();
+		test(aValues.empty() && rootNotifications == 0, "transactions inside deferred groups wait for the update");
+		root.setDeferredNotifications(false);
+		test(aValues == vector<float>{50} && rootNotifications == 2, "disabling the deferred mode notifies the pending changes");
+		reset();
+		a = 60;
+		test(aValues == vector<float>{60} && !root.isInTransaction(), "changes are notified right away again");
+	}
+
+	void run(){
+		sub.setName("sub");
+		sub.add(c.set("c", 0));
+		root.setName("root");
+		root.add(a.set("a", 0), b.set("b", 0), sub);
+		a.addListener(this, &ofApp::aChanged);
+		ofAddListener(root.parameterChangedE(), this, &ofApp::rootChanged);
+		ofAddListener(sub.parameterChangedE(), this, &ofApp::subChanged);
+		ofAddListener(root.changesCommittedE(), this, &ofApp::rootCommitted);
+		ofAddListener(sub.changesCommittedE(), this, &ofApp::subCommitted);
+
+		testTransactions();
+		testListeners();
+		testDeferred();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,136 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	const uint64_t millis = 1000000;
+
+	void profiled(){
+		OF_PROFILE_SCOPE("profiled");
+		ofSleepMillis(1);
+	}
+
+	void testDisabled(){
+		auto & profiler = ofGetFrameProfiler();
+		test(!profiler.isEnabled(), "the profiler is disabled by default");
+		profiled();
+		profiler.newFrame(10 * millis);
+		test(profiler.getNumFrames() == 0 && profiler.getScopeStats().empty(), "nothing is recorded while disabled");
+	}
+
+	void testFrames(){
+		auto & profiler = ofGetFrameProfiler();
+		profiler.enable();
+		profiler.reset();
+
+		// 100 frames from 1 to 100ms plus a very long one
+		for(uint64_t i = 1; i <= 100; i++){
+			profiler.newFrame(i * millis);
+		}
+		profiler.newFrame(500 * millis);
+		test_eq(profiler.getNumFrames(), 101u, "every frame is counted");
+		test_eq(profiler.getNumHitches(), 68u, "frames longer than 1/30s are hitches");
+		test_eq(profiler.getMaxFrameTime(), 0.5, "the longest frame");
+		// percentiles are the end of the bucket of the frame
+		auto bucket = profiler.getHistogramBucketWidth();
+		test(abs(profiler.getFrameTimePercentile(50) - 0.051 - bucket) < 1e-9, "p50");
+		test(abs(profiler.getFrameTimePercentile(95) - 0.096 - bucket) < 1e-9, "p95");
+		test_eq(profiler.getFrameTimePercentile(100), 0.5, "frames longer than the histogram are the max");
+
+		auto histogram = profiler.getFrameTimeHistogram();
+		test_eq(histogram[size_t(round(0.01 / bucket))], 1u, "frames are in the bucket of their time");
+		test_eq(histogram.back(), 2u, "the last bucket has the frames of 100ms or longer");
+
+		profiler.setHitchThreshold(0.2);
+		profiler.newFrame(100 * millis);
+		test_eq(profiler.getNumHitches(), 68u, "the hitch threshold can be changed");
+		profiler.setHitchThreshold(1 / 30.);
+
+		profiler.reset();
+		test(profiler.getNumFrames() == 0 && profiler.getFrameTimePercentile(99) == 0, "reset forgets the frames");
+	}
+
+	void testScopes(){
+		auto & profiler = ofGetFrameProfiler();
+		profiler.reset();
+		for(int i = 0; i < 3; i++){
+			profiled();
+		}
+		std::thread worker([this]{
+			profiled();
+		});
+		worker.join();
+
+		auto stats = profiler.getScopeStats();
+		test(stats.size() == 1 && stats[0].name == "profiled", "scopes are recorded by name");
+		test_eq(stats[0].count, 4u, "scopes of every thread are recorded");
+		test(stats[0].averageSecs >= 0.001 && stats[0].maxSecs >= stats[0].averageSecs, "the time of the scopes");
+
+		// the core events record the phases of the frame
+		profiler.reset();
+		for(int i = 0; i < 3; i++){
+			ofEvents().notifyUpdate();
+			ofEvents().notifyDraw();
+		}
+		vector<string> names;
+		for(auto & phase: profiler.getScopeStats()){
+			names.push_back(phase.name);
+		}
+		test(ofContains(names, string("update")) && ofContains(names, string("draw")), "update and draw are recorded");
+		test(profiler.getNumFrames() >= 2, "draw ends a frame");
+
+		// the ring buffer keeps the last scopes
+		profiler.reset();
+		profiler.setThreadBufferSize(8);
+		std::thread small([]{
+			for(int i = 0; i < 20; i++){
+				OF_PROFILE_SCOPE("small");
+			}
+		});
+		small.join();
+		profiler.setThreadBufferSize(16384);
+		stats = profiler.getScopeStats();
+		test(stats.size() == 1 && stats[0].count == 8, "threads keep the scopes that fit in their buffer");
+	}
+
+	void testTrace(){
+		auto & profiler = ofGetFrameProfiler();
+		profiler.reset();
+		{
+			OF_PROFILE_SCOPE("a \"quoted\" scope");
+		}
+		profiler.newFrame(16 * millis);
+		ostringstream trace;
+		profiler.writeChromeTrace(trace);
+		string json = trace.str();
+		test(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0 && json.find("]}") != string::npos, "the trace is a chrome trace object");
+		test(ofIsStringInString(json, "\"name\":\"a \\\"quoted\\\" scope\",\"cat\":\"scope\",\"ph\":\"X\""), "scopes are complete events with escaped names");
+		test(ofIsStringInString(json, "\"name\":\"frame\",\"cat\":\"frame\""), "frames are in the trace");
+		test(ofIsStringInString(json, "\"args\":{\"name\":\"main\"}"), "the thread ending the frames is the main thread");
+		test(!ofIsStringInString(json, "profiled"), "scopes before a reset aren't in the trace");
+
+		test(profiler.saveChromeTrace("trace.json"), "the trace is saved");
+		test_eq(ofBufferFromFile("trace.json").getText(), json, "the saved trace");
+		ofFile::removeFile("trace.json");
+
+		ofLogNotice() << profiler.getSummary();
+		profiler.disable();
+	}
+
+	void run(){
+		testDisabled();
+		testFrames();
+		testScopes();
+		testTrace();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,150 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+
+	const string document =
+		"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		"<!DOCTYPE show [ <!ELEMENT show ANY> ]>\n"
+		"<!-- a <comment> -->\n"
+		"<show name=\"test &amp; more\" version='2'>\n"
+		"\t<cue id=\"0\" time=\"1.5\"><light channel=\"1\"/><text>fade &lt;in&gt; &#65;&#x42;</text></cue>\n"
+		"\t<cue id=\"1\" time=\"3\">\n"
+		"\t\t<light channel=\"2\"/>\n"
+		"\t\t<text><![CDATA[<raw> & text]]></text>\n"
+		"\t</cue>\n"
+		"\t<cue id=\"2\" time=\"4.25\"><text>last</text></cue>\n"
+		"</show>\n";
+
+	vector<string> events(const string & xml){
+		ofBuffer buffer(xml);
+		ofXmlReader reader(buffer);
+		vector<string> events;
+		while(reader.next() != ofXmlReader::EndDocument){
+			switch(reader.getEvent()){
+			case ofXmlReader::StartElement:
+				events.push_back("<" + reader.getName() + ">");
+				break;
+			case ofXmlReader::EndElement:
+				events.push_back("</" + reader.getName() + ">");
+				break;
+			case ofXmlReader::Text:
+				events.push_back(reader.getText());
+				break;
+			default:
+				events.push_back("error");
+				return events;
+			}
+		}
+		return events;
+	}
+
+	void testReader(){
+		vector<string> expected = {
+			"<show>",
+			"<cue>", "<light>", "</light>", "<text>", "fade <in> AB", "</text>", "</cue>",
+			"<cue>", "<light>", "</light>", "<text>", "<raw> & text", "</text>", "</cue>",
+			"<cue>", "<text>", "last", "</text>", "</cue>",
+			"</show>",
+		};
+		test(events(document) == expected, "the reader returns every element and text in order");
+
+		ofBuffer buffer(document);
+		ofXmlReader reader(buffer);
+		test_eq(reader.next(), ofXmlReader::StartElement, "the first event is the root element");
+		test_eq(reader.getNumAttributes(), 2u, "attributes of the root element");
+		test_eq(reader.getAttribute("name"), "test & more", "attribute values are decoded");
+		test_eq(reader.getAttribute("version"), "2", "single quoted attributes");
+		test(!reader.hasAttribute("missing") && reader.getAttribute("missing") == "", "missing attributes are empty");
+		reader.next();
+		test_eq(reader.getPath(), "show/cue", "the path of the current element");
+		test_eq(reader.getDepth(), 2u, "the depth of the current element");
+		test(reader.skipElement() && reader.getEvent() == ofXmlReader::EndElement && reader.getName() == "cue", "elements can be skipped");
+		reader.next();
+		test_eq(reader.getAttribute("id"), "1", "the next element after skipping one");
+		test_eq(reader.readElementText(), "<raw> & text", "the text of an element and its children");
+		test_eq(reader.getLine(), 9u, "the line of the reader");
+
+		// every time is read without building a tree
+		float total = 0;
+		reader.reset();
+		while(reader.next() != ofXmlReader::EndDocument){
+			if(reader.getEvent() == ofXmlReader::StartElement && reader.getName() == "cue"){
+				total += ofToFloat(reader.getAttribute("time"));
+			}
+		}
+		test_eq(total, 8.75f, "the reader can be reset");
+
+		ofLogNotice() << "the next errors are expected";
+		test(events("<a><b></a>").back() == "error", "mismatched elements are an error");
+		test(events("<a><b>").back() == "error", "unclosed elements are an error");
+		test(events("<a x=1/>").back() == "error", "unquoted attributes are an error");
+		test(events("<a><!-- b </a>").back() == "error", "unclosed comments are an error");
+		ofBuffer brokenBuffer("<a>\n<b>\n</c>");
+		ofXmlReader broken(brokenBuffer);
+		while(broken.next() != ofXmlReader::Error && broken.getEvent() != ofXmlReader::EndDocument);
+		test(ofIsStringInString(broken.getError(), "line 3"), "errors say where they are");
+		test(events("<a></a><!-- end -->\n").size() == 2, "content after the root element is skipped");
+	}
+
+	void testFiles(){
+		ofXml xml;
+		xml.loadFromBuffer(document.substr(document.find("<show")));
+		test_eq(xml.getValue("cue/text"), "fade <in> AB", "paths find the first matching element");
+		test_eq(xml.getValue("cue[1]/text"), "<raw> & text", "paths with an index");
+		test_eq(xml.getAttribute("cue[2][@time]"), "4.25", "paths to attributes");
+		test_eq(xml.getAttribute("name"), "test & more", "attributes of the current element");
+		test(xml.exists("cue/light") && !xml.exists("cue/sound"), "paths that exist and don't");
+		test_eq(xml.getValue("cue[2]/text"), "last", "the same path twice uses the cache");
+
+		// the cache follows the changes of the document
+		xml.setValue("cue[2]/text", "changed");
+		test_eq(xml.getValue("cue[2]/text"), "changed", "values are read after changing them");
+		test(xml.remove("cue[0]"), "elements can be removed");
+		test_eq(xml.getValue("cue/text"), "<raw> & text", "paths are resolved again after removing an element");
+		test_eq(xml.getValue("cue[1]/text"), "changed", "indices are resolved again after removing an element");
+		test(xml.addChild("cue"), "elements can be added");
+		test_eq(xml.getNumChildren("cue"), 3, "the added element is found");
+		test(xml.setToChild(2) && xml.addValue("text", "added") && xml.setToParent(), "values can be added to the new element");
+		test_eq(xml.getValue("cue[2]/text"), "added", "paths are resolved again after adding an element");
+		test_eq(xml.getAttribute("cue[@id]"), "1", "attributes of the first element");
+		test(xml.setTo("cue") && xml.setAttribute("id", "10") && xml.setToParent(), "attributes can be changed");
+		test_eq(xml.getAttribute("cue[@id]"), "10", "attributes are read after changing them");
+		test(xml.removeAttribute("cue[@id]") && !xml.exists("cue[@id]"), "paths are resolved again after removing an attribute");
+		test(xml.setTo("cue[1]") && xml.getValue("text") == "changed" && xml.setToParent(), "setTo uses the paths");
+		test_eq(xml.getValue("//text"), "<raw> & text", "paths that Poco resolves still work");
+
+		// saving streams the document to the file
+		test(xml.save("saved.xml"), "the document is saved");
+		test_eq(ofBufferFromFile("saved.xml").getText(), xml.toString(), "the saved file is the same as toString");
+		test(!ofIsStringInString(xml.toString(), "#text"), "the text tags of the writer are removed");
+		ofXml saved;
+		test(saved.load("saved.xml") && saved.toString() == xml.toString(), "the saved file can be loaded");
+
+		ofXmlReader reader;
+		test(reader.load("saved.xml"), "the reader loads files");
+		size_t cues = 0;
+		while(reader.next() != ofXmlReader::EndDocument && reader.getEvent() != ofXmlReader::Error){
+			cues += reader.getEvent() == ofXmlReader::StartElement && reader.getName() == "cue";
+		}
+		test(reader.getEvent() == ofXmlReader::EndDocument && cues == 3, "the reader reads what ofXml saves");
+		ofFile::removeFile("saved.xml");
+		ofLogNotice() << "the next error is expected";
+		test(!reader.load("doesnt_exist.xml"), "loading a file that doesn't exist fails");
+	}
+
+	void run(){
+		testReader();
+		testFiles();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}